@@ -0,0 +1,208 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_BENCHMARK_H
+#define RC_DYNAMICS_API_BENCHMARK_H
+
+#include "rc_dynamics_api/json.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace bench
+{
+namespace detail
+{
+/**
+ * Results of all benchmarks of a program, which are written as JSON on exit
+ * if requested by the --json option.
+ */
+struct Results
+{
+  std::string program;
+  std::string filename;
+  nlohmann::json results = nlohmann::json::array();
+
+  ~Results()
+  {
+    if (filename.empty())
+    {
+      return;
+    }
+
+    nlohmann::json js;
+    js["program"] = program;
+    js["time"] = std::chrono::duration_cast<std::chrono::seconds>(
+                     std::chrono::system_clock::now().time_since_epoch()).count();
+    js["results"] = results;
+
+    std::ofstream out(filename);
+    out << js.dump(2) << std::endl;
+    if (!out)
+    {
+      std::cerr << "Cannot write benchmark results to '" << filename << "'" << std::endl;
+    }
+  }
+};
+
+inline Results& getResults()
+{
+  static Results results;
+  return results;
+}
+}
+
+/**
+ * Parses the options that are common to all benchmark programs and removes
+ * them from the arguments:
+ *
+ *   --json <file>  additionally writes all results to the file, for tracking
+ *                  regressions
+ *
+ * @param argc number of arguments
+ * @param argv arguments
+ */
+inline void init(int& argc, char* argv[])
+{
+  detail::Results& results = detail::getResults();
+  const char* name = std::strrchr(argv[0], '/');
+  results.program = name ? name + 1 : argv[0];
+
+  int k = 1;
+  for (int i = 1; i < argc; i++)
+  {
+    if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+    {
+      results.filename = argv[++i];
+    }
+    else
+    {
+      argv[k++] = argv[i];
+    }
+  }
+  argc = k;
+}
+
+/**
+ * Records a result for the JSON output, without printing it.
+ *
+ * @param name name of the benchmark
+ * @param value measured value
+ * @param unit unit of the value, e.g. "ns/op", "MB/s" or "us"
+ */
+inline void record(const std::string& name, double value, const std::string& unit)
+{
+  nlohmann::json js;
+  js["name"] = name;
+  js["value"] = value;
+  js["unit"] = unit;
+  detail::getResults().results.push_back(js);
+}
+
+/**
+ * Records and prints a result that is not a time per operation, e.g. a
+ * throughput or a latency percentile.
+ */
+inline void reportValue(const std::string& name, double value, const std::string& unit)
+{
+  record(name, value, unit);
+  std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << value << " " << unit << std::endl;
+}
+
+/**
+ * Prevents the compiler from optimizing away the computation of a value.
+ */
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * Calls fn repeatedly until at least min_secs have elapsed and returns the
+ * average time per operation in nanoseconds.
+ *
+ * @param fn function to be measured
+ * @param ops_per_call number of operations done by one call of fn, e.g. batch size
+ * @param min_secs minimum measurement time
+ */
+template <class F>
+double measure(F fn, std::size_t ops_per_call = 1, double min_secs = 0.5)
+{
+  typedef std::chrono::steady_clock clock;
+
+  // warm up caches and branch predictors
+  fn();
+
+  std::size_t calls = 0;
+  std::size_t batch = 1;
+  clock::time_point start = clock::now();
+  std::chrono::duration<double> elapsed(0);
+  while (elapsed.count() < min_secs)
+  {
+    for (std::size_t i = 0; i < batch; i++)
+    {
+      fn();
+    }
+    calls += batch;
+    batch *= 2;
+    elapsed = clock::now() - start;
+  }
+
+  return elapsed.count() * 1e9 / (static_cast<double>(calls) * ops_per_call);
+}
+
+/**
+ * Records and prints the result of one benchmark as a line of a table.
+ */
+inline void report(const std::string& name, double ns_per_op)
+{
+  record(name, ns_per_op, "ns/op");
+  std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << ns_per_op << " ns/op" << std::setw(14) << std::setprecision(2) << 1e3 / ns_per_op
+            << " Mop/s" << std::endl;
+}
+}
+
+#endif  // RC_DYNAMICS_API_BENCHMARK_H
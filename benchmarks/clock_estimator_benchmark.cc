@@ -0,0 +1,190 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "benchmark.h"
+#include "synthetic_data.h"
+
+#include <rc_dynamics_api/clock_estimator.h>
+#include <rc_dynamics_api/data_receiver.h>
+#include <rc_dynamics_api/data_sender.h>
+#include <rc_dynamics_api/pose_timeline.h>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::ClockEstimator;
+
+namespace
+{
+/**
+ * Simulates a 200 Hz stream from a device whose clock is 3.2 s behind and
+ * drifts by 40 ppm, with a minimum delay of 100 us, exponentially
+ * distributed delays with a mean of 300 us and 2% of messages delayed by
+ * 5 - 20 ms. Reports the error of converted time stamps against the true
+ * sending time at some points in time.
+ */
+void benchmarkAccuracy()
+{
+  const double skew = 40e-6;
+  const int64_t device_start = bench::synthetic_start;
+  const int64_t host_start = device_start + 3200000000ll;
+
+  mt19937 rng(42);
+  exponential_distribution<double> delay(1.0 / 300e3);
+  uniform_real_distribution<double> uniform(0, 1);
+
+  ClockEstimator::Ptr estimator = ClockEstimator::create();
+  vector<int> checkpoints = { 1, 10, 60, 300 };
+  vector<double> errors;
+  size_t next = 0;
+  for (int i = 0; next < checkpoints.size(); i++)
+  {
+    int64_t host_send = host_start + i * 5000000ll;
+    int64_t device = device_start + static_cast<int64_t>((host_send - host_start) / (1 + skew));
+    double d = 100e3 + delay(rng);
+    if (uniform(rng) < 0.02)
+    {
+      d += 5e6 + 15e6 * uniform(rng);
+    }
+
+    estimator->add(device, host_send + static_cast<int64_t>(d));
+    errors.push_back((estimator->toHost(device) - host_send) / 1e3);
+
+    if (host_send - host_start >= checkpoints[next] * 1000000000ll)
+    {
+      // errors of the last second
+
+      vector<double> last(errors.end() - min<size_t>(errors.size(), 200), errors.end());
+      sort(last.begin(), last.end());
+      string name = "after " + to_string(checkpoints[next]) + " s";
+      bench::reportValue("error incl. 100 us min. delay, " + name + ", min", last.front(), "us");
+      bench::reportValue("error incl. 100 us min. delay, " + name + ", max", last.back(), "us");
+      bench::reportValue("skew error, " + name, (estimator->getModel().skew - skew) * 1e6, "ppm");
+      next++;
+    }
+  }
+
+  bench::report("ClockEstimator::add()", bench::measure([&]() {
+                  static int64_t t = 0;
+                  t += 5000000;
+                  estimator->add(device_start + t, host_start + t + 100000);
+                }));
+
+  int64_t t = device_start;
+  bench::report("ClockEstimator::toHost()", bench::measure([&]() { bench::doNotOptimize(estimator->toHost(t++)); }));
+}
+
+/**
+ * Sends Imu messages via loopback, time stamped with the clock of this host
+ * minus 2.5 s like an rc_visard with another clock, and estimates the
+ * offset from the kernel receive time stamps.
+ */
+void benchmarkLoopback()
+{
+  const int64_t device_offset = -2500000000ll;
+
+  unsigned int port = 0;
+  rc::dynamics::DataReceiver::Ptr receiver = rc::dynamics::DataReceiver::create("127.0.0.1", port);
+  rc::dynamics::DataSender::Ptr sender = rc::dynamics::DataSender::create("127.0.0.1", port);
+  receiver->setTimeout(100);
+  receiver->setReceiveTimestamps(true);
+
+  atomic<bool> running(true);
+  thread producer([&]() {
+    roboception::msgs::Imu msg = bench::createImu(0);
+    chrono::steady_clock::time_point next = chrono::steady_clock::now();
+    while (running)
+    {
+      int64_t now = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+      bench::setTime(msg.mutable_timestamp(), now + device_offset);
+      sender->send(msg);
+
+      next += chrono::milliseconds(1);
+      this_thread::sleep_until(next);
+    }
+  });
+
+  ClockEstimator::Ptr estimator = ClockEstimator::create();
+  vector<double> scheduling;
+  chrono::steady_clock::time_point end = chrono::steady_clock::now() + chrono::seconds(2);
+  while (chrono::steady_clock::now() < end)
+  {
+    shared_ptr<roboception::msgs::Imu> msg = receiver->receive<roboception::msgs::Imu>();
+    if (msg)
+    {
+      int64_t now = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+      scheduling.push_back((now - receiver->getReceiveTime()) / 1e3);
+      estimator->add(rc::dynamics::toNanoseconds(msg->timestamp()), receiver->getReceiveTime());
+    }
+  }
+
+  running = false;
+  producer.join();
+
+  if (scheduling.empty())
+  {
+    throw runtime_error("No messages received via loopback");
+  }
+
+  sort(scheduling.begin(), scheduling.end());
+  bench::reportValue("loopback, kernel receive time to user space, p50", scheduling[scheduling.size() / 2], "us");
+  bench::reportValue("loopback, kernel receive time to user space, p99", scheduling[scheduling.size() * 99 / 100],
+                     "us");
+  ClockEstimator::Model model = estimator->getModel();
+  double error = model.getOffset(model.device_ref) + device_offset;
+  bench::reportValue("loopback, estimated offset - true offset", error / 1e3, "us");
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  try
+  {
+    benchmarkAccuracy();
+    benchmarkLoopback();
+  }
+  catch (const exception& e)
+  {
+    cerr << "ERROR: " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
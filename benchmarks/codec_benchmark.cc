@@ -0,0 +1,280 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark.h"
+#include "synthetic_data.h"
+
+#include <rc_dynamics_api/compressed_recording.h>
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::BitReader;
+using rc::dynamics::BitWriter;
+using rc::dynamics::CompressedRecordingReader;
+using rc::dynamics::CompressedRecordingWriter;
+using rc::dynamics::MessageCodec;
+using rc::dynamics::RecordedMessage;
+
+namespace
+{
+const char* filename = "codec_benchmark.rcz";
+
+/**
+ * Adds gaussian noise to all floating point fields, like the measurement
+ * noise of real sensors.
+ */
+void addNoise(google::protobuf::Message& m, mt19937& rng, double sigma)
+{
+  normal_distribution<double> noise(0, sigma);
+  const google::protobuf::Reflection* refl = m.GetReflection();
+  const google::protobuf::Descriptor* descr = m.GetDescriptor();
+  for (int i = 0; i < descr->field_count(); i++)
+  {
+    const google::protobuf::FieldDescriptor* field = descr->field(i);
+    if (field->is_repeated())
+    {
+      continue;
+    }
+    if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE && refl->HasField(m, field))
+    {
+      refl->SetDouble(&m, field, refl->GetDouble(m, field) + noise(rng));
+    }
+    else if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE && refl->HasField(m, field))
+    {
+      addNoise(*refl->MutableMessage(&m, field), rng, sigma);
+    }
+  }
+}
+
+/// Returns the largest difference of the floating point fields of two messages of the same type
+double maxDifference(const google::protobuf::Message& a, const google::protobuf::Message& b)
+{
+  double ret = 0;
+  const google::protobuf::Reflection* refl = a.GetReflection();
+  const google::protobuf::Descriptor* descr = a.GetDescriptor();
+  for (int i = 0; i < descr->field_count(); i++)
+  {
+    const google::protobuf::FieldDescriptor* field = descr->field(i);
+    if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE)
+    {
+      if (field->is_repeated())
+      {
+        for (int k = 0; k < refl->FieldSize(a, field) && k < refl->FieldSize(b, field); k++)
+        {
+          ret = max(ret, fabs(refl->GetRepeatedDouble(a, field, k) - refl->GetRepeatedDouble(b, field, k)));
+        }
+      }
+      else
+      {
+        ret = max(ret, fabs(refl->GetDouble(a, field) - refl->GetDouble(b, field)));
+      }
+    }
+    else if (field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE && !field->is_repeated())
+    {
+      ret = max(ret, maxDifference(refl->GetMessage(a, field), refl->GetMessage(b, field)));
+    }
+  }
+  return ret;
+}
+
+/**
+ * Measures the compression of a sequence of messages and checks that they
+ * are decoded within the tolerance.
+ */
+template <class T>
+bool benchmark(const string& name, const vector<T>& msgs, double tolerance)
+{
+  vector<string> data(msgs.size());
+  size_t raw_size = 0;
+  for (size_t i = 0; i < msgs.size(); i++)
+  {
+    data[i] = msgs[i].SerializeAsString();
+    raw_size += data[i].size();
+  }
+
+  MessageCodec codec(T::descriptor(), tolerance);
+  BitWriter out;
+  bool ok = true;
+  double encode_ns = bench::measure(
+      [&]() {
+        out.clear();
+        codec.reset();
+        for (auto&& s : data)
+        {
+          ok = codec.encode(out, s.data(), s.size()) && ok;
+        }
+        out.finish();
+      },
+      msgs.size());
+
+  vector<string> decoded(msgs.size());
+  double decode_ns = bench::measure(
+      [&]() {
+        BitReader in(out.getData(), out.getSize());
+        codec.reset();
+        for (auto&& s : decoded)
+        {
+          codec.decode(in, s);
+        }
+      },
+      msgs.size());
+
+  double bytes_per_msg = static_cast<double>(raw_size) / msgs.size();
+  cout << left << setw(36) << name << " tolerance " << setw(6) << tolerance << right << fixed << setprecision(1)
+       << setw(7) << bytes_per_msg << " -> " << setw(5) << static_cast<double>(out.getSize()) / msgs.size()
+       << " bytes/msg, ratio " << setw(5) << static_cast<double>(raw_size) / out.getSize() << ", encode " << setw(6)
+       << setprecision(0) << bytes_per_msg / encode_ns * 1000 << " MB/s, decode " << setw(6)
+       << bytes_per_msg / decode_ns * 1000 << " MB/s" << endl;
+  cout.unsetf(ios::fixed);
+
+  ostringstream prefix;
+  prefix << name << ", tolerance " << tolerance;
+  bench::record(prefix.str() + ", ratio", static_cast<double>(raw_size) / out.getSize(), "x");
+  bench::record(prefix.str() + ", encode", bytes_per_msg / encode_ns * 1000, "MB/s");
+  bench::record(prefix.str() + ", decode", bytes_per_msg / decode_ns * 1000, "MB/s");
+
+  T m;
+  for (size_t i = 0; i < msgs.size(); i++)
+  {
+    if (tolerance == 0)
+    {
+      ok = ok && decoded[i] == data[i];
+    }
+    else
+    {
+      ok = ok && m.ParseFromString(decoded[i]) && maxDifference(m, msgs[i]) <= tolerance * (1 + 1e-9);
+    }
+  }
+  return ok;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  mt19937 rng(42);
+
+  vector<roboception::msgs::Dynamics> dynamics, noisy_dynamics;
+  for (int i = 0; i < 20000; i++)
+  {
+    dynamics.push_back(bench::createDynamics(i));
+    noisy_dynamics.push_back(dynamics.back());
+    addNoise(noisy_dynamics.back(), rng, 1e-5);
+  }
+
+  vector<roboception::msgs::Imu> imu, noisy_imu;
+  for (int i = 0; i < 100000; i++)
+  {
+    imu.push_back(bench::createImu(i));
+    noisy_imu.push_back(imu.back());
+    addNoise(noisy_imu.back(), rng, 1e-3);
+  }
+
+  bool ok = true;
+  for (double tolerance : { 0.0, 1e-6, 1e-4 })
+  {
+    ok = benchmark("Dynamics (smooth trajectory)", dynamics, tolerance) && ok;
+    ok = benchmark("Dynamics (trajectory with noise)", noisy_dynamics, tolerance) && ok;
+    ok = benchmark("Imu (smooth)", imu, tolerance) && ok;
+    ok = benchmark("Imu (with noise)", noisy_imu, tolerance) && ok;
+  }
+
+  // compressed recording of both streams, from serialized messages as received
+
+  {
+    vector<string> data(noisy_dynamics.size() + noisy_imu.size());
+    vector<uint16_t> streams(data.size());
+    vector<int64_t> stamps(data.size());
+    size_t raw_size = 0;
+    for (size_t i = 0, d = 0; i < data.size(); i++)
+    {
+      // one dynamics message after each five imu messages
+      bool is_dynamics = (i % 6 == 5 && d < noisy_dynamics.size());
+      streams[i] = is_dynamics ? 1 : 0;
+      data[i] = is_dynamics ? noisy_dynamics[d++].SerializeAsString() : noisy_imu[i - d].SerializeAsString();
+      stamps[i] = bench::synthetic_start + static_cast<int64_t>(i) * 833333 + 300000;
+      raw_size += data[i].size();
+    }
+
+    double write_ns = bench::measure(
+        [&]() {
+          CompressedRecordingWriter::Ptr writer =
+              CompressedRecordingWriter::create(filename, { { "imu", "Imu" }, { "dynamics", "Dynamics" } }, 1e-6);
+          for (size_t i = 0; i < data.size(); i++)
+          {
+            writer->write(streams[i], stamps[i], data[i].data(), data[i].size());
+          }
+          writer->close();
+        },
+        data.size());
+    bench::report("CompressedRecordingWriter::write", write_ns);
+
+    double read_ns = bench::measure(
+        [&]() {
+          CompressedRecordingReader::Ptr reader = CompressedRecordingReader::open(filename);
+          RecordedMessage msg;
+          size_t i = 0;
+          while (reader->next(msg))
+          {
+            ok = ok && i < data.size() && msg.stream == streams[i] && msg.host_stamp == stamps[i];
+            i++;
+          }
+          ok = ok && i == data.size() && reader->isComplete();
+        },
+        data.size());
+    bench::report("CompressedRecordingReader::next", read_ns);
+
+    FILE* f = fopen(filename, "rb");
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    cout << "Compressed recording of imu and dynamics with noise: " << raw_size << " -> " << size << " bytes, ratio "
+         << setprecision(3) << static_cast<double>(raw_size) / size << endl;
+    bench::record("Compressed recording of imu and dynamics with noise, ratio", static_cast<double>(raw_size) / size,
+                  "x");
+    remove(filename);
+  }
+
+  if (!ok)
+  {
+    cerr << "ERROR: messages are not decoded as encoded" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark.h"
+#include "synthetic_data.h"
+
+#include "../tools/csv_printing.h"
+
+#include <rc_dynamics_api/recording.h>
+
+#include <cfloat>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::RecordingReader;
+using rc::dynamics::RecordedMessage;
+
+namespace
+{
+/**
+ * Reads all Dynamics messages of a recording, or creates synthetic ones if
+ * no recording is given.
+ */
+vector<roboception::msgs::Dynamics> loadDynamics(const char* filename)
+{
+  vector<roboception::msgs::Dynamics> ret;
+  if (filename)
+  {
+    RecordingReader::Ptr reader = RecordingReader::open(filename);
+    RecordingReader::Cursor cursor = reader->cursor();
+    RecordedMessage msg;
+    while (cursor.next(msg))
+    {
+      if (reader->getStream(msg.stream).pb_msg_type == "Dynamics")
+      {
+        ret.push_back(roboception::msgs::Dynamics());
+        ret.back().ParseFromArray(msg.data, static_cast<int>(msg.size));
+      }
+    }
+  }
+  else
+  {
+    for (int i = 0; i < 20000; i++)
+    {
+      ret.push_back(bench::createDynamics(i));
+    }
+  }
+  return ret;
+}
+
+/// Checks that appendFixed() gives the same result as std::to_string()
+bool verifyFixed()
+{
+  vector<double> values = { 0.0, -0.0, 1.0, -1.0, 0.5, 0.0000005, 0.0000015, -0.0000005, 2.5e-7, 1e-7, 999999.9999995,
+                            123456789.123456, 1e9, -1e9, 1e15, 1e300, DBL_MIN, DBL_MAX, -DBL_MAX, NAN, -NAN, INFINITY,
+                            -INFINITY, 9.81, 3.14159265358979 };
+
+  mt19937_64 rng(42);
+  uniform_real_distribution<double> exponent(-12, 12);
+  uniform_int_distribution<int> digits(0, 999999999);
+  for (int i = 0; i < 1000000; i++)
+  {
+    double v = pow(10.0, exponent(rng)) * (i % 2 ? 1 : -1);
+    values.push_back(v);
+
+    // values that are close to ties when rounding to six decimals
+    values.push_back(digits(rng) * 1e-6 + 5e-7);
+  }
+
+  string out;
+  for (double v : values)
+  {
+    out.clear();
+    csv::appendFixed(out, v);
+    if (out != to_string(v))
+    {
+      cerr << "ERROR: appendFixed(" << setprecision(17) << v << ") gives " << out << " instead of " << to_string(v)
+           << endl;
+      return false;
+    }
+  }
+
+  for (int64_t v : vector<int64_t>{ INT64_MIN, INT64_MIN + 1, -1, 0, 1, 10, INT64_MAX })
+  {
+    out.clear();
+    csv::appendInt(out, v);
+    if (out != to_string(v))
+    {
+      cerr << "ERROR: appendInt(" << v << ") gives " << out << endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Checks that the Writer gives the same lines as Line
+bool verifyWriter(const vector<roboception::msgs::Dynamics>& msgs)
+{
+  ostringstream expected, actual;
+  {
+    csv::Writer writer(actual);
+    for (auto&& m : msgs)
+    {
+      csv::Line l;
+      expected << (l << m) << '\n';
+      writer << m;
+    }
+  }
+
+  // also messages with some optional fields missing
+  roboception::msgs::Dynamics m = msgs.front();
+  m.clear_linear_velocity();
+  m.clear_covariance();
+  m.set_pose_frame("");
+  {
+    csv::Line l;
+    expected << (l << m) << '\n';
+    csv::Writer writer(actual);
+    writer << m;
+  }
+
+  if (expected.str() != actual.str())
+  {
+    cerr << "ERROR: csv::Writer gives different lines than csv::Line" << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  vector<roboception::msgs::Dynamics> msgs = loadDynamics(argc > 1 ? argv[1] : 0);
+  if (msgs.empty())
+  {
+    cerr << "No Dynamics messages available" << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!verifyFixed() || !verifyWriter(msgs))
+  {
+    return EXIT_FAILURE;
+  }
+
+  ostringstream out;
+
+  double line_ns = bench::measure(
+      [&]() {
+        out.str("");
+        for (auto&& m : msgs)
+        {
+          csv::Line l;
+          out << (l << m) << '\n';
+        }
+      },
+      msgs.size());
+  bench::report("csv::Line (Dynamics)", line_ns);
+
+  double writer_ns = bench::measure(
+      [&]() {
+        out.str("");
+        csv::Writer writer(out);
+        for (auto&& m : msgs)
+        {
+          writer << m;
+        }
+      },
+      msgs.size());
+  bench::report("csv::Writer (Dynamics)", writer_ns);
+
+  cout << "speedup: " << fixed << setprecision(1) << line_ns / writer_ns << endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark.h"
+
+#include <rc_dynamics_api/pose_kernels.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace rc::dynamics;
+namespace k = rc::dynamics::kernels;
+
+namespace
+{
+/**
+ * Poses in structure-of-arrays layout with random positions and random unit
+ * quaternions.
+ */
+struct Poses
+{
+  explicit Poses(size_t n, unsigned int seed = 1) : x(n), y(n), z(n), qx(n), qy(n), qz(n), qw(n)
+  {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> pos(-10, 10);
+    normal_distribution<double> rot(0, 1);
+
+    for (size_t i = 0; i < n; i++)
+    {
+      x[i] = pos(rng);
+      y[i] = pos(rng);
+      z[i] = pos(rng);
+
+      double a = rot(rng), b = rot(rng), c = rot(rng), d = rot(rng);
+      double norm = sqrt(a * a + b * b + c * c + d * d);
+      qx[i] = a / norm;
+      qy[i] = b / norm;
+      qz[i] = c / norm;
+      qw[i] = d / norm;
+    }
+  }
+
+  k::PoseArray array()
+  {
+    k::PoseArray p = { { x.data(), y.data(), z.data() }, { qx.data(), qy.data(), qz.data(), qw.data() } };
+    return p;
+  }
+
+  vector<double> x, y, z, qx, qy, qz, qw;
+};
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  // odd size for exercising the scalar tail of the vectorized kernels
+  const size_t n = 4099;
+
+  cout << "Instruction set: " << k::instructionSet() << endl;
+
+  Poses a(n, 1), b(n, 2), out(n);
+  vector<double> t(n);
+  mt19937 rng(3);
+  uniform_real_distribution<double> dist(0, 1);
+  for (auto& v : t)
+  {
+    v = dist(rng);
+  }
+
+  StampedPose cam2imu = { 0, 0.05, -0.01, 0.02, 0.5, -0.5, 0.5, 0.5 };
+
+  // the results are checked against the scalar reference by tests/pose_kernels_test.cc
+
+  bench::report("multiply", bench::measure([&]() {
+                  k::multiply(a.array().orientation, b.array().orientation, out.array().orientation, n);
+                  bench::doNotOptimize(out.qw[0]);
+                }, n));
+  bench::report("multiply (scalar)", bench::measure([&]() {
+                  k::scalar::multiply(a.array().orientation, b.array().orientation, out.array().orientation, n);
+                  bench::doNotOptimize(out.qw[0]);
+                }, n));
+
+  bench::report("normalize", bench::measure([&]() {
+                  k::normalize(a.array().orientation, n);
+                  bench::doNotOptimize(a.qw[0]);
+                }, n));
+  bench::report("normalize (scalar)", bench::measure([&]() {
+                  k::scalar::normalize(a.array().orientation, n);
+                  bench::doNotOptimize(a.qw[0]);
+                }, n));
+
+  bench::report("rotate", bench::measure([&]() {
+                  k::rotate(a.array().orientation, b.array().position, out.array().position, n);
+                  bench::doNotOptimize(out.x[0]);
+                }, n));
+  bench::report("rotate (scalar)", bench::measure([&]() {
+                  k::scalar::rotate(a.array().orientation, b.array().position, out.array().position, n);
+                  bench::doNotOptimize(out.x[0]);
+                }, n));
+
+  bench::report("compose", bench::measure([&]() {
+                  k::compose(a.array(), b.array(), out.array(), n);
+                  bench::doNotOptimize(out.x[0]);
+                }, n));
+  bench::report("compose (scalar)", bench::measure([&]() {
+                  k::scalar::compose(a.array(), b.array(), out.array(), n);
+                  bench::doNotOptimize(out.x[0]);
+                }, n));
+
+  bench::report("compose with constant", bench::measure([&]() {
+                  k::compose(a.array(), cam2imu, out.array(), n);
+                  bench::doNotOptimize(out.x[0]);
+                }, n));
+  bench::report("compose with constant (scalar)", bench::measure([&]() {
+                  k::scalar::compose(a.array(), cam2imu, out.array(), n);
+                  bench::doNotOptimize(out.x[0]);
+                }, n));
+
+  bench::report("inverse", bench::measure([&]() {
+                  k::inverse(a.array(), out.array(), n);
+                  bench::doNotOptimize(out.x[0]);
+                }, n));
+  bench::report("inverse (scalar)", bench::measure([&]() {
+                  k::scalar::inverse(a.array(), out.array(), n);
+                  bench::doNotOptimize(out.x[0]);
+                }, n));
+
+  bench::report("slerp", bench::measure([&]() {
+                  k::slerp(a.array().orientation, b.array().orientation, t.data(), out.array().orientation, n);
+                  bench::doNotOptimize(out.qw[0]);
+                }, n));
+  bench::report("slerp (scalar)", bench::measure([&]() {
+                  k::scalar::slerp(a.array().orientation, b.array().orientation, t.data(),
+                                   out.array().orientation, n);
+                  bench::doNotOptimize(out.qw[0]);
+                }, n));
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark.h"
+
+#include <rc_dynamics_api/pose_timeline.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::PoseTimeline;
+using rc::dynamics::StampedPose;
+
+namespace
+{
+/**
+ * Creates a synthetic trajectory of n poses at 200 Hz with some jitter on
+ * the time stamps, moving on a circle while rotating about z.
+ */
+roboception::msgs::Trajectory createTrajectory(int n)
+{
+  roboception::msgs::Trajectory trajectory;
+  mt19937 rng(42);
+  uniform_int_distribution<int> jitter(-200000, 200000);
+
+  int64_t t = 1500000000ll * 1000000000ll;
+  for (int i = 0; i < n; i++)
+  {
+    int64_t stamp = t + i * 5000000ll + jitter(rng);
+    double a = i * 0.001;
+
+    auto pose = trajectory.add_poses();
+    pose->mutable_timestamp()->set_sec(static_cast<int32_t>(stamp / 1000000000));
+    pose->mutable_timestamp()->set_nsec(static_cast<int32_t>(stamp % 1000000000));
+    pose->mutable_pose()->mutable_position()->set_x(cos(a));
+    pose->mutable_pose()->mutable_position()->set_y(sin(a));
+    pose->mutable_pose()->mutable_position()->set_z(0.1 * a);
+    pose->mutable_pose()->mutable_orientation()->set_x(0);
+    pose->mutable_pose()->mutable_orientation()->set_y(0);
+    pose->mutable_pose()->mutable_orientation()->set_z(sin(a / 2));
+    pose->mutable_pose()->mutable_orientation()->set_w(cos(a / 2));
+  }
+
+  return trajectory;
+}
+
+vector<int64_t> randomStamps(const PoseTimeline& timeline, size_t n, bool sorted)
+{
+  mt19937 rng(7);
+  uniform_int_distribution<int64_t> dist(timeline.startTime(), timeline.endTime());
+
+  vector<int64_t> stamps(n);
+  for (auto& s : stamps)
+  {
+    s = dist(rng);
+  }
+
+  if (sorted)
+  {
+    sort(stamps.begin(), stamps.end());
+  }
+
+  return stamps;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  const size_t batch_size = 10000;
+
+  for (int n : { 1000, 100000, 1000000 })
+  {
+    PoseTimeline timeline = PoseTimeline::fromTrajectory(createTrajectory(n));
+    string suffix = " (" + to_string(n) + " poses)";
+
+    vector<int64_t> stamps = randomStamps(timeline, batch_size, false);
+    vector<StampedPose> poses(batch_size);
+
+    size_t k = 0;
+    bench::report("PoseTimeline single lookup" + suffix, bench::measure([&]() {
+                    StampedPose pose;
+                    timeline.lookup(stamps[k++ % batch_size], pose);
+                    bench::doNotOptimize(pose);
+                  }));
+
+    bench::report("PoseTimeline batch lookup, random" + suffix, bench::measure([&]() {
+                    timeline.lookup(stamps.data(), batch_size, poses.data());
+                    bench::doNotOptimize(poses);
+                  }, batch_size));
+
+    vector<int64_t> sorted_stamps = randomStamps(timeline, batch_size, true);
+    bench::report("PoseTimeline batch lookup, sorted" + suffix, bench::measure([&]() {
+                    timeline.lookup(sorted_stamps.data(), batch_size, poses.data());
+                    bench::doNotOptimize(poses);
+                  }, batch_size));
+  }
+
+  // bounded timeline as fed live from a stream
+
+  PoseTimeline ring(2000);
+  PoseTimeline source = PoseTimeline::fromTrajectory(createTrajectory(100000));
+  size_t i = 0;
+  bench::report("PoseTimeline ring buffer add (capacity 2000)", bench::measure([&]() {
+                  StampedPose pose = source.at(i % source.size());
+                  pose.stamp += static_cast<int64_t>(i / source.size()) * 1000000000000ll;
+                  ring.add(pose);
+                  i++;
+                }));
+
+  vector<int64_t> stamps = randomStamps(ring, batch_size, false);
+  size_t k = 0;
+  bench::report("PoseTimeline ring buffer single lookup", bench::measure([&]() {
+                  StampedPose pose;
+                  ring.lookup(stamps[k++ % batch_size], pose);
+                  bench::doNotOptimize(pose);
+                }));
+
+  return 0;
+}
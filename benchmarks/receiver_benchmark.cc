@@ -0,0 +1,363 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "benchmark.h"
+#include "synthetic_data.h"
+
+#include <rc_dynamics_api/data_receiver.h>
+#include <rc_dynamics_api/data_sender.h>
+#include <rc_dynamics_api/metrics.h>
+#include <rc_dynamics_api/net_utils.h>
+#include <rc_dynamics_api/tracing.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::DataReceiver;
+using rc::dynamics::DataSender;
+
+namespace
+{
+/// Number of datagrams that are sent before receiving them, small enough for the default socket buffer
+const size_t batch_size = 64;
+
+int64_t steadyNow()
+{
+  return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <class T>
+void benchmarkDecode(const string& name, const vector<T>& msgs)
+{
+  vector<string> data(msgs.size());
+  for (size_t i = 0; i < msgs.size(); i++)
+  {
+    msgs[i].SerializeToString(&data[i]);
+  }
+
+  T msg;
+  bench::report("ParseFromArray (" + name + ")", bench::measure(
+                                                      [&]() {
+                                                        for (auto&& d : data)
+                                                        {
+                                                          msg.ParseFromArray(d.data(), static_cast<int>(d.size()));
+                                                          bench::doNotOptimize(msg);
+                                                        }
+                                                      },
+                                                      data.size()));
+
+  // as done by DataReceiver::receive()
+  bench::report("new + ParseFromArray (" + name + ")", bench::measure(
+                                                            [&]() {
+                                                              for (auto&& d : data)
+                                                              {
+                                                                shared_ptr<T> m(new T());
+                                                                m->ParseFromArray(d.data(), static_cast<int>(d.size()));
+                                                                bench::doNotOptimize(m);
+                                                              }
+                                                            },
+                                                            data.size()));
+}
+
+/**
+ * Sends a batch of messages via loopback and receives them with the given
+ * function. Receiving itself is checked by tests/data_receiver_test.
+ */
+template <class F>
+double measureLoopback(DataSender& sender, const string& data, F receive)
+{
+  return bench::measure(
+      [&]() {
+        for (size_t i = 0; i < batch_size; i++)
+        {
+          sender.send(data.data(), data.size());
+        }
+        for (size_t i = 0; i < batch_size; i++)
+        {
+          bench::doNotOptimize(receive());
+        }
+      },
+      batch_size);
+}
+
+void benchmarkDispatch()
+{
+  unsigned int port = 0;
+  DataReceiver::Ptr receiver = DataReceiver::create("127.0.0.1", port);
+  DataSender::Ptr sender = DataSender::create("127.0.0.1", port);
+  receiver->setTimeout(1000);
+
+  string data = bench::createDynamics(0).SerializeAsString();
+  size_t size;
+
+  double raw_ns = measureLoopback(*sender, data, [&]() { return receiver->receiveRaw(size) != 0; });
+  bench::report("send + receiveRaw (Dynamics)", raw_ns);
+
+  double typed_ns = measureLoopback(*sender, data, [&]() {
+    return receiver->receive<roboception::msgs::Dynamics>() != nullptr;
+  });
+  bench::report("send + receive<Dynamics>()", typed_ns);
+
+  double dispatch_ns = measureLoopback(*sender, data, [&]() { return receiver->receive("Dynamics") != nullptr; });
+  bench::report("send + receive(\"Dynamics\")", dispatch_ns);
+
+  bench::reportValue("dispatch overhead of receive(\"Dynamics\")", dispatch_ns - typed_ns, "ns/op");
+}
+
+void benchmarkAddressResolution()
+{
+  string ip;
+  bench::report("getThisHostsIP()", bench::measure([&]() {
+                  rc::getThisHostsIP(ip, "127.0.0.1");
+                  bench::doNotOptimize(ip);
+                }));
+
+  bench::report("getThisHostsIP() with interface", bench::measure([&]() {
+                  rc::getThisHostsIP(ip, "127.0.0.1", "lo");
+                  bench::doNotOptimize(ip);
+                }));
+
+#ifndef WIN32
+  // scanning the interfaces, as done for every lookup before caching
+  bench::report("getifaddrs() + freeifaddrs()", bench::measure([&]() {
+                  struct ifaddrs* addrs = 0;
+                  getifaddrs(&addrs);
+                  bench::doNotOptimize(addrs);
+                  freeifaddrs(addrs);
+                }));
+#endif
+}
+
+void benchmarkMetrics()
+{
+  rc::dynamics::MetricsRegistry::Ptr registry = rc::dynamics::MetricsRegistry::create();
+  rc::dynamics::Counter& counter = registry->counter("benchmark_total", "Benchmark");
+  rc::dynamics::Histogram& histogram = registry->histogram(
+      "benchmark_seconds", "Benchmark", rc::dynamics::Histogram::exponentialBounds(1e-7, 2, 16));
+
+  bench::report("Counter::inc()", bench::measure([&]() { counter.inc(); }));
+
+  double value = 0;
+  bench::report("Histogram::observe()", bench::measure([&]() {
+                  histogram.observe(value);
+                  value = value < 1e-2 ? value * 1.5 + 1e-7 : 0;
+                }));
+
+  // all receiving threads of one stream share the same counter
+
+  atomic<bool> running(true);
+  vector<thread> threads;
+  for (int i = 0; i < 3; i++)
+  {
+    threads.push_back(thread([&]() {
+      while (running)
+      {
+        counter.inc();
+      }
+    }));
+  }
+
+  bench::report("Counter::inc(), 4 threads", bench::measure([&]() { counter.inc(); }));
+
+  running = false;
+  for (thread& t : threads)
+  {
+    t.join();
+  }
+
+  // exporting the metrics of the library, e.g. for a scrape by Prometheus
+
+  DataReceiver::Ptr receiver;
+  for (const char* stream : { "imu", "dynamics", "pose_rt" })
+  {
+    unsigned int port = 0;
+    receiver = DataReceiver::create("127.0.0.1", port);
+    receiver->setStreamName(stream);
+  }
+
+  rc::dynamics::MetricsRegistry::Ptr library = rc::dynamics::MetricsRegistry::getDefault();
+  bench::report("MetricsRegistry::toPrometheus()",
+                bench::measure([&]() { bench::doNotOptimize(library->toPrometheus()); }));
+  bench::report("MetricsRegistry::toJson()", bench::measure([&]() { bench::doNotOptimize(library->toJson()); }));
+}
+
+void benchmarkTracing()
+{
+  rc::dynamics::Tracer& tracer = rc::dynamics::Tracer::get();
+  tracer.clear();
+
+  bench::report("Tracer::record()", bench::measure([&]() { tracer.record("benchmark", "record", 0, 0); }));
+  bench::report("TraceScope", bench::measure([&]() { rc::dynamics::TraceScope scope("benchmark", "scope"); }));
+
+  tracer.setEnabled(false);
+  bench::report("TraceScope, disabled at runtime",
+                bench::measure([&]() { rc::dynamics::TraceScope scope("benchmark", "scope"); }));
+  tracer.setEnabled(true);
+
+  // the buffer of this thread is full now
+
+  bench::report("Tracer::toChromeTrace(), 65536 events",
+                bench::measure([&]() { bench::doNotOptimize(tracer.toChromeTrace()); }, 1, 1.0));
+  tracer.clear();
+}
+
+/**
+ * Sends Imu messages at the given rate (0 for as fast as possible) via
+ * loopback and measures throughput, loss and latency of a DataReceiver in
+ * another thread.
+ */
+void benchmarkStream(double rate, double secs)
+{
+  unsigned int port = 0;
+  DataReceiver::Ptr receiver = DataReceiver::create("127.0.0.1", port);
+  DataSender::Ptr sender = DataSender::create("127.0.0.1", port);
+  receiver->setTimeout(200);
+
+  atomic<bool> sending(true);
+  vector<double> latency_us;
+  latency_us.reserve(rate > 0 ? static_cast<size_t>(rate * secs) + 1 : 1000000);
+  uint64_t received = 0;
+
+  thread receive_thread([&]() {
+    roboception::msgs::Imu msg;
+    size_t size;
+    while (true)
+    {
+      const char* data = receiver->receiveRaw(size);
+      if (!data)
+      {
+        if (!sending)
+        {
+          break;
+        }
+        continue;
+      }
+
+      int64_t now = steadyNow();
+      msg.ParseFromArray(data, static_cast<int>(size));
+      received++;
+      if (latency_us.size() < latency_us.capacity())
+      {
+        latency_us.push_back((now - (msg.timestamp().sec() * 1000000000ll + msg.timestamp().nsec())) * 1e-3);
+      }
+    }
+  });
+
+  // the time stamp of each message is the steady clock at sending
+
+  roboception::msgs::Imu msg = bench::createImu(0);
+  string data;
+  uint64_t sent = 0;
+  int64_t start = steadyNow();
+  int64_t end = start + static_cast<int64_t>(secs * 1e9);
+  int64_t period = rate > 0 ? static_cast<int64_t>(1e9 / rate) : 0;
+  for (int64_t now = start; now < end; now = steadyNow())
+  {
+    if (period > 0)
+    {
+      int64_t t = start + static_cast<int64_t>(sent) * period;
+      if (t - now > 1000000)
+      {
+        this_thread::sleep_for(chrono::nanoseconds(t - now - 500000));
+      }
+      while ((now = steadyNow()) < t)
+      {
+        this_thread::yield();
+      }
+    }
+
+    bench::setTime(msg.mutable_timestamp(), now);
+    msg.SerializeToString(&data);
+    sender->send(data.data(), data.size());
+    sent++;
+  }
+  double elapsed = (steadyNow() - start) * 1e-9;
+
+  sending = false;
+  receive_thread.join();
+
+  string name = "loopback Imu stream, " + (rate > 0 ? to_string(static_cast<int>(rate)) + " Hz" : string("max rate"));
+  bench::reportValue(name + ", sent", sent / elapsed, "msgs/s");
+  bench::reportValue(name + ", received", received / elapsed, "msgs/s");
+  bench::reportValue(name + ", loss", 100.0 * (sent - received) / max<uint64_t>(sent, 1), "%");
+
+  if (!latency_us.empty())
+  {
+    sort(latency_us.begin(), latency_us.end());
+    bench::reportValue(name + ", latency p50", latency_us[latency_us.size() / 2], "us");
+    bench::reportValue(name + ", latency p99", latency_us[latency_us.size() * 99 / 100], "us");
+    bench::reportValue(name + ", latency max", latency_us.back(), "us");
+  }
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  vector<roboception::msgs::Frame> frames;
+  vector<roboception::msgs::Imu> imu;
+  vector<roboception::msgs::Dynamics> dynamics;
+  for (int i = 0; i < 1000; i++)
+  {
+    frames.push_back(bench::createFrame(i));
+    imu.push_back(bench::createImu(i));
+    dynamics.push_back(bench::createDynamics(i));
+  }
+
+  try
+  {
+    benchmarkDecode("Frame", frames);
+    benchmarkDecode("Imu", imu);
+    benchmarkDecode("Dynamics", dynamics);
+
+    benchmarkDispatch();
+    benchmarkAddressResolution();
+    benchmarkMetrics();
+    benchmarkTracing();
+
+    benchmarkStream(1000, 2);
+    benchmarkStream(0, 1);
+  }
+  catch (const exception& e)
+  {
+    cerr << "ERROR: " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
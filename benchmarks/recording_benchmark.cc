@@ -0,0 +1,324 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark.h"
+#include "synthetic_data.h"
+
+#include <rc_dynamics_api/async_recording_writer.h>
+#include <rc_dynamics_api/segmented_recording.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::AsyncRecordingStats;
+using rc::dynamics::AsyncRecordingWriter;
+using rc::dynamics::RecordingReader;
+using rc::dynamics::RecordingWriter;
+using rc::dynamics::RecordedMessage;
+using rc::dynamics::SegmentedRecordingReader;
+using rc::dynamics::SegmentedRecordingWriter;
+
+namespace
+{
+const char* filename = "recording_benchmark.bin";
+const int num_msgs = 200000;
+
+vector<string> serializeDynamics(int n)
+{
+  vector<string> ret(n);
+  for (int i = 0; i < n; i++)
+  {
+    bench::createDynamics(i).SerializeToString(&ret[i]);
+  }
+  return ret;
+}
+
+int64_t hostStamp(int i)
+{
+  return bench::synthetic_start + i * 5000000ll + 300000;
+}
+
+/// Checks that all messages are read back as written
+bool verify(const RecordingReader& reader, const vector<string>& data, size_t n)
+{
+  RecordingReader::Cursor cursor = reader.cursor();
+  RecordedMessage msg;
+  size_t i = 0;
+  while (cursor.next(msg))
+  {
+    if (i >= n || msg.host_stamp != hostStamp(static_cast<int>(i)) || string(msg.data, msg.size) != data[i])
+    {
+      return false;
+    }
+    i++;
+  }
+  return i == n && reader.getMessageCount() == n;
+}
+
+/// Checks that seeking finds the first message at or after the given time
+bool verifySeek(const RecordingReader& reader)
+{
+  RecordingReader::Cursor cursor = reader.cursor();
+  RecordedMessage msg;
+  for (int i : { 0, 1, 777, num_msgs / 2, num_msgs - 1 })
+  {
+    cursor.seek(hostStamp(i) - 1);
+    if (!cursor.next(msg) || msg.host_stamp != hostStamp(i))
+    {
+      return false;
+    }
+  }
+  cursor.seek(hostStamp(num_msgs));
+  return !cursor.next(msg);
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  vector<string> data = serializeDynamics(num_msgs);
+  bool ok = true;
+
+  // writing
+
+  double write_ns = bench::measure(
+      [&]() {
+        RecordingWriter::Ptr writer = RecordingWriter::create(filename, "dynamics", "Dynamics");
+        for (int i = 0; i < num_msgs; i++)
+        {
+          writer->write(0, hostStamp(i), data[i].data(), data[i].size());
+        }
+        writer->close();
+      },
+      num_msgs);
+  bench::report("RecordingWriter::write (Dynamics)", write_ns);
+
+  // writing with direct I/O and intermediate flushes, which rewrite the last partial page
+
+  {
+    RecordingWriter::Ptr writer = RecordingWriter::create(filename, { { "dynamics", "Dynamics" } }, 65536, true);
+    for (int i = 0; i < num_msgs; i++)
+    {
+      writer->write(0, hostStamp(i), data[i].data(), data[i].size());
+      if (i % 1000 == 999)
+      {
+        writer->flush();
+      }
+    }
+    writer->close();
+    ok = ok && verify(*RecordingReader::open(filename), data, num_msgs);
+  }
+
+  // asynchronous writing, with a queue that is large enough for all messages
+
+  double async_ns = bench::measure(
+      [&]() {
+        AsyncRecordingWriter::Ptr writer =
+            AsyncRecordingWriter::create(filename, { { "dynamics", "Dynamics" } }, num_msgs);
+        for (int i = 0; i < num_msgs; i++)
+        {
+          writer->write(0, hostStamp(i), data[i].data(), data[i].size());
+        }
+        writer->close();
+      },
+      num_msgs);
+  bench::report("AsyncRecordingWriter::write + close", async_ns);
+  ok = ok && verify(*RecordingReader::open(filename), data, num_msgs);
+
+  // latency of the caller with a message rate of 10 kHz
+
+  {
+    AsyncRecordingWriter::Ptr writer = AsyncRecordingWriter::create(filename, { { "dynamics", "Dynamics" } });
+    vector<double> latencies;
+    chrono::steady_clock::time_point t = chrono::steady_clock::now();
+    for (int i = 0; i < 20000; i++)
+    {
+      t += chrono::microseconds(100);
+      while (chrono::steady_clock::now() < t)
+      {
+      }
+
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      writer->write(0, hostStamp(i), data[i].data(), data[i].size());
+      latencies.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+    }
+    writer->close();
+
+    AsyncRecordingStats stats = writer->getStats();
+    sort(latencies.begin(), latencies.end());
+    cout << "AsyncRecordingWriter::write at 10 kHz: p50 " << fixed << setprecision(1)
+         << latencies[latencies.size() / 2] << " ns, p99 " << latencies[latencies.size() * 99 / 100] << " ns, max "
+         << latencies.back() << " ns, max queued " << stats.max_queued << ", dropped " << stats.dropped
+         << ", longest write " << setprecision(3) << stats.max_stall_ms << " ms" << endl;
+    ok = ok && stats.written + stats.dropped == 20000;
+  }
+
+  // reading
+
+  {
+    RecordingWriter::Ptr writer = RecordingWriter::create(filename, "dynamics", "Dynamics");
+    for (int i = 0; i < num_msgs; i++)
+    {
+      writer->write(0, hostStamp(i), data[i].data(), data[i].size());
+    }
+  }
+
+  RecordingReader::Ptr reader = RecordingReader::open(filename);
+  ok = ok && reader->isComplete() && verify(*reader, data, num_msgs) && verifySeek(*reader);
+
+  double read_ns = bench::measure(
+      [&]() {
+        RecordingReader::Cursor cursor = reader->cursor();
+        RecordedMessage msg;
+        size_t bytes = 0;
+        while (cursor.next(msg))
+        {
+          bytes += msg.size;
+        }
+        bench::doNotOptimize(bytes);
+      },
+      num_msgs);
+  bench::report("RecordingReader::Cursor::next", read_ns);
+
+  double parse_ns = bench::measure(
+      [&]() {
+        RecordingReader::Cursor cursor = reader->cursor();
+        RecordedMessage msg;
+        roboception::msgs::Dynamics dynamics;
+        while (cursor.next(msg))
+        {
+          dynamics.ParseFromArray(msg.data, static_cast<int>(msg.size));
+        }
+        bench::doNotOptimize(dynamics);
+      },
+      num_msgs);
+  bench::report("RecordingReader::Cursor::next + parse", parse_ns);
+
+  double seek_ns = bench::measure([&]() {
+    static int i = 0;
+    RecordingReader::Cursor cursor = reader->cursor();
+    cursor.seek(hostStamp((i += 7919) % num_msgs));
+    bench::doNotOptimize(cursor);
+  });
+  bench::report("RecordingReader::Cursor::seek", seek_ns);
+  reader.reset();
+
+  // recovery of a recording that has not been closed, e.g. due to a crash
+
+  {
+    ifstream in(filename, ios::binary);
+    string content((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+
+    // cut off the block index and half of the last block
+    RecordingReader::Ptr complete = RecordingReader::open(filename);
+    const rc::dynamics::RecordingBlock& last = complete->getBlocks().back();
+    size_t valid = num_msgs - last.count;
+    content.resize(static_cast<size_t>(last.offset) + 100);
+    complete.reset();
+
+    ofstream out(filename, ios::binary | ios::trunc);
+    out.write(content.data(), content.size());
+    out.close();
+
+    RecordingReader::Ptr recovered = RecordingReader::open(filename);
+    ok = ok && !recovered->isComplete() && verify(*recovered, data, valid);
+  }
+
+  remove(filename);
+
+  // segmented recording of a frequent and a rare stream, queried by time range
+
+  {
+    SegmentedRecordingWriter::Ptr writer = SegmentedRecordingWriter::create(
+        "recording_benchmark", { { "dynamics", "Dynamics" }, { "rare", "Dynamics" } }, 4 << 20, 60000);
+    for (int i = 0; i < num_msgs; i++)
+    {
+      writer->write(0, hostStamp(i), data[i].data(), data[i].size());
+      if (i % 1000 == 0)
+      {
+        writer->write(1, hostStamp(i) + 1, data[i].data(), data[i].size());
+      }
+    }
+    writer->close();
+
+    const int first = num_msgs / 2 + 123, count = 200;
+    auto query = [&](const string& stream, int64_t start, int64_t end) {
+      SegmentedRecordingReader::Ptr reader = SegmentedRecordingReader::open(writer->getManifestFilename());
+      SegmentedRecordingReader::Query q = reader->query(stream, start, end);
+      RecordedMessage msg;
+      int n = 0;
+      while (q.next(msg))
+      {
+        ok = ok && msg.host_stamp >= start && msg.host_stamp <= end && msg.stream == reader->getStreamIndex(stream);
+        n++;
+      }
+      return n;
+    };
+
+    double query_ns = bench::measure([&]() { query("dynamics", hostStamp(first), hostStamp(first + count - 1)); }, 1);
+    cout << "SegmentedRecordingReader::query of 1 s out of " << writer->getSegments().size() << " segments: "
+         << fixed << setprecision(1) << query_ns / 1000 << " us" << endl;
+
+    double rare_ns = bench::measure([&]() { query("rare", hostStamp(0), hostStamp(num_msgs)); }, 1);
+    cout << "SegmentedRecordingReader::query of a rare stream in all segments: " << fixed << setprecision(1)
+         << rare_ns / 1000 << " us" << endl;
+
+    SegmentedRecordingReader::Ptr reader = SegmentedRecordingReader::open(writer->getManifestFilename());
+    ok = ok && writer->getSegments().size() > 1 && reader->isComplete() &&
+         reader->getMessageCount() == num_msgs + num_msgs / 1000 &&
+         query("dynamics", hostStamp(first), hostStamp(first + count - 1)) == count &&
+         query("rare", hostStamp(0), hostStamp(num_msgs)) == num_msgs / 1000 &&
+         query("dynamics", hostStamp(num_msgs), hostStamp(num_msgs + 1)) == 0;
+
+    for (auto&& segment : writer->getSegments())
+    {
+      remove(segment.filename.c_str());
+    }
+    remove(writer->getManifestFilename().c_str());
+  }
+
+  if (!ok)
+  {
+    cerr << "ERROR: recording is not read back as written" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,448 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "benchmark.h"
+#include "../tools/visard_simulator.h"
+
+#include <rc_dynamics_api/remote_interface.h>
+#include <rc_dynamics_api/supervised_receiver.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::RemoteInterface;
+using rc::dynamics::RequestScheduler;
+using rc::dynamics::VisardSimulator;
+
+namespace
+{
+void reportLatency(const string& name, vector<double>& us)
+{
+  sort(us.begin(), us.end());
+  bench::reportValue(name + ", p50", us[us.size() / 2], "us");
+  bench::reportValue(name + ", p99", us[us.size() * 99 / 100], "us");
+}
+
+/**
+ * Measures the time from requesting a stream until the first message has
+ * been received.
+ */
+void benchmarkTimeToFirstMessage(RemoteInterface& rc, const string& stream, int n)
+{
+  // requests are started at random times relative to the messages of the
+  // stream, as in reality
+
+  mt19937 rng(42);
+  uniform_int_distribution<int> delay(0, 50);
+
+  vector<double> us;
+  for (int i = 0; i < n; i++)
+  {
+    this_thread::sleep_for(chrono::milliseconds(delay(rng)));
+
+    // createReceiverForStream() returns after receiving the first message
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    rc::dynamics::DataReceiver::Ptr receiver = rc.createReceiverForStream(stream, "lo");
+    us.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+  }
+
+  reportLatency("time to first message (" + stream + ")", us);
+}
+
+/**
+ * Measures reconnecting a receiver after the rc_visard has lost all
+ * destinations, e.g. because of a reboot.
+ */
+void benchmarkReconnect(VisardSimulator& sim, RemoteInterface& rc, const string& stream, int n)
+{
+  rc::dynamics::DataReceiver::Ptr receiver = rc.createReceiverForStream(stream, "lo");
+
+  mt19937 rng(42);
+  uniform_int_distribution<int> delay(0, 50);
+
+  vector<double> us;
+  for (int i = 0; i < n; i++)
+  {
+    this_thread::sleep_for(chrono::milliseconds(delay(rng)));
+    sim.clearDestinations();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    rc.reconnectReceiver(receiver);
+    us.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+  }
+
+  reportLatency("reconnectReceiver() (" + stream + ")", us);
+}
+
+/**
+ * Measures the interruption of a supervised stream while a consumer keeps
+ * receiving, after the rc_visard has lost all destinations (imu) or
+ * rc_dynamics has been stopped for a while (dynamics, since imu is sent
+ * regardless of rc_dynamics).
+ */
+void benchmarkOutage(VisardSimulator& sim, const RemoteInterface::Ptr& rc, bool restart_dynamics)
+{
+  string stream = restart_dynamics ? "dynamics" : "imu";
+  string pb_msg_type = rc->getPbMsgTypeOfStream(stream);
+  rc::dynamics::SupervisedReceiver::Ptr supervised =
+      rc::dynamics::SupervisedReceiver::create(rc, stream, "lo", 0, 100);
+
+  atomic<bool> running(true);
+  thread consumer([&]() {
+    rc::dynamics::DataReceiver::Ptr receiver = supervised->getReceiver();
+    while (running)
+    {
+      receiver->receive(pb_msg_type);
+    }
+  });
+
+  this_thread::sleep_for(chrono::milliseconds(200));
+  if (restart_dynamics)
+  {
+    sim.setDynamicsState("IDLE");
+    this_thread::sleep_for(chrono::milliseconds(300));
+    sim.setDynamicsState("RUNNING");
+  }
+  else
+  {
+    sim.clearDestinations();
+  }
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  rc::dynamics::StreamOutageStats stats = supervised->getStats();
+  while ((stats.outages == 0 || stats.in_outage) && chrono::steady_clock::now() - start < chrono::seconds(10))
+  {
+    this_thread::sleep_for(chrono::milliseconds(10));
+    stats = supervised->getStats();
+  }
+
+  running = false;
+  consumer.join();
+
+  string name = restart_dynamics ? "stream outage, 300 ms rc_dynamics stop" : "stream outage, lost destination";
+  bench::reportValue(name + ", silence 100 ms", stats.last_outage_ms, "ms");
+  bench::reportValue(name + ", restored", static_cast<double>(stats.restored), "");
+}
+
+/**
+ * Measures the datagrams sent by the rc_visard and received by n consumers
+ * of the imu stream, with one unicast destination per consumer or one
+ * shared multicast group.
+ */
+void benchmarkConsumers(VisardSimulator& sim, RemoteInterface& rc, bool multicast, int n)
+{
+  vector<rc::dynamics::DataReceiver::Ptr> receivers;
+  for (int i = 0; i < n; i++)
+  {
+    if (multicast)
+    {
+      receivers.push_back(rc.createMulticastReceiverForStream("imu", "239.255.0.1", 30201, "lo"));
+    }
+    else
+    {
+      receivers.push_back(rc.createReceiverForStream("imu", "lo"));
+    }
+  }
+
+  size_t destinations = sim.getDestinations("imu").size();
+
+  atomic<bool> running(true);
+  vector<uint64_t> received(n, 0);
+  vector<thread> consumers;
+  uint64_t sent = sim.getStatistics().messages;
+  for (int i = 0; i < n; i++)
+  {
+    consumers.push_back(thread([&, i]() {
+      receivers[i]->setTimeout(100);
+      while (running)
+      {
+        if (receivers[i]->receive<roboception::msgs::Imu>())
+        {
+          received[i]++;
+        }
+      }
+    }));
+  }
+
+  this_thread::sleep_for(chrono::seconds(1));
+  running = false;
+  for (thread& t : consumers)
+  {
+    t.join();
+  }
+  sent = sim.getStatistics().messages - sent;
+
+  receivers.clear();
+  if (multicast)
+  {
+    rc.deleteDestinationsFromStream("imu", { "239.255.0.1:30201" });
+  }
+
+  string name = string(multicast ? "multicast" : "unicast") + ", " + to_string(n) + " imu consumers";
+  bench::reportValue(name + ", destinations", static_cast<double>(destinations), "");
+  bench::reportValue(name + ", datagrams sent", static_cast<double>(sent), "1/s");
+  bench::reportValue(name + ", min. received", static_cast<double>(*min_element(received.begin(), received.end())),
+                     "1/s");
+}
+
+/**
+ * Measures how long it takes to find out that a stream cannot be
+ * established because rc_dynamics is not running.
+ */
+void benchmarkNotRunning(VisardSimulator& sim, RemoteInterface& rc)
+{
+  sim.setDynamicsState("IDLE");
+
+  vector<double> us;
+  for (int i = 0; i < 10; i++)
+  {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    try
+    {
+      rc.createReceiverForStream("dynamics", "lo");
+      throw runtime_error("Stream has been established although rc_dynamics is not running");
+    }
+    catch (const RemoteInterface::DynamicsNotRunning&)
+    {
+    }
+    us.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+  }
+
+  reportLatency("createReceiverForStream() if not running", us);
+
+  sim.setDynamicsState("RUNNING");
+}
+
+/**
+ * Measures subscribing one host with several destinations to all streams
+ * with single requests and with applyStreamDestinations().
+ */
+void benchmarkDestinations(const string& firmware_version)
+{
+  // the firmware version is only read once by a RemoteInterface
+
+  VisardSimulator::Config config;
+  config.latency_ms = 5;
+  config.firmware_version = firmware_version;
+  VisardSimulator::Ptr sim = VisardSimulator::create("127.0.0.1", 0, config);
+  RemoteInterface::Ptr rc = RemoteInterface::create(sim->getAddress());
+  rc->checkSystemReady();
+
+  RequestScheduler::Config unlimited;
+  unlimited.rate = 0;
+  rc->getRequestScheduler()->setConfig(unlimited);
+
+  map<string, RemoteInterface::DestinationChanges> subscribe, unsubscribe;
+  for (auto&& stream : VisardSimulator::getDefaultStreams())
+  {
+    for (int i = 0; i < 4; i++)
+    {
+      subscribe[stream.name].add.push_back("127.0.0.1:" + to_string(40000 + i));
+    }
+    unsubscribe[stream.name].remove = subscribe[stream.name].add;
+  }
+
+  string name = to_string(subscribe.size() * 4) + " destinations";
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (auto&& change : subscribe)
+  {
+    for (auto&& dest : change.second.add)
+    {
+      rc->addDestinationToStream(change.first, dest);
+    }
+  }
+  bench::reportValue("add " + name + " one by one, " + firmware_version,
+                     chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), "ms");
+  rc->applyStreamDestinations(unsubscribe);
+
+  uint64_t requests = sim->getStatistics().requests;
+  start = chrono::steady_clock::now();
+  rc->applyStreamDestinations(subscribe);
+  bench::reportValue("applyStreamDestinations() " + name + ", " + firmware_version,
+                     chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), "ms");
+  bench::reportValue("applyStreamDestinations() requests, " + firmware_version,
+                     static_cast<double>(sim->getStatistics().requests - requests), "");
+
+  rc->applyStreamDestinations(unsubscribe);
+}
+
+/**
+ * Sends requests from several threads to a simulator that rejects requests
+ * beyond a rate limit and reports the throughput and the number of
+ * rejections, with the given rate limit of the client.
+ */
+void benchmarkRateLimit(VisardSimulator& sim, RemoteInterface& rc, double client_rate)
+{
+  const int threads = 8;
+  const int requests = 25;
+
+  VisardSimulator::Config sim_config;
+  sim_config.max_requests_per_sec = 100;
+  sim.setConfig(sim_config);
+
+  RequestScheduler::Ptr scheduler = rc.getRequestScheduler();
+  RequestScheduler::Config config;
+  config.rate = client_rate;
+  config.burst = 10;
+  scheduler->setConfig(config);
+
+  // wait until the rate window of the simulator is empty
+
+  this_thread::sleep_for(chrono::milliseconds(1100));
+
+  RequestScheduler::Statistics before = scheduler->getStatistics();
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  vector<thread> clients;
+  int failed = 0;
+  mutex mtx;
+  for (int i = 0; i < threads; i++)
+  {
+    clients.push_back(thread([&]() {
+      for (int k = 0; k < requests; k++)
+      {
+        try
+        {
+          rc.getDynamicsState();
+        }
+        catch (const RemoteInterface::TooManyRequests&)
+        {
+          lock_guard<mutex> lock(mtx);
+          failed++;
+        }
+      }
+    }));
+  }
+
+  for (auto&& client : clients)
+  {
+    client.join();
+  }
+
+  double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  RequestScheduler::Statistics stats = scheduler->getStatistics();
+
+  string name = "8 threads, limit 100/s, client " +
+                (client_rate > 0 ? to_string(static_cast<int>(client_rate)) + "/s" : string("unlimited"));
+  bench::reportValue(name + ", throughput", threads * requests / secs, "req/s");
+  bench::reportValue(name + ", rejected", static_cast<double>(stats.rejected - before.rejected), "");
+  bench::reportValue(name + ", throttled", static_cast<double>(stats.throttled - before.throttled), "");
+  bench::reportValue(name + ", failed", failed, "");
+
+  sim.setConfig(VisardSimulator::Config());
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  try
+  {
+    VisardSimulator::Ptr sim = VisardSimulator::create();
+    RemoteInterface::Ptr rc = RemoteInterface::create(sim->getAddress());
+
+    // measure the requests themselves, without rate limit
+
+    RequestScheduler::Config unlimited;
+    unlimited.rate = 0;
+    rc->getRequestScheduler()->setConfig(unlimited);
+
+    if (!rc->checkSystemReady())
+    {
+      throw runtime_error("Simulator is not ready");
+    }
+
+    bench::report("checkSystemReady()", bench::measure([&]() { bench::doNotOptimize(rc->checkSystemReady()); }));
+    bench::report("getDynamicsState()", bench::measure([&]() { bench::doNotOptimize(rc->getDynamicsState()); }));
+    bench::report("getDestinationsOfStream()",
+                  bench::measure([&]() { bench::doNotOptimize(rc->getDestinationsOfStream("imu")); }));
+    bench::report("add + deleteDestinationFromStream()", bench::measure([&]() {
+                    rc->addDestinationToStream("imu", "127.0.0.1:9");
+                    rc->deleteDestinationFromStream("imu", "127.0.0.1:9");
+                  }));
+
+    benchmarkTimeToFirstMessage(*rc, "imu", 20);
+    benchmarkTimeToFirstMessage(*rc, "pose", 20);
+    benchmarkReconnect(*sim, *rc, "imu", 20);
+    benchmarkNotRunning(*sim, *rc);
+    benchmarkOutage(*sim, rc, false);
+    benchmarkOutage(*sim, rc, true);
+    benchmarkConsumers(*sim, *rc, false, 4);
+    benchmarkConsumers(*sim, *rc, true, 4);
+
+    // like an rc_visard that is busy with other requests
+
+    VisardSimulator::Config config;
+    config.latency_ms = 5;
+    config.latency_jitter_ms = 5;
+    sim->setConfig(config);
+
+    vector<double> us;
+    for (int i = 0; i < 100; i++)
+    {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      rc->getDynamicsState();
+      us.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+    }
+    reportLatency("getDynamicsState() with 5-10 ms latency", us);
+    sim->setConfig(VisardSimulator::Config());
+
+    // many clients against a rate limited rc_visard, with and without
+    // keeping the rate limit ahead of time
+
+    // subscribing to many streams with 5 ms latency per request
+
+    benchmarkDestinations("v1.5.0");
+    benchmarkDestinations("v1.7.0");
+
+    benchmarkRateLimit(*sim, *rc, 0);
+    benchmarkRateLimit(*sim, *rc, 90);
+
+    VisardSimulator::Statistics stats = sim->getStatistics();
+    bench::reportValue("REST-API requests", static_cast<double>(stats.requests), "");
+  }
+  catch (const exception& e)
+  {
+    cerr << "ERROR: " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,227 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark.h"
+
+#include <rc_dynamics_api/shm_ring.h>
+
+#include "roboception/msgs/dynamics.pb.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace rc::dynamics;
+
+namespace
+{
+const char* shm_name = "/rcdynamics_shm_ring_benchmark";
+
+int64_t steadyNow()
+{
+  return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Latency statistics of one reader process, sent to the parent via pipe
+struct ReaderResult
+{
+  uint64_t received;
+  uint64_t overruns;
+  double p50_us, p99_us, max_us;
+};
+
+/**
+ * Reader process: receives and parses num_msgs messages (or until timeout)
+ * and measures the latency between publishing and parsing.
+ */
+void runReader(int ready_fd, int result_fd, uint64_t num_msgs)
+{
+  auto reader = ShmRingReader::open(shm_name);
+  reader->setTimeout(1000);
+
+  char c = 1;
+  if (write(ready_fd, &c, 1) != 1)
+  {
+    _exit(EXIT_FAILURE);
+  }
+
+  vector<double> latencies;
+  latencies.reserve(num_msgs);
+
+  roboception::msgs::Dynamics msg;
+  while (reader->getReceived() + reader->getOverruns() < num_msgs)
+  {
+    size_t size;
+    int64_t host_stamp;
+    const char* data = reader->receiveRaw(size, host_stamp);
+    if (!data)
+    {
+      break;
+    }
+
+    bool parsed = msg.ParseFromArray(data, static_cast<int>(size));
+    if (reader->validate() && parsed)
+    {
+      latencies.push_back((steadyNow() - host_stamp) * 1e-3);
+    }
+  }
+
+  ReaderResult result = { reader->getReceived(), reader->getOverruns(), 0, 0, 0 };
+  if (!latencies.empty())
+  {
+    sort(latencies.begin(), latencies.end());
+    result.p50_us = latencies[latencies.size() / 2];
+    result.p99_us = latencies[latencies.size() * 99 / 100];
+    result.max_us = latencies.back();
+  }
+
+  if (write(result_fd, &result, sizeof(result)) != sizeof(result))
+  {
+    _exit(EXIT_FAILURE);
+  }
+  _exit(EXIT_SUCCESS);
+}
+
+/**
+ * Publishes num_msgs serialized Dynamics messages with the given rate (0 for
+ * as fast as possible) to num_readers reader processes.
+ */
+void runBenchmark(int num_readers, uint64_t num_msgs, double rate)
+{
+  auto writer = ShmRingWriter::create(shm_name, "Dynamics", 1024);
+
+  int ready_pipe[2], result_pipe[2];
+  if (pipe(ready_pipe) < 0 || pipe(result_pipe) < 0)
+  {
+    throw runtime_error("Cannot create pipes");
+  }
+
+  vector<pid_t> pids;
+  for (int i = 0; i < num_readers; i++)
+  {
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+      runReader(ready_pipe[1], result_pipe[1], num_msgs);
+    }
+    pids.push_back(pid);
+  }
+
+  for (int i = 0; i < num_readers; i++)
+  {
+    char c;
+    if (read(ready_pipe[0], &c, 1) != 1)
+    {
+      throw runtime_error("Reader process failed");
+    }
+  }
+
+  roboception::msgs::Dynamics msg;
+  msg.mutable_timestamp()->set_sec(1500000000);
+  msg.mutable_timestamp()->set_nsec(0);
+  msg.set_pose_frame("world");
+  msg.mutable_pose()->mutable_orientation()->set_w(1);
+  for (int k = 0; k < 36; k++)
+  {
+    msg.add_covariance(0.001 * k);
+  }
+
+  string data;
+  int64_t period = rate > 0 ? static_cast<int64_t>(1e9 / rate) : 0;
+  int64_t start = steadyNow();
+  for (uint64_t n = 0; n < num_msgs; n++)
+  {
+    if (period > 0)
+    {
+      while (steadyNow() < start + static_cast<int64_t>(n) * period)
+      {
+        this_thread::yield();
+      }
+    }
+
+    msg.mutable_pose()->mutable_position()->set_x(static_cast<double>(n));
+    msg.SerializeToString(&data);
+    writer->publish(data.data(), data.size(), steadyNow());
+  }
+  double secs = (steadyNow() - start) * 1e-9;
+
+  string rate_name = rate > 0 ? to_string(static_cast<int>(rate)) + " Hz" : "max rate";
+  string prefix = "ShmRing " + to_string(num_readers) + " readers, " + rate_name;
+  cout << "readers: " << num_readers << ", " << rate_name << ", published " << fixed << setprecision(0)
+       << num_msgs / secs << " msgs/s" << endl;
+  bench::record(prefix + ", published", num_msgs / secs, "msgs/s");
+
+  for (int i = 0; i < num_readers; i++)
+  {
+    ReaderResult r;
+    if (read(result_pipe[0], &r, sizeof(r)) != sizeof(r))
+    {
+      throw runtime_error("Reader process failed");
+    }
+    cout << "  reader " << i << ": received " << r.received << ", overruns " << r.overruns << ", latency p50 "
+         << setprecision(2) << r.p50_us << " us, p99 " << r.p99_us << " us, max " << r.max_us << " us" << endl;
+
+    string reader = prefix + ", reader " + to_string(i);
+    bench::record(reader + ", overruns", static_cast<double>(r.overruns), "msgs");
+    bench::record(reader + ", latency p50", r.p50_us, "us");
+    bench::record(reader + ", latency p99", r.p99_us, "us");
+  }
+
+  for (pid_t pid : pids)
+  {
+    waitpid(pid, NULL, 0);
+  }
+
+  close(ready_pipe[0]);
+  close(ready_pipe[1]);
+  close(result_pipe[0]);
+  close(result_pipe[1]);
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  for (int num_readers : { 1, 4, 8 })
+  {
+    runBenchmark(num_readers, 5000, 1000);
+    runBenchmark(num_readers, 200000, 0);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,288 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "benchmark.h"
+#include "synthetic_data.h"
+
+#include <rc_dynamics_api/stream_joiner.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::StreamJoiner;
+
+namespace
+{
+struct Arrival
+{
+  size_t stream;
+  int64_t arrival;
+  int64_t stamp;
+  StreamJoiner::MessagePtr msg;
+};
+
+/**
+ * Creates a 1000 Hz imu stream (stream 0) and a 200 Hz dynamics stream
+ * (stream 1) of the given duration, ordered by time of arrival. Dynamics
+ * messages arrive with a constant delay of 2 ms plus a random jitter, which
+ * may reorder them.
+ */
+vector<Arrival> createArrivals(double secs, int64_t max_jitter_ns)
+{
+  mt19937 rng(42);
+  uniform_int_distribution<int64_t> jitter(0, max_jitter_ns);
+
+  vector<Arrival> arrivals;
+  int n = static_cast<int>(secs * 1000);
+  for (int i = 0; i < n; i++)
+  {
+    Arrival a;
+    a.stream = 0;
+    a.msg = make_shared<roboception::msgs::Imu>(bench::createImu(i));
+    a.stamp = StreamJoiner::getStamp(*a.msg);
+    a.arrival = a.stamp;
+    arrivals.push_back(a);
+
+    if (i % 5 == 0)
+    {
+      a.stream = 1;
+      a.msg = make_shared<roboception::msgs::Dynamics>(bench::createDynamics(i / 5));
+      a.stamp = StreamJoiner::getStamp(*a.msg);
+      a.arrival = a.stamp + 2000000 + jitter(rng);
+      arrivals.push_back(a);
+    }
+  }
+
+  stable_sort(arrivals.begin(), arrivals.end(),
+              [](const Arrival& a, const Arrival& b) { return a.arrival < b.arrival; });
+
+  return arrivals;
+}
+
+/// Pushes all arrivals, pops all tuples that are ready after every push, and flushes at the end
+size_t join(StreamJoiner& joiner, const vector<Arrival>& arrivals, vector<StreamJoiner::Tuple>* tuples = 0)
+{
+  size_t n = 0;
+  StreamJoiner::Tuple tuple;
+  for (const Arrival& a : arrivals)
+  {
+    joiner.push(a.stream, a.stamp, a.msg);
+    while (joiner.pop(tuple))
+    {
+      n++;
+      if (tuples)
+      {
+        tuples->push_back(tuple);
+      }
+    }
+  }
+
+  joiner.flush();
+  while (joiner.pop(tuple))
+  {
+    n++;
+    if (tuples)
+    {
+      tuples->push_back(tuple);
+    }
+  }
+
+  return n;
+}
+
+const char* getName(StreamJoiner::Matching matching)
+{
+  switch (matching)
+  {
+    case StreamJoiner::Matching::EXACT:
+      return "exact";
+    case StreamJoiner::Matching::NEAREST:
+      return "nearest";
+    default:
+      return "interpolate";
+  }
+}
+
+/**
+ * Measures the time for pushing a message and popping the ready tuples, for
+ * joining imu with dynamics arriving in order and with up to 10 ms jitter.
+ */
+void benchmarkThroughput()
+{
+  vector<StreamJoiner::Matching> matchings = { StreamJoiner::Matching::EXACT, StreamJoiner::Matching::NEAREST,
+                                               StreamJoiner::Matching::INTERPOLATE };
+  vector<int64_t> jitters = { 0, 10000000 };
+
+  for (int64_t jitter : jitters)
+  {
+    vector<Arrival> arrivals = createArrivals(10, jitter);
+
+    for (StreamJoiner::Matching matching : matchings)
+    {
+      StreamJoiner::Config config;
+      config.matching = matching;
+      config.max_delay_ns = jitter;
+
+      double ns = bench::measure(
+          [&]() {
+            StreamJoiner::Ptr joiner = StreamJoiner::create(2, config);
+            bench::doNotOptimize(join(*joiner, arrivals));
+          },
+          arrivals.size());
+
+      bench::report(string("push+pop ") + getName(matching) + " jitter " + to_string(jitter / 1000000) + " ms", ns);
+    }
+  }
+}
+
+/**
+ * Reports the ratio of matched imu messages and the error of interpolated
+ * dynamics positions against the true trajectory.
+ */
+void benchmarkMatching()
+{
+  vector<Arrival> arrivals = createArrivals(10, 10000000);
+  size_t imu = 0;
+  for (const Arrival& a : arrivals)
+  {
+    imu += a.stream == 0;
+  }
+
+  vector<StreamJoiner::Matching> matchings = { StreamJoiner::Matching::EXACT, StreamJoiner::Matching::NEAREST,
+                                               StreamJoiner::Matching::INTERPOLATE };
+
+  for (StreamJoiner::Matching matching : matchings)
+  {
+    StreamJoiner::Config config;
+    config.matching = matching;
+    config.max_delay_ns = 10000000;
+
+    StreamJoiner::Ptr joiner = StreamJoiner::create(2, config);
+    vector<StreamJoiner::Tuple> tuples;
+    join(*joiner, arrivals, &tuples);
+
+    double max_error = 0;
+    for (const StreamJoiner::Tuple& tuple : tuples)
+    {
+      // position on the circle of the synthetic dynamics at the imu time stamp
+      double a = static_cast<double>(tuple.stamp - bench::synthetic_start) / 5000000 * 0.001;
+      const roboception::msgs::Vector3d& p = tuple.get<roboception::msgs::Dynamics>(1)->pose().position();
+      max_error = max(max_error, hypot(p.x() - cos(a), p.y() - sin(a)));
+    }
+
+    string name = getName(matching);
+    bench::reportValue("matched imu " + name, 100.0 * tuples.size() / imu, "%");
+    bench::reportValue("max position error " + name, 1e6 * max_error, "um");
+  }
+}
+
+/**
+ * Reports the messages that are dropped as late if the maximum delay is
+ * smaller than the jitter, and the buffered messages if the dynamics stream
+ * stops, which must not exceed the time of max_lag_ns.
+ */
+void benchmarkLateAndStalled()
+{
+  vector<Arrival> arrivals = createArrivals(10, 20000000);
+
+  vector<int64_t> delays = { 0, 10000000, 20000000 };
+  for (int64_t delay : delays)
+  {
+    StreamJoiner::Config config;
+    config.max_delay_ns = delay;
+
+    StreamJoiner::Ptr joiner = StreamJoiner::create(2, config);
+    join(*joiner, arrivals);
+
+    StreamJoiner::Statistics stats = joiner->getStatistics();
+    bench::reportValue("late with max delay " + to_string(delay / 1000000) + " ms", 100.0 * stats.late / stats.pushed,
+                       "%");
+  }
+
+  // dynamics stops after 1 s of 10 s
+
+  vector<Arrival> stalled;
+  for (const Arrival& a : arrivals)
+  {
+    if (a.stream == 0 || a.stamp < bench::synthetic_start + 1000000000ll)
+    {
+      stalled.push_back(a);
+    }
+  }
+
+  StreamJoiner::Config config;
+  config.max_delay_ns = 20000000;
+  config.partial = true;
+
+  StreamJoiner::Ptr joiner = StreamJoiner::create(2, config);
+  StreamJoiner::Tuple tuple;
+  size_t max_buffered = 0, emitted = 0;
+  for (const Arrival& a : stalled)
+  {
+    joiner->push(a.stream, a.stamp, a.msg);
+    while (joiner->pop(tuple))
+    {
+      emitted++;
+    }
+    max_buffered = max(max_buffered, joiner->getBufferSize(0));
+  }
+
+  bench::reportValue("stalled stream: max buffered imu", static_cast<double>(max_buffered), "msgs");
+  bench::reportValue("stalled stream: emitted before flush", 100.0 * emitted / (stalled.size() - 200), "%");
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bench::init(argc, argv);
+
+  try
+  {
+    benchmarkThroughput();
+    benchmarkMatching();
+    benchmarkLateAndStalled();
+  }
+  catch (const exception& e)
+  {
+    cerr << "ERROR: " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
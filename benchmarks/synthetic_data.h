@@ -0,0 +1,138 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_SYNTHETIC_DATA_H
+#define RC_DYNAMICS_API_SYNTHETIC_DATA_H
+
+#include "roboception/msgs/frame.pb.h"
+#include "roboception/msgs/dynamics.pb.h"
+#include "roboception/msgs/imu.pb.h"
+
+#include <cmath>
+#include <stdint.h>
+
+namespace bench
+{
+/// Time stamp of the first synthetic message in nanoseconds since epoch
+const int64_t synthetic_start = 1500000000ll * 1000000000ll;
+
+inline void setTime(roboception::msgs::Time* time, int64_t stamp)
+{
+  time->set_sec(static_cast<int32_t>(stamp / 1000000000));
+  time->set_nsec(static_cast<int32_t>(stamp % 1000000000));
+}
+
+/**
+ * Creates the i-th message of a synthetic 200 Hz dynamics stream, moving on
+ * a circle while rotating about z, with all fields set that the rc_visard
+ * sends. The covariance is given as upper triangle of a 6x6 matrix, so that
+ * the serialized message stays below the 512 bytes a DataReceiver can
+ * receive.
+ */
+inline roboception::msgs::Dynamics createDynamics(int i)
+{
+  roboception::msgs::Dynamics msg;
+  double a = i * 0.001;
+
+  setTime(msg.mutable_timestamp(), synthetic_start + i * 5000000ll);
+  msg.mutable_pose()->mutable_position()->set_x(std::cos(a));
+  msg.mutable_pose()->mutable_position()->set_y(std::sin(a));
+  msg.mutable_pose()->mutable_position()->set_z(0.1 * a);
+  msg.mutable_pose()->mutable_orientation()->set_x(0);
+  msg.mutable_pose()->mutable_orientation()->set_y(0);
+  msg.mutable_pose()->mutable_orientation()->set_z(std::sin(a / 2));
+  msg.mutable_pose()->mutable_orientation()->set_w(std::cos(a / 2));
+  msg.set_pose_frame("world");
+  msg.mutable_linear_velocity()->set_x(-std::sin(a));
+  msg.mutable_linear_velocity()->set_y(std::cos(a));
+  msg.mutable_linear_velocity()->set_z(0.1);
+  msg.set_linear_velocity_frame("world");
+  msg.mutable_angular_velocity()->set_x(0.001 * std::sin(7 * a));
+  msg.mutable_angular_velocity()->set_y(0.001 * std::cos(5 * a));
+  msg.mutable_angular_velocity()->set_z(0.2);
+  msg.set_angular_velocity_frame("imu");
+  msg.mutable_linear_acceleration()->set_x(0.01 * std::cos(3 * a));
+  msg.mutable_linear_acceleration()->set_y(0.01 * std::sin(3 * a));
+  msg.mutable_linear_acceleration()->set_z(9.81);
+  msg.set_linear_acceleration_frame("imu");
+  for (int r = 0; r < 6; r++)
+  {
+    for (int c = r; c < 6; c++)
+    {
+      msg.add_covariance(r == c ? 1e-4 * (1 + 0.01 * std::sin(a + r)) : 0);
+    }
+  }
+  msg.set_possible_slam_failure(false);
+
+  return msg;
+}
+
+/**
+ * Creates the i-th message of a synthetic 200 Hz pose stream, on the same
+ * trajectory as createDynamics().
+ */
+inline roboception::msgs::Frame createFrame(int i)
+{
+  roboception::msgs::Frame msg;
+  roboception::msgs::Dynamics dynamics = createDynamics(i);
+
+  *msg.mutable_pose()->mutable_timestamp() = dynamics.timestamp();
+  *msg.mutable_pose()->mutable_pose() = dynamics.pose();
+  msg.set_parent("world");
+  msg.set_name("rcvisard");
+  msg.set_producer("ins");
+
+  return msg;
+}
+
+/**
+ * Creates the i-th message of a synthetic 1000 Hz imu stream.
+ */
+inline roboception::msgs::Imu createImu(int i)
+{
+  roboception::msgs::Imu msg;
+  double a = i * 0.0002;
+
+  setTime(msg.mutable_timestamp(), synthetic_start + i * 1000000ll);
+  msg.mutable_linear_acceleration()->set_x(0.01 * std::cos(3 * a));
+  msg.mutable_linear_acceleration()->set_y(0.01 * std::sin(3 * a));
+  msg.mutable_linear_acceleration()->set_z(9.81);
+  msg.mutable_angular_velocity()->set_x(0.001 * std::sin(7 * a));
+  msg.mutable_angular_velocity()->set_y(0.001 * std::cos(5 * a));
+  msg.mutable_angular_velocity()->set_z(0.2);
+
+  return msg;
+}
+}
+
+#endif  // RC_DYNAMICS_API_SYNTHETIC_DATA_H
@@ -0,0 +1,237 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "async_recording_writer.h"
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+int64_t steadyNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void updateMax(std::atomic<int64_t>& value, int64_t v)
+{
+  int64_t current = value.load(std::memory_order_relaxed);
+  while (v > current && !value.compare_exchange_weak(current, v, std::memory_order_relaxed))
+  {
+  }
+}
+}
+
+AsyncRecordingWriter::Ptr AsyncRecordingWriter::create(const std::string& filename,
+                                                       const std::vector<RecordingStream>& streams,
+                                                       std::size_t queue_size, bool direct_io,
+                                                       unsigned int flush_interval_ms)
+{
+  return create(RecordingWriter::create(filename, streams, 65536, direct_io), queue_size, flush_interval_ms);
+}
+
+AsyncRecordingWriter::Ptr AsyncRecordingWriter::create(const RecordingWriter::Ptr& writer, std::size_t queue_size,
+                                                       unsigned int flush_interval_ms)
+{
+  return Ptr(new AsyncRecordingWriter(writer, queue_size, flush_interval_ms));
+}
+
+AsyncRecordingWriter::AsyncRecordingWriter(const RecordingWriter::Ptr& writer, std::size_t queue_size,
+                                           unsigned int flush_interval_ms)
+  : writer_(writer)
+  , filename_(writer->getFilename())
+  , num_streams_(writer->getStreams().size())
+  , flush_interval_ms_(flush_interval_ms)
+  , slots_(std::max<std::size_t>(queue_size, 1))
+  , head_(0)
+  , max_queued_(0)
+  , dropped_(0)
+  , tail_(0)
+  , max_stall_ns_(0)
+  , stop_(false)
+  , failed_(false)
+{
+  thread_ = std::thread(&AsyncRecordingWriter::run, this);
+}
+
+AsyncRecordingWriter::~AsyncRecordingWriter()
+{
+  try
+  {
+    close();
+  }
+  catch (const std::exception&)
+  {
+    // destructor must not throw
+  }
+}
+
+bool AsyncRecordingWriter::write(uint16_t stream, int64_t host_stamp, const char* data, std::size_t size)
+{
+  if (stream >= num_streams_)
+  {
+    throw std::invalid_argument("Invalid stream index for recording: " + std::to_string(stream));
+  }
+
+  if (size > MAX_MESSAGE_SIZE)
+  {
+    throw std::invalid_argument("Message of " + std::to_string(size) + " bytes exceeds maximum size for recording");
+  }
+
+  uint64_t head = head_.load(std::memory_order_relaxed);
+  uint64_t queued = head - tail_.load(std::memory_order_acquire);
+  if (queued >= slots_.size() || failed_.load(std::memory_order_relaxed) || !thread_.joinable())
+  {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  Slot& slot = slots_[head % slots_.size()];
+  slot.host_stamp = host_stamp;
+  slot.size = static_cast<uint32_t>(size);
+  slot.stream = stream;
+  std::memcpy(slot.data, data, size);
+
+  head_.store(head + 1, std::memory_order_release);
+
+  if (queued + 1 > max_queued_.load(std::memory_order_relaxed))
+  {
+    max_queued_.store(queued + 1, std::memory_order_relaxed);
+  }
+
+  return true;
+}
+
+void AsyncRecordingWriter::close()
+{
+  if (thread_.joinable())
+  {
+    stop_.store(true);
+    thread_.join();
+
+    // the writer thread has drained the queue, unless it failed
+    if (failed_.load())
+    {
+      try
+      {
+        writer_->close();
+      }
+      catch (const std::exception&)
+      {
+        // report the first error
+      }
+      throw std::runtime_error(error_);
+    }
+
+    writer_->close();
+  }
+}
+
+AsyncRecordingStats AsyncRecordingWriter::getStats() const
+{
+  AsyncRecordingStats stats;
+  uint64_t tail = tail_.load(std::memory_order_acquire);
+  stats.written = tail;
+  stats.dropped = dropped_.load(std::memory_order_relaxed);
+  stats.queued = static_cast<std::size_t>(head_.load(std::memory_order_acquire) - tail);
+  stats.max_queued = static_cast<std::size_t>(max_queued_.load(std::memory_order_relaxed));
+  stats.capacity = slots_.size();
+  stats.max_stall_ms = max_stall_ns_.load(std::memory_order_relaxed) * 1e-6;
+  return stats;
+}
+
+std::size_t AsyncRecordingWriter::drain()
+{
+  uint64_t tail = tail_.load(std::memory_order_relaxed);
+  uint64_t head = head_.load(std::memory_order_acquire);
+
+  for (uint64_t i = tail; i < head; i++)
+  {
+    const Slot& slot = slots_[i % slots_.size()];
+
+    // writing a message usually only copies it into the current block, but
+    // may also write the output buffer to the file
+    int64_t start = steadyNow();
+    writer_->write(slot.stream, slot.host_stamp, slot.data, slot.size);
+    updateMax(max_stall_ns_, steadyNow() - start);
+
+    tail_.store(i + 1, std::memory_order_release);
+  }
+
+  return static_cast<std::size_t>(head - tail);
+}
+
+void AsyncRecordingWriter::run()
+{
+  try
+  {
+    int64_t last_flush = steadyNow();
+    while (true)
+    {
+      // read stop flag before draining, so that no message is left behind
+      bool stop = stop_.load();
+      std::size_t n = drain();
+
+      if (flush_interval_ms_ > 0 && steadyNow() - last_flush >= flush_interval_ms_ * 1000000ll)
+      {
+        int64_t start = steadyNow();
+        writer_->flush();
+        last_flush = steadyNow();
+        updateMax(max_stall_ns_, last_flush - start);
+      }
+
+      if (stop)
+      {
+        break;
+      }
+
+      if (n == 0)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+  }
+  catch (const std::exception& e)
+  {
+    error_ = e.what();
+    failed_.store(true);
+  }
+}
+}
+}
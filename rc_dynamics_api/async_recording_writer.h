@@ -0,0 +1,175 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_ASYNC_RECORDING_WRITER_H
+#define RC_DYNAMICS_API_ASYNC_RECORDING_WRITER_H
+
+#include "recording.h"
+
+#include <atomic>
+#include <thread>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Statistics of an AsyncRecordingWriter, for detecting that storage cannot
+ * keep up with the incoming messages.
+ */
+struct AsyncRecordingStats
+{
+  uint64_t written;        ///< number of messages written to the recording
+  uint64_t dropped;        ///< number of messages dropped because the queue was full
+  std::size_t queued;      ///< number of messages currently waiting in the queue
+  std::size_t max_queued;  ///< maximum number of messages that have been waiting in the queue
+  std::size_t capacity;    ///< capacity of the queue
+  double max_stall_ms;     ///< longest time that writing to the file took at once
+};
+
+/**
+ * Records messages like RecordingWriter, but writes the file in a separate
+ * thread, so that slow storage never blocks the caller, e.g. the receive
+ * loop of a DataReceiver.
+ *
+ * Messages are copied into a lock-free single producer single consumer
+ * queue, from which the writer thread takes them. If the queue is full,
+ * messages are dropped and counted instead of waiting. The writer thread
+ * flushes the recording periodically, so that not more than the last flush
+ * interval is lost on a crash.
+ *
+ * NOTE: write() must always be called from the same thread.
+ */
+class AsyncRecordingWriter
+{
+public:
+  using Ptr = std::shared_ptr<AsyncRecordingWriter>;
+
+  /// Maximum size of a message, which is the maximum size a DataReceiver can receive
+  static const std::size_t MAX_MESSAGE_SIZE = 512;
+
+  /**
+   * Creates a new recording file, replacing an existing one, and starts the
+   * writer thread.
+   *
+   * @param filename name of the file
+   * @param streams streams that are contained in the recording
+   * @param queue_size maximum number of messages waiting for being written
+   * @param direct_io write with O_DIRECT to bypass the page cache, if supported
+   * @param flush_interval_ms interval for flushing the recording to the file, 0 for never
+   */
+  static Ptr create(const std::string& filename, const std::vector<RecordingStream>& streams,
+                    std::size_t queue_size = 8192, bool direct_io = false, unsigned int flush_interval_ms = 1000);
+
+  /**
+   * Starts the writer thread for writing into the given recording, e.g. a
+   * SegmentedRecordingWriter. The recording must not be used otherwise
+   * until this AsyncRecordingWriter is closed.
+   *
+   * @param writer recording
+   * @param queue_size maximum number of messages waiting for being written
+   * @param flush_interval_ms interval for flushing the recording to the file, 0 for never
+   */
+  static Ptr create(const RecordingWriter::Ptr& writer, std::size_t queue_size = 8192,
+                    unsigned int flush_interval_ms = 1000);
+
+  /// Writes all queued messages and closes the recording
+  virtual ~AsyncRecordingWriter();
+
+  /**
+   * Queues a serialized message for writing. This never blocks.
+   *
+   * @param stream index of the stream as given to create()
+   * @param host_stamp receive time stamp in nanoseconds since epoch
+   * @param data serialized message
+   * @param size size of the serialized message, at most MAX_MESSAGE_SIZE
+   * @return false if the message was dropped, because the queue is full or writing failed
+   */
+  bool write(uint16_t stream, int64_t host_stamp, const char* data, std::size_t size);
+
+  /**
+   * Writes all queued messages, stops the writer thread and closes the
+   * recording. An error of the writer thread is thrown as exception.
+   */
+  void close();
+
+  /// Returns the name of the file, or of the first file if the recording is rotated
+  const std::string& getFilename() const
+  {
+    return filename_;
+  }
+
+  /// Returns statistics about the queue and writing
+  AsyncRecordingStats getStats() const;
+
+protected:
+  AsyncRecordingWriter(const RecordingWriter::Ptr& writer, std::size_t queue_size, unsigned int flush_interval_ms);
+
+  struct Slot
+  {
+    int64_t host_stamp;
+    uint32_t size;
+    uint16_t stream;
+    char data[MAX_MESSAGE_SIZE];
+  };
+
+  void run();
+  std::size_t drain();
+
+  RecordingWriter::Ptr writer_;
+  std::string filename_;
+  std::size_t num_streams_;
+  unsigned int flush_interval_ms_;
+  std::vector<Slot> slots_;
+
+  // producer and writer thread fields are separated to avoid false sharing
+
+  char pad0_[64];
+  std::atomic<uint64_t> head_;  // number of queued messages, written by producer
+  std::atomic<uint64_t> max_queued_;
+  std::atomic<uint64_t> dropped_;
+
+  char pad1_[64];
+  std::atomic<uint64_t> tail_;  // number of taken messages, written by writer thread
+  std::atomic<int64_t> max_stall_ns_;
+
+  char pad2_[64];
+  std::atomic<bool> stop_;
+  std::atomic<bool> failed_;
+  std::string error_;  // set by writer thread before failed_
+  std::thread thread_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_ASYNC_RECORDING_WRITER_H
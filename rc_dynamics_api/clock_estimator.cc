@@ -0,0 +1,268 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "clock_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+const int64_t NS_PER_MS = 1000000;
+
+// index of the interval of the given time, rounding towards negative infinity
+int64_t getInterval(int64_t t, int64_t length)
+{
+  int64_t i = t / length;
+  if (t % length < 0)
+  {
+    i--;
+  }
+  return i;
+}
+}
+
+ClockEstimator::Config::Config() : interval_ms(500), intervals(120), min_intervals(4), max_jump_ms(50)
+{
+}
+
+ClockEstimator::Ptr ClockEstimator::create(const Config& config)
+{
+  return Ptr(new ClockEstimator(config));
+}
+
+ClockEstimator::ClockEstimator(const Config& config) : config_(config)
+{
+  config_.interval_ms = std::max(1u, config_.interval_ms);
+  config_.intervals = std::max(2u, config_.intervals);
+  config_.min_intervals = std::max(2u, std::min(config_.min_intervals, config_.intervals));
+  reset();
+}
+
+void ClockEstimator::add(int64_t device_ns, int64_t host_ns)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  int64_t offset = host_ns - device_ns;
+  model_.samples++;
+
+  if (!model_.valid)
+  {
+    model_.valid = true;
+    restart(device_ns, offset);
+    return;
+  }
+
+  // messages cannot arrive earlier than predicted, unless the device clock
+  // jumped forward
+
+  double error = static_cast<double>(offset) - model_.getOffset(device_ns);
+  if (error < -static_cast<double>(config_.max_jump_ms * NS_PER_MS))
+  {
+    model_.restarts++;
+    restart(device_ns, offset);
+    return;
+  }
+
+  int64_t interval = getInterval(device_ns, config_.interval_ms * NS_PER_MS);
+  if (interval != interval_)
+  {
+    closeInterval();
+    interval_ = interval;
+    current_.device = device_ns;
+    current_.offset = offset;
+  }
+  else if (offset < current_.offset)
+  {
+    current_.device = device_ns;
+    current_.offset = offset;
+  }
+
+  if (error < 0)
+  {
+    model_.host_ref += static_cast<int64_t>(std::floor(error));
+  }
+}
+
+bool ClockEstimator::isValid() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return model_.valid;
+}
+
+int64_t ClockEstimator::toHost(int64_t device_ns) const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!model_.valid)
+  {
+    return device_ns;
+  }
+
+  return device_ns + static_cast<int64_t>(std::llround(model_.getOffset(device_ns)));
+}
+
+int64_t ClockEstimator::toDevice(int64_t host_ns) const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!model_.valid)
+  {
+    return host_ns;
+  }
+
+  return model_.device_ref +
+         static_cast<int64_t>(std::llround(static_cast<double>(host_ns - model_.host_ref) / (1 + model_.skew)));
+}
+
+ClockEstimator::Model ClockEstimator::getModel() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return model_;
+}
+
+void ClockEstimator::reset()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  model_ = Model();
+  model_.valid = false;
+  model_.device_ref = 0;
+  model_.host_ref = 0;
+  model_.skew = 0;
+  model_.samples = 0;
+  model_.restarts = 0;
+  model_.intervals = 0;
+  interval_ = 0;
+  current_.device = 0;
+  current_.offset = 0;
+  minima_.clear();
+  late_intervals_ = 0;
+}
+
+void ClockEstimator::restart(int64_t device, int64_t offset)
+{
+  minima_.clear();
+  late_intervals_ = 0;
+
+  interval_ = getInterval(device, config_.interval_ms * NS_PER_MS);
+  current_.device = device;
+  current_.offset = offset;
+
+  model_.device_ref = device;
+  model_.host_ref = device + offset;
+  model_.skew = 0;
+  model_.intervals = 0;
+}
+
+void ClockEstimator::closeInterval()
+{
+  // minima that are much later than the model are either caused by
+  // congestion or by a backward jump of the device clock, which is assumed
+  // if it persists
+
+  double error = static_cast<double>(current_.offset) - model_.getOffset(current_.device);
+  if (error > static_cast<double>(config_.max_jump_ms * NS_PER_MS))
+  {
+    late_intervals_++;
+    if (late_intervals_ < 3)
+    {
+      return;
+    }
+
+    model_.restarts++;
+    minima_.clear();
+  }
+
+  late_intervals_ = 0;
+  minima_.push_back(current_);
+  if (minima_.size() > config_.intervals)
+  {
+    minima_.pop_front();
+  }
+
+  fit();
+}
+
+void ClockEstimator::fit()
+{
+  // relative to the latest minimum for keeping the precision of doubles
+
+  const Minimum& ref = minima_.back();
+  double skew = 0;
+  if (minima_.size() >= config_.min_intervals)
+  {
+    double n = static_cast<double>(minima_.size());
+    double mx = 0, my = 0;
+    for (auto&& m : minima_)
+    {
+      mx += static_cast<double>(m.device - ref.device);
+      my += static_cast<double>(m.offset - ref.offset);
+    }
+    mx /= n;
+    my /= n;
+
+    double sxx = 0, sxy = 0;
+    for (auto&& m : minima_)
+    {
+      double x = static_cast<double>(m.device - ref.device) - mx;
+      double y = static_cast<double>(m.offset - ref.offset) - my;
+      sxx += x * x;
+      sxy += x * y;
+    }
+
+    if (sxx > 0)
+    {
+      skew = sxy / sxx;
+    }
+  }
+
+  // the line lies below all minima, including the current interval
+
+  double offset = static_cast<double>(current_.offset - ref.offset) -
+                  skew * static_cast<double>(current_.device - ref.device);
+  for (auto&& m : minima_)
+  {
+    offset = std::min(offset, static_cast<double>(m.offset - ref.offset) -
+                                  skew * static_cast<double>(m.device - ref.device));
+  }
+
+  model_.device_ref = ref.device;
+  model_.host_ref = ref.device + ref.offset + static_cast<int64_t>(std::floor(offset));
+  model_.skew = skew;
+  model_.intervals = static_cast<unsigned int>(minima_.size());
+}
+}
+}
@@ -0,0 +1,168 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_CLOCK_ESTIMATOR_H
+#define RC_DYNAMICS_API_CLOCK_ESTIMATOR_H
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Online estimation of the clock of an rc_visard relative to the clock of
+ * this host, for converting the time stamps of messages into host time and
+ * vice versa.
+ *
+ * Every message gives a sample of its device time stamp and the host time
+ * at which it has been received, e.g. by DataReceiver::getReceiveTime()
+ * after enabling DataReceiver::setReceiveTimestamps(). The difference of
+ * both is the clock offset plus the transmission delay, which is always
+ * positive. Therefore, only the sample with the minimum difference is kept
+ * per interval, which is hardly affected by delays. The relative drift
+ * (skew) of the clocks is the slope of a linear regression through the
+ * minima of the last intervals. The offset is chosen such that the line
+ * lies just below all minima.
+ *
+ * The offset includes the minimum transmission delay, which cannot be
+ * separated from the offset by one-way measurements. Converted time stamps
+ * are thus the time at which a message would have been received with
+ * minimum delay, which is close to the sending time on a local network.
+ *
+ * The model is never later than a received message, i.e. it is moved as
+ * soon as a message arrives earlier than predicted. Jumps of the device
+ * clock, e.g. due to NTP or PTP synchronization, restart the estimation.
+ * Backward jumps are only accepted after several intervals, so that
+ * congestion of the network is not mistaken for a jump.
+ *
+ * Conversions take constant time. All methods are thread-safe.
+ */
+class ClockEstimator
+{
+public:
+  using Ptr = std::shared_ptr<ClockEstimator>;
+
+  /// Parameters of the estimation
+  struct Config
+  {
+    Config();
+
+    unsigned int interval_ms;    ///< length of the intervals of the minimum filter in device time
+    unsigned int intervals;      ///< number of intervals of the regression, i.e. the window length
+    unsigned int min_intervals;  ///< minimum number of intervals for estimating the drift
+    unsigned int max_jump_ms;    ///< larger deviations from the model are treated as jump of the device clock
+  };
+
+  /// Model of the device clock, i.e. host = host_ref + (device - device_ref) * (1 + skew)
+  struct Model
+  {
+    bool valid;              ///< false until the first sample has been added
+    int64_t device_ref;      ///< reference time of the device in nanoseconds
+    int64_t host_ref;        ///< corresponding time of the host in nanoseconds
+    double skew;             ///< drift of the host clock relative to the device clock, e.g. 1e-6 for 1 ppm
+    uint64_t samples;        ///< number of added samples
+    uint64_t restarts;       ///< number of restarts due to jumps of the device clock
+    unsigned int intervals;  ///< number of intervals of the regression
+
+    /// Returns the offset of the host to the device clock at the given device time in nanoseconds
+    double getOffset(int64_t device) const
+    {
+      return static_cast<double>(host_ref - device_ref) + static_cast<double>(device - device_ref) * skew;
+    }
+  };
+
+  static Ptr create(const Config& config = Config());
+
+  /**
+   * Adds a sample, i.e. the time stamp of a message and its receive time.
+   *
+   * @param device_ns time stamp of the message in nanoseconds since epoch (device clock)
+   * @param host_ns receive time in nanoseconds since epoch (host clock)
+   */
+  void add(int64_t device_ns, int64_t host_ns);
+
+  /// Returns true if at least one sample has been added
+  bool isValid() const;
+
+  /**
+   * Converts a time stamp of the device into host time.
+   *
+   * @param device_ns time stamp in nanoseconds since epoch (device clock)
+   * @return time stamp in nanoseconds since epoch (host clock), unchanged if not valid
+   */
+  int64_t toHost(int64_t device_ns) const;
+
+  /**
+   * Converts a time stamp of the host into device time.
+   *
+   * @param host_ns time stamp in nanoseconds since epoch (host clock)
+   * @return time stamp in nanoseconds since epoch (device clock), unchanged if not valid
+   */
+  int64_t toDevice(int64_t host_ns) const;
+
+  /// Returns the current model
+  Model getModel() const;
+
+  /// Forgets all samples
+  void reset();
+
+private:
+  explicit ClockEstimator(const Config& config);
+
+  struct Minimum
+  {
+    int64_t device;  // device time of the sample
+    int64_t offset;  // host - device
+  };
+
+  void restart(int64_t device, int64_t offset);
+  void closeInterval();
+  void fit();
+
+  Config config_;
+  mutable std::mutex mtx_;
+  Model model_;
+  int64_t interval_;  // index of the current interval
+  Minimum current_;   // minimum of the current interval
+  std::deque<Minimum> minima_;
+  unsigned int late_intervals_;  // consecutive intervals above the model by more than max_jump_ms
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_CLOCK_ESTIMATOR_H
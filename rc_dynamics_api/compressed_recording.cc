@@ -0,0 +1,476 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "compressed_recording.h"
+
+#include "roboception/msgs/frame.pb.h"
+#include "roboception/msgs/dynamics.pb.h"
+#include "roboception/msgs/imu.pb.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+const char file_magic[8] = { 'R', 'C', 'D', 'Y', 'N', 'R', 'C', 'Z' };
+const uint32_t file_version = 1;
+const uint32_t chunk_magic = 0x435a4352;  // "RCZC"
+
+/// Number of bits of the stream index, which leaves one value as end marker
+const int stream_bits = 4;
+
+struct StreamEntry
+{
+  char name[32];
+  char pb_msg_type[32];
+};
+
+struct FileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t num_streams;
+  double tolerance;
+  int64_t created;
+  StreamEntry streams[RecordingWriter::MAX_STREAMS];
+  char reserved[32];
+};
+
+struct ChunkHeader
+{
+  uint32_t magic;
+  uint32_t count;
+  uint32_t size;  // number of bytes of compressed data following the header
+  uint32_t reserved;
+  int64_t first_stamp;
+  int64_t last_stamp;
+};
+
+static_assert(sizeof(FileHeader) == 1024, "Unexpected size of compressed recording file header");
+static_assert(sizeof(ChunkHeader) == 32, "Unexpected size of compressed recording chunk header");
+static_assert(RecordingWriter::MAX_STREAMS < (1u << stream_bits), "Stream index does not fit into header");
+
+/**
+ * Returns the protobuf message type with the given name or 0 if it is
+ * unknown.
+ */
+const ::google::protobuf::Descriptor* findMessageType(const std::string& pb_msg_type)
+{
+  // referencing the messages of the data streams makes sure that they are linked
+  static const ::google::protobuf::Descriptor* known[] = { roboception::msgs::Frame::descriptor(),
+                                                            roboception::msgs::Imu::descriptor(),
+                                                            roboception::msgs::Dynamics::descriptor() };
+
+  for (auto type : known)
+  {
+    if (type->name() == pb_msg_type)
+    {
+      return type;
+    }
+  }
+
+  return ::google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(pb_msg_type);
+}
+
+/// Creates an empty message of the given type
+::google::protobuf::Message* createMessage(const ::google::protobuf::Descriptor* type)
+{
+  return ::google::protobuf::MessageFactory::generated_factory()->GetPrototype(type)->New();
+}
+}
+
+CompressedRecordingWriter::Ptr CompressedRecordingWriter::create(const std::string& filename,
+                                                                 const std::vector<RecordingStream>& streams,
+                                                                 double tolerance, std::size_t chunk_size)
+{
+  return Ptr(new CompressedRecordingWriter(filename, streams, tolerance, chunk_size));
+}
+
+CompressedRecordingWriter::CompressedRecordingWriter(const std::string& filename,
+                                                     const std::vector<RecordingStream>& streams, double tolerance,
+                                                     std::size_t chunk_size)
+  : filename_(filename)
+  , chunk_size_(std::max<std::size_t>(chunk_size, 1))
+  , chunk_count_(0)
+  , first_stamp_(0)
+  , last_stamp_(0)
+  , count_(0)
+  , file_size_(0)
+{
+  if (streams.empty() || streams.size() > RecordingWriter::MAX_STREAMS)
+  {
+    throw std::invalid_argument("Number of streams of a recording must be between 1 and " +
+                                std::to_string(RecordingWriter::MAX_STREAMS));
+  }
+
+  FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, file_magic, sizeof(file_magic));
+  header.version = file_version;
+  header.num_streams = static_cast<uint32_t>(streams.size());
+  header.tolerance = tolerance;
+  header.created =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+          .count();
+
+  streams_.resize(streams.size());
+  for (std::size_t i = 0; i < streams.size(); i++)
+  {
+    if (streams[i].name.size() >= sizeof(header.streams[i].name) ||
+        streams[i].pb_msg_type.size() >= sizeof(header.streams[i].pb_msg_type))
+    {
+      throw std::invalid_argument("Name too long for recording: " + streams[i].name);
+    }
+    std::memcpy(header.streams[i].name, streams[i].name.data(), streams[i].name.size());
+    std::memcpy(header.streams[i].pb_msg_type, streams[i].pb_msg_type.data(), streams[i].pb_msg_type.size());
+
+    const ::google::protobuf::Descriptor* type = findMessageType(streams[i].pb_msg_type);
+    if (type)
+    {
+      streams_[i].codec.reset(new MessageCodec(type, tolerance));
+    }
+    streams_[i].stamp.n = 0;
+  }
+
+  file_.open(filename, std::ios::binary | std::ios::trunc);
+  if (!file_.is_open())
+  {
+    throw std::runtime_error("Cannot create recording file '" + filename + "'");
+  }
+
+  file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file_size_ = sizeof(header);
+}
+
+CompressedRecordingWriter::~CompressedRecordingWriter()
+{
+  try
+  {
+    close();
+  }
+  catch (const std::exception&)
+  {
+    // destructor must not throw
+  }
+}
+
+void CompressedRecordingWriter::writeHeader(uint16_t stream, int64_t host_stamp, bool raw)
+{
+  if (!file_.is_open())
+  {
+    throw std::runtime_error("Recording '" + filename_ + "' is already closed");
+  }
+
+  if (stream >= streams_.size())
+  {
+    throw std::invalid_argument("Invalid stream index for recording: " + std::to_string(stream));
+  }
+
+  if (chunk_count_ == 0)
+  {
+    first_stamp_ = host_stamp;
+  }
+  last_stamp_ = host_stamp;
+
+  chunk_.write(stream, stream_bits);
+  chunk_.writeBit(raw);
+  streams_[stream].stamp.encode(chunk_, host_stamp);
+}
+
+void CompressedRecordingWriter::write(uint16_t stream, int64_t host_stamp, const char* data, std::size_t size)
+{
+  MessageCodec* codec = stream < streams_.size() ? streams_[stream].codec.get() : 0;
+  if (codec && codec->prepare(data, size))
+  {
+    writeHeader(stream, host_stamp, false);
+    codec->encode(chunk_);
+  }
+  else
+  {
+    // store messages that cannot be compressed as they are
+
+    writeHeader(stream, host_stamp, true);
+    chunk_.writeUInt(size);
+    chunk_.writeBytes(data, size);
+  }
+
+  count_++;
+  if (++chunk_count_ >= chunk_size_)
+  {
+    writeChunk();
+  }
+}
+
+void CompressedRecordingWriter::write(uint16_t stream, int64_t host_stamp, const ::google::protobuf::Message& m)
+{
+  m.SerializeToString(&buffer_);
+  write(stream, host_stamp, buffer_.data(), buffer_.size());
+}
+
+void CompressedRecordingWriter::writeChunk()
+{
+  if (chunk_count_ == 0)
+  {
+    return;
+  }
+
+  // end marker, followed by padding to whole bytes
+  chunk_.write((1u << stream_bits) - 1, stream_bits);
+  chunk_.finish();
+
+  ChunkHeader ch;
+  ch.magic = chunk_magic;
+  ch.count = chunk_count_;
+  ch.size = static_cast<uint32_t>(chunk_.getSize());
+  ch.reserved = 0;
+  ch.first_stamp = first_stamp_;
+  ch.last_stamp = last_stamp_;
+
+  file_.write(reinterpret_cast<const char*>(&ch), sizeof(ch));
+  file_.write(chunk_.getData(), static_cast<std::streamsize>(chunk_.getSize()));
+  if (!file_)
+  {
+    throw std::runtime_error("Cannot write to recording file '" + filename_ + "'");
+  }
+  file_size_ += sizeof(ch) + chunk_.getSize();
+
+  // chunks are decoded independently
+
+  chunk_.clear();
+  chunk_count_ = 0;
+  for (auto&& s : streams_)
+  {
+    if (s.codec)
+    {
+      s.codec->reset();
+    }
+    s.stamp.n = 0;
+  }
+}
+
+void CompressedRecordingWriter::flush()
+{
+  if (file_.is_open())
+  {
+    writeChunk();
+    file_.flush();
+  }
+}
+
+void CompressedRecordingWriter::close()
+{
+  if (!file_.is_open())
+  {
+    return;
+  }
+
+  try
+  {
+    writeChunk();
+  }
+  catch (...)
+  {
+    file_.close();
+    throw;
+  }
+
+  file_.close();
+}
+
+CompressedRecordingReader::Ptr CompressedRecordingReader::open(const std::string& filename)
+{
+  return Ptr(new CompressedRecordingReader(filename));
+}
+
+CompressedRecordingReader::CompressedRecordingReader(const std::string& filename)
+  : filename_(filename), file_(filename, std::ios::binary), remaining_(0), complete_(false)
+{
+  if (!file_.is_open())
+  {
+    throw std::runtime_error("Cannot open recording file '" + filename + "'");
+  }
+
+  FileHeader header;
+  file_.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!file_ || std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0)
+  {
+    throw std::invalid_argument("File '" + filename + "' is not a compressed recording");
+  }
+
+  if (header.version != file_version || header.num_streams > RecordingWriter::MAX_STREAMS)
+  {
+    throw std::invalid_argument("Unsupported version of compressed recording '" + filename + "'");
+  }
+
+  tolerance_ = header.tolerance;
+  codecs_.resize(header.num_streams);
+  for (uint32_t i = 0; i < header.num_streams; i++)
+  {
+    RecordingStream stream;
+    stream.name = std::string(header.streams[i].name, strnlen(header.streams[i].name, sizeof(header.streams[i].name)));
+    stream.pb_msg_type = std::string(header.streams[i].pb_msg_type,
+                                     strnlen(header.streams[i].pb_msg_type, sizeof(header.streams[i].pb_msg_type)));
+    streams_.push_back(stream);
+
+    const ::google::protobuf::Descriptor* type = findMessageType(stream.pb_msg_type);
+    if (type)
+    {
+      codecs_[i].codec.reset(new MessageCodec(type, tolerance_));
+      codecs_[i].msg.reset(createMessage(type));
+    }
+    codecs_[i].stamp.n = 0;
+  }
+}
+
+CompressedRecordingReader::~CompressedRecordingReader()
+{
+}
+
+bool CompressedRecordingReader::nextChunk()
+{
+  ChunkHeader ch;
+  file_.read(reinterpret_cast<char*>(&ch), sizeof(ch));
+  if (file_.gcount() == 0)
+  {
+    complete_ = true;
+    return false;
+  }
+
+  if (file_.gcount() != sizeof(ch) || ch.magic != chunk_magic)
+  {
+    return false;
+  }
+
+  chunk_.resize(ch.size);
+  file_.read(chunk_.data(), ch.size);
+  if (file_.gcount() != static_cast<std::streamsize>(ch.size))
+  {
+    return false;
+  }
+
+  reader_.reset(new BitReader(chunk_.data(), chunk_.size()));
+  remaining_ = ch.count;
+  for (auto&& s : codecs_)
+  {
+    if (s.codec)
+    {
+      s.codec->reset();
+    }
+    s.stamp.n = 0;
+  }
+  return true;
+}
+
+bool CompressedRecordingReader::readHeader(uint16_t& stream, int64_t& host_stamp, bool& raw)
+{
+  while (remaining_ == 0)
+  {
+    if (!nextChunk())
+    {
+      return false;
+    }
+  }
+
+  stream = static_cast<uint16_t>(reader_->read(stream_bits));
+  if (stream >= codecs_.size())
+  {
+    throw std::runtime_error("Invalid data in compressed recording '" + filename_ + "'");
+  }
+
+  raw = reader_->readBit();
+  host_stamp = codecs_[stream].stamp.decode(*reader_);
+  remaining_--;
+  return true;
+}
+
+bool CompressedRecordingReader::next(RecordedMessage& msg)
+{
+  bool raw;
+  if (!readHeader(msg.stream, msg.host_stamp, raw))
+  {
+    return false;
+  }
+
+  Stream& s = codecs_[msg.stream];
+  if (raw)
+  {
+    uint64_t size = reader_->readUInt();
+    if (size > chunk_.size())
+    {
+      throw std::runtime_error("Invalid data in compressed recording '" + filename_ + "'");
+    }
+    data_.resize(static_cast<std::size_t>(size));
+    reader_->readBytes(&data_[0], data_.size());
+  }
+  else if (s.codec)
+  {
+    s.codec->decode(*reader_, data_);
+  }
+  else
+  {
+    throw std::runtime_error("Unknown message type in compressed recording '" + filename_ + "'");
+  }
+
+  msg.flags = 0;
+  msg.data = data_.data();
+  msg.size = data_.size();
+  return true;
+}
+
+const ::google::protobuf::Message* CompressedRecordingReader::nextMessage(uint16_t& stream, int64_t& host_stamp)
+{
+  RecordedMessage msg;
+  if (!next(msg))
+  {
+    return 0;
+  }
+
+  Stream& s = codecs_[msg.stream];
+  if (!s.msg || !s.msg->ParseFromString(data_))
+  {
+    throw std::runtime_error("Cannot parse message in compressed recording '" + filename_ + "'");
+  }
+
+  stream = msg.stream;
+  host_stamp = msg.host_stamp;
+  return s.msg.get();
+}
+}
+}
@@ -0,0 +1,246 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_COMPRESSED_RECORDING_H
+#define RC_DYNAMICS_API_COMPRESSED_RECORDING_H
+
+#include "recording.h"
+#include "message_codec.h"
+
+#include <fstream>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Records messages like RecordingWriter, but compresses them with a
+ * MessageCodec per stream, which typically reduces the size of pose and
+ * IMU data several times.
+ *
+ * Messages are compressed in chunks of a given number of messages, which
+ * are written as a whole and can be decoded independently. Messages of
+ * unknown protobuf types are stored uncompressed.
+ *
+ * File layout (headers in the native byte order of the recording host, as
+ * for RecordingWriter):
+ *
+ *   file header | chunk | chunk | ... | chunk
+ *
+ * where a chunk consists of a chunk header with the number of messages,
+ * the time range and the size, followed by the compressed messages.
+ *
+ * NOTE: A CompressedRecordingWriter is not thread-safe.
+ */
+class CompressedRecordingWriter
+{
+public:
+  using Ptr = std::shared_ptr<CompressedRecordingWriter>;
+
+  /**
+   * Creates a new compressed recording file, replacing an existing one.
+   *
+   * @param filename name of the file
+   * @param streams streams that are contained in the recording
+   * @param tolerance maximum error of floating point values, 0 for lossless compression
+   * @param chunk_size number of messages per chunk
+   */
+  static Ptr create(const std::string& filename, const std::vector<RecordingStream>& streams, double tolerance = 0,
+                    std::size_t chunk_size = 4096);
+
+  /// Closes the recording
+  virtual ~CompressedRecordingWriter();
+
+  /**
+   * Compresses and appends a serialized message. Messages that cannot be
+   * compressed, e.g. because of unknown fields, are stored as they are.
+   *
+   * @param stream index of the stream as given to create()
+   * @param host_stamp receive time stamp in nanoseconds since epoch
+   * @param data serialized message
+   * @param size size of the serialized message
+   */
+  void write(uint16_t stream, int64_t host_stamp, const char* data, std::size_t size);
+
+  /**
+   * Compresses and appends a message.
+   *
+   * @param stream index of the stream as given to create()
+   * @param host_stamp receive time stamp in nanoseconds since epoch
+   * @param m message of the type of the stream
+   */
+  void write(uint16_t stream, int64_t host_stamp, const ::google::protobuf::Message& m);
+
+  /// Writes the current chunk to the file
+  void flush();
+
+  /// Writes the current chunk and closes the file. This is done automatically on destruction.
+  void close();
+
+  /// Returns the name of the file
+  const std::string& getFilename() const
+  {
+    return filename_;
+  }
+
+  /// Returns the number of written messages
+  uint64_t getMessageCount() const
+  {
+    return count_;
+  }
+
+  /// Returns the size of the file without the current chunk
+  uint64_t getFileSize() const
+  {
+    return file_size_;
+  }
+
+protected:
+  CompressedRecordingWriter(const std::string& filename, const std::vector<RecordingStream>& streams,
+                            double tolerance, std::size_t chunk_size);
+
+  struct Stream
+  {
+    std::unique_ptr<MessageCodec> codec;  // 0 for unknown message types
+    MessageCodec::IntState stamp;
+  };
+
+  void writeHeader(uint16_t stream, int64_t host_stamp, bool raw);
+  void writeChunk();
+
+  std::string filename_;
+  std::ofstream file_;
+  std::vector<Stream> streams_;
+  std::size_t chunk_size_;
+  BitWriter chunk_;
+  uint32_t chunk_count_;
+  int64_t first_stamp_;
+  int64_t last_stamp_;
+  uint64_t count_;
+  uint64_t file_size_;
+  std::string buffer_;  // serialized message
+};
+
+/**
+ * Reads a recording of a CompressedRecordingWriter sequentially, chunk by
+ * chunk, without loading the whole file.
+ */
+class CompressedRecordingReader
+{
+public:
+  using Ptr = std::shared_ptr<CompressedRecordingReader>;
+
+  /**
+   * Opens a compressed recording.
+   *
+   * @param filename name of the file
+   */
+  static Ptr open(const std::string& filename);
+
+  virtual ~CompressedRecordingReader();
+
+  /// Returns the name of the file
+  const std::string& getFilename() const
+  {
+    return filename_;
+  }
+
+  /// Returns the streams contained in the recording
+  const std::vector<RecordingStream>& getStreams() const
+  {
+    return streams_;
+  }
+
+  /// Returns the maximum error of floating point values, 0 for lossless compression
+  double getTolerance() const
+  {
+    return tolerance_;
+  }
+
+  /**
+   * Returns the next message, serialized again after decompression. The data
+   * of the message stays valid until the next call.
+   *
+   * @param msg next message
+   * @return false if there are no more messages
+   */
+  bool next(RecordedMessage& msg);
+
+  /**
+   * Returns the next message as decompressed protobuf message, which stays
+   * valid until the next call.
+   *
+   * @param stream index of the stream of the message
+   * @param host_stamp receive time stamp of the message
+   * @return message or 0 if there are no more messages
+   */
+  const ::google::protobuf::Message* nextMessage(uint16_t& stream, int64_t& host_stamp);
+
+  /**
+   * Returns true if the end of the file has been reached without finding
+   * incomplete data, e.g. of a recording that has not been closed.
+   */
+  bool isComplete() const
+  {
+    return complete_;
+  }
+
+protected:
+  explicit CompressedRecordingReader(const std::string& filename);
+
+  struct Stream
+  {
+    std::unique_ptr<MessageCodec> codec;  // 0 for unknown message types
+    std::unique_ptr<::google::protobuf::Message> msg;
+    MessageCodec::IntState stamp;
+  };
+
+  bool nextChunk();
+  bool readHeader(uint16_t& stream, int64_t& host_stamp, bool& raw);
+
+  std::string filename_;
+  std::ifstream file_;
+  std::vector<RecordingStream> streams_;
+  std::vector<Stream> codecs_;
+  double tolerance_;
+  std::vector<char> chunk_;
+  std::unique_ptr<BitReader> reader_;
+  uint32_t remaining_;  // number of remaining messages in the current chunk
+  std::string data_;    // serialized data of the last message
+  bool complete_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_COMPRESSED_RECORDING_H
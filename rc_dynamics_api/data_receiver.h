@@ -41,18 +41,28 @@
 
 #ifdef WIN32
 #include <winsock2.h>
+#include <ws2tcpip.h>
 #else
 #include <netinet/in.h>
 #include <unistd.h>
 #include <ifaddrs.h>
 #include <arpa/inet.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #endif
 
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <vector>
 
+#include "metrics.h"
 #include "net_utils.h"
 #include "socket_exception.h"
+#include "tracing.h"
 
 #include "roboception/msgs/frame.pb.h"
 #include "roboception/msgs/dynamics.pb.h"
@@ -84,7 +94,23 @@ public:
    */
   static Ptr create(const std::string& ip_address, unsigned int& port)
   {
-    return Ptr(new DataReceiver(ip_address, port));
+    return Ptr(new DataReceiver(ip_address, port, ""));
+  }
+
+  /**
+   * Creates a data receiver that joins an IPv4 multicast group, so that
+   * one stream of the rc_visard can be received by any number of
+   * receivers on this and other hosts. Several receivers of the same group
+   * and port may exist on one host.
+   *
+   * @param group multicast group address, e.g. "239.255.0.1"
+   * @param port port number for receiving data, which must not be 0
+   * @param interface_ip IP address of the network interface for joining the group, empty for the default
+   * @return
+   */
+  static Ptr createMulticast(const std::string& group, unsigned int port, const std::string& interface_ip = "")
+  {
+    return Ptr(new DataReceiver(group, port, interface_ip, ""));
   }
 
   virtual ~DataReceiver()
@@ -103,6 +129,14 @@ public:
     return ip_;
   }
 
+  /**
+   * Returns true if the receiver has joined a multicast group, see createMulticast()
+   */
+  bool isMulticast() const
+  {
+    return multicast_;
+  }
+
   /**
    * Returns port  for which the receiver was created
    */
@@ -110,6 +144,43 @@ public:
     return port_;
   }
 
+  /**
+   * Sets the name of the received stream, which is used as label of the
+   * metrics of this receiver, see MetricsRegistry. Receivers of
+   * RemoteInterface are named automatically.
+   *
+   * @param stream name of the stream, e.g. "imu"
+   */
+  void setStreamName(const std::string& stream)
+  {
+    MetricsRegistry::Ptr registry = MetricsRegistry::getDefault();
+    MetricsRegistry::Labels labels = { { "stream", stream } };
+    metric_messages_ = &registry->counter("rc_dynamics_messages_received_total", "Received messages", labels);
+    metric_bytes_ = &registry->counter("rc_dynamics_received_bytes_total", "Received bytes", labels);
+    metric_timeouts_ = &registry->counter("rc_dynamics_receive_timeouts_total", "Receive calls that timed out", labels);
+    metric_decode_ = &registry->histogram("rc_dynamics_decode_duration_seconds",
+                                          "Time for de-serializing a message, sampled every 16th message",
+                                          Histogram::exponentialBounds(1e-7, 2, 16), labels);
+    stream_name_ = stream;
+  }
+
+  /**
+   * Returns the name of the received stream, see setStreamName()
+   */
+  const std::string& getStreamName() const
+  {
+    return stream_name_;
+  }
+
+  /**
+   * Returns the number of messages that have been received so far. This
+   * may be called from any thread, e.g. for supervising the stream.
+   */
+  uint64_t getMessageCount() const
+  {
+    return received_.load(std::memory_order_relaxed);
+  }
+
   /**
    * Sets a user-specified timeout for the receivePose() method.
    *
@@ -132,27 +203,127 @@ public:
       throw SocketException("Error while setting receive timeout!", errno);
     }
 #endif
+    timeout_ms_ = ms;
   }
 
   /**
-   * Receives the next message from data stream (template-parameter version)
+   * Returns the timeout that has been set by setTimeout(), 0 for none.
    *
-   * This method blocks until the next message is received and returns it as
-   * specified by the template parameter PbMsgType, or when it runs into
-   * user-specified timeout (see setTimeout(...)).
+   * @return timeout in milliseconds
+   */
+  unsigned int getTimeout() const
+  {
+    return timeout_ms_;
+  }
+
+  /**
+   * Enables or disables time stamping of received messages, see
+   * getReceiveTime(). If supported by the operating system, the kernel
+   * stamps datagrams on arrival, which excludes the scheduling delay of the
+   * receiving thread.
    *
-   * NOTE: The specified PbMsgType *must match* the type with which the
-   * received data was serialized during sending. Otherwise it will result in
-   * undefined behaviour!
+   * @param enable true for time stamping
+   */
+  void setReceiveTimestamps(bool enable)
+  {
+#if defined(SO_TIMESTAMPNS)
+    int on = enable ? 1 : 0;
+    setOption(SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on), "Error while setting SO_TIMESTAMPNS!");
+#elif defined(SO_TIMESTAMP)
+    int on = enable ? 1 : 0;
+    setOption(SOL_SOCKET, SO_TIMESTAMP, &on, sizeof(on), "Error while setting SO_TIMESTAMP!");
+#endif
+    timestamps_ = enable;
+    receive_time_ = 0;
+  }
+
+  /**
+   * Returns the time at which the last message has been received in
+   * nanoseconds since epoch (system clock), if enabled by
+   * setReceiveTimestamps(). This is the time of the kernel if available and
+   * otherwise the time at which the message has been taken from the socket.
    *
-   * @return the next rc_dynamics data stream message as PbMsgType, or NULL if timeout
+   * @return receive time or 0 if time stamping is disabled
    */
-  template <class PbMsgType>
-  std::shared_ptr<PbMsgType> receive()
+  int64_t getReceiveTime() const
+  {
+    return receive_time_;
+  }
+
+  /**
+   * Waits until at least one of the given receivers has a message available,
+   * so that several data streams can be received in one thread.
+   *
+   * @param receivers receivers to wait for
+   * @param ms timeout in milliseconds
+   * @return indices of the receivers with available messages, empty if timeout
+   */
+  static std::vector<std::size_t> select(const std::vector<Ptr>& receivers, unsigned int ms)
+  {
+    fd_set fds;
+    FD_ZERO(&fds);
+
+    int max_fd = 0;
+    for (auto&& r : receivers)
+    {
+      FD_SET(r->_sockfd, &fds);
+#ifndef WIN32
+      max_fd = std::max(max_fd, r->_sockfd);
+#endif
+    }
+
+    struct timeval timeout;
+    timeout.tv_sec = ms / 1000;
+    timeout.tv_usec = (ms % 1000) * 1000;
+
+    std::vector<std::size_t> ready;
+    int ret = ::select(max_fd + 1, &fds, NULL, NULL, &timeout);
+    if (ret < 0)
+    {
+#ifdef WIN32
+      throw SocketException("Error during socket select!", WSAGetLastError());
+#else
+      if (errno == EINTR)
+      {
+        // e.g. interrupted by a signal, same as timeout
+        return ready;
+      }
+      throw SocketException("Error during socket select!", errno);
+#endif
+    }
+
+    for (std::size_t i = 0; i < receivers.size() && ready.size() < static_cast<std::size_t>(ret); i++)
+    {
+      if (FD_ISSET(receivers[i]->_sockfd, &fds))
+      {
+        ready.push_back(i);
+      }
+    }
+
+    return ready;
+  }
+
+  /**
+   * Receives the next message from data stream without de-serializing it.
+   *
+   * This method blocks until the next message is received, or when it runs
+   * into user-specified timeout (see setTimeout(...)).
+   *
+   * NOTE: The returned pointer refers to an internal buffer of the receiver
+   * and is only valid until the next call of any receive method.
+   *
+   * @param size size of the received message in bytes (only valid if not NULL is returned)
+   * @return pointer to the serialized message, or NULL if timeout
+   */
+  const char* receiveRaw(std::size_t& size)
   {
 // receive msg from socket; blocking call (timeout)
 #ifdef WIN32
-    int msg_size = recvfrom(_sockfd, _buffer, sizeof(_buffer), 0, NULL, NULL);
+    int msg_size;
+    {
+      RC_DYNAMICS_TRACE_SCOPE("receive", "recvfrom");
+      msg_size = recvfrom(_sockfd, _buffer, sizeof(_buffer), 0, NULL, NULL);
+    }
 
     if (msg_size < 0)
     {
@@ -160,6 +331,7 @@ public:
       if (e == WSAETIMEDOUT)
       {
         // timeouts are allowed to happen, then return NULL pointer
+        metric_timeouts_->inc();
         return nullptr;
       }
       else
@@ -168,7 +340,17 @@ public:
       }
     }
 #else
-    int msg_size = TEMP_FAILURE_RETRY(recvfrom(_sockfd, _buffer, sizeof(_buffer), 0, NULL, NULL));
+    int msg_size;
+    if (timestamps_)
+    {
+      RC_DYNAMICS_TRACE_SCOPE("receive", "recvmsg");
+      msg_size = receiveWithTimestamp();
+    }
+    else
+    {
+      RC_DYNAMICS_TRACE_SCOPE("receive", "recvfrom");
+      msg_size = TEMP_FAILURE_RETRY(recvfrom(_sockfd, _buffer, sizeof(_buffer), 0, NULL, NULL));
+    }
 
     if (msg_size < 0)
     {
@@ -176,6 +358,7 @@ public:
       if (e == EAGAIN || e == EWOULDBLOCK)
       {
         // timeouts are allowed to happen, then return NULL pointer
+        metric_timeouts_->inc();
         return nullptr;
       }
       else
@@ -185,9 +368,67 @@ public:
     }
 #endif
 
-    // parse msgs as probobuf
+#ifdef WIN32
+    if (timestamps_)
+    {
+      receive_time_ = now();
+    }
+#endif
+
+    // only the receiving thread writes, so that no atomic increment is needed
+    received_.store(received_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    metric_messages_->inc();
+    metric_bytes_->inc(static_cast<uint64_t>(msg_size));
+    size = static_cast<std::size_t>(msg_size);
+    return _buffer;
+  }
+
+  /**
+   * Receives the next message from data stream (template-parameter version)
+   *
+   * This method blocks until the next message is received and returns it as
+   * specified by the template parameter PbMsgType, or when it runs into
+   * user-specified timeout (see setTimeout(...)).
+   *
+   * NOTE: The specified PbMsgType *must match* the type with which the
+   * received data was serialized during sending. Otherwise it will result in
+   * undefined behaviour!
+   *
+   * @return the next rc_dynamics data stream message as PbMsgType, or NULL if timeout
+   */
+  template <class PbMsgType>
+  std::shared_ptr<PbMsgType> receive()
+  {
+    RC_DYNAMICS_TRACE_SCOPE("receive", "receive");
+
+    std::size_t msg_size;
+    const char* data = receiveRaw(msg_size);
+    if (!data)
+    {
+      return nullptr;
+    }
+
+    // parse msgs as probobuf, measuring only some messages for keeping the
+    // overhead of reading the clock low
+
+    bool sample = (received_.load(std::memory_order_relaxed) & (DECODE_SAMPLING - 1)) == 0;
+    std::chrono::steady_clock::time_point start;
+    if (sample)
+    {
+      start = std::chrono::steady_clock::now();
+    }
+
     auto pb_msg = std::shared_ptr<PbMsgType>(new PbMsgType());
-    pb_msg->ParseFromArray(_buffer, msg_size);
+    {
+      RC_DYNAMICS_TRACE_SCOPE("receive", "parse");
+      pb_msg->ParseFromArray(data, static_cast<int>(msg_size));
+    }
+
+    if (sample)
+    {
+      metric_decode_->observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
     return pb_msg;
   }
 
@@ -207,6 +448,8 @@ public:
    */
   virtual std::shared_ptr<::google::protobuf::Message> receive(const std::string& pb_msg_type)
   {
+    RC_DYNAMICS_TRACE_SCOPE("receive", "dispatch");
+
     auto found = _recv_func_map.find(pb_msg_type);
     if (found == _recv_func_map.end())
     {
@@ -220,7 +463,9 @@ public:
   }
 
 protected:
-  DataReceiver(const std::string& ip_address, unsigned int& port) : ip_(ip_address), port_(port)
+  DataReceiver(const std::string& ip_address, unsigned int& port, const std::string& stream)
+    : ip_(ip_address), port_(port), multicast_(false), timeout_ms_(0), received_(0), timestamps_(false),
+      receive_time_(0)
   {
     // check if given string is a valid IP address
     if (!rc::isValidIPAddress(ip_address))
@@ -272,6 +517,177 @@ protected:
       port_ = port = ntohs(myaddr.sin_port);
     }
 
+    registerMessageTypes();
+    setStreamName(stream);
+  }
+
+  DataReceiver(const std::string& group, unsigned int port, const std::string& interface_ip,
+               const std::string& stream)
+    : ip_(group), port_(port), multicast_(true), timeout_ms_(0), received_(0), timestamps_(false),
+      receive_time_(0)
+  {
+    struct in_addr group_addr, interface_addr;
+    group_addr.s_addr = inet_addr(group.c_str());
+    if (!rc::isValidIPAddress(group) || !IN_MULTICAST(ntohl(group_addr.s_addr)))
+    {
+      throw std::invalid_argument("Given IP address is not a valid multicast address: " + group);
+    }
+
+    interface_addr.s_addr = htonl(INADDR_ANY);
+    if (!interface_ip.empty())
+    {
+      if (!rc::isValidIPAddress(interface_ip))
+      {
+        throw std::invalid_argument("Given IP address is not a valid address: " + interface_ip);
+      }
+      interface_addr.s_addr = inet_addr(interface_ip.c_str());
+    }
+
+    if (port == 0)
+    {
+      throw std::invalid_argument("Port of multicast group must not be 0");
+    }
+
+    // open socket for UDP listening
+    _sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef WIN32
+    if (_sockfd == INVALID_SOCKET)
+#else
+    if (_sockfd < 0)
+#endif
+    {
+      throw SocketException("Error while creating socket!", errno);
+    }
+
+    try
+    {
+      // all receivers of the group on this host share the same port
+
+      int on = 1;
+      setOption(SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on), "Error while setting SO_REUSEADDR!");
+#if defined(SO_REUSEPORT) && !defined(__linux__)
+      setOption(SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on), "Error while setting SO_REUSEPORT!");
+#endif
+
+      // bind to the group address, so that no other datagrams to this port
+      // are received, which is not possible on Windows
+
+      struct sockaddr_in myaddr;
+      memset(&myaddr, 0, sizeof(myaddr));
+      myaddr.sin_family = AF_INET;
+#ifdef WIN32
+      myaddr.sin_addr.s_addr = htonl(INADDR_ANY);
+#else
+      myaddr.sin_addr = group_addr;
+#endif
+      myaddr.sin_port = htons(static_cast<u_short>(port));
+      if (bind(_sockfd, (sockaddr*)&myaddr, sizeof(sockaddr)) < 0)
+      {
+        throw SocketException("Error while binding socket!", errno);
+      }
+
+      struct ip_mreq mreq;
+      mreq.imr_multiaddr = group_addr;
+      mreq.imr_interface = interface_addr;
+      setOption(IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq), "Error while joining multicast group!");
+
+#ifdef IP_MULTICAST_ALL
+      // only receive the joined group, not all groups that other sockets of
+      // this host have joined on the same port
+      int off = 0;
+      setOption(IPPROTO_IP, IP_MULTICAST_ALL, &off, sizeof(off), "Error while setting IP_MULTICAST_ALL!");
+#endif
+    }
+    catch (...)
+    {
+#ifdef WIN32
+      closesocket(_sockfd);
+#else
+      close(_sockfd);
+#endif
+      throw;
+    }
+
+    registerMessageTypes();
+    setStreamName(stream);
+  }
+
+  void setOption(int level, int name, const void* value, std::size_t size, const char* error)
+  {
+    if (setsockopt(_sockfd, level, name, (const char*)value, static_cast<int>(size)) < 0)
+    {
+#ifdef WIN32
+      throw SocketException(error, WSAGetLastError());
+#else
+      throw SocketException(error, errno);
+#endif
+    }
+  }
+
+  static int64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+  }
+
+#ifndef WIN32
+  // receives the next datagram into the buffer and sets the receive time
+  int receiveWithTimestamp()
+  {
+    struct iovec iov;
+    iov.iov_base = _buffer;
+    iov.iov_len = sizeof(_buffer);
+
+    union
+    {
+      char buf[CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(sizeof(struct timeval))];
+      struct cmsghdr align;
+    } control;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    int msg_size = static_cast<int>(TEMP_FAILURE_RETRY(recvmsg(_sockfd, &msg, 0)));
+    if (msg_size < 0)
+    {
+      return msg_size;
+    }
+
+    receive_time_ = 0;
+    for (struct cmsghdr* c = CMSG_FIRSTHDR(&msg); c != NULL; c = CMSG_NXTHDR(&msg, c))
+    {
+#if defined(SO_TIMESTAMPNS)
+      if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPNS)
+      {
+        struct timespec ts;
+        memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+        receive_time_ = static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+      }
+#elif defined(SO_TIMESTAMP)
+      if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMP)
+      {
+        struct timeval tv;
+        memcpy(&tv, CMSG_DATA(c), sizeof(tv));
+        receive_time_ = static_cast<int64_t>(tv.tv_sec) * 1000000000 + static_cast<int64_t>(tv.tv_usec) * 1000;
+      }
+#endif
+    }
+
+    if (receive_time_ == 0)
+    {
+      receive_time_ = now();
+    }
+
+    return msg_size;
+  }
+#endif
+
+  void registerMessageTypes()
+  {
     // register all known protobuf message types
     _recv_func_map[roboception::msgs::Frame::descriptor()->name()] =
         std::bind(&DataReceiver::receive<roboception::msgs::Frame>, this);
@@ -294,6 +710,21 @@ protected:
 
   std::string ip_;
   unsigned int port_;
+  bool multicast_;
+  unsigned int timeout_ms_;
+  std::atomic<uint64_t> received_;
+
+  bool timestamps_;
+  int64_t receive_time_;
+
+  // every DECODE_SAMPLING-th message is measured, must be a power of two
+  static const uint64_t DECODE_SAMPLING = 16;
+
+  std::string stream_name_;
+  Counter* metric_messages_;
+  Counter* metric_bytes_;
+  Counter* metric_timeouts_;
+  Histogram* metric_decode_;
 };
 }
 }
@@ -0,0 +1,223 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_DATA_SENDER_H
+#define RC_DYNAMICS_API_DATA_SENDER_H
+
+#include <memory>
+#include <string>
+
+#ifdef WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netinet/in.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#endif
+
+#include <string.h>
+#include <errno.h>
+
+#include <google/protobuf/message.h>
+
+#include "net_utils.h"
+#include "socket_exception.h"
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * A simple sender object for streaming serialized messages via UDP to a
+ * destination, in the same way as rc_visard's rc_dynamics module does. It
+ * is the counterpart of DataReceiver, e.g. for replaying recordings.
+ */
+class DataSender
+{
+public:
+  using Ptr = std::shared_ptr<DataSender>;
+
+  /**
+   * Creates a data sender for the given destination.
+   *
+   * @param ip_address IP address of the destination
+   * @param port port number of the destination
+   * @return
+   */
+  static Ptr create(const std::string& ip_address, unsigned int port)
+  {
+    return Ptr(new DataSender(ip_address, port));
+  }
+
+  virtual ~DataSender()
+  {
+#ifdef WIN32
+    closesocket(_sockfd);
+#else
+    close(_sockfd);
+#endif
+  }
+
+  /**
+   * Returns IP address of the destination
+   */
+  std::string getIpAddress() const
+  {
+    return ip_;
+  }
+
+  /**
+   * Returns port of the destination
+   */
+  unsigned int getPort() const
+  {
+    return port_;
+  }
+
+  /**
+   * Sets the options for sending to a multicast group.
+   *
+   * @param interface_ip IP address of the network interface for sending, empty for the default
+   * @param loop true for also delivering the datagrams to receivers of the group on this host
+   * @param ttl number of routers that the datagrams may pass, 1 for the local network
+   */
+  void setMulticastOptions(const std::string& interface_ip, bool loop = true, unsigned int ttl = 1)
+  {
+    struct in_addr addr;
+    addr.s_addr = htonl(INADDR_ANY);
+    if (!interface_ip.empty())
+    {
+      if (!rc::isValidIPAddress(interface_ip))
+      {
+        throw std::invalid_argument("Given IP address is not a valid address: " + interface_ip);
+      }
+      addr.s_addr = inet_addr(interface_ip.c_str());
+    }
+
+#ifdef WIN32
+    DWORD loop_value = loop ? 1 : 0;
+    DWORD ttl_value = ttl;
+#else
+    unsigned char loop_value = loop ? 1 : 0;
+    unsigned char ttl_value = static_cast<unsigned char>(ttl);
+#endif
+
+    if (setsockopt(_sockfd, IPPROTO_IP, IP_MULTICAST_IF, (const char*)&addr, sizeof(addr)) < 0 ||
+        setsockopt(_sockfd, IPPROTO_IP, IP_MULTICAST_LOOP, (const char*)&loop_value, sizeof(loop_value)) < 0 ||
+        setsockopt(_sockfd, IPPROTO_IP, IP_MULTICAST_TTL, (const char*)&ttl_value, sizeof(ttl_value)) < 0)
+    {
+#ifdef WIN32
+      throw SocketException("Error while setting multicast options!", WSAGetLastError());
+#else
+      throw SocketException("Error while setting multicast options!", errno);
+#endif
+    }
+  }
+
+  /**
+   * Sends a serialized message as one datagram.
+   *
+   * @param data serialized message
+   * @param size size of the message in bytes
+   */
+  void send(const char* data, std::size_t size)
+  {
+#ifdef WIN32
+    int ret = sendto(_sockfd, data, static_cast<int>(size), 0, (const sockaddr*)&_dest, sizeof(_dest));
+    if (ret < 0)
+    {
+      throw SocketException("Error during socket sendto!", WSAGetLastError());
+    }
+#else
+    ssize_t ret = TEMP_FAILURE_RETRY(sendto(_sockfd, data, size, 0, (const sockaddr*)&_dest, sizeof(_dest)));
+    if (ret < 0)
+    {
+      throw SocketException("Error during socket sendto!", errno);
+    }
+#endif
+  }
+
+  /**
+   * Serializes and sends a protobuf message as one datagram.
+   *
+   * @param msg message to be sent
+   */
+  void send(const ::google::protobuf::Message& msg)
+  {
+    msg.SerializeToString(&_buffer);
+    send(_buffer.data(), _buffer.size());
+  }
+
+protected:
+  DataSender(const std::string& ip_address, unsigned int port) : ip_(ip_address), port_(port)
+  {
+    // check if given string is a valid IP address
+    if (!rc::isValidIPAddress(ip_address))
+    {
+      throw std::invalid_argument("Given IP address is not a valid address: " + ip_address);
+    }
+
+    // open socket for UDP sending
+    _sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef WIN32
+    if (_sockfd == INVALID_SOCKET)
+#else
+    if (_sockfd < 0)
+#endif
+    {
+      throw SocketException("Error while creating socket!", errno);
+    }
+
+    memset(&_dest, 0, sizeof(_dest));
+    _dest.sin_family = AF_INET;
+    _dest.sin_addr.s_addr = inet_addr(ip_address.c_str());
+    _dest.sin_port = htons(static_cast<u_short>(port));
+  }
+
+#ifdef WIN32
+  SOCKET _sockfd;
+#else
+  int _sockfd;
+#endif
+
+  struct sockaddr_in _dest;
+  std::string _buffer;
+
+  std::string ip_;
+  unsigned int port_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_DATA_SENDER_H
@@ -0,0 +1,332 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "imu_preintegration.h"
+#include "pose_timeline.h"
+
+#include <cmath>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+/// r = a * b for quaternions (x, y, z, w)
+void multiply(const double* a, const double* b, double* r)
+{
+  double x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+  double y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+  double z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+  double w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+  r[0] = x;
+  r[1] = y;
+  r[2] = z;
+  r[3] = w;
+}
+
+/// Rotates v by unit quaternion q, or by its inverse if inverse is true
+void rotate(const double* q, bool inverse, const double* v, double* out)
+{
+  double qx = inverse ? -q[0] : q[0];
+  double qy = inverse ? -q[1] : q[1];
+  double qz = inverse ? -q[2] : q[2];
+  double qw = q[3];
+
+  double tx = 2 * (qy * v[2] - qz * v[1]);
+  double ty = 2 * (qz * v[0] - qx * v[2]);
+  double tz = 2 * (qx * v[1] - qy * v[0]);
+
+  out[0] = v[0] + qw * tx + (qy * tz - qz * ty);
+  out[1] = v[1] + qw * ty + (qz * tx - qx * tz);
+  out[2] = v[2] + qw * tz + (qx * ty - qy * tx);
+}
+}
+
+ImuPreintegrator::ImuPreintegrator(std::size_t capacity) : nodes_(capacity < 2 ? 2 : capacity), start_(0), size_(0)
+{
+  for (int i = 0; i < 3; i++)
+  {
+    acc_bias_[i] = 0;
+    gyro_bias_[i] = 0;
+  }
+}
+
+void ImuPreintegrator::setBiases(const double acc_bias[3], const double gyro_bias[3])
+{
+  for (int i = 0; i < 3; i++)
+  {
+    acc_bias_[i] = acc_bias[i];
+    gyro_bias_[i] = gyro_bias[i];
+  }
+}
+
+void ImuPreintegrator::integrate(const Node& a, double dt, const double acc[3], const double gyro[3], Node& b)
+{
+  // rotation with the mean angular velocity of the step, using the exact
+  // quaternion exponential
+
+  double w[3], angle = 0;
+  for (int i = 0; i < 3; i++)
+  {
+    w[i] = 0.5 * (a.gyro[i] + gyro[i]);
+    angle += w[i] * w[i];
+  }
+  angle = std::sqrt(angle) * dt;
+
+  double dq[4];
+  double s = angle > 1e-12 ? std::sin(0.5 * angle) / angle * dt : 0.5 * dt;
+  dq[0] = w[0] * s;
+  dq[1] = w[1] * s;
+  dq[2] = w[2] * s;
+  dq[3] = std::cos(0.5 * angle);
+
+  multiply(a.q, dq, b.q);
+
+  double n = std::sqrt(b.q[0] * b.q[0] + b.q[1] * b.q[1] + b.q[2] * b.q[2] + b.q[3] * b.q[3]);
+  for (int i = 0; i < 4; i++)
+  {
+    b.q[i] /= n;
+  }
+
+  // velocity and position with the mean of the accelerations at the start
+  // and end of the step, rotated into the origin frame
+
+  double a0[3], a1[3];
+  rotate(a.q, false, a.acc, a0);
+  rotate(b.q, false, acc, a1);
+
+  for (int i = 0; i < 3; i++)
+  {
+    double am = 0.5 * (a0[i] + a1[i]);
+    b.v[i] = a.v[i] + am * dt;
+    b.p[i] = a.p[i] + a.v[i] * dt + 0.5 * am * dt * dt;
+    b.acc[i] = acc[i];
+    b.gyro[i] = gyro[i];
+  }
+}
+
+bool ImuPreintegrator::add(int64_t stamp, const double acc[3], const double gyro[3])
+{
+  if (size_ > 0 && stamp <= endTime())
+  {
+    return false;
+  }
+
+  double a[3], g[3];
+  for (int i = 0; i < 3; i++)
+  {
+    a[i] = acc[i] - acc_bias_[i];
+    g[i] = gyro[i] - gyro_bias_[i];
+  }
+
+  // determine slot, dropping the oldest sample if the buffer is full
+
+  std::size_t k;
+  bool wrapped = false;
+  if (size_ == nodes_.size())
+  {
+    k = start_;
+    start_ = index(1);
+    wrapped = start_ == 0;
+  }
+  else
+  {
+    k = index(size_++);
+  }
+
+  Node& node = nodes_[k];
+  if (size_ == 1)
+  {
+    // first sample defines the origin
+    node.stamp = stamp;
+    for (int i = 0; i < 3; i++)
+    {
+      node.acc[i] = a[i];
+      node.gyro[i] = g[i];
+      node.q[i] = 0;
+      node.v[i] = 0;
+      node.p[i] = 0;
+    }
+    node.q[3] = 1;
+  }
+  else
+  {
+    const Node& prev = nodes_[index(size_ - 2)];
+    integrate(prev, (stamp - prev.stamp) * 1e-9, a, g, node);
+    node.stamp = stamp;
+  }
+
+  // the ring has dropped a full buffer of samples since the last rebase
+
+  if (wrapped)
+  {
+    rebase();
+  }
+
+  return true;
+}
+
+void ImuPreintegrator::rebase()
+{
+  // same transformation as for deltas, i.e. deltas do not change
+
+  const Node origin = nodes_[start_];
+  const double q_inv[4] = { -origin.q[0], -origin.q[1], -origin.q[2], origin.q[3] };
+
+  for (std::size_t i = 0; i < size_; i++)
+  {
+    Node& node = nodes_[index(i)];
+    double dt = (node.stamp - origin.stamp) * 1e-9;
+
+    double dv[3], dp[3];
+    for (int k = 0; k < 3; k++)
+    {
+      dv[k] = node.v[k] - origin.v[k];
+      dp[k] = node.p[k] - origin.p[k] - origin.v[k] * dt;
+    }
+
+    multiply(q_inv, node.q, node.q);
+    rotate(origin.q, true, dv, node.v);
+    rotate(origin.q, true, dp, node.p);
+  }
+}
+
+bool ImuPreintegrator::add(const roboception::msgs::Imu& imu)
+{
+  double acc[3] = { imu.linear_acceleration().x(), imu.linear_acceleration().y(), imu.linear_acceleration().z() };
+  double gyro[3] = { imu.angular_velocity().x(), imu.angular_velocity().y(), imu.angular_velocity().z() };
+  return add(toNanoseconds(imu.timestamp()), acc, gyro);
+}
+
+void ImuPreintegrator::clear()
+{
+  start_ = 0;
+  size_ = 0;
+}
+
+void ImuPreintegrator::stateAt(int64_t stamp, Node& node) const
+{
+  // binary search for the last sample with time stamp <= stamp
+
+  std::size_t lo = 0, hi = size_ - 1;
+  if (nodes_[index(hi)].stamp <= stamp)
+  {
+    lo = hi;
+  }
+
+  while (hi - lo > 1)
+  {
+    std::size_t mid = lo + (hi - lo) / 2;
+    if (nodes_[index(mid)].stamp <= stamp)
+    {
+      lo = mid;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  const Node& a = nodes_[index(lo)];
+  if (a.stamp == stamp)
+  {
+    node = a;
+    return;
+  }
+
+  // integrate partial step with linearly interpolated measurements
+
+  const Node& b = nodes_[index(lo + 1)];
+  double f = static_cast<double>(stamp - a.stamp) / (b.stamp - a.stamp);
+
+  double acc[3], gyro[3];
+  for (int i = 0; i < 3; i++)
+  {
+    acc[i] = a.acc[i] + f * (b.acc[i] - a.acc[i]);
+    gyro[i] = a.gyro[i] + f * (b.gyro[i] - a.gyro[i]);
+  }
+
+  integrate(a, (stamp - a.stamp) * 1e-9, acc, gyro, node);
+  node.stamp = stamp;
+}
+
+bool ImuPreintegrator::delta(int64_t t0, int64_t t1, ImuDelta& delta) const
+{
+  if (size_ == 0 || t1 < t0 || t0 < startTime() || t1 > endTime())
+  {
+    return false;
+  }
+
+  Node s0, s1;
+  stateAt(t0, s0);
+  stateAt(t1, s1);
+
+  delta.t0 = t0;
+  delta.t1 = t1;
+  delta.dt = (t1 - t0) * 1e-9;
+
+  // dq = q0^-1 * q1
+
+  double q0_inv[4] = { -s0.q[0], -s0.q[1], -s0.q[2], s0.q[3] };
+  double dq[4];
+  multiply(q0_inv, s1.q, dq);
+  delta.qx = dq[0];
+  delta.qy = dq[1];
+  delta.qz = dq[2];
+  delta.qw = dq[3];
+
+  // dv = R0^T (v1 - v0), dp = R0^T (p1 - p0 - v0 dt)
+
+  double dv[3], dp[3];
+  for (int i = 0; i < 3; i++)
+  {
+    dv[i] = s1.v[i] - s0.v[i];
+    dp[i] = s1.p[i] - s0.p[i] - s0.v[i] * delta.dt;
+  }
+
+  double r[3];
+  rotate(s0.q, true, dv, r);
+  delta.vx = r[0];
+  delta.vy = r[1];
+  delta.vz = r[2];
+
+  rotate(s0.q, true, dp, r);
+  delta.px = r[0];
+  delta.py = r[1];
+  delta.pz = r[2];
+
+  return true;
+}
+}
+}
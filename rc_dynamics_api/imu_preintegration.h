@@ -0,0 +1,182 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_IMU_PREINTEGRATION_H
+#define RC_DYNAMICS_API_IMU_PREINTEGRATION_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+#include "roboception/msgs/imu.pb.h"
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Pre-integrated IMU measurements between two points in time t0 and t1,
+ * expressed in the IMU frame at t0. Gravity is not removed, i.e. the terms
+ * are the usual pre-integration terms that are independent of the
+ * (unknown) initial velocity and orientation w.r.t. gravity.
+ */
+struct ImuDelta
+{
+  int64_t t0, t1;          ///< time stamps in nanoseconds since epoch
+  double dt;               ///< t1 - t0 in seconds
+  double qx, qy, qz, qw;   ///< delta rotation
+  double vx, vy, vz;       ///< delta velocity
+  double px, py, pz;       ///< delta position
+};
+
+/**
+ * Streaming pre-integration of the 'imu' stream, e.g. for bridging the time
+ * between two poses of lower rate streams.
+ *
+ * Every added sample is integrated (midpoint rule for the rotation,
+ * trapezoidal rule for the acceleration) onto the state of the previous
+ * sample in O(1), and the cumulative state is kept in a ring buffer of fixed
+ * capacity. The delta between any two time stamps within the buffer can
+ * then be computed in O(log n) from the cumulative states at these time
+ * stamps, without re-integrating the samples in between.
+ *
+ * Since gravity is not removed, velocity and position of the cumulative
+ * state grow quadratically with the integrated time. For keeping the
+ * precision of deltas on long running streams, the cumulative state is
+ * rebased onto the oldest sample each time the ring has dropped as many
+ * samples as it can hold, which costs O(1) per sample on average.
+ *
+ * All memory is allocated on construction, so that adding samples and
+ * querying deltas does not allocate, e.g. on the receive thread.
+ *
+ * NOTE: An ImuPreintegrator is not thread-safe.
+ */
+class ImuPreintegrator
+{
+public:
+  /**
+   * @param capacity number of samples kept, e.g. 2000 for 10 s of the 200 Hz imu stream
+   */
+  explicit ImuPreintegrator(std::size_t capacity = 2000);
+
+  /**
+   * Sets the biases that are subtracted from subsequently added samples.
+   */
+  void setBiases(const double acc_bias[3], const double gyro_bias[3]);
+
+  /**
+   * Adds a sample. Samples must be added in order of increasing time stamps,
+   * older samples are ignored.
+   *
+   * @param stamp time stamp in nanoseconds since epoch
+   * @param acc linear acceleration in m/s^2
+   * @param gyro angular velocity in rad/s
+   * @return true if sample was added
+   */
+  bool add(int64_t stamp, const double acc[3], const double gyro[3]);
+
+  /// Adds a message of the 'imu' stream, see add(int64_t, const double*, const double*)
+  bool add(const roboception::msgs::Imu& imu);
+
+  /**
+   * Removes all samples, e.g. after a gap in the stream.
+   */
+  void clear();
+
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  /// Time stamp of the oldest sample. Must not be called if empty.
+  int64_t startTime() const
+  {
+    return nodes_[start_].stamp;
+  }
+
+  /// Time stamp of the latest sample. Must not be called if empty.
+  int64_t endTime() const
+  {
+    return nodes_[index(size_ - 1)].stamp;
+  }
+
+  /**
+   * Computes the pre-integrated delta between the given time stamps, which
+   * may lie between samples.
+   *
+   * @param t0 start time in nanoseconds since epoch
+   * @param t1 end time in nanoseconds since epoch, t1 >= t0
+   * @param delta pre-integrated delta (only valid if returned true)
+   * @return false if t0 or t1 are out of the time range of the buffered samples or t1 < t0
+   */
+  bool delta(int64_t t0, int64_t t1, ImuDelta& delta) const;
+
+protected:
+  /// Sample with cumulative state, integrated from the oldest sample of the last rebase
+  struct Node
+  {
+    int64_t stamp;
+    double acc[3], gyro[3];  // bias corrected measurements
+    double q[4];             // orientation (x, y, z, w)
+    double v[3], p[3];       // velocity and position in the origin frame
+  };
+
+  std::size_t index(std::size_t i) const
+  {
+    std::size_t k = start_ + i;
+    return k >= nodes_.size() ? k - nodes_.size() : k;
+  }
+
+  /// Integrates from node a over dt seconds with the measurements acc and gyro at the end of the step (without setting
+  /// the time stamp of b)
+  static void integrate(const Node& a, double dt, const double acc[3], const double gyro[3], Node& b);
+
+  /// Expresses the cumulative states relative to the state of the oldest sample
+  void rebase();
+
+  /// Computes the cumulative state at the given time stamp within the buffer
+  void stateAt(int64_t stamp, Node& node) const;
+
+  std::vector<Node> nodes_;
+  std::size_t start_, size_;
+  double acc_bias_[3], gyro_bias_[3];
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_IMU_PREINTEGRATION_H
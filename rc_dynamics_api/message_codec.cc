@@ -0,0 +1,818 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "message_codec.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+uint64_t toBits(double v)
+{
+  uint64_t ret;
+  std::memcpy(&ret, &v, sizeof(ret));
+  return ret;
+}
+
+double fromBits(uint64_t v)
+{
+  double ret;
+  std::memcpy(&ret, &v, sizeof(ret));
+  return ret;
+}
+
+#if defined(__GNUC__)
+inline int leadingZeros(uint64_t v)
+{
+  return __builtin_clzll(v);
+}
+
+inline int trailingZeros(uint64_t v)
+{
+  return __builtin_ctzll(v);
+}
+#else
+inline int leadingZeros(uint64_t v)
+{
+  int n = 0;
+  for (uint64_t mask = 1ull << 63; (v & mask) == 0; mask >>= 1)
+  {
+    n++;
+  }
+  return n;
+}
+
+inline int trailingZeros(uint64_t v)
+{
+  int n = 0;
+  for (; (v & 1) == 0; v >>= 1)
+  {
+    n++;
+  }
+  return n;
+}
+#endif
+
+inline uint64_t zigzag(int64_t v)
+{
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t unzigzag(uint64_t v)
+{
+  return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+/// Quantized values must be exactly representable and fit into the integer predictions
+const double max_quantized = 1e15;
+
+/// Maximum number of elements of repeated fields and bytes of strings, for detecting corrupted data
+const uint64_t max_size = 1 << 24;
+
+// reading and writing the protobuf wire format
+
+inline bool readVarint(const char*& p, const char* end, uint64_t& v)
+{
+  v = 0;
+  for (int shift = 0; p < end && shift < 64; shift += 7)
+  {
+    uint64_t b = static_cast<unsigned char>(*p++);
+    v |= (b & 0x7f) << shift;
+    if (b < 0x80)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline uint64_t loadLittleEndian(const char* p, int n)
+{
+  uint64_t v = 0;
+  for (int i = n - 1; i >= 0; i--)
+  {
+    v = (v << 8) | static_cast<unsigned char>(p[i]);
+  }
+  return v;
+}
+
+inline void writeVarint(std::string& data, uint64_t v)
+{
+  while (v >= 0x80)
+  {
+    data.push_back(static_cast<char>(v | 0x80));
+    v >>= 7;
+  }
+  data.push_back(static_cast<char>(v));
+}
+
+inline void writeLittleEndian(std::string& data, uint64_t v, int n)
+{
+  char b[8];
+  for (int i = 0; i < n; i++)
+  {
+    b[i] = static_cast<char>(v >> (8 * i));
+  }
+  data.append(b, n);
+}
+
+/**
+ * Writes the length of a length delimited field, for which one byte has
+ * been reserved at the given position.
+ */
+void writeLength(std::string& data, std::size_t pos)
+{
+  std::size_t len = data.size() - pos - 1;
+  if (len < 0x80)
+  {
+    data[pos] = static_cast<char>(len);
+  }
+  else
+  {
+    std::string v;
+    writeVarint(v, len);
+    data.replace(pos, 1, v);
+  }
+}
+
+inline int getWireType(int kind)
+{
+  static const int wire_types[] = { 0, 5, 1, 5, 1, 2, 2 };
+  return wire_types[kind];
+}
+}
+
+void BitReader::refillTail()
+{
+  if (data_ == end_)
+  {
+    throw std::runtime_error("Unexpected end of compressed data");
+  }
+
+  acc_ = 0;
+  bits_ = 0;
+  while (data_ != end_)
+  {
+    acc_ = (acc_ << 8) | static_cast<unsigned char>(*data_++);
+    bits_ += 8;
+  }
+}
+
+void MessageCodec::IntState::encode(BitWriter& out, int64_t v)
+{
+  out.writeUInt(zigzag(static_cast<int64_t>(static_cast<uint64_t>(v) - static_cast<uint64_t>(predict()))));
+  update(v);
+}
+
+int64_t MessageCodec::IntState::decode(BitReader& in)
+{
+  int64_t v = static_cast<int64_t>(static_cast<uint64_t>(unzigzag(in.readUInt())) + static_cast<uint64_t>(predict()));
+  update(v);
+  return v;
+}
+
+uint64_t MessageCodec::FloatState::predict() const
+{
+  if (n == 2)
+  {
+    double v = fromBits(v1);
+    double p = v + (v - fromBits(v0));
+    if (std::isfinite(p))
+    {
+      return toBits(p);
+    }
+  }
+
+  return n == 0 ? 0 : v1;
+}
+
+void MessageCodec::FloatState::encode(BitWriter& out, double v, double step)
+{
+  if (step > 0)
+  {
+    // quantized values, with escape for values that cannot be quantized
+
+    double s = v / step;
+    if (std::fabs(s) < max_quantized)
+    {
+      out.writeBit(false);
+      q.encode(out, static_cast<int64_t>(std::llround(s)));
+    }
+    else
+    {
+      out.writeBit(true);
+      out.write(toBits(v), 64);
+      q.n = 0;
+    }
+    return;
+  }
+
+  uint64_t bits = toBits(v);
+  uint64_t x = bits ^ predict();
+  v0 = v1;
+  v1 = bits;
+  n += (n < 2);
+
+  if (x == 0)
+  {
+    out.writeBit(false);
+    return;
+  }
+
+  int lz = std::min(leadingZeros(x), 31);
+  int tz = trailingZeros(x);
+  if (leading >= 0 && lz >= leading && tz >= trailing)
+  {
+    // meaningful bits fit into the window of the previous value
+    out.write(0x2, 2);
+    out.write(x >> trailing, 64 - leading - trailing);
+  }
+  else
+  {
+    int len = 64 - lz - tz;
+    out.write((0x3 << 11) | (lz << 6) | (len - 1), 13);
+    out.write(x >> tz, len);
+    leading = lz;
+    trailing = tz;
+  }
+}
+
+double MessageCodec::FloatState::decode(BitReader& in, double step)
+{
+  if (step > 0)
+  {
+    if (!in.readBit())
+    {
+      return static_cast<double>(q.decode(in)) * step;
+    }
+
+    q.n = 0;
+    return fromBits(in.read(64));
+  }
+
+  uint64_t x = 0;
+  if (in.readBit())
+  {
+    if (in.readBit())
+    {
+      uint64_t h = in.read(11);
+      leading = static_cast<int>(h >> 6);
+      int len = static_cast<int>(h & 0x3f) + 1;
+      trailing = 64 - leading - len;
+      if (trailing < 0)
+      {
+        throw std::runtime_error("Invalid compressed data");
+      }
+      x = in.read(len) << trailing;
+    }
+    else
+    {
+      if (leading < 0)
+      {
+        throw std::runtime_error("Invalid compressed data");
+      }
+      x = in.read(64 - leading - trailing) << trailing;
+    }
+  }
+
+  uint64_t bits = x ^ predict();
+  v0 = v1;
+  v1 = bits;
+  n += (n < 2);
+  return fromBits(bits);
+}
+
+MessageCodec::MessageCodec(const ::google::protobuf::Descriptor* type, double tolerance)
+  : type_(type), tolerance_(tolerance), step_(2 * tolerance), data_(0)
+{
+  if (!type)
+  {
+    throw std::invalid_argument("Message type of codec must be given");
+  }
+
+  if (!(tolerance >= 0))
+  {
+    throw std::invalid_argument("Tolerance of codec must not be negative");
+  }
+
+  root_.number = 0;
+  root_.kind = MESSAGE;
+  root_.repeated = false;
+  root_.packed = false;
+  compile(type, root_);
+  reset();
+}
+
+void MessageCodec::compile(const ::google::protobuf::Descriptor* type, Op& op)
+{
+  using namespace ::google::protobuf;
+
+  for (int i = 0; i < type->field_count(); i++)
+  {
+    const FieldDescriptor* field = type->field(i);
+
+    Op child;
+    child.number = static_cast<uint32_t>(field->number());
+    child.repeated = field->is_repeated();
+    child.packed = field->is_packed();
+
+    switch (field->type())
+    {
+      case FieldDescriptor::TYPE_DOUBLE:
+        child.kind = DOUBLE;
+        break;
+      case FieldDescriptor::TYPE_FLOAT:
+        child.kind = FLOAT;
+        break;
+      case FieldDescriptor::TYPE_FIXED64:
+      case FieldDescriptor::TYPE_SFIXED64:
+        child.kind = FIXED64;
+        break;
+      case FieldDescriptor::TYPE_FIXED32:
+      case FieldDescriptor::TYPE_SFIXED32:
+        child.kind = FIXED32;
+        break;
+      case FieldDescriptor::TYPE_STRING:
+      case FieldDescriptor::TYPE_BYTES:
+        child.kind = BYTES;
+        break;
+      case FieldDescriptor::TYPE_MESSAGE:
+        child.kind = MESSAGE;
+        for (const Descriptor* t = type; t; t = t->containing_type())
+        {
+          if (t == field->message_type())
+          {
+            throw std::invalid_argument("Recursive message types are not supported by codec: " + t->full_name());
+          }
+        }
+        compile(field->message_type(), child);
+        break;
+      case FieldDescriptor::TYPE_GROUP:
+        throw std::invalid_argument("Groups are not supported by codec: " + field->full_name());
+      default:
+        child.kind = VARINT;
+        break;
+    }
+
+    op.children.push_back(std::move(child));
+  }
+
+  std::sort(op.children.begin(), op.children.end(),
+            [](const Op& a, const Op& b) { return a.number < b.number; });
+  op.presence.resize(op.children.size());
+}
+
+void MessageCodec::reset()
+{
+  reset(root_);
+}
+
+void MessageCodec::reset(Op& op)
+{
+  op.size.n = 0;
+  op.values.clear();
+  std::fill(op.presence.begin(), op.presence.end(), 0);
+  for (auto&& child : op.children)
+  {
+    reset(child);
+  }
+}
+
+MessageCodec::Value& MessageCodec::getValue(Op& op, std::size_t index)
+{
+  if (index >= op.values.size())
+  {
+    Value value;
+    value.i.n = 0;
+    value.f.n = 0;
+    value.f.leading = -1;
+    value.f.trailing = 0;
+    value.f.q.n = 0;
+    op.values.resize(index + 1, value);
+  }
+  return op.values[index];
+}
+
+bool MessageCodec::prepare(const char* data, std::size_t size)
+{
+  data_ = data;
+  tokens_.clear();
+  return scan(data, data + size, root_);
+}
+
+bool MessageCodec::scan(const char* p, const char* end, const Op& node)
+{
+  // one token per field with the number of elements, followed by the values
+
+  const std::vector<Op>& ops = node.children;
+  std::size_t header = tokens_.size();
+  tokens_.resize(header + ops.size(), 0);
+
+  std::size_t i = 0;
+  while (p < end)
+  {
+    uint64_t tag;
+    if (!readVarint(p, end, tag))
+    {
+      return false;
+    }
+
+    // fields must be ordered by their number
+
+    uint64_t number = tag >> 3;
+    while (i < ops.size() && ops[i].number < number)
+    {
+      i++;
+    }
+
+    if (i == ops.size() || ops[i].number != number)
+    {
+      return false;
+    }
+
+    const Op& op = ops[i];
+    if (op.packed)
+    {
+      uint64_t len;
+      if ((tag & 7) != 2 || tokens_[header + i] != 0 || !readVarint(p, end, len) ||
+          len > static_cast<uint64_t>(end - p) || len == 0)
+      {
+        return false;
+      }
+
+      const char* e = p + len;
+      uint64_t count = 0;
+      while (p < e)
+      {
+        if (!scanValue(p, e, op))
+        {
+          return false;
+        }
+        count++;
+      }
+      tokens_[header + i] = count;
+    }
+    else
+    {
+      if (static_cast<int>(tag & 7) != getWireType(op.kind) || (!op.repeated && tokens_[header + i] != 0) ||
+          !scanValue(p, end, op))
+      {
+        return false;
+      }
+      tokens_[header + i]++;
+    }
+  }
+
+  return true;
+}
+
+bool MessageCodec::scanValue(const char*& p, const char* end, const Op& op)
+{
+  uint64_t v;
+  switch (op.kind)
+  {
+    case VARINT:
+      if (!readVarint(p, end, v))
+      {
+        return false;
+      }
+      tokens_.push_back(v);
+      return true;
+    case FIXED32:
+    case FLOAT:
+      if (end - p < 4)
+      {
+        return false;
+      }
+      v = loadLittleEndian(p, 4);
+      p += 4;
+
+      // NaNs of floats may change by converting them to double
+      if (op.kind == FLOAT && (v & 0x7f800000) == 0x7f800000 && (v & 0x7fffff) != 0)
+      {
+        return false;
+      }
+      tokens_.push_back(v);
+      return true;
+    case FIXED64:
+    case DOUBLE:
+      if (end - p < 8)
+      {
+        return false;
+      }
+      tokens_.push_back(loadLittleEndian(p, 8));
+      p += 8;
+      return true;
+    case BYTES:
+    case MESSAGE:
+    {
+      if (!readVarint(p, end, v) || v > static_cast<uint64_t>(end - p))
+      {
+        return false;
+      }
+
+      const char* e = p + v;
+      if (op.kind == BYTES)
+      {
+        tokens_.push_back(static_cast<uint64_t>(p - data_));
+        tokens_.push_back(v);
+      }
+      else if (!scan(p, e, op))
+      {
+        return false;
+      }
+      p = e;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void MessageCodec::encode(BitWriter& out)
+{
+  std::size_t pos = 0;
+  encode(out, root_, pos);
+}
+
+void MessageCodec::encode(BitWriter& out, const ::google::protobuf::Message& m)
+{
+  if (m.GetDescriptor() != type_)
+  {
+    throw std::invalid_argument("Message type " + m.GetDescriptor()->full_name() + " does not match codec for " +
+                                type_->full_name());
+  }
+
+  m.SerializeToString(&buffer_);
+  if (!encode(out, buffer_.data(), buffer_.size()))
+  {
+    throw std::invalid_argument("Message of type " + type_->full_name() + " cannot be encoded");
+  }
+}
+
+void MessageCodec::encode(BitWriter& out, Op& node, std::size_t& pos)
+{
+  std::vector<Op>& ops = node.children;
+  std::size_t header = pos;
+  pos += ops.size();
+
+  // present fields, usually the same as in the preceding message
+
+  bool same = true;
+  for (std::size_t i = 0; i < ops.size(); i++)
+  {
+    same = same && (ops[i].repeated || node.presence[i] == (tokens_[header + i] != 0));
+  }
+
+  out.writeBit(!same);
+  if (!same)
+  {
+    for (std::size_t i = 0; i < ops.size(); i++)
+    {
+      if (!ops[i].repeated)
+      {
+        node.presence[i] = (tokens_[header + i] != 0);
+        out.writeBit(node.presence[i] != 0);
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < ops.size(); i++)
+  {
+    if (ops[i].repeated)
+    {
+      ops[i].size.encode(out, static_cast<int64_t>(tokens_[header + i]));
+    }
+  }
+
+  // values of all fields
+
+  for (std::size_t i = 0; i < ops.size(); i++)
+  {
+    uint64_t count = tokens_[header + i];
+    for (std::size_t k = 0; k < count; k++)
+    {
+      encodeValue(out, ops[i], k, pos);
+    }
+  }
+}
+
+void MessageCodec::encodeValue(BitWriter& out, Op& op, std::size_t index, std::size_t& pos)
+{
+  Value& value = getValue(op, index);
+  switch (op.kind)
+  {
+    case VARINT:
+    case FIXED32:
+    case FIXED64:
+      value.i.encode(out, static_cast<int64_t>(tokens_[pos++]));
+      break;
+    case FLOAT:
+    {
+      uint32_t bits = static_cast<uint32_t>(tokens_[pos++]);
+      float f;
+      std::memcpy(&f, &bits, sizeof(f));
+      value.f.encode(out, f, step_);
+      break;
+    }
+    case DOUBLE:
+      value.f.encode(out, fromBits(tokens_[pos++]), step_);
+      break;
+    case BYTES:
+    {
+      const char* s = data_ + tokens_[pos];
+      std::size_t len = static_cast<std::size_t>(tokens_[pos + 1]);
+      pos += 2;
+
+      if (len == value.s.size() && value.s.compare(0, len, s, len) == 0)
+      {
+        out.writeBit(false);
+      }
+      else
+      {
+        out.writeBit(true);
+        out.writeUInt(len);
+        out.writeBytes(s, len);
+        value.s.assign(s, len);
+      }
+      break;
+    }
+    case MESSAGE:
+      encode(out, op, pos);
+      break;
+  }
+}
+
+void MessageCodec::decode(BitReader& in, std::string& data)
+{
+  data.clear();
+  counts_.clear();
+  decode(in, root_, data);
+}
+
+void MessageCodec::decode(BitReader& in, ::google::protobuf::Message& m)
+{
+  if (m.GetDescriptor() != type_)
+  {
+    throw std::invalid_argument("Message type " + m.GetDescriptor()->full_name() + " does not match codec for " +
+                                type_->full_name());
+  }
+
+  decode(in, buffer_);
+  if (!m.ParseFromString(buffer_))
+  {
+    throw std::runtime_error("Invalid compressed data");
+  }
+}
+
+void MessageCodec::decode(BitReader& in, Op& node, std::string& data)
+{
+  std::vector<Op>& ops = node.children;
+
+  if (in.readBit())
+  {
+    for (std::size_t i = 0; i < ops.size(); i++)
+    {
+      if (!ops[i].repeated)
+      {
+        node.presence[i] = in.readBit();
+      }
+    }
+  }
+
+  std::size_t base = counts_.size();
+  counts_.resize(base + ops.size());
+  for (std::size_t i = 0; i < ops.size(); i++)
+  {
+    uint64_t count = ops[i].repeated ? static_cast<uint64_t>(ops[i].size.decode(in)) : node.presence[i];
+    if (count > max_size)
+    {
+      throw std::runtime_error("Invalid compressed data");
+    }
+    counts_[base + i] = count;
+  }
+
+  for (std::size_t i = 0; i < ops.size(); i++)
+  {
+    Op& op = ops[i];
+    uint64_t count = counts_[base + i];
+    if (count == 0)
+    {
+      continue;
+    }
+
+    if (op.packed)
+    {
+      writeVarint(data, (static_cast<uint64_t>(op.number) << 3) | 2);
+      std::size_t start = data.size();
+      data.push_back(0);
+      for (std::size_t k = 0; k < count; k++)
+      {
+        decodeValue(in, op, k, data);
+      }
+      writeLength(data, start);
+    }
+    else
+    {
+      uint64_t tag = (static_cast<uint64_t>(op.number) << 3) | static_cast<uint64_t>(getWireType(op.kind));
+      for (std::size_t k = 0; k < count; k++)
+      {
+        writeVarint(data, tag);
+        decodeValue(in, op, k, data);
+      }
+    }
+  }
+
+  counts_.resize(base);
+}
+
+void MessageCodec::decodeValue(BitReader& in, Op& op, std::size_t index, std::string& data)
+{
+  Value& value = getValue(op, index);
+  switch (op.kind)
+  {
+    case VARINT:
+      writeVarint(data, static_cast<uint64_t>(value.i.decode(in)));
+      break;
+    case FIXED32:
+      writeLittleEndian(data, static_cast<uint64_t>(value.i.decode(in)), 4);
+      break;
+    case FIXED64:
+      writeLittleEndian(data, static_cast<uint64_t>(value.i.decode(in)), 8);
+      break;
+    case FLOAT:
+    {
+      float f = static_cast<float>(value.f.decode(in, step_));
+      uint32_t bits;
+      std::memcpy(&bits, &f, sizeof(bits));
+      writeLittleEndian(data, bits, 4);
+      break;
+    }
+    case DOUBLE:
+      writeLittleEndian(data, toBits(value.f.decode(in, step_)), 8);
+      break;
+    case BYTES:
+    {
+      if (in.readBit())
+      {
+        uint64_t len = in.readUInt();
+        if (len > max_size)
+        {
+          throw std::runtime_error("Invalid compressed data");
+        }
+
+        value.s.resize(static_cast<std::size_t>(len));
+        in.readBytes(&value.s[0], value.s.size());
+      }
+      writeVarint(data, value.s.size());
+      data.append(value.s);
+      break;
+    }
+    case MESSAGE:
+    {
+      std::size_t start = data.size();
+      data.push_back(0);
+      decode(in, op, data);
+      writeLength(data, start);
+      break;
+    }
+  }
+}
+}
+}
@@ -0,0 +1,504 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_MESSAGE_CODEC_H
+#define RC_DYNAMICS_API_MESSAGE_CODEC_H
+
+#include <google/protobuf/message.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Appends values with an arbitrary number of bits to a byte buffer, most
+ * significant bit first.
+ */
+class BitWriter
+{
+public:
+  BitWriter() : size_(0), acc_(0), bits_(0)
+  {
+  }
+
+  /**
+   * Appends the lowest n bits of a value.
+   *
+   * @param v value
+   * @param n number of bits, between 1 and 64
+   */
+  void write(uint64_t v, int n)
+  {
+    if (n < 64)
+    {
+      v &= (1ull << n) - 1;
+    }
+
+    if (n < 64 - bits_)
+    {
+      acc_ = (acc_ << n) | v;
+      bits_ += n;
+    }
+    else
+    {
+      // fill up the accumulator and continue with the remaining bits
+      int rest = n - (64 - bits_);
+      acc_ = (bits_ == 0 ? 0 : acc_ << (64 - bits_)) | (v >> rest);
+      writeWord();
+      acc_ = rest > 0 ? v & ((1ull << rest) - 1) : 0;
+      bits_ = rest;
+    }
+  }
+
+  /// Appends a single bit
+  void writeBit(bool b)
+  {
+    write(b ? 1 : 0, 1);
+  }
+
+  /// Appends an unsigned integer in 1, 10, 19, 36 or 68 bits, depending on its magnitude
+  void writeUInt(uint64_t v)
+  {
+    if (v == 0)
+    {
+      writeBit(false);
+    }
+    else if (v < (1ull << 8))
+    {
+      write(0x200 | v, 10);
+    }
+    else if (v < (1ull << 16))
+    {
+      write(0x60000 | v, 19);
+    }
+    else if (v < (1ull << 32))
+    {
+      write(0xe, 4);
+      write(v, 32);
+    }
+    else
+    {
+      write(0xf, 4);
+      write(v, 64);
+    }
+  }
+
+  /// Appends bytes
+  void writeBytes(const char* data, std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; i++)
+    {
+      write(static_cast<unsigned char>(data[i]), 8);
+    }
+  }
+
+  /// Pads the written bits with zeros to the next byte boundary
+  void finish()
+  {
+    while (bits_ > 0)
+    {
+      int n = bits_ >= 8 ? 8 : bits_;
+      reserve(1);
+      data_[size_++] = static_cast<char>((acc_ >> (bits_ - n)) << (8 - n));
+      bits_ -= n;
+    }
+    acc_ = 0;
+  }
+
+  /// Returns the written bytes, without the bits that have not been finished
+  const char* getData() const
+  {
+    return data_.data();
+  }
+
+  /// Returns the number of written bytes, without the bits that have not been finished
+  std::size_t getSize() const
+  {
+    return size_;
+  }
+
+  /// Removes all written data
+  void clear()
+  {
+    size_ = 0;
+    acc_ = 0;
+    bits_ = 0;
+  }
+
+private:
+  void reserve(std::size_t n)
+  {
+    if (size_ + n > data_.size())
+    {
+      data_.resize(std::max<std::size_t>(2 * data_.size(), 4096));
+    }
+  }
+
+  void writeWord()
+  {
+    reserve(8);
+    char* p = &data_[size_];
+    for (int i = 0; i < 8; i++)
+    {
+      p[i] = static_cast<char>(acc_ >> (56 - 8 * i));
+    }
+    size_ += 8;
+  }
+
+  std::vector<char> data_;
+  std::size_t size_;  // number of bytes in data_
+  uint64_t acc_;      // bits that are not yet appended to data_
+  int bits_;          // number of bits in acc_
+};
+
+/**
+ * Reads values with an arbitrary number of bits from bytes that have been
+ * written by a BitWriter.
+ */
+class BitReader
+{
+public:
+  BitReader(const char* data, std::size_t size) : data_(data), end_(data + size), acc_(0), bits_(0)
+  {
+  }
+
+  /**
+   * Reads n bits.
+   *
+   * @param n number of bits, between 1 and 64
+   * @return value
+   */
+  uint64_t read(int n)
+  {
+    if (n <= bits_)
+    {
+      bits_ -= n;
+      return n == 64 ? acc_ : (acc_ >> bits_) & ((1ull << n) - 1);
+    }
+
+    // take the remaining bits and continue with the next bytes
+    int k = bits_;
+    uint64_t ret = k > 0 ? acc_ & ((1ull << k) - 1) : 0;
+    refill();
+    return k > 0 ? (ret << (n - k)) | read(n - k) : read(n);
+  }
+
+  /// Reads a single bit
+  bool readBit()
+  {
+    if (bits_ == 0)
+    {
+      refill();
+    }
+    bits_--;
+    return ((acc_ >> bits_) & 1) != 0;
+  }
+
+  /// Reads an unsigned integer that has been written by BitWriter::writeUInt()
+  uint64_t readUInt()
+  {
+    if (!readBit())
+    {
+      return 0;
+    }
+    if (!readBit())
+    {
+      return read(8);
+    }
+    if (!readBit())
+    {
+      return read(16);
+    }
+    if (!readBit())
+    {
+      return read(32);
+    }
+    return read(64);
+  }
+
+  /// Reads bytes
+  void readBytes(char* data, std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; i++)
+    {
+      data[i] = static_cast<char>(read(8));
+    }
+  }
+
+private:
+  void refill()
+  {
+    if (end_ - data_ >= 8)
+    {
+      acc_ = 0;
+      for (int i = 0; i < 8; i++)
+      {
+        acc_ = (acc_ << 8) | static_cast<unsigned char>(data_[i]);
+      }
+      data_ += 8;
+      bits_ = 64;
+    }
+    else
+    {
+      refillTail();
+    }
+  }
+
+  void refillTail();
+
+  const char* data_;
+  const char* end_;
+  uint64_t acc_;
+  int bits_;  // number of unread bits in acc_
+};
+
+/**
+ * Domain specific compression of a sequence of protobuf messages of the same
+ * type, e.g. the messages of one data stream.
+ *
+ * The fields of all messages are compressed separately, by predicting the
+ * value of a field from its values in the preceding messages and storing
+ * only the difference in a variable number of bits:
+ *
+ * - integers (e.g. the seconds and nanoseconds of time stamps) are
+ *   predicted linearly from the last two values, so that regular time
+ *   stamps or constant values cost a single bit,
+ * - floating point values are stored as XOR with the linear prediction,
+ *   omitting the leading and trailing zero bits (as in Facebook's Gorilla),
+ *   which is lossless,
+ * - optionally, floating point values are quantized with a given tolerance
+ *   and then compressed like integers, which is lossy, but compresses much
+ *   stronger,
+ * - strings (e.g. frame names) and the set of present fields cost a single
+ *   bit if they are unchanged.
+ *
+ * Messages are encoded directly from and decoded directly to their
+ * serialized form, without parsing them into protobuf messages. Messages
+ * that are not serialized in the canonical way, i.e. with unknown fields
+ * or fields that are not ordered by their number, cannot be encoded.
+ *
+ * Encoding and decoding is streamable: messages are encoded one after the
+ * other and decoding must process them in the same order with a
+ * MessageCodec that has been created with the same parameters. reset()
+ * forgets the preceding messages, e.g. for starting an independently
+ * decodable block of messages.
+ *
+ * NOTE: A MessageCodec is not thread-safe.
+ */
+class MessageCodec
+{
+public:
+  /**
+   * Creates a codec for messages of the given type.
+   *
+   * @param type protobuf message type
+   * @param tolerance maximum error of floating point values, 0 for lossless compression
+   */
+  MessageCodec(const ::google::protobuf::Descriptor* type, double tolerance = 0);
+
+  /// Returns the protobuf message type
+  const ::google::protobuf::Descriptor* getType() const
+  {
+    return type_;
+  }
+
+  /// Returns the maximum error of floating point values
+  double getTolerance() const
+  {
+    return tolerance_;
+  }
+
+  /**
+   * Checks that a serialized message can be encoded and prepares encoding
+   * it with encode().
+   *
+   * @param data serialized message
+   * @param size size of the serialized message
+   * @return false if the message cannot be encoded
+   */
+  bool prepare(const char* data, std::size_t size);
+
+  /**
+   * Encodes the message of the last successful call of prepare().
+   *
+   * @param out output
+   */
+  void encode(BitWriter& out);
+
+  /**
+   * Encodes a serialized message.
+   *
+   * @param out output
+   * @param data serialized message
+   * @param size size of the serialized message
+   * @return false if the message cannot be encoded, in which case nothing is written
+   */
+  bool encode(BitWriter& out, const char* data, std::size_t size)
+  {
+    if (!prepare(data, size))
+    {
+      return false;
+    }
+    encode(out);
+    return true;
+  }
+
+  /**
+   * Encodes a message.
+   *
+   * @param out output
+   * @param m message of the type given to the constructor
+   */
+  void encode(BitWriter& out, const ::google::protobuf::Message& m);
+
+  /**
+   * Decodes a message into its serialized form.
+   *
+   * @param in input
+   * @param data serialized message, replaces the previous content
+   */
+  void decode(BitReader& in, std::string& data);
+
+  /**
+   * Decodes a message.
+   *
+   * @param in input
+   * @param m message of the type given to the constructor
+   */
+  void decode(BitReader& in, ::google::protobuf::Message& m);
+
+  /// Forgets all preceding messages
+  void reset();
+
+  /// Encodes an integer as difference to the linear prediction from the last two values
+  struct IntState
+  {
+    int64_t v1, v0;  // last two values
+    int n;           // number of valid values, at most 2
+
+    void encode(BitWriter& out, int64_t v);
+    int64_t decode(BitReader& in);
+
+    int64_t predict() const
+    {
+      // computed with unsigned integers, because overflow is well defined for them
+      return n == 0 ? 0 : n == 1 ? v1 : static_cast<int64_t>(2 * static_cast<uint64_t>(v1) - static_cast<uint64_t>(v0));
+    }
+
+    void update(int64_t v)
+    {
+      v0 = v1;
+      v1 = v;
+      n += (n < 2);
+    }
+  };
+
+protected:
+  /// Encodes a floating point value losslessly or quantized
+  struct FloatState
+  {
+    uint64_t v1, v0;  // bit patterns of the last two values
+    int n;            // number of valid values, at most 2
+    int leading;      // number of leading zeros of the last stored XOR value, -1 if there is none
+    int trailing;     // number of trailing zeros of the last stored XOR value
+    IntState q;       // state of quantized values
+
+    void encode(BitWriter& out, double v, double step);
+    double decode(BitReader& in, double step);
+    uint64_t predict() const;
+  };
+
+  struct Value
+  {
+    IntState i;
+    FloatState f;
+    std::string s;
+  };
+
+  /// Encoding of a field in serialized messages
+  enum Kind
+  {
+    VARINT,
+    FIXED32,
+    FIXED64,
+    FLOAT,
+    DOUBLE,
+    BYTES,
+    MESSAGE
+  };
+
+  struct Op
+  {
+    uint32_t number;  // field number
+    Kind kind;
+    bool repeated;
+    bool packed;
+    std::vector<Op> children;    // fields of messages, ordered by number
+    std::vector<char> presence;  // presence of the children in the last message
+    IntState size;               // number of elements of repeated fields
+    std::vector<Value> values;   // state of the field, per element for repeated fields
+  };
+
+  static void compile(const ::google::protobuf::Descriptor* type, Op& op);
+  static void reset(Op& op);
+  static Value& getValue(Op& op, std::size_t index);
+
+  bool scan(const char* p, const char* end, const Op& node);
+  bool scanValue(const char*& p, const char* end, const Op& op);
+  void encode(BitWriter& out, Op& node, std::size_t& pos);
+  void encodeValue(BitWriter& out, Op& op, std::size_t index, std::size_t& pos);
+  void decode(BitReader& in, Op& node, std::string& data);
+  void decodeValue(BitReader& in, Op& op, std::size_t index, std::string& data);
+
+  const ::google::protobuf::Descriptor* type_;
+  double tolerance_;
+  double step_;  // quantization step, 0 for lossless compression
+  Op root_;
+
+  const char* data_;             // serialized message of prepare()
+  std::vector<uint64_t> tokens_;  // fields of the message of prepare() in the order of encoding
+  std::vector<uint64_t> counts_;  // number of elements of the fields during decoding
+  std::string buffer_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_MESSAGE_CODEC_H
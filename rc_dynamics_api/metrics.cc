@@ -0,0 +1,469 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "metrics.h"
+#include "json.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+uint64_t toBits(double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double fromBits(uint64_t bits)
+{
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void atomicAdd(std::atomic<uint64_t>& bits, double value)
+{
+  uint64_t current = bits.load(std::memory_order_relaxed);
+  while (!bits.compare_exchange_weak(current, toBits(fromBits(current) + value), std::memory_order_relaxed))
+  {
+  }
+}
+
+bool isValidName(const std::string& name, bool colon)
+{
+  if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+  {
+    return false;
+  }
+
+  for (char c : name)
+  {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && !(colon && c == ':'))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::string formatValue(double value)
+{
+  if (std::isnan(value))
+  {
+    return "NaN";
+  }
+
+  if (std::isinf(value))
+  {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+
+  char tmp[32];
+  std::snprintf(tmp, sizeof(tmp), "%.10g", value);
+  return tmp;
+}
+
+std::string escape(const std::string& s, bool quote)
+{
+  std::string ret;
+  ret.reserve(s.size());
+  for (char c : s)
+  {
+    if (c == '\\')
+    {
+      ret += "\\\\";
+    }
+    else if (c == '\n')
+    {
+      ret += "\\n";
+    }
+    else if (quote && c == '"')
+    {
+      ret += "\\\"";
+    }
+    else
+    {
+      ret += c;
+    }
+  }
+
+  return ret;
+}
+
+// writes the labels in braces, with an optional additional label, e.g. le of histograms
+void writeLabels(std::ostream& out, const MetricsRegistry::Labels& labels, const std::string& name = "",
+                 const std::string& value = "")
+{
+  if (labels.empty() && name.empty())
+  {
+    return;
+  }
+
+  out << '{';
+  const char* sep = "";
+  for (auto&& l : labels)
+  {
+    out << sep << l.first << "=\"" << escape(l.second, true) << '"';
+    sep = ",";
+  }
+
+  if (!name.empty())
+  {
+    out << sep << name << "=\"" << value << '"';
+  }
+  out << '}';
+}
+
+// JSON cannot represent infinity, which is written as string like in the text format
+nlohmann::json toJsonValue(double value)
+{
+  if (std::isfinite(value))
+  {
+    return value;
+  }
+  return formatValue(value);
+}
+}
+
+Gauge::Gauge() : bits_(toBits(0))
+{
+}
+
+void Gauge::set(double value)
+{
+  bits_.store(toBits(value), std::memory_order_relaxed);
+}
+
+void Gauge::add(double value)
+{
+  atomicAdd(bits_, value);
+}
+
+double Gauge::get() const
+{
+  return fromBits(bits_.load(std::memory_order_relaxed));
+}
+
+std::vector<double> Histogram::exponentialBounds(double start, double factor, std::size_t count)
+{
+  if (start <= 0 || factor <= 1)
+  {
+    throw std::invalid_argument("Exponential histogram bounds require start > 0 and factor > 1");
+  }
+
+  std::vector<double> bounds;
+  for (std::size_t i = 0; i < count; i++)
+  {
+    bounds.push_back(start);
+    start *= factor;
+  }
+
+  return bounds;
+}
+
+Histogram::Histogram(const std::vector<double>& bounds)
+  : bounds_(bounds), counts_(new std::atomic<uint64_t>[bounds.size() + 1]), sum_bits_(toBits(0))
+{
+  for (std::size_t i = 1; i < bounds_.size(); i++)
+  {
+    if (!(bounds_[i - 1] < bounds_[i]))
+    {
+      throw std::invalid_argument("Histogram bounds must be in ascending order");
+    }
+  }
+
+  for (std::size_t i = 0; i <= bounds_.size(); i++)
+  {
+    counts_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::observe(double value)
+{
+  // values equal to a bound belong to its bucket, as defined by Prometheus
+  std::size_t i = static_cast<std::size_t>(std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin());
+  counts_[i].fetch_add(1, std::memory_order_relaxed);
+  atomicAdd(sum_bits_, value);
+}
+
+Histogram::Snapshot Histogram::getSnapshot() const
+{
+  Snapshot ret;
+  ret.bounds = bounds_;
+  ret.counts.resize(bounds_.size() + 1);
+
+  uint64_t count = 0;
+  for (std::size_t i = 0; i <= bounds_.size(); i++)
+  {
+    count += counts_[i].load(std::memory_order_relaxed);
+    ret.counts[i] = count;
+  }
+
+  ret.count = count;
+  ret.sum = fromBits(sum_bits_.load(std::memory_order_relaxed));
+  return ret;
+}
+
+MetricsRegistry::Ptr MetricsRegistry::getDefault()
+{
+  // never destroyed, since metrics may still be updated while static
+  // objects are destroyed at exit
+  static Ptr* registry = new Ptr(new MetricsRegistry());
+  return *registry;
+}
+
+MetricsRegistry::Ptr MetricsRegistry::create()
+{
+  return Ptr(new MetricsRegistry());
+}
+
+MetricsRegistry::Family& MetricsRegistry::getFamily(const std::string& name, const std::string& help, Type type,
+                                                    const Labels& labels)
+{
+  if (!isValidName(name, true))
+  {
+    throw std::invalid_argument("Invalid metric name: '" + name + "'");
+  }
+
+  for (auto&& l : labels)
+  {
+    if (!isValidName(l.first, false) || l.first.compare(0, 2, "__") == 0 ||
+        (type == Type::HISTOGRAM && l.first == "le"))
+    {
+      throw std::invalid_argument("Invalid label name of metric " + name + ": '" + l.first + "'");
+    }
+  }
+
+  auto it = families_.find(name);
+  if (it == families_.end())
+  {
+    Family& family = families_[name];
+    family.type = type;
+    family.help = help;
+    return family;
+  }
+
+  if (it->second.type != type)
+  {
+    throw std::invalid_argument("Metric " + name + " is already registered with another type");
+  }
+
+  return it->second;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const Labels& labels)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  std::unique_ptr<Counter>& metric = getFamily(name, help, Type::COUNTER, labels).counters[labels];
+  if (!metric)
+  {
+    metric.reset(new Counter());
+  }
+  return *metric;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const Labels& labels)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  std::unique_ptr<Gauge>& metric = getFamily(name, help, Type::GAUGE, labels).gauges[labels];
+  if (!metric)
+  {
+    metric.reset(new Gauge());
+  }
+  return *metric;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const std::vector<double>& bounds, const Labels& labels)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  Family& family = getFamily(name, help, Type::HISTOGRAM, labels);
+  if (family.histograms.empty())
+  {
+    family.bounds = bounds;
+  }
+  else if (family.bounds != bounds)
+  {
+    throw std::invalid_argument("Metric " + name + " is already registered with other bounds");
+  }
+
+  std::unique_ptr<Histogram>& metric = family.histograms[labels];
+  if (!metric)
+  {
+    metric.reset(new Histogram(bounds));
+  }
+  return *metric;
+}
+
+std::string MetricsRegistry::toPrometheus() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  std::ostringstream out;
+
+  for (auto&& f : families_)
+  {
+    const std::string& name = f.first;
+    const Family& family = f.second;
+
+    out << "# HELP " << name << ' ' << escape(family.help, false) << '\n';
+    switch (family.type)
+    {
+      case Type::COUNTER:
+        out << "# TYPE " << name << " counter\n";
+        for (auto&& m : family.counters)
+        {
+          out << name;
+          writeLabels(out, m.first);
+          out << ' ' << m.second->get() << '\n';
+        }
+        break;
+
+      case Type::GAUGE:
+        out << "# TYPE " << name << " gauge\n";
+        for (auto&& m : family.gauges)
+        {
+          out << name;
+          writeLabels(out, m.first);
+          out << ' ' << formatValue(m.second->get()) << '\n';
+        }
+        break;
+
+      case Type::HISTOGRAM:
+        out << "# TYPE " << name << " histogram\n";
+        for (auto&& m : family.histograms)
+        {
+          Histogram::Snapshot s = m.second->getSnapshot();
+          for (std::size_t i = 0; i < s.counts.size(); i++)
+          {
+            out << name << "_bucket";
+            writeLabels(out, m.first, "le",
+                        formatValue(i < s.bounds.size() ? s.bounds[i] : std::numeric_limits<double>::infinity()));
+            out << ' ' << s.counts[i] << '\n';
+          }
+
+          out << name << "_sum";
+          writeLabels(out, m.first);
+          out << ' ' << formatValue(s.sum) << '\n';
+
+          out << name << "_count";
+          writeLabels(out, m.first);
+          out << ' ' << s.count << '\n';
+        }
+        break;
+    }
+  }
+
+  return out.str();
+}
+
+std::string MetricsRegistry::toJson() const
+{
+  nlohmann::json metrics = nlohmann::json::array();
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto&& f : families_)
+    {
+      const Family& family = f.second;
+
+      nlohmann::json js;
+      js["name"] = f.first;
+      js["help"] = family.help;
+
+      nlohmann::json samples = nlohmann::json::array();
+      switch (family.type)
+      {
+        case Type::COUNTER:
+          js["type"] = "counter";
+          for (auto&& m : family.counters)
+          {
+            samples.push_back({ { "labels", m.first }, { "value", m.second->get() } });
+          }
+          break;
+
+        case Type::GAUGE:
+          js["type"] = "gauge";
+          for (auto&& m : family.gauges)
+          {
+            samples.push_back({ { "labels", m.first }, { "value", toJsonValue(m.second->get()) } });
+          }
+          break;
+
+        case Type::HISTOGRAM:
+          js["type"] = "histogram";
+          for (auto&& m : family.histograms)
+          {
+            Histogram::Snapshot s = m.second->getSnapshot();
+            nlohmann::json buckets = nlohmann::json::array();
+            for (std::size_t i = 0; i < s.counts.size(); i++)
+            {
+              double le = i < s.bounds.size() ? s.bounds[i] : std::numeric_limits<double>::infinity();
+              buckets.push_back({ { "le", toJsonValue(le) }, { "count", s.counts[i] } });
+            }
+
+            samples.push_back({ { "labels", m.first },
+                                { "count", s.count },
+                                { "sum", toJsonValue(s.sum) },
+                                { "buckets", buckets } });
+          }
+          break;
+      }
+
+      js["samples"] = samples;
+      metrics.push_back(js);
+    }
+  }
+
+  nlohmann::json ret;
+  ret["time"] =
+      std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+  ret["metrics"] = metrics;
+  return ret.dump();
+}
+}
+}
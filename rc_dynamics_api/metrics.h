@@ -0,0 +1,249 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_METRICS_H
+#define RC_DYNAMICS_API_METRICS_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Monotonically increasing count, e.g. of received messages. Increments
+ * are lock-free and may be done from any thread.
+ */
+class Counter
+{
+public:
+  Counter() : value_(0)
+  {
+  }
+
+  void inc(uint64_t n = 1)
+  {
+    value_.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  uint64_t get() const
+  {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+private:
+  Counter(const Counter&) = delete;
+  Counter& operator=(const Counter&) = delete;
+
+  std::atomic<uint64_t> value_;
+};
+
+/**
+ * Value that can go up and down, e.g. the number of registered
+ * destinations. Changes are lock-free and may be done from any thread.
+ */
+class Gauge
+{
+public:
+  Gauge();
+
+  void set(double value);
+  void add(double value);
+  double get() const;
+
+private:
+  Gauge(const Gauge&) = delete;
+  Gauge& operator=(const Gauge&) = delete;
+
+  std::atomic<uint64_t> bits_;
+};
+
+/**
+ * Distribution of values, e.g. of request durations, counted in buckets
+ * with fixed upper bounds. Observing a value is lock-free and may be done
+ * from any thread.
+ */
+class Histogram
+{
+public:
+  /// Contents of a histogram at one point in time
+  struct Snapshot
+  {
+    std::vector<double> bounds;    ///< upper bounds of the buckets, without the implicit +Inf bucket
+    std::vector<uint64_t> counts;  ///< cumulative counts of the buckets including +Inf, i.e. one more than bounds
+    double sum;                    ///< sum of all observed values
+    uint64_t count;                ///< number of observed values
+  };
+
+  /**
+   * Returns count bounds that start with start and grow by factor, e.g.
+   * exponentialBounds(1e-4, 2, 16) for durations from 0.1 ms to 3.3 s.
+   */
+  static std::vector<double> exponentialBounds(double start, double factor, std::size_t count);
+
+  /**
+   * Creates a histogram.
+   *
+   * @param bounds upper bounds of the buckets in ascending order
+   */
+  explicit Histogram(const std::vector<double>& bounds);
+
+  void observe(double value);
+
+  /**
+   * Returns the current contents. Values that are observed concurrently
+   * may be missing in some, but not all buckets.
+   */
+  Snapshot getSnapshot() const;
+
+  const std::vector<double>& getBounds() const
+  {
+    return bounds_;
+  }
+
+private:
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  std::vector<double> bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+  std::atomic<uint64_t> sum_bits_;
+};
+
+/**
+ * Registry of named metrics, which can be exported in the text format of
+ * Prometheus or as JSON snapshot, e.g. by a MetricsServer.
+ *
+ * Metrics are identified by their name and labels. Looking them up
+ * requires a lock, but they are never removed, so that the hot paths keep
+ * references to them and only update atomics.
+ *
+ * The library records its metrics in the default registry, see
+ * getDefault():
+ *
+ *   rc_dynamics_rest_requests_total{method}              REST-API requests, without retries
+ *   rc_dynamics_rest_request_duration_seconds{method}    duration of every attempt
+ *   rc_dynamics_rest_retries_total{method}               retries after http error code 429
+ *   rc_dynamics_rest_too_many_requests_total{method}     responses with http error code 429
+ *   rc_dynamics_rest_failures_total{method}              requests without response or given up
+ *   rc_dynamics_messages_received_total{stream}          received messages
+ *   rc_dynamics_received_bytes_total{stream}             received bytes
+ *   rc_dynamics_receive_timeouts_total{stream}           receive calls that timed out
+ *   rc_dynamics_decode_duration_seconds{stream}          de-serialization of every 16th message
+ *   rc_dynamics_stream_outages_total{stream}             outages detected by SupervisedReceiver
+ *   rc_dynamics_unexpected_receive_timeouts_total        UnexpectedReceiveTimeout exceptions
+ *   rc_dynamics_socket_errors_total                      SocketException exceptions
+ *
+ * The stream label is the name of the stream for receivers of
+ * RemoteInterface and empty for other receivers, see
+ * DataReceiver::setStreamName().
+ */
+class MetricsRegistry
+{
+public:
+  using Ptr = std::shared_ptr<MetricsRegistry>;
+  using Labels = std::map<std::string, std::string>;
+
+  /// Returns the registry that is used by the library
+  static Ptr getDefault();
+
+  /// Creates an empty registry, e.g. for metrics of an application
+  static Ptr create();
+
+  /**
+   * Returns the counter with the given name and labels, which is created if
+   * it does not exist yet. The returned reference stays valid as long as
+   * the registry exists.
+   *
+   * @param name name of the metric, e.g. "rc_dynamics_messages_received_total"
+   * @param help description of the metric, which is taken from the first call
+   * @param labels names and values of the labels
+   * @throw invalid_argument if the name or labels are invalid or the name is used by another type of metric
+   */
+  Counter& counter(const std::string& name, const std::string& help, const Labels& labels = Labels());
+
+  /// Like counter(), but for gauges
+  Gauge& gauge(const std::string& name, const std::string& help, const Labels& labels = Labels());
+
+  /// Like counter(), but for histograms, which must have the same bounds for all labels
+  Histogram& histogram(const std::string& name, const std::string& help, const std::vector<double>& bounds,
+                       const Labels& labels = Labels());
+
+  /// Returns all metrics in the text exposition format of Prometheus (version 0.0.4)
+  std::string toPrometheus() const;
+
+  /**
+   * Returns all metrics as JSON snapshot, i.e. an object with the time of
+   * the snapshot in seconds since epoch and an array of metrics, each with
+   * name, type, help and samples.
+   */
+  std::string toJson() const;
+
+private:
+  MetricsRegistry() = default;
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+  enum class Type
+  {
+    COUNTER,
+    GAUGE,
+    HISTOGRAM
+  };
+
+  struct Family
+  {
+    Type type;
+    std::string help;
+    std::vector<double> bounds;
+    std::map<Labels, std::unique_ptr<Counter>> counters;
+    std::map<Labels, std::unique_ptr<Gauge>> gauges;
+    std::map<Labels, std::unique_ptr<Histogram>> histograms;
+  };
+
+  Family& getFamily(const std::string& name, const std::string& help, Type type, const Labels& labels);
+
+  mutable std::mutex mtx_;
+  std::map<std::string, Family> families_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_METRICS_H
@@ -0,0 +1,207 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "metrics_server.h"
+#include "socket_exception.h"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace rc
+{
+namespace dynamics
+{
+MetricsServer::Ptr MetricsServer::create(const MetricsRegistry::Ptr& registry, unsigned int port,
+                                         const std::string& ip_address)
+{
+  return Ptr(new MetricsServer(registry, port, ip_address));
+}
+
+MetricsServer::MetricsServer(const MetricsRegistry::Ptr& registry, unsigned int port, const std::string& ip_address)
+  : registry_(registry), port_(port), listen_fd_(-1), running_(true)
+{
+  if (!registry_)
+  {
+    throw std::invalid_argument("MetricsServer requires a registry");
+  }
+
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  if (inet_pton(AF_INET, ip_address.c_str(), &addr.sin_addr) != 1)
+  {
+    throw std::invalid_argument("Given IP address is not a valid address: " + ip_address);
+  }
+
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0)
+  {
+    throw SocketException("Error while creating socket!", errno);
+  }
+
+  int on = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(listen_fd_, 16) < 0)
+  {
+    int e = errno;
+    close(listen_fd_);
+    throw SocketException("Error while binding socket!", e);
+  }
+
+  socklen_t len = sizeof(addr);
+  getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+  port_ = ntohs(addr.sin_port);
+
+  thread_ = std::thread(&MetricsServer::serve, this);
+}
+
+MetricsServer::~MetricsServer()
+{
+  running_ = false;
+  thread_.join();
+  close(listen_fd_);
+}
+
+void MetricsServer::serve()
+{
+  while (running_)
+  {
+    // wake up regularly for checking if the server is stopped
+
+    pollfd p;
+    p.fd = listen_fd_;
+    p.events = POLLIN;
+    if (poll(&p, 1, 100) <= 0)
+    {
+      continue;
+    }
+
+    int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd >= 0)
+    {
+      handleConnection(fd);
+      close(fd);
+    }
+  }
+}
+
+void MetricsServer::handleConnection(int fd)
+{
+  // slow or stalled clients must not block the server for long
+
+  struct timeval timeout;
+  timeout.tv_sec = 1;
+  timeout.tv_usec = 0;
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  // only the request line is of interest, the headers are skipped
+
+  std::string request;
+  char tmp[1024];
+  while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192)
+  {
+    ssize_t n = TEMP_FAILURE_RETRY(recv(fd, tmp, sizeof(tmp), 0));
+    if (n <= 0)
+    {
+      return;
+    }
+    request.append(tmp, static_cast<std::size_t>(n));
+  }
+
+  std::istringstream line(request.substr(0, request.find("\r\n")));
+  std::string method, target;
+  line >> method >> target;
+  std::string path = target.substr(0, target.find('?'));
+
+  int status = 200;
+  std::string reason = "OK";
+  std::string type = "text/plain; charset=utf-8";
+  std::string body;
+  if (method != "GET" && method != "HEAD")
+  {
+    status = 405;
+    reason = "Method Not Allowed";
+    body = "Only GET is supported\n";
+  }
+  else if (path == "/metrics")
+  {
+    type = "text/plain; version=0.0.4; charset=utf-8";
+    body = registry_->toPrometheus();
+  }
+  else if (path == "/metrics.json")
+  {
+    type = "application/json";
+    body = registry_->toJson();
+  }
+  else
+  {
+    status = 404;
+    reason = "Not Found";
+    body = "Available are /metrics and /metrics.json\n";
+  }
+
+  std::ostringstream response;
+  response << "HTTP/1.1 " << status << ' ' << reason << "\r\n"
+           << "Content-Type: " << type << "\r\n"
+           << "Content-Length: " << body.size() << "\r\n"
+           << "Connection: close\r\n\r\n";
+  if (method != "HEAD")
+  {
+    response << body;
+  }
+
+  std::string data = response.str();
+  std::size_t sent = 0;
+  while (sent < data.size())
+  {
+    ssize_t n = TEMP_FAILURE_RETRY(send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL));
+    if (n <= 0)
+    {
+      return;
+    }
+    sent += static_cast<std::size_t>(n);
+  }
+}
+}
+}
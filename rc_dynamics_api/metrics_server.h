@@ -0,0 +1,102 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_METRICS_SERVER_H
+#define RC_DYNAMICS_API_METRICS_SERVER_H
+
+#include "metrics.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Minimal http server that exports a MetricsRegistry for pulling, i.e.
+ *
+ *   GET /metrics        text exposition format of Prometheus
+ *   GET /metrics.json   JSON snapshot
+ *
+ * Requests are served one after the other by a background thread, which
+ * is sufficient for scraping and does not affect the receiving threads.
+ * By default, the server only listens on the loopback interface.
+ *
+ * NOTE: Only available on POSIX systems.
+ */
+class MetricsServer
+{
+public:
+  using Ptr = std::shared_ptr<MetricsServer>;
+
+  /**
+   * Creates a server that immediately starts listening.
+   *
+   * @param registry metrics to be exported
+   * @param port port number, 0 for an arbitrary port
+   * @param ip_address IP address to listen on, e.g. "0.0.0.0" for all interfaces
+   */
+  static Ptr create(const MetricsRegistry::Ptr& registry = MetricsRegistry::getDefault(), unsigned int port = 9464,
+                    const std::string& ip_address = "127.0.0.1");
+
+  /// Stops the server
+  ~MetricsServer();
+
+  /// Returns the port number the server is listening on
+  unsigned int getPort() const
+  {
+    return port_;
+  }
+
+private:
+  MetricsServer(const MetricsRegistry::Ptr& registry, unsigned int port, const std::string& ip_address);
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+  void serve();
+  void handleConnection(int fd);
+
+  MetricsRegistry::Ptr registry_;
+  unsigned int port_;
+  int listen_fd_;
+  std::atomic<bool> running_;
+  std::thread thread_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_METRICS_SERVER_H
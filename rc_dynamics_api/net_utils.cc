@@ -46,7 +46,19 @@
 #else
 #include <ifaddrs.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
 #include <unistd.h>
+#include <errno.h>
+#ifdef __linux__
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#endif
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
 #endif
 
 namespace rc
@@ -233,47 +245,224 @@ bool isValidIPAddress(const std::string& ip)
 
 #else
 
-bool getThisHostsIP(string& this_hosts_ip, const string& other_hosts_ip, const string& network_interface)
+namespace
 {
-  // scan all network interfaces (for the desired one)
-  struct ifaddrs* if_addr_struct = NULL;
-  struct ifaddrs* ifa = NULL;
-  void* tmp_addr_ptr = NULL;
-  getifaddrs(&if_addr_struct);
-  bool found_valid = false;
-  char address_buffer[INET_ADDRSTRLEN], netmask_buffer[INET_ADDRSTRLEN];
-  for (ifa = if_addr_struct; ifa != NULL; ifa = ifa->ifa_next)
+/**
+ * Resolves the local address for reaching another host. The addresses of
+ * the network interfaces and all resolved addresses are cached as integers
+ * until the addresses or routes of this host change, which is signalled by
+ * netlink on Linux. On other systems, the cache expires after one second.
+ */
+class AddressResolver
+{
+public:
+  static AddressResolver& get()
   {
-    // check if any valid IP4 address
+    static AddressResolver resolver;
+    return resolver;
+  }
 
-    if (!ifa->ifa_addr || ifa->ifa_addr->sa_family != AF_INET)
-      continue;
+  bool resolve(uint32_t& this_hosts_addr, uint32_t other_hosts_addr, const string& network_interface)
+  {
+    lock_guard<mutex> lock(mtx_);
+
+    if (hasChanged())
+    {
+      refresh();
+    }
 
-    tmp_addr_ptr = &((struct sockaddr_in*)ifa->ifa_addr)->sin_addr;
-    inet_ntop(AF_INET, tmp_addr_ptr, address_buffer, INET_ADDRSTRLEN);
+    auto key = make_pair(other_hosts_addr, network_interface);
+    auto found = cache_.find(key);
+    if (found == cache_.end())
+    {
+      found = cache_.insert(make_pair(key, lookup(other_hosts_addr, network_interface))).first;
+    }
 
-    // if network interface name is given, then filter by this interface
+    this_hosts_addr = found->second;
+    return this_hosts_addr != 0;
+  }
+
+private:
+  struct Interface
+  {
+    string name;
+    uint32_t addr;  // in network byte order
+    uint32_t mask;
+  };
 
-    if (network_interface.size() == 0 || strcmp(network_interface.c_str(), ifa->ifa_name) == 0)
+  AddressResolver() : netlink_fd_(-1)
+  {
+#ifdef __linux__
+    netlink_fd_ = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (netlink_fd_ >= 0)
     {
-      // find network interface that can reach the specified other hosts IP
+      struct sockaddr_nl addr;
+      memset(&addr, 0, sizeof(addr));
+      addr.nl_family = AF_NETLINK;
+      addr.nl_groups = RTMGRP_IPV4_IFADDR | RTMGRP_IPV4_ROUTE;
+      if (::bind(netlink_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0)
+      {
+        close(netlink_fd_);
+        netlink_fd_ = -1;
+      }
+    }
+#endif
+
+    refresh();
+  }
+
+  ~AddressResolver()
+  {
+    if (netlink_fd_ >= 0)
+    {
+      close(netlink_fd_);
+    }
+  }
+
+  // Reads all pending notifications and returns true if addresses or routes have changed
+  bool hasChanged()
+  {
+    if (netlink_fd_ < 0)
+    {
+      return chrono::steady_clock::now() - last_refresh_ > chrono::seconds(1);
+    }
 
-      tmp_addr_ptr = &((struct sockaddr_in*)ifa->ifa_netmask)->sin_addr;
-      inet_ntop(AF_INET, tmp_addr_ptr, netmask_buffer, INET_ADDRSTRLEN);
-      if (isIPInRange(address_buffer, other_hosts_ip, netmask_buffer))
+    bool changed = false;
+#ifdef __linux__
+    char buffer[8192];
+    while (true)
+    {
+      ssize_t n = recv(netlink_fd_, buffer, sizeof(buffer), MSG_DONTWAIT);
+      if (n < 0)
       {
-        found_valid = true;
+        // notifications have been lost if the buffer overflowed
+        changed = changed || errno == ENOBUFS;
+        if (errno == EINTR || errno == ENOBUFS)
+        {
+          continue;
+        }
         break;
       }
+
+      int len = static_cast<int>(n);
+      for (struct nlmsghdr* h = reinterpret_cast<struct nlmsghdr*>(buffer); NLMSG_OK(h, len); h = NLMSG_NEXT(h, len))
+      {
+        if (h->nlmsg_type == RTM_NEWADDR || h->nlmsg_type == RTM_DELADDR || h->nlmsg_type == RTM_NEWROUTE ||
+            h->nlmsg_type == RTM_DELROUTE)
+        {
+          changed = true;
+        }
+      }
     }
+#endif
+
+    return changed;
   }
 
-  if (found_valid)
+  void refresh()
   {
-    this_hosts_ip = string(address_buffer);
+    interfaces_.clear();
+    cache_.clear();
+    last_refresh_ = chrono::steady_clock::now();
+
+    struct ifaddrs* if_addr_struct = NULL;
+    if (getifaddrs(&if_addr_struct) != 0)
+    {
+      return;
+    }
+
+    for (struct ifaddrs* ifa = if_addr_struct; ifa != NULL; ifa = ifa->ifa_next)
+    {
+      // check if any valid IP4 address
+
+      if (!ifa->ifa_addr || ifa->ifa_addr->sa_family != AF_INET || !ifa->ifa_netmask)
+        continue;
+
+      Interface i;
+      i.name = ifa->ifa_name;
+      i.addr = reinterpret_cast<struct sockaddr_in*>(ifa->ifa_addr)->sin_addr.s_addr;
+      i.mask = reinterpret_cast<struct sockaddr_in*>(ifa->ifa_netmask)->sin_addr.s_addr;
+      interfaces_.push_back(i);
+    }
+
+    freeifaddrs(if_addr_struct);
   }
 
-  return found_valid;
+  uint32_t lookup(uint32_t other_hosts_addr, const string& network_interface) const
+  {
+    // let the kernel decide which source address it would use for reaching
+    // the other host, which is correct also on multi-homed hosts; connecting
+    // a UDP socket does not send anything
+
+    int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd >= 0)
+    {
+      struct sockaddr_in addr;
+      memset(&addr, 0, sizeof(addr));
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = other_hosts_addr;
+      addr.sin_port = htons(9);
+
+      socklen_t len = sizeof(addr);
+      bool ok = connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0 &&
+                getsockname(fd, reinterpret_cast<struct sockaddr*>(&addr), &len) == 0;
+      close(fd);
+
+      if (ok && addr.sin_addr.s_addr != INADDR_ANY)
+      {
+        for (auto&& i : interfaces_)
+        {
+          // if network interface name is given, then the address must belong to it
+
+          if (i.addr == addr.sin_addr.s_addr && (network_interface.empty() || i.name == network_interface))
+          {
+            return i.addr;
+          }
+        }
+      }
+    }
+
+    // otherwise, find network interface that can reach the specified other
+    // hosts IP, e.g. if the route leads to another than the given interface
+
+    for (auto&& i : interfaces_)
+    {
+      if ((network_interface.empty() || i.name == network_interface) &&
+          (i.addr & i.mask) == (other_hosts_addr & i.mask))
+      {
+        return i.addr;
+      }
+    }
+
+    return 0;
+  }
+
+  mutex mtx_;
+  int netlink_fd_;
+  chrono::steady_clock::time_point last_refresh_;
+  vector<Interface> interfaces_;
+  map<pair<uint32_t, string>, uint32_t> cache_;
+};
+}
+
+bool getThisHostsIP(string& this_hosts_ip, const string& other_hosts_ip, const string& network_interface)
+{
+  struct in_addr other_hosts_addr;
+  if (TEMP_FAILURE_RETRY(inet_pton(AF_INET, other_hosts_ip.c_str(), &other_hosts_addr)) != 1)
+  {
+    return false;
+  }
+
+  struct in_addr this_hosts_addr;
+  if (!AddressResolver::get().resolve(this_hosts_addr.s_addr, other_hosts_addr.s_addr, network_interface))
+  {
+    return false;
+  }
+
+  char address_buffer[INET_ADDRSTRLEN];
+  inet_ntop(AF_INET, &this_hosts_addr, address_buffer, INET_ADDRSTRLEN);
+  this_hosts_ip = string(address_buffer);
+  return true;
 }
 
 bool isValidIPAddress(const std::string& ip)
@@ -66,6 +66,11 @@ bool isIPInRange(const std::string& ip, const std::string& network, const std::s
  * to be used, or the IP address of another host that should be reachable from
  * the returned IP address.
  *
+ * On POSIX systems, the address that the routing table of the kernel
+ * chooses for reaching the other host is preferred over scanning the
+ * subnets of the interfaces. Interface addresses and results are cached
+ * until addresses or routes change, so that repeated calls are cheap.
+ *
  * @param this_hosts_ip IP address to be used as stream destination (only valid if returned true)
  * @param other_hosts_ip rc_visard's IP address, e.g. "192.168.0.20"
  * @param network_interface name, e.g. eth0, wlan0, ...
@@ -0,0 +1,739 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pose_kernels.h"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RC_DYNAMICS_KERNELS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RC_DYNAMICS_KERNELS_SSE2
+#endif
+
+namespace rc
+{
+namespace dynamics
+{
+namespace kernels
+{
+namespace
+{
+/*
+ * All kernels are written once as templates on the lane type T, which is
+ * either double for the scalar version, or a wrapper around a SIMD register
+ * providing the arithmetic operators. Lanes<T> provides memory access and
+ * the remaining functions.
+ */
+
+template <class T>
+struct Lanes;
+
+template <>
+struct Lanes<double>
+{
+  static const std::size_t width = 1;
+
+  static double load(const double* p)
+  {
+    return *p;
+  }
+
+  static double broadcast(double a)
+  {
+    return a;
+  }
+
+  static void store(double* p, double v)
+  {
+    *p = v;
+  }
+
+  static double sqrt(double v)
+  {
+    return std::sqrt(v);
+  }
+
+  /// returns -1 for negative values and 1 otherwise
+  static double sign(double v)
+  {
+    return v < 0 ? -1.0 : 1.0;
+  }
+};
+
+#if defined(RC_DYNAMICS_KERNELS_AVX2)
+
+struct Double4
+{
+  Double4()
+  {
+  }
+
+  Double4(__m256d v) : v(v)
+  {
+  }
+
+  __m256d v;
+};
+
+inline Double4 operator+(Double4 a, Double4 b)
+{
+  return _mm256_add_pd(a.v, b.v);
+}
+
+inline Double4 operator-(Double4 a, Double4 b)
+{
+  return _mm256_sub_pd(a.v, b.v);
+}
+
+inline Double4 operator-(Double4 a)
+{
+  return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0));
+}
+
+inline Double4 operator*(Double4 a, Double4 b)
+{
+  return _mm256_mul_pd(a.v, b.v);
+}
+
+inline Double4 operator/(Double4 a, Double4 b)
+{
+  return _mm256_div_pd(a.v, b.v);
+}
+
+template <>
+struct Lanes<Double4>
+{
+  static const std::size_t width = 4;
+
+  static Double4 load(const double* p)
+  {
+    return _mm256_loadu_pd(p);
+  }
+
+  static Double4 broadcast(double a)
+  {
+    return _mm256_set1_pd(a);
+  }
+
+  static void store(double* p, Double4 v)
+  {
+    _mm256_storeu_pd(p, v.v);
+  }
+
+  static Double4 sqrt(Double4 v)
+  {
+    return _mm256_sqrt_pd(v.v);
+  }
+
+  static Double4 sign(Double4 v)
+  {
+    return _mm256_or_pd(_mm256_and_pd(v.v, _mm256_set1_pd(-0.0)), _mm256_set1_pd(1.0));
+  }
+};
+
+typedef Double4 Simd;
+const char* simd_name = "AVX2";
+
+#elif defined(RC_DYNAMICS_KERNELS_SSE2)
+
+struct Double2
+{
+  Double2()
+  {
+  }
+
+  Double2(__m128d v) : v(v)
+  {
+  }
+
+  __m128d v;
+};
+
+inline Double2 operator+(Double2 a, Double2 b)
+{
+  return _mm_add_pd(a.v, b.v);
+}
+
+inline Double2 operator-(Double2 a, Double2 b)
+{
+  return _mm_sub_pd(a.v, b.v);
+}
+
+inline Double2 operator-(Double2 a)
+{
+  return _mm_xor_pd(a.v, _mm_set1_pd(-0.0));
+}
+
+inline Double2 operator*(Double2 a, Double2 b)
+{
+  return _mm_mul_pd(a.v, b.v);
+}
+
+inline Double2 operator/(Double2 a, Double2 b)
+{
+  return _mm_div_pd(a.v, b.v);
+}
+
+template <>
+struct Lanes<Double2>
+{
+  static const std::size_t width = 2;
+
+  static Double2 load(const double* p)
+  {
+    return _mm_loadu_pd(p);
+  }
+
+  static Double2 broadcast(double a)
+  {
+    return _mm_set1_pd(a);
+  }
+
+  static void store(double* p, Double2 v)
+  {
+    _mm_storeu_pd(p, v.v);
+  }
+
+  static Double2 sqrt(Double2 v)
+  {
+    return _mm_sqrt_pd(v.v);
+  }
+
+  static Double2 sign(Double2 v)
+  {
+    return _mm_or_pd(_mm_and_pd(v.v, _mm_set1_pd(-0.0)), _mm_set1_pd(1.0));
+  }
+};
+
+typedef Double2 Simd;
+const char* simd_name = "SSE2";
+
+#else
+
+typedef double Simd;
+const char* simd_name = "scalar";
+
+#endif
+
+/// Loads lanes starting at index i, or broadcasts the first value if Constant
+template <class T, bool Constant>
+struct Fetch
+{
+  static T get(const double* p, std::size_t i)
+  {
+    return Lanes<T>::load(p + i);
+  }
+};
+
+template <class T>
+struct Fetch<T, true>
+{
+  static T get(const double* p, std::size_t)
+  {
+    return Lanes<T>::broadcast(*p);
+  }
+};
+
+template <class T>
+struct Quat
+{
+  T x, y, z, w;
+};
+
+template <class T>
+struct Vec3
+{
+  T x, y, z;
+};
+
+template <class T, bool Constant>
+inline Quat<T> loadQuat(const ConstQuaternionArray& q, std::size_t i)
+{
+  Quat<T> r;
+  r.x = Fetch<T, Constant>::get(q.x, i);
+  r.y = Fetch<T, Constant>::get(q.y, i);
+  r.z = Fetch<T, Constant>::get(q.z, i);
+  r.w = Fetch<T, Constant>::get(q.w, i);
+  return r;
+}
+
+template <class T>
+inline void storeQuat(const QuaternionArray& q, std::size_t i, const Quat<T>& v)
+{
+  Lanes<T>::store(q.x + i, v.x);
+  Lanes<T>::store(q.y + i, v.y);
+  Lanes<T>::store(q.z + i, v.z);
+  Lanes<T>::store(q.w + i, v.w);
+}
+
+template <class T, bool Constant>
+inline Vec3<T> loadVec(const ConstVectorArray& v, std::size_t i)
+{
+  Vec3<T> r;
+  r.x = Fetch<T, Constant>::get(v.x, i);
+  r.y = Fetch<T, Constant>::get(v.y, i);
+  r.z = Fetch<T, Constant>::get(v.z, i);
+  return r;
+}
+
+template <class T>
+inline void storeVec(const VectorArray& v, std::size_t i, const Vec3<T>& u)
+{
+  Lanes<T>::store(v.x + i, u.x);
+  Lanes<T>::store(v.y + i, u.y);
+  Lanes<T>::store(v.z + i, u.z);
+}
+
+template <class T>
+inline Quat<T> mul(const Quat<T>& a, const Quat<T>& b)
+{
+  Quat<T> r;
+  r.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+  r.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+  r.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+  r.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+  return r;
+}
+
+template <class T>
+inline Quat<T> normalized(const Quat<T>& q)
+{
+  T s = Lanes<T>::broadcast(1.0) / Lanes<T>::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+  Quat<T> r;
+  r.x = q.x * s;
+  r.y = q.y * s;
+  r.z = q.z * s;
+  r.w = q.w * s;
+  return r;
+}
+
+template <class T>
+inline Vec3<T> rotate(const Quat<T>& q, const Vec3<T>& v)
+{
+  // with u = (q.x, q.y, q.z) and t = 2 * (u x v): v' = v + q.w * t + u x t
+
+  T two = Lanes<T>::broadcast(2.0);
+  T tx = two * (q.y * v.z - q.z * v.y);
+  T ty = two * (q.z * v.x - q.x * v.z);
+  T tz = two * (q.x * v.y - q.y * v.x);
+
+  Vec3<T> r;
+  r.x = v.x + q.w * tx + (q.y * tz - q.z * ty);
+  r.y = v.y + q.w * ty + (q.z * tx - q.x * tz);
+  r.z = v.z + q.w * tz + (q.x * ty - q.y * tx);
+  return r;
+}
+
+inline void slerpWeights(double d, double t, double& s0, double& s1)
+{
+  if (d > 0.9995)
+  {
+    // nearly identical orientations: normalized lerp avoids division by sin(theta) ~ 0
+    s0 = 1 - t;
+    s1 = t;
+  }
+  else
+  {
+    double theta = std::acos(d);
+    double sin_theta = std::sin(theta);
+    s0 = std::sin((1 - t) * theta) / sin_theta;
+    s1 = std::sin(t * theta) / sin_theta;
+  }
+}
+
+template <class T>
+void multiplyRange(const ConstQuaternionArray& a, const ConstQuaternionArray& b, const QuaternionArray& out,
+                   std::size_t begin, std::size_t end)
+{
+  for (std::size_t i = begin; i < end; i += Lanes<T>::width)
+  {
+    storeQuat(out, i, mul(loadQuat<T, false>(a, i), loadQuat<T, false>(b, i)));
+  }
+}
+
+template <class T>
+void normalizeRange(const QuaternionArray& q, std::size_t begin, std::size_t end)
+{
+  for (std::size_t i = begin; i < end; i += Lanes<T>::width)
+  {
+    storeQuat(q, i, normalized(loadQuat<T, false>(q, i)));
+  }
+}
+
+template <class T>
+void rotateRange(const ConstQuaternionArray& q, const ConstVectorArray& v, const VectorArray& out,
+                 std::size_t begin, std::size_t end)
+{
+  for (std::size_t i = begin; i < end; i += Lanes<T>::width)
+  {
+    storeVec(out, i, rotate(loadQuat<T, false>(q, i), loadVec<T, false>(v, i)));
+  }
+}
+
+template <class T, bool ConstantA, bool ConstantB>
+void composeRange(const ConstPoseArray& a, const ConstPoseArray& b, const PoseArray& out, std::size_t begin,
+                  std::size_t end)
+{
+  for (std::size_t i = begin; i < end; i += Lanes<T>::width)
+  {
+    Quat<T> qa = loadQuat<T, ConstantA>(a.orientation, i);
+    Vec3<T> pa = loadVec<T, ConstantA>(a.position, i);
+    Quat<T> qb = loadQuat<T, ConstantB>(b.orientation, i);
+    Vec3<T> pb = loadVec<T, ConstantB>(b.position, i);
+
+    Vec3<T> p = rotate(qa, pb);
+    p.x = p.x + pa.x;
+    p.y = p.y + pa.y;
+    p.z = p.z + pa.z;
+
+    storeVec(out.position, i, p);
+    storeQuat(out.orientation, i, mul(qa, qb));
+  }
+}
+
+template <class T>
+void inverseRange(const ConstPoseArray& p, const PoseArray& out, std::size_t begin, std::size_t end)
+{
+  for (std::size_t i = begin; i < end; i += Lanes<T>::width)
+  {
+    Quat<T> q = loadQuat<T, false>(p.orientation, i);
+    q.x = -q.x;
+    q.y = -q.y;
+    q.z = -q.z;
+
+    Vec3<T> t = rotate(q, loadVec<T, false>(p.position, i));
+    t.x = -t.x;
+    t.y = -t.y;
+    t.z = -t.z;
+
+    storeVec(out.position, i, t);
+    storeQuat(out.orientation, i, q);
+  }
+}
+
+template <class T>
+void slerpRange(const ConstQuaternionArray& a, const ConstQuaternionArray& b, const double* t,
+                const QuaternionArray& out, std::size_t begin, std::size_t end)
+{
+  const std::size_t width = Lanes<T>::width;
+
+  for (std::size_t i = begin; i < end; i += width)
+  {
+    Quat<T> qa = loadQuat<T, false>(a, i);
+    Quat<T> qb = loadQuat<T, false>(b, i);
+
+    // interpolate along the shorter arc
+
+    T d = qa.x * qb.x + qa.y * qb.y + qa.z * qb.z + qa.w * qb.w;
+    T s = Lanes<T>::sign(d);
+    d = d * s;
+    qb.x = qb.x * s;
+    qb.y = qb.y * s;
+    qb.z = qb.z * s;
+    qb.w = qb.w * s;
+
+    // there are no SIMD instructions for trigonometric functions, so the
+    // weights are computed per lane
+
+    double dl[width], s0l[width], s1l[width];
+    Lanes<T>::store(dl, d);
+    for (std::size_t k = 0; k < width; k++)
+    {
+      slerpWeights(dl[k], t[i + k], s0l[k], s1l[k]);
+    }
+
+    T s0 = Lanes<T>::load(s0l);
+    T s1 = Lanes<T>::load(s1l);
+
+    Quat<T> r;
+    r.x = s0 * qa.x + s1 * qb.x;
+    r.y = s0 * qa.y + s1 * qb.y;
+    r.z = s0 * qa.z + s1 * qb.z;
+    r.w = s0 * qa.w + s1 * qb.w;
+    storeQuat(out, i, normalized(r));
+  }
+}
+
+/// End of the range that can be processed with full SIMD registers
+inline std::size_t simdEnd(std::size_t n)
+{
+  return n - n % Lanes<Simd>::width;
+}
+
+ConstPoseArray toArray(const StampedPose& p)
+{
+  return ConstPoseArray(ConstVectorArray(&p.x, &p.y, &p.z), ConstQuaternionArray(&p.qx, &p.qy, &p.qz, &p.qw));
+}
+}
+
+const char* instructionSet()
+{
+  return simd_name;
+}
+
+void multiply(ConstQuaternionArray a, ConstQuaternionArray b, QuaternionArray out, std::size_t n)
+{
+  std::size_t m = simdEnd(n);
+  multiplyRange<Simd>(a, b, out, 0, m);
+  multiplyRange<double>(a, b, out, m, n);
+}
+
+void normalize(QuaternionArray q, std::size_t n)
+{
+  std::size_t m = simdEnd(n);
+  normalizeRange<Simd>(q, 0, m);
+  normalizeRange<double>(q, m, n);
+}
+
+void rotate(ConstQuaternionArray q, ConstVectorArray v, VectorArray out, std::size_t n)
+{
+  std::size_t m = simdEnd(n);
+  rotateRange<Simd>(q, v, out, 0, m);
+  rotateRange<double>(q, v, out, m, n);
+}
+
+void compose(ConstPoseArray a, ConstPoseArray b, PoseArray out, std::size_t n)
+{
+  std::size_t m = simdEnd(n);
+  composeRange<Simd, false, false>(a, b, out, 0, m);
+  composeRange<double, false, false>(a, b, out, m, n);
+}
+
+void compose(ConstPoseArray a, const StampedPose& b, PoseArray out, std::size_t n)
+{
+  std::size_t m = simdEnd(n);
+  composeRange<Simd, false, true>(a, toArray(b), out, 0, m);
+  composeRange<double, false, true>(a, toArray(b), out, m, n);
+}
+
+void compose(const StampedPose& a, ConstPoseArray b, PoseArray out, std::size_t n)
+{
+  std::size_t m = simdEnd(n);
+  composeRange<Simd, true, false>(toArray(a), b, out, 0, m);
+  composeRange<double, true, false>(toArray(a), b, out, m, n);
+}
+
+void inverse(ConstPoseArray p, PoseArray out, std::size_t n)
+{
+  std::size_t m = simdEnd(n);
+  inverseRange<Simd>(p, out, 0, m);
+  inverseRange<double>(p, out, m, n);
+}
+
+void slerp(ConstQuaternionArray a, ConstQuaternionArray b, const double* t, QuaternionArray out, std::size_t n)
+{
+  std::size_t m = simdEnd(n);
+  slerpRange<Simd>(a, b, t, out, 0, m);
+  slerpRange<double>(a, b, t, out, m, n);
+}
+
+/*
+ * The scalar versions are plain loops that are written independently of the
+ * templates above, with textbook formulations, e.g. rotation as q * v * q^-1,
+ * so that they can serve as reference for testing the vectorized kernels.
+ */
+namespace scalar
+{
+namespace
+{
+struct Quaternion
+{
+  double x, y, z, w;
+};
+
+Quaternion get(const ConstQuaternionArray& q, std::size_t i)
+{
+  Quaternion r = { q.x[i], q.y[i], q.z[i], q.w[i] };
+  return r;
+}
+
+void set(const QuaternionArray& q, std::size_t i, const Quaternion& v)
+{
+  q.x[i] = v.x;
+  q.y[i] = v.y;
+  q.z[i] = v.z;
+  q.w[i] = v.w;
+}
+
+// Hamilton product in vector form: (a.w * b.w - a.v . b.v, a.w * b.v + b.w * a.v + a.v x b.v)
+Quaternion product(const Quaternion& a, const Quaternion& b)
+{
+  Quaternion r;
+  r.w = a.w * b.w - (a.x * b.x + a.y * b.y + a.z * b.z);
+  r.x = a.w * b.x + b.w * a.x + (a.y * b.z - a.z * b.y);
+  r.y = a.w * b.y + b.w * a.y + (a.z * b.x - a.x * b.z);
+  r.z = a.w * b.z + b.w * a.z + (a.x * b.y - a.y * b.x);
+  return r;
+}
+
+Quaternion conjugate(const Quaternion& q)
+{
+  Quaternion r = { -q.x, -q.y, -q.z, q.w };
+  return r;
+}
+
+// q * (v, 0) * q^-1
+void rotateVector(const Quaternion& q, double x, double y, double z, double& rx, double& ry, double& rz)
+{
+  Quaternion v = { x, y, z, 0 };
+  Quaternion r = product(product(q, v), conjugate(q));
+  rx = r.x;
+  ry = r.y;
+  rz = r.z;
+}
+
+void composePose(const Quaternion& qa, double ax, double ay, double az, const Quaternion& qb, double bx, double by,
+                 double bz, const PoseArray& out, std::size_t i)
+{
+  double x, y, z;
+  rotateVector(qa, bx, by, bz, x, y, z);
+  out.position.x[i] = ax + x;
+  out.position.y[i] = ay + y;
+  out.position.z[i] = az + z;
+  set(out.orientation, i, product(qa, qb));
+}
+}
+
+void multiply(ConstQuaternionArray a, ConstQuaternionArray b, QuaternionArray out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++)
+  {
+    set(out, i, product(get(a, i), get(b, i)));
+  }
+}
+
+void normalize(QuaternionArray q, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++)
+  {
+    double norm = std::sqrt(q.x[i] * q.x[i] + q.y[i] * q.y[i] + q.z[i] * q.z[i] + q.w[i] * q.w[i]);
+    q.x[i] /= norm;
+    q.y[i] /= norm;
+    q.z[i] /= norm;
+    q.w[i] /= norm;
+  }
+}
+
+void rotate(ConstQuaternionArray q, ConstVectorArray v, VectorArray out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++)
+  {
+    rotateVector(get(q, i), v.x[i], v.y[i], v.z[i], out.x[i], out.y[i], out.z[i]);
+  }
+}
+
+void compose(ConstPoseArray a, ConstPoseArray b, PoseArray out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++)
+  {
+    composePose(get(a.orientation, i), a.position.x[i], a.position.y[i], a.position.z[i], get(b.orientation, i),
+                b.position.x[i], b.position.y[i], b.position.z[i], out, i);
+  }
+}
+
+void compose(ConstPoseArray a, const StampedPose& b, PoseArray out, std::size_t n)
+{
+  Quaternion qb = { b.qx, b.qy, b.qz, b.qw };
+  for (std::size_t i = 0; i < n; i++)
+  {
+    composePose(get(a.orientation, i), a.position.x[i], a.position.y[i], a.position.z[i], qb, b.x, b.y, b.z, out, i);
+  }
+}
+
+void compose(const StampedPose& a, ConstPoseArray b, PoseArray out, std::size_t n)
+{
+  Quaternion qa = { a.qx, a.qy, a.qz, a.qw };
+  for (std::size_t i = 0; i < n; i++)
+  {
+    composePose(qa, a.x, a.y, a.z, get(b.orientation, i), b.position.x[i], b.position.y[i], b.position.z[i], out, i);
+  }
+}
+
+void inverse(ConstPoseArray p, PoseArray out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++)
+  {
+    // (R, t)^-1 = (R^T, -R^T t)
+
+    Quaternion q = conjugate(get(p.orientation, i));
+    double x, y, z;
+    rotateVector(q, p.position.x[i], p.position.y[i], p.position.z[i], x, y, z);
+    out.position.x[i] = -x;
+    out.position.y[i] = -y;
+    out.position.z[i] = -z;
+    set(out.orientation, i, q);
+  }
+}
+
+void slerp(ConstQuaternionArray a, ConstQuaternionArray b, const double* t, QuaternionArray out, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++)
+  {
+    Quaternion qa = get(a, i);
+    Quaternion qb = get(b, i);
+
+    double d = qa.x * qb.x + qa.y * qb.y + qa.z * qb.z + qa.w * qb.w;
+    if (d < 0)
+    {
+      // q and -q are the same rotation, take the shorter arc
+      d = -d;
+      qb.x = -qb.x;
+      qb.y = -qb.y;
+      qb.z = -qb.z;
+      qb.w = -qb.w;
+    }
+
+    double s0 = 1 - t[i], s1 = t[i];
+    if (d <= 0.9995)
+    {
+      double theta = std::acos(d);
+      s0 = std::sin((1 - t[i]) * theta) / std::sin(theta);
+      s1 = std::sin(t[i] * theta) / std::sin(theta);
+    }
+
+    Quaternion r = { s0 * qa.x + s1 * qb.x, s0 * qa.y + s1 * qb.y, s0 * qa.z + s1 * qb.z, s0 * qa.w + s1 * qb.w };
+    double norm = std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z + r.w * r.w);
+    r.x /= norm;
+    r.y /= norm;
+    r.z /= norm;
+    r.w /= norm;
+    set(out, i, r);
+  }
+}
+}
+}
+}
+}
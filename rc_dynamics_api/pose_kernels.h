@@ -0,0 +1,185 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_POSE_KERNELS_H
+#define RC_DYNAMICS_API_POSE_KERNELS_H
+
+#include <cstddef>
+
+#include "pose_timeline.h"
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Batch quaternion and pose operations on arrays in structure-of-arrays
+ * layout, e.g. for transforming whole trajectories.
+ *
+ * The functions in this namespace are vectorized with AVX2 (if compiled with
+ * ENABLE_AVX2, see CMakeLists.txt) or SSE2, and fall back to a scalar
+ * instantiation of the same code on other platforms. All quaternions are
+ * expected to be of unit length, except for the input of normalize(...).
+ *
+ * Output arrays may be identical to input arrays, i.e. all operations can be
+ * done in-place, but must not overlap them otherwise.
+ */
+namespace kernels
+{
+/// Mutable array of quaternions in structure-of-arrays layout
+struct QuaternionArray
+{
+  double* x;
+  double* y;
+  double* z;
+  double* w;
+};
+
+/// Read-only array of quaternions in structure-of-arrays layout
+struct ConstQuaternionArray
+{
+  ConstQuaternionArray(const double* x, const double* y, const double* z, const double* w)
+    : x(x), y(y), z(z), w(w)
+  {
+  }
+
+  ConstQuaternionArray(const QuaternionArray& q) : x(q.x), y(q.y), z(q.z), w(q.w)
+  {
+  }
+
+  const double* x;
+  const double* y;
+  const double* z;
+  const double* w;
+};
+
+/// Mutable array of 3D vectors in structure-of-arrays layout
+struct VectorArray
+{
+  double* x;
+  double* y;
+  double* z;
+};
+
+/// Read-only array of 3D vectors in structure-of-arrays layout
+struct ConstVectorArray
+{
+  ConstVectorArray(const double* x, const double* y, const double* z) : x(x), y(y), z(z)
+  {
+  }
+
+  ConstVectorArray(const VectorArray& v) : x(v.x), y(v.y), z(v.z)
+  {
+  }
+
+  const double* x;
+  const double* y;
+  const double* z;
+};
+
+/// Mutable array of poses in structure-of-arrays layout
+struct PoseArray
+{
+  VectorArray position;
+  QuaternionArray orientation;
+};
+
+/// Read-only array of poses in structure-of-arrays layout
+struct ConstPoseArray
+{
+  ConstPoseArray(const ConstVectorArray& position, const ConstQuaternionArray& orientation)
+    : position(position), orientation(orientation)
+  {
+  }
+
+  ConstPoseArray(const PoseArray& p) : position(p.position), orientation(p.orientation)
+  {
+  }
+
+  ConstVectorArray position;
+  ConstQuaternionArray orientation;
+};
+
+/**
+ * Returns the name of the instruction set used by the vectorized functions,
+ * i.e. "AVX2", "SSE2" or "scalar".
+ */
+const char* instructionSet();
+
+/// out[i] = a[i] * b[i]
+void multiply(ConstQuaternionArray a, ConstQuaternionArray b, QuaternionArray out, std::size_t n);
+
+/// Normalizes all quaternions to unit length in-place
+void normalize(QuaternionArray q, std::size_t n);
+
+/// out[i] = q[i] * v[i] * q[i]^-1, i.e. rotation of v[i] by q[i]
+void rotate(ConstQuaternionArray q, ConstVectorArray v, VectorArray out, std::size_t n);
+
+/// out[i] = a[i] * b[i], i.e. transformation b[i] expressed in the parent frame of a[i]
+void compose(ConstPoseArray a, ConstPoseArray b, PoseArray out, std::size_t n);
+
+/// out[i] = a[i] * b, e.g. for applying the cam2imu transformation to all poses of a trajectory
+void compose(ConstPoseArray a, const StampedPose& b, PoseArray out, std::size_t n);
+
+/// out[i] = a * b[i]
+void compose(const StampedPose& a, ConstPoseArray b, PoseArray out, std::size_t n);
+
+/// out[i] = p[i]^-1
+void inverse(ConstPoseArray p, PoseArray out, std::size_t n);
+
+/// Spherical linear interpolation out[i] = slerp(a[i], b[i], t[i]) along the shorter arc
+void slerp(ConstQuaternionArray a, ConstQuaternionArray b, const double* t, QuaternionArray out, std::size_t n);
+
+/**
+ * Scalar reference implementations of all kernels. They are plain loops
+ * that do not share any code with the vectorized kernels, so that they can
+ * be used for testing them (see tests/pose_kernels_test.cc). Slerp uses the
+ * same threshold for switching to normalized lerp for nearly identical
+ * orientations.
+ */
+namespace scalar
+{
+void multiply(ConstQuaternionArray a, ConstQuaternionArray b, QuaternionArray out, std::size_t n);
+void normalize(QuaternionArray q, std::size_t n);
+void rotate(ConstQuaternionArray q, ConstVectorArray v, VectorArray out, std::size_t n);
+void compose(ConstPoseArray a, ConstPoseArray b, PoseArray out, std::size_t n);
+void compose(ConstPoseArray a, const StampedPose& b, PoseArray out, std::size_t n);
+void compose(const StampedPose& a, ConstPoseArray b, PoseArray out, std::size_t n);
+void inverse(ConstPoseArray p, PoseArray out, std::size_t n);
+void slerp(ConstQuaternionArray a, ConstQuaternionArray b, const double* t, QuaternionArray out, std::size_t n);
+}
+}
+}
+}
+
+#endif  // RC_DYNAMICS_API_POSE_KERNELS_H
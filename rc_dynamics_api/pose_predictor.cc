@@ -0,0 +1,241 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pose_predictor.h"
+
+#include <chrono>
+#include <cmath>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+/// Rotates v by unit quaternion q = (x, y, z, w), or by its inverse if inverse is true
+void rotate(const double* q, bool inverse, const double* v, double* out)
+{
+  double qx = inverse ? -q[0] : q[0];
+  double qy = inverse ? -q[1] : q[1];
+  double qz = inverse ? -q[2] : q[2];
+  double qw = q[3];
+
+  double tx = 2 * (qy * v[2] - qz * v[1]);
+  double ty = 2 * (qz * v[0] - qx * v[2]);
+  double tz = 2 * (qx * v[1] - qy * v[0]);
+
+  out[0] = v[0] + qw * tx + (qy * tz - qz * ty);
+  out[1] = v[1] + qw * ty + (qz * tx - qx * tz);
+  out[2] = v[2] + qw * tz + (qx * ty - qy * tx);
+}
+
+/// Returns true if a vector given in the frame is expressed in the pose frame
+bool isPoseFrame(const std::string& frame, const std::string& pose_frame)
+{
+  return frame.empty() || frame == pose_frame;
+}
+}
+
+PosePredictor::PosePredictor(double max_horizon) : max_horizon_(max_horizon), seq_(0), stamp_(0)
+{
+  for (int i = 0; i < NUM_VALUES; i++)
+  {
+    values_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void PosePredictor::update(const roboception::msgs::Dynamics& dynamics)
+{
+  double v[NUM_VALUES];
+
+  const auto& pose = dynamics.pose();
+  v[PX] = pose.position().x();
+  v[PY] = pose.position().y();
+  v[PZ] = pose.position().z();
+  v[QX] = pose.orientation().x();
+  v[QY] = pose.orientation().y();
+  v[QZ] = pose.orientation().z();
+  v[QW] = pose.orientation().w();
+
+  // express linear velocity and acceleration in the pose frame and angular
+  // velocity in the body frame, so that predict() has nothing to convert
+
+  const double* q = v + QX;
+  const std::string& pose_frame = dynamics.pose_frame();
+
+  double lin[3] = { dynamics.linear_velocity().x(), dynamics.linear_velocity().y(), dynamics.linear_velocity().z() };
+  if (isPoseFrame(dynamics.linear_velocity_frame(), pose_frame))
+  {
+    v[VX] = lin[0];
+    v[VY] = lin[1];
+    v[VZ] = lin[2];
+  }
+  else
+  {
+    rotate(q, false, lin, v + VX);
+  }
+
+  double ang[3] = { dynamics.angular_velocity().x(), dynamics.angular_velocity().y(),
+                    dynamics.angular_velocity().z() };
+  if (isPoseFrame(dynamics.angular_velocity_frame(), pose_frame))
+  {
+    rotate(q, true, ang, v + WX);
+  }
+  else
+  {
+    v[WX] = ang[0];
+    v[WY] = ang[1];
+    v[WZ] = ang[2];
+  }
+
+  double acc[3] = { dynamics.linear_acceleration().x(), dynamics.linear_acceleration().y(),
+                    dynamics.linear_acceleration().z() };
+  if (isPoseFrame(dynamics.linear_acceleration_frame(), pose_frame))
+  {
+    v[AX] = acc[0];
+    v[AY] = acc[1];
+    v[AZ] = acc[2];
+  }
+  else
+  {
+    rotate(q, false, acc, v + AX);
+  }
+
+  // publish with sequence lock: an odd sequence number marks an update in progress
+
+  uint32_t seq = seq_.load(std::memory_order_relaxed);
+  seq_.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  stamp_.store(toNanoseconds(dynamics.timestamp()), std::memory_order_relaxed);
+  for (int i = 0; i < NUM_VALUES; i++)
+  {
+    values_[i].store(v[i], std::memory_order_relaxed);
+  }
+
+  seq_.store(seq + 2, std::memory_order_release);
+}
+
+bool PosePredictor::hasSample() const
+{
+  return seq_.load(std::memory_order_acquire) != 0;
+}
+
+int64_t PosePredictor::sampleTime() const
+{
+  uint32_t seq0, seq1;
+  int64_t stamp;
+  do
+  {
+    seq0 = seq_.load(std::memory_order_acquire);
+    stamp = stamp_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    seq1 = seq_.load(std::memory_order_relaxed);
+  } while ((seq0 & 1) || seq0 != seq1);
+
+  return stamp;
+}
+
+bool PosePredictor::predict(int64_t stamp, StampedPose& pose) const
+{
+  // read consistent copy of the latest sample
+
+  uint32_t seq0, seq1;
+  int64_t t0;
+  double v[NUM_VALUES];
+  do
+  {
+    seq0 = seq_.load(std::memory_order_acquire);
+    t0 = stamp_.load(std::memory_order_relaxed);
+    for (int i = 0; i < NUM_VALUES; i++)
+    {
+      v[i] = values_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    seq1 = seq_.load(std::memory_order_relaxed);
+  } while ((seq0 & 1) || seq0 != seq1);
+
+  if (seq0 == 0)
+  {
+    return false;
+  }
+
+  double dt = (stamp - t0) * 1e-9;
+  if (std::fabs(dt) > max_horizon_)
+  {
+    return false;
+  }
+
+  pose.stamp = stamp;
+
+  // position with constant acceleration
+
+  double dt2 = 0.5 * dt * dt;
+  pose.x = v[PX] + v[VX] * dt + v[AX] * dt2;
+  pose.y = v[PY] + v[VY] * dt + v[AY] * dt2;
+  pose.z = v[PZ] + v[VZ] * dt + v[AZ] * dt2;
+
+  // orientation: q(t) = q * exp(w * dt / 2) with w in body frame
+
+  double wn = std::sqrt(v[WX] * v[WX] + v[WY] * v[WY] + v[WZ] * v[WZ]);
+  double half_angle = 0.5 * wn * dt;
+
+  double dw = std::cos(half_angle);
+  double s;
+  if (wn > 1e-12)
+  {
+    s = std::sin(half_angle) / wn;
+  }
+  else
+  {
+    s = 0.5 * dt;  // limit of sin(wn * dt / 2) / wn for wn -> 0
+  }
+  double dx = v[WX] * s, dy = v[WY] * s, dz = v[WZ] * s;
+
+  double qx = v[QX], qy = v[QY], qz = v[QZ], qw = v[QW];
+  pose.qx = qw * dx + qx * dw + qy * dz - qz * dy;
+  pose.qy = qw * dy - qx * dz + qy * dw + qz * dx;
+  pose.qz = qw * dz + qx * dy - qy * dx + qz * dw;
+  pose.qw = qw * dw - qx * dx - qy * dy - qz * dz;
+
+  return true;
+}
+
+bool PosePredictor::predict(StampedPose& pose) const
+{
+  int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+  return predict(now, pose);
+}
+}
+}
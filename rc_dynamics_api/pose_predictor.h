@@ -0,0 +1,138 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_POSE_PREDICTOR_H
+#define RC_DYNAMICS_API_POSE_PREDICTOR_H
+
+#include <atomic>
+#include <stdint.h>
+
+#include "roboception/msgs/dynamics.pb.h"
+
+#include "pose_timeline.h"
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Extrapolates the pose of the latest Dynamics message to the current or
+ * any other point in time, e.g. to compensate for the network latency of the
+ * 'dynamics' stream.
+ *
+ * Position is extrapolated with constant linear acceleration, orientation
+ * by integrating the angular velocity, which is assumed to be constant in the
+ * body frame, with the exact quaternion exponential. Velocities and
+ * accelerations that are not given in the frame of the pose (see the *_frame
+ * fields of the Dynamics message) are assumed to be given in the body frame,
+ * i.e. the frame that the pose refers to. The linear acceleration is used as
+ * given, i.e. it is expected to be free of gravity.
+ *
+ * The latest sample is published with a sequence lock, so that one thread
+ * (e.g. the receive thread) can update the predictor while any number of
+ * other threads (e.g. a control loop) query it concurrently without locks.
+ * update() must not be called from more than one thread at the same time.
+ */
+class PosePredictor
+{
+public:
+  /**
+   * @param max_horizon maximum time in seconds by which a pose is extrapolated
+   */
+  explicit PosePredictor(double max_horizon = 0.5);
+
+  /**
+   * Sets the sample from which poses are extrapolated.
+   */
+  void update(const roboception::msgs::Dynamics& dynamics);
+
+  /**
+   * Returns true if update() was called at least once.
+   */
+  bool hasSample() const;
+
+  /**
+   * Returns the time stamp in nanoseconds of the current sample, or 0 if
+   * there is no sample yet.
+   */
+  int64_t sampleTime() const;
+
+  /**
+   * Extrapolates the pose to the given time stamp.
+   *
+   * @param stamp time stamp in nanoseconds since epoch (clock of rc_visard)
+   * @param pose extrapolated pose (only valid if returned true)
+   * @return false if there is no sample yet or the time stamp is more than max_horizon away from it
+   */
+  bool predict(int64_t stamp, StampedPose& pose) const;
+
+  /**
+   * Extrapolates the pose to the current time of the system clock. This
+   * requires the clocks of host and rc_visard to be synchronized, e.g. via
+   * NTP or PTP.
+   */
+  bool predict(StampedPose& pose) const;
+
+protected:
+  // layout of the published sample
+  enum
+  {
+    PX,
+    PY,
+    PZ,
+    QX,
+    QY,
+    QZ,
+    QW,
+    VX,  // linear velocity in pose frame
+    VY,
+    VZ,
+    WX,  // angular velocity in body frame
+    WY,
+    WZ,
+    AX,  // linear acceleration in pose frame
+    AY,
+    AZ,
+    NUM_VALUES
+  };
+
+  double max_horizon_;
+
+  std::atomic<uint32_t> seq_;
+  std::atomic<int64_t> stamp_;
+  std::atomic<double> values_[NUM_VALUES];
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_POSE_PREDICTOR_H
@@ -0,0 +1,462 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pose_timeline.h"
+#include "pose_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+// number of interpolation search steps before falling back to bisection
+const int max_interpolation_steps = 4;
+
+StampedPose toStampedPose(int64_t stamp, const roboception::msgs::Pose& pose)
+{
+  StampedPose p;
+  p.stamp = stamp;
+  p.x = pose.position().x();
+  p.y = pose.position().y();
+  p.z = pose.position().z();
+  p.qx = pose.orientation().x();
+  p.qy = pose.orientation().y();
+  p.qz = pose.orientation().z();
+  p.qw = pose.orientation().w();
+  return p;
+}
+}
+
+StampedPose toStampedPose(const roboception::msgs::PoseStamped& pose)
+{
+  return toStampedPose(toNanoseconds(pose.timestamp()), pose.pose());
+}
+
+PoseTimeline::PoseTimeline(std::size_t capacity, Interpolation interpolation)
+  : bounded_(capacity > 0), interpolation_(interpolation), start_(0), size_(0)
+{
+  if (bounded_)
+  {
+    wrap_ = capacity;
+    stamp_.resize(capacity);
+    x_.resize(capacity);
+    y_.resize(capacity);
+    z_.resize(capacity);
+    qx_.resize(capacity);
+    qy_.resize(capacity);
+    qz_.resize(capacity);
+    qw_.resize(capacity);
+  }
+  else
+  {
+    wrap_ = std::numeric_limits<std::size_t>::max();
+  }
+}
+
+PoseTimeline PoseTimeline::fromTrajectory(const roboception::msgs::Trajectory& trajectory,
+                                          Interpolation interpolation)
+{
+  PoseTimeline timeline(0, interpolation);
+
+  int n = trajectory.poses_size();
+  timeline.stamp_.reserve(n);
+  timeline.x_.reserve(n);
+  timeline.y_.reserve(n);
+  timeline.z_.reserve(n);
+  timeline.qx_.reserve(n);
+  timeline.qy_.reserve(n);
+  timeline.qz_.reserve(n);
+  timeline.qw_.reserve(n);
+
+  for (const auto& pose : trajectory.poses())
+  {
+    timeline.add(pose);
+  }
+
+  return timeline;
+}
+
+bool PoseTimeline::add(const StampedPose& pose)
+{
+  if (size_ > 0 && pose.stamp <= endTime())
+  {
+    return false;
+  }
+
+  if (bounded_)
+  {
+    std::size_t k;
+    if (size_ == stamp_.size())
+    {
+      // timeline is full: overwrite oldest pose
+      k = start_;
+      start_ = index(1);
+    }
+    else
+    {
+      k = index(size_++);
+    }
+
+    stamp_[k] = pose.stamp;
+    x_[k] = pose.x;
+    y_[k] = pose.y;
+    z_[k] = pose.z;
+    qx_[k] = pose.qx;
+    qy_[k] = pose.qy;
+    qz_[k] = pose.qz;
+    qw_[k] = pose.qw;
+  }
+  else
+  {
+    stamp_.push_back(pose.stamp);
+    x_.push_back(pose.x);
+    y_.push_back(pose.y);
+    z_.push_back(pose.z);
+    qx_.push_back(pose.qx);
+    qy_.push_back(pose.qy);
+    qz_.push_back(pose.qz);
+    qw_.push_back(pose.qw);
+    size_++;
+  }
+
+  return true;
+}
+
+bool PoseTimeline::add(const roboception::msgs::PoseStamped& pose)
+{
+  return add(toStampedPose(pose));
+}
+
+bool PoseTimeline::add(const roboception::msgs::Frame& frame)
+{
+  return add(frame.pose());
+}
+
+bool PoseTimeline::add(const roboception::msgs::Dynamics& dynamics)
+{
+  return add(toStampedPose(toNanoseconds(dynamics.timestamp()), dynamics.pose()));
+}
+
+void PoseTimeline::transform(const StampedPose& transformation)
+{
+  // poses of a bounded timeline may wrap around the end of the storage arrays
+
+  std::size_t first = std::min(size_, stamp_.size() - start_);
+  std::size_t begin[2] = { start_, 0 };
+  std::size_t count[2] = { first, size_ - first };
+
+  for (int k = 0; k < 2; k++)
+  {
+    if (count[k] > 0)
+    {
+      std::size_t b = begin[k];
+      kernels::PoseArray poses = { { &x_[b], &y_[b], &z_[b] }, { &qx_[b], &qy_[b], &qz_[b], &qw_[b] } };
+      kernels::compose(poses, transformation, poses, count[k]);
+    }
+  }
+}
+
+void PoseTimeline::clear()
+{
+  start_ = 0;
+  size_ = 0;
+
+  if (!bounded_)
+  {
+    stamp_.clear();
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    qx_.clear();
+    qy_.clear();
+    qz_.clear();
+    qw_.clear();
+  }
+}
+
+StampedPose PoseTimeline::at(std::size_t i) const
+{
+  std::size_t k = index(i);
+
+  StampedPose p;
+  p.stamp = stamp_[k];
+  p.x = x_[k];
+  p.y = y_[k];
+  p.z = z_[k];
+  p.qx = qx_[k];
+  p.qy = qy_[k];
+  p.qz = qz_[k];
+  p.qw = qw_[k];
+  return p;
+}
+
+std::size_t PoseTimeline::find(int64_t stamp, std::size_t hint) const
+{
+  std::size_t lo = 0, hi = size_ - 1;
+
+  // narrow down the search range by galloping from the hint
+
+  if (hint < hi)
+  {
+    std::size_t step = 1;
+    if (stamp_[index(hint)] <= stamp)
+    {
+      lo = hint;
+      while (lo + step < hi && stamp_[index(lo + step)] <= stamp)
+      {
+        lo += step;
+        step *= 2;
+      }
+
+      if (lo + step < hi)
+      {
+        hi = lo + step;
+      }
+    }
+    else
+    {
+      hi = hint;
+      while (hi > step && stamp_[index(hi - step)] > stamp)
+      {
+        hi -= step;
+        step *= 2;
+      }
+
+      if (hi > step)
+      {
+        lo = hi - step;
+      }
+    }
+  }
+
+  // interpolation search, which needs only a few steps for nearly evenly
+  // spaced time stamps, with bisection as fallback for guaranteed O(log n)
+
+  int steps = 0;
+  while (hi - lo > 1)
+  {
+    std::size_t mid;
+    if (steps++ < max_interpolation_steps)
+    {
+      int64_t t_lo = stamp_[index(lo)];
+      int64_t t_hi = stamp_[index(hi)];
+      mid = lo + static_cast<std::size_t>(static_cast<double>(stamp - t_lo) / (t_hi - t_lo) * (hi - lo));
+
+      if (mid <= lo)
+      {
+        mid = lo + 1;
+      }
+      else if (mid >= hi)
+      {
+        mid = hi - 1;
+      }
+    }
+    else
+    {
+      mid = lo + (hi - lo) / 2;
+    }
+
+    if (stamp_[index(mid)] <= stamp)
+    {
+      lo = mid;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+void PoseTimeline::interpolate(std::size_t i, int64_t stamp, StampedPose& pose) const
+{
+  std::size_t k0 = index(i);
+  std::size_t k1 = index(i + 1);
+
+  double a = static_cast<double>(stamp - stamp_[k0]) / (stamp_[k1] - stamp_[k0]);
+
+  pose.stamp = stamp;
+
+  if (interpolation_ == Interpolation::NEAREST)
+  {
+    std::size_t k = a < 0.5 ? k0 : k1;
+    pose.x = x_[k];
+    pose.y = y_[k];
+    pose.z = z_[k];
+    pose.qx = qx_[k];
+    pose.qy = qy_[k];
+    pose.qz = qz_[k];
+    pose.qw = qw_[k];
+    return;
+  }
+
+  pose.x = x_[k0] + a * (x_[k1] - x_[k0]);
+  pose.y = y_[k0] + a * (y_[k1] - y_[k0]);
+  pose.z = z_[k0] + a * (z_[k1] - z_[k0]);
+
+  // slerp, using the shorter arc
+
+  double qx1 = qx_[k1], qy1 = qy_[k1], qz1 = qz_[k1], qw1 = qw_[k1];
+  double d = qx_[k0] * qx1 + qy_[k0] * qy1 + qz_[k0] * qz1 + qw_[k0] * qw1;
+  if (d < 0)
+  {
+    d = -d;
+    qx1 = -qx1;
+    qy1 = -qy1;
+    qz1 = -qz1;
+    qw1 = -qw1;
+  }
+
+  double s0, s1;
+  if (d > 0.9995)
+  {
+    // nearly identical orientations: normalized lerp is accurate enough and
+    // avoids division by sin(theta) ~ 0
+    s0 = 1 - a;
+    s1 = a;
+  }
+  else
+  {
+    double theta = std::acos(d);
+    double sin_theta = std::sin(theta);
+    s0 = std::sin((1 - a) * theta) / sin_theta;
+    s1 = std::sin(a * theta) / sin_theta;
+  }
+
+  pose.qx = s0 * qx_[k0] + s1 * qx1;
+  pose.qy = s0 * qy_[k0] + s1 * qy1;
+  pose.qz = s0 * qz_[k0] + s1 * qz1;
+  pose.qw = s0 * qw_[k0] + s1 * qw1;
+
+  double norm = std::sqrt(pose.qx * pose.qx + pose.qy * pose.qy + pose.qz * pose.qz + pose.qw * pose.qw);
+  pose.qx /= norm;
+  pose.qy /= norm;
+  pose.qz /= norm;
+  pose.qw /= norm;
+}
+
+bool PoseTimeline::lookup(int64_t stamp, StampedPose& pose) const
+{
+  if (size_ == 0 || stamp < startTime() || stamp > endTime())
+  {
+    return false;
+  }
+
+  if (stamp == endTime())
+  {
+    pose = at(size_ - 1);
+    return true;
+  }
+
+  interpolate(find(stamp, size_), stamp, pose);
+  return true;
+}
+
+std::size_t PoseTimeline::lookup(const int64_t* stamps, std::size_t n, StampedPose* poses, bool* valid) const
+{
+  if (size_ == 0)
+  {
+    if (valid)
+    {
+      for (std::size_t k = 0; k < n; k++)
+      {
+        valid[k] = false;
+      }
+    }
+    return 0;
+  }
+
+  int64_t t_start = startTime();
+  int64_t t_end = endTime();
+
+  std::size_t found = 0, hint = size_;
+  for (std::size_t k = 0; k < n; k++)
+  {
+    int64_t stamp = stamps[k];
+    bool ok = stamp >= t_start && stamp <= t_end;
+
+    if (ok)
+    {
+      if (stamp == t_end)
+      {
+        poses[k] = at(size_ - 1);
+      }
+      else
+      {
+        // galloping from the previous result only pays off for sorted time stamps
+        if (k > 0 && stamp < stamps[k - 1])
+        {
+          hint = size_;
+        }
+
+        hint = find(stamp, hint);
+        interpolate(hint, stamp, poses[k]);
+      }
+      found++;
+    }
+
+    if (valid)
+    {
+      valid[k] = ok;
+    }
+  }
+
+  return found;
+}
+
+std::size_t PoseTimeline::lookup(const std::vector<int64_t>& stamps, std::vector<StampedPose>& poses,
+                                 std::vector<bool>* valid) const
+{
+  poses.resize(stamps.size());
+
+  if (valid == 0)
+  {
+    return lookup(stamps.data(), stamps.size(), poses.data());
+  }
+
+  // std::vector<bool> does not provide a contiguous array of bool
+
+  std::unique_ptr<bool[]> v(new bool[stamps.size()]);
+  std::size_t found = lookup(stamps.data(), stamps.size(), poses.data(), v.get());
+  valid->assign(v.get(), v.get() + stamps.size());
+  return found;
+}
+}
+}
@@ -0,0 +1,239 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_POSE_TIMELINE_H
+#define RC_DYNAMICS_API_POSE_TIMELINE_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+#include "roboception/msgs/frame.pb.h"
+#include "roboception/msgs/dynamics.pb.h"
+#include "roboception/msgs/trajectory.pb.h"
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Converts a protobuf time stamp into nanoseconds since epoch.
+ */
+inline int64_t toNanoseconds(const roboception::msgs::Time& time)
+{
+  return static_cast<int64_t>(time.sec()) * 1000000000 + time.nsec();
+}
+
+/**
+ * Plain pose with time stamp, i.e. position and orientation as unit
+ * quaternion, as used by the PoseTimeline.
+ */
+struct StampedPose
+{
+  int64_t stamp;  ///< time stamp in nanoseconds since epoch
+  double x, y, z;
+  double qx, qy, qz, qw;
+};
+
+/// Converts a PoseStamped message, e.g. the pose of a Frame, into a StampedPose
+StampedPose toStampedPose(const roboception::msgs::PoseStamped& pose);
+
+/**
+ * Time-indexed sequence of poses for looking up the pose at arbitrary time
+ * stamps, e.g. for tagging camera images or other sensor data.
+ *
+ * Poses are kept sorted by time stamp in contiguous arrays (one per
+ * component). Lookups use interpolation search, falling back to binary search
+ * if the time stamps are not evenly spaced, and interpolate between the two
+ * neighbouring poses (linear for position, slerp for orientation).
+ *
+ * A timeline can either be unbounded, e.g. for a trajectory queried by
+ * RemoteInterface::getSlamTrajectory(...), or bounded to a fixed capacity.
+ * A bounded timeline works as ring buffer, i.e. adding a pose to a full
+ * timeline drops the oldest pose, which makes it suitable for being fed live
+ * from the 'pose' or 'dynamics' stream.
+ *
+ * NOTE: A PoseTimeline is not thread-safe. If it is fed and queried from
+ * different threads, access must be synchronized by the user.
+ */
+class PoseTimeline
+{
+public:
+  enum class Interpolation
+  {
+    NEAREST,  ///< return the pose closest in time
+    LINEAR    ///< lerp position and slerp orientation
+  };
+
+  /**
+   * Creates an empty timeline.
+   *
+   * @param capacity maximum number of poses kept, or 0 for an unbounded timeline
+   * @param interpolation interpolation method for lookups between poses
+   */
+  explicit PoseTimeline(std::size_t capacity = 0, Interpolation interpolation = Interpolation::LINEAR);
+
+  /**
+   * Creates an unbounded timeline from all poses of a trajectory.
+   */
+  static PoseTimeline fromTrajectory(const roboception::msgs::Trajectory& trajectory,
+                                     Interpolation interpolation = Interpolation::LINEAR);
+
+  /**
+   * Appends a pose. Poses must be added in order of increasing time stamps,
+   * poses that are not newer than the latest one are ignored.
+   *
+   * @return true if pose was added
+   */
+  bool add(const StampedPose& pose);
+
+  /// Appends the pose of a PoseStamped message, see add(const StampedPose&)
+  bool add(const roboception::msgs::PoseStamped& pose);
+
+  /// Appends the pose of a Frame message, e.g. of the 'pose' stream
+  bool add(const roboception::msgs::Frame& frame);
+
+  /// Appends the pose of a Dynamics message, i.e. of the 'dynamics' stream
+  bool add(const roboception::msgs::Dynamics& dynamics);
+
+  /**
+   * Right-multiplies all poses with the given transformation, e.g. with the
+   * cam2imu transformation (see RemoteInterface::getCam2ImuTransform()) for
+   * getting poses of the camera instead of the IMU. The time stamp of the
+   * transformation is ignored.
+   */
+  void transform(const StampedPose& transformation);
+
+  /**
+   * Removes all poses.
+   */
+  void clear();
+
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  /**
+   * Returns the capacity of a bounded timeline, or 0 if unbounded.
+   */
+  std::size_t capacity() const
+  {
+    return bounded_ ? stamp_.size() : 0;
+  }
+
+  /**
+   * Returns the time stamp of the oldest pose. Must not be called if empty.
+   */
+  int64_t startTime() const
+  {
+    return stamp_[index(0)];
+  }
+
+  /**
+   * Returns the time stamp of the latest pose. Must not be called if empty.
+   */
+  int64_t endTime() const
+  {
+    return stamp_[index(size_ - 1)];
+  }
+
+  /**
+   * Returns the i-th oldest pose.
+   */
+  StampedPose at(std::size_t i) const;
+
+  /**
+   * Looks up the pose at the given time stamp.
+   *
+   * @param stamp time stamp in nanoseconds since epoch
+   * @param pose interpolated pose (only valid if returned true)
+   * @return false if the time stamp is outside of the time range of the timeline
+   */
+  bool lookup(int64_t stamp, StampedPose& pose) const;
+
+  /**
+   * Looks up the poses at the given time stamps in one batch.
+   *
+   * The batch is most efficient if the time stamps are sorted, since each
+   * search then starts from the result of the previous one, but any order is
+   * allowed.
+   *
+   * @param stamps time stamps in nanoseconds since epoch
+   * @param n number of time stamps
+   * @param poses array of at least n poses for storing the results
+   * @param valid optional array of at least n flags, set to false if the respective time stamp is out of range
+   * @return number of time stamps for which a pose could be looked up
+   */
+  std::size_t lookup(const int64_t* stamps, std::size_t n, StampedPose* poses, bool* valid = 0) const;
+
+  /**
+   * Convenience version of the batch lookup for vectors.
+   */
+  std::size_t lookup(const std::vector<int64_t>& stamps, std::vector<StampedPose>& poses,
+                     std::vector<bool>* valid = 0) const;
+
+protected:
+  /// Maps logical index (0 is the oldest pose) to index in storage arrays
+  std::size_t index(std::size_t i) const
+  {
+    std::size_t k = start_ + i;
+    return k >= wrap_ ? k - wrap_ : k;
+  }
+
+  /**
+   * Returns logical index i with stamp(i) <= stamp < stamp(i+1), starting
+   * search at the logical index hint. Requires startTime() <= stamp < endTime().
+   */
+  std::size_t find(int64_t stamp, std::size_t hint) const;
+
+  void interpolate(std::size_t i, int64_t stamp, StampedPose& pose) const;
+
+  bool bounded_;
+  Interpolation interpolation_;
+  std::size_t start_, size_, wrap_;
+
+  // poses in structure-of-arrays layout
+  std::vector<int64_t> stamp_;
+  std::vector<double> x_, y_, z_;
+  std::vector<double> qx_, qy_, qz_, qw_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_POSE_TIMELINE_H
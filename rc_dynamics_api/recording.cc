@@ -0,0 +1,862 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "recording.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <errno.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+const char file_magic[8] = { 'R', 'C', 'D', 'Y', 'N', 'R', 'E', 'C' };
+const uint32_t file_version = 1;
+const uint32_t block_magic = 0x4b424352;  // "RCBK"
+const uint32_t index_magic = 0x58494352;  // "RCIX"
+
+struct StreamEntry
+{
+  char name[32];
+  char pb_msg_type[32];
+};
+
+struct FileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t num_streams;
+  int64_t created;
+  StreamEntry streams[RecordingWriter::MAX_STREAMS];
+  char reserved[40];
+};
+
+struct BlockHeader
+{
+  uint32_t magic;
+  uint32_t count;
+  uint32_t size;  // number of bytes of all messages following the header
+  uint32_t streams;  // bit mask of the streams in the block, 0 in older recordings
+  int64_t first_stamp;
+  int64_t last_stamp;
+};
+
+struct MessageHeader
+{
+  int64_t host_stamp;
+  uint32_t size;
+  uint16_t stream;
+  uint16_t flags;
+};
+
+struct IndexEntry
+{
+  uint64_t offset;
+  int64_t first_stamp;
+  int64_t last_stamp;
+  uint32_t count;
+  uint32_t streams;  // bit mask of the streams in the block, 0 in older recordings
+};
+
+struct Trailer
+{
+  uint64_t index_offset;
+  uint32_t count;
+  uint32_t magic;
+};
+
+static_assert(sizeof(FileHeader) == 1024, "Unexpected size of recording file header");
+static_assert(sizeof(BlockHeader) == 32, "Unexpected size of recording block header");
+static_assert(sizeof(MessageHeader) == 16, "Unexpected size of recording message header");
+static_assert(sizeof(IndexEntry) == 32, "Unexpected size of recording index entry");
+static_assert(sizeof(Trailer) == 16, "Unexpected size of recording trailer");
+
+void copyName(char* dest, const std::string& src, std::size_t n)
+{
+  if (src.size() >= n)
+  {
+    throw std::invalid_argument("Name too long for recording: " + src);
+  }
+  std::memset(dest, 0, n);
+  std::memcpy(dest, src.data(), src.size());
+}
+
+std::string getName(const char* src, std::size_t n)
+{
+  return std::string(src, strnlen(src, n));
+}
+
+template <class T>
+T load(const char* p)
+{
+  T ret;
+  std::memcpy(&ret, p, sizeof(T));
+  return ret;
+}
+}
+
+namespace rec
+{
+/**
+ * Appends data to a file through a large, page aligned buffer. With direct
+ * I/O, only whole pages are written, so that the last partial page is
+ * written again together with the following data.
+ */
+class FileSink
+{
+public:
+  FileSink(const std::string& filename, bool direct_io)
+    : filename_(filename), direct_(false), buffer_(0), fill_(0), offset_(0)
+  {
+#ifdef WIN32
+    (void)direct_io;
+    file_ = std::fopen(filename.c_str(), "wb");
+    if (!file_)
+    {
+      throw std::runtime_error("Cannot create recording file '" + filename + "': " + std::strerror(errno));
+    }
+    std::setvbuf(file_, NULL, _IONBF, 0);
+    buffer_ = static_cast<char*>(_aligned_malloc(buffer_size, page_size));
+#else
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    fd_ = -1;
+#ifdef O_DIRECT
+    if (direct_io)
+    {
+      // not all file systems support direct I/O, e.g. tmpfs
+      fd_ = ::open(filename.c_str(), flags | O_DIRECT, 0644);
+      direct_ = (fd_ >= 0);
+    }
+#else
+    (void)direct_io;
+#endif
+    if (fd_ < 0)
+    {
+      fd_ = ::open(filename.c_str(), flags, 0644);
+    }
+
+    if (fd_ < 0)
+    {
+      throw std::runtime_error("Cannot create recording file '" + filename + "': " + std::strerror(errno));
+    }
+
+    void* p = 0;
+    if (posix_memalign(&p, page_size, buffer_size) == 0)
+    {
+      buffer_ = static_cast<char*>(p);
+    }
+#endif
+
+    if (!buffer_)
+    {
+      closeFile();
+      throw std::bad_alloc();
+    }
+  }
+
+  ~FileSink()
+  {
+    closeFile();
+#ifdef WIN32
+    _aligned_free(buffer_);
+#else
+    free(buffer_);
+#endif
+  }
+
+  /// Returns true if the file is written with direct I/O
+  bool isDirect() const
+  {
+    return direct_;
+  }
+
+  void write(const void* data, std::size_t size)
+  {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0)
+    {
+      std::size_t n = std::min(size, buffer_size - fill_);
+      std::memcpy(buffer_ + fill_, p, n);
+      fill_ += n;
+      p += n;
+      size -= n;
+
+      if (fill_ == buffer_size)
+      {
+        writeAt(buffer_, buffer_size, offset_);
+        offset_ += buffer_size;
+        fill_ = 0;
+      }
+    }
+  }
+
+  void flush()
+  {
+    if (fill_ == 0)
+    {
+      return;
+    }
+
+    if (direct_)
+    {
+      // write whole pages, but keep the last partial page in the buffer
+      std::size_t n = (fill_ + page_size - 1) / page_size * page_size;
+      std::memset(buffer_ + fill_, 0, n - fill_);
+      writeAt(buffer_, n, offset_);
+
+      std::size_t complete = fill_ / page_size * page_size;
+      std::memmove(buffer_, buffer_ + complete, fill_ - complete);
+      offset_ += complete;
+      fill_ -= complete;
+    }
+    else
+    {
+      writeAt(buffer_, fill_, offset_);
+      offset_ += fill_;
+      fill_ = 0;
+    }
+  }
+
+  void close()
+  {
+    flush();
+
+#ifndef WIN32
+    // remove the padding of the last page
+    if (direct_ && ftruncate(fd_, static_cast<off_t>(offset_ + fill_)) < 0)
+    {
+      throw std::runtime_error("Cannot write to recording file '" + filename_ + "': " + std::strerror(errno));
+    }
+#endif
+
+    closeFile();
+  }
+
+private:
+  static const std::size_t page_size = 4096;
+  static const std::size_t buffer_size = 1 << 20;
+
+  void writeAt(const char* data, std::size_t size, uint64_t offset)
+  {
+#ifdef WIN32
+    bool ok = (_fseeki64(file_, static_cast<long long>(offset), SEEK_SET) == 0 &&
+               std::fwrite(data, 1, size, file_) == size);
+#else
+    bool ok = true;
+    while (ok && size > 0)
+    {
+      ssize_t n = TEMP_FAILURE_RETRY(pwrite(fd_, data, size, static_cast<off_t>(offset)));
+      ok = (n > 0);
+      if (ok)
+      {
+        data += n;
+        size -= static_cast<std::size_t>(n);
+        offset += static_cast<uint64_t>(n);
+      }
+    }
+#endif
+
+    if (!ok)
+    {
+      throw std::runtime_error("Cannot write to recording file '" + filename_ + "': " + std::strerror(errno));
+    }
+  }
+
+  void closeFile()
+  {
+#ifdef WIN32
+    if (file_)
+    {
+      std::fclose(file_);
+    }
+    file_ = 0;
+#else
+    if (fd_ >= 0)
+    {
+      ::close(fd_);
+    }
+    fd_ = -1;
+#endif
+  }
+
+  std::string filename_;
+#ifdef WIN32
+  std::FILE* file_;
+#else
+  int fd_;
+#endif
+  bool direct_;
+  char* buffer_;
+  std::size_t fill_;  // number of bytes in buffer
+  uint64_t offset_;   // file offset of the start of the buffer
+};
+}
+
+RecordingWriter::Ptr RecordingWriter::create(const std::string& filename, const std::vector<RecordingStream>& streams,
+                                             std::size_t block_size, bool direct_io)
+{
+  return Ptr(new RecordingWriter(filename, streams, block_size, direct_io));
+}
+
+RecordingWriter::Ptr RecordingWriter::create(const std::string& filename, const std::string& stream_name,
+                                             const std::string& pb_msg_type)
+{
+  return create(filename, { { stream_name, pb_msg_type } });
+}
+
+RecordingWriter::RecordingWriter(const std::string& filename, const std::vector<RecordingStream>& streams,
+                                 std::size_t block_size, bool direct_io)
+  : streams_(streams)
+  , direct_io_(direct_io)
+  , num_streams_(streams.size())
+  , block_size_(block_size)
+  , count_(0)
+  , file_size_(0)
+{
+  if (streams.empty() || streams.size() > MAX_STREAMS)
+  {
+    throw std::invalid_argument("Number of streams of a recording must be between 1 and " +
+                                std::to_string(MAX_STREAMS));
+  }
+
+  block_.reserve(block_size_ + sizeof(BlockHeader));
+  block_.resize(sizeof(BlockHeader));
+  current_.count = 0;
+  current_.streams = 0;
+
+  open(filename);
+}
+
+void RecordingWriter::open(const std::string& filename)
+{
+  FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, file_magic, sizeof(file_magic));
+  header.version = file_version;
+  header.num_streams = static_cast<uint32_t>(streams_.size());
+  header.created =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  for (std::size_t i = 0; i < streams_.size(); i++)
+  {
+    copyName(header.streams[i].name, streams_[i].name, sizeof(header.streams[i].name));
+    copyName(header.streams[i].pb_msg_type, streams_[i].pb_msg_type, sizeof(header.streams[i].pb_msg_type));
+  }
+
+  filename_ = filename;
+  file_.reset(new rec::FileSink(filename, direct_io_));
+  index_.clear();
+  file_size_ = 0;
+
+  writeFile(&header, sizeof(header));
+}
+
+RecordingWriter::~RecordingWriter()
+{
+  try
+  {
+    close();
+  }
+  catch (const std::exception&)
+  {
+    // destructor must not throw
+  }
+}
+
+void RecordingWriter::write(uint16_t stream, int64_t host_stamp, const char* data, std::size_t size)
+{
+  if (!file_)
+  {
+    throw std::runtime_error("Recording '" + filename_ + "' is already closed");
+  }
+
+  if (stream >= num_streams_)
+  {
+    throw std::invalid_argument("Invalid stream index for recording: " + std::to_string(stream));
+  }
+
+  if (current_.count > 0 && block_.size() + sizeof(MessageHeader) + size > block_size_ + sizeof(BlockHeader))
+  {
+    writeBlock();
+  }
+
+  MessageHeader mh;
+  mh.host_stamp = host_stamp;
+  mh.size = static_cast<uint32_t>(size);
+  mh.stream = stream;
+  mh.flags = 0;
+
+  const char* p = reinterpret_cast<const char*>(&mh);
+  block_.insert(block_.end(), p, p + sizeof(mh));
+  block_.insert(block_.end(), data, data + size);
+
+  if (current_.count == 0)
+  {
+    current_.first_stamp = host_stamp;
+  }
+  current_.last_stamp = host_stamp;
+  current_.count++;
+  current_.streams |= 1u << stream;
+  count_++;
+}
+
+void RecordingWriter::flush()
+{
+  if (file_)
+  {
+    writeBlock();
+    file_->flush();
+  }
+}
+
+void RecordingWriter::writeBlock()
+{
+  if (current_.count == 0)
+  {
+    return;
+  }
+
+  BlockHeader bh;
+  bh.magic = block_magic;
+  bh.count = current_.count;
+  bh.size = static_cast<uint32_t>(block_.size() - sizeof(BlockHeader));
+  bh.streams = current_.streams;
+  bh.first_stamp = current_.first_stamp;
+  bh.last_stamp = current_.last_stamp;
+  std::memcpy(block_.data(), &bh, sizeof(bh));
+
+  current_.offset = file_size_;
+  writeFile(block_.data(), block_.size());
+  index_.push_back(current_);
+
+  block_.resize(sizeof(BlockHeader));
+  current_.count = 0;
+  current_.streams = 0;
+}
+
+void RecordingWriter::close()
+{
+  if (!file_)
+  {
+    return;
+  }
+
+  try
+  {
+    writeBlock();
+
+    Trailer trailer;
+    trailer.index_offset = file_size_;
+    trailer.count = static_cast<uint32_t>(index_.size());
+    trailer.magic = index_magic;
+
+    std::vector<IndexEntry> entries(index_.size());
+    for (std::size_t i = 0; i < index_.size(); i++)
+    {
+      entries[i].offset = index_[i].offset;
+      entries[i].first_stamp = index_[i].first_stamp;
+      entries[i].last_stamp = index_[i].last_stamp;
+      entries[i].count = index_[i].count;
+      entries[i].streams = index_[i].streams;
+    }
+
+    if (!entries.empty())
+    {
+      writeFile(entries.data(), entries.size() * sizeof(IndexEntry));
+    }
+    writeFile(&trailer, sizeof(trailer));
+
+    file_->close();
+  }
+  catch (...)
+  {
+    file_.reset();
+    throw;
+  }
+
+  file_.reset();
+}
+
+void RecordingWriter::rotate(const std::string& filename)
+{
+  if (!file_)
+  {
+    throw std::runtime_error("Recording '" + filename_ + "' is already closed");
+  }
+
+  RecordingWriter::close();
+  open(filename);
+}
+
+void RecordingWriter::writeFile(const void* data, std::size_t size)
+{
+  file_->write(data, size);
+  file_size_ += size;
+}
+
+RecordingReader::Ptr RecordingReader::open(const std::string& filename)
+{
+  return Ptr(new RecordingReader(filename));
+}
+
+RecordingReader::RecordingReader(const std::string& filename)
+  : filename_(filename), data_(0), size_(0), count_(0), complete_(false)
+{
+#ifdef WIN32
+  file_handle_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file_handle_ == INVALID_HANDLE_VALUE)
+  {
+    throw std::runtime_error("Cannot open recording file '" + filename + "'");
+  }
+
+  LARGE_INTEGER size;
+  GetFileSizeEx(file_handle_, &size);
+  size_ = static_cast<std::size_t>(size.QuadPart);
+
+  mapping_handle_ = 0;
+  if (size_ >= sizeof(FileHeader))
+  {
+    mapping_handle_ = CreateFileMappingA(file_handle_, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping_handle_)
+    {
+      data_ = static_cast<const char*>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+    }
+
+    if (!data_)
+    {
+      if (mapping_handle_)
+      {
+        CloseHandle(mapping_handle_);
+      }
+      CloseHandle(file_handle_);
+      throw std::runtime_error("Cannot map recording file '" + filename + "'");
+    }
+  }
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Cannot open recording file '" + filename + "': " + std::strerror(errno));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) < 0)
+  {
+    int e = errno;
+    ::close(fd);
+    throw std::runtime_error("Cannot open recording file '" + filename + "': " + std::strerror(e));
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+
+  if (size_ >= sizeof(FileHeader))
+  {
+    void* p = mmap(NULL, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+    {
+      int e = errno;
+      ::close(fd);
+      throw std::runtime_error("Cannot map recording file '" + filename + "': " + std::strerror(e));
+    }
+    data_ = static_cast<const char*>(p);
+
+    // messages are usually read sequentially
+    madvise(p, size_, MADV_SEQUENTIAL);
+  }
+
+  // the mapping stays valid after closing the file descriptor
+  ::close(fd);
+#endif
+
+  FileHeader header;
+  if (data_)
+  {
+    header = load<FileHeader>(data_);
+  }
+
+  if (!data_ || std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0)
+  {
+    unmap();
+    throw std::invalid_argument("File '" + filename + "' is not a recording");
+  }
+
+  if (header.version != file_version || header.num_streams > RecordingWriter::MAX_STREAMS)
+  {
+    unmap();
+    throw std::invalid_argument("Unsupported version of recording '" + filename + "'");
+  }
+
+  for (uint32_t i = 0; i < header.num_streams; i++)
+  {
+    RecordingStream stream;
+    stream.name = getName(header.streams[i].name, sizeof(header.streams[i].name));
+    stream.pb_msg_type = getName(header.streams[i].pb_msg_type, sizeof(header.streams[i].pb_msg_type));
+    streams_.push_back(stream);
+  }
+
+  // use the block index at the end of the file if the recording has been closed properly
+
+  if (size_ >= sizeof(FileHeader) + sizeof(Trailer))
+  {
+    Trailer trailer = load<Trailer>(data_ + size_ - sizeof(Trailer));
+    if (trailer.magic == index_magic && trailer.index_offset >= sizeof(FileHeader) && trailer.index_offset <= size_ &&
+        trailer.index_offset + static_cast<uint64_t>(trailer.count) * sizeof(IndexEntry) + sizeof(Trailer) == size_)
+    {
+      blocks_.resize(trailer.count);
+      complete_ = true;
+      for (uint32_t i = 0; i < trailer.count && complete_; i++)
+      {
+        IndexEntry entry = load<IndexEntry>(data_ + trailer.index_offset + i * sizeof(IndexEntry));
+        blocks_[i].offset = entry.offset;
+        blocks_[i].first_stamp = entry.first_stamp;
+        blocks_[i].last_stamp = entry.last_stamp;
+        blocks_[i].count = entry.count;
+        blocks_[i].streams = entry.streams != 0 ? entry.streams : ~0u;
+        count_ += entry.count;
+
+        // the index is only trusted if all blocks lie within the file before the index
+        complete_ = entry.offset >= sizeof(FileHeader) && isValidBlock(entry.offset, trailer.index_offset);
+      }
+
+      if (!complete_)
+      {
+        blocks_.clear();
+        count_ = 0;
+      }
+    }
+  }
+
+  if (!complete_)
+  {
+    scanBlocks(size_);
+  }
+}
+
+RecordingReader::~RecordingReader()
+{
+  unmap();
+}
+
+void RecordingReader::unmap()
+{
+#ifdef WIN32
+  if (data_)
+  {
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_handle_);
+  }
+  if (file_handle_ != INVALID_HANDLE_VALUE)
+  {
+    CloseHandle(file_handle_);
+  }
+  file_handle_ = INVALID_HANDLE_VALUE;
+#else
+  if (data_)
+  {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+  data_ = 0;
+}
+
+bool RecordingReader::isValidBlock(uint64_t offset, uint64_t end) const
+{
+  if (offset > end || end - offset < sizeof(BlockHeader))
+  {
+    return false;
+  }
+
+  BlockHeader bh = load<BlockHeader>(data_ + offset);
+  return bh.magic == block_magic && bh.size <= end - offset - sizeof(BlockHeader);
+}
+
+void RecordingReader::scanBlocks(uint64_t end)
+{
+  uint64_t pos = sizeof(FileHeader);
+  while (isValidBlock(pos, end))
+  {
+    BlockHeader bh = load<BlockHeader>(data_ + pos);
+
+    RecordingBlock block;
+    block.offset = pos;
+    block.first_stamp = bh.first_stamp;
+    block.last_stamp = bh.last_stamp;
+    block.count = bh.count;
+    block.streams = bh.streams != 0 ? bh.streams : ~0u;
+    blocks_.push_back(block);
+    count_ += bh.count;
+
+    pos += sizeof(BlockHeader) + bh.size;
+  }
+}
+
+int64_t RecordingReader::getStartTime() const
+{
+  return blocks_.empty() ? 0 : blocks_.front().first_stamp;
+}
+
+int64_t RecordingReader::getEndTime() const
+{
+  return blocks_.empty() ? 0 : blocks_.back().last_stamp;
+}
+
+RecordingReader::Cursor::Cursor(const RecordingReader* reader) : reader_(reader), streams_(~0u)
+{
+  rewind();
+}
+
+void RecordingReader::Cursor::rewind()
+{
+  block_ = 0;
+  pos_ = 0;
+  end_ = 0;
+  remaining_ = 0;
+}
+
+bool RecordingReader::Cursor::nextBlock()
+{
+  // skip blocks without messages of the selected streams, and blocks that
+  // do not lie within the file, e.g. of a file that has been truncated
+  // after opening it
+
+  while (block_ < reader_->blocks_.size() && ((reader_->blocks_[block_].streams & streams_) == 0 ||
+                                               !reader_->isValidBlock(reader_->blocks_[block_].offset, reader_->size_)))
+  {
+    block_++;
+  }
+
+  if (block_ >= reader_->blocks_.size())
+  {
+    return false;
+  }
+
+  const RecordingBlock& block = reader_->blocks_[block_++];
+  const char* p = reader_->data_ + block.offset;
+  BlockHeader bh = load<BlockHeader>(p);
+
+  pos_ = p + sizeof(BlockHeader);
+  end_ = pos_ + bh.size;
+  remaining_ = bh.count;
+  return true;
+}
+
+bool RecordingReader::Cursor::isValidMessage() const
+{
+  std::size_t available = static_cast<std::size_t>(end_ - pos_);
+  return available >= sizeof(MessageHeader) &&
+         load<MessageHeader>(pos_).size <= available - sizeof(MessageHeader);
+}
+
+bool RecordingReader::Cursor::next(RecordedMessage& msg)
+{
+  for (;;)
+  {
+    while (remaining_ == 0)
+    {
+      if (!nextBlock())
+      {
+        return false;
+      }
+    }
+
+    if (!isValidMessage())
+    {
+      // corrupted block, continue with the next one
+      remaining_ = 0;
+      continue;
+    }
+
+    MessageHeader mh = load<MessageHeader>(pos_);
+
+    msg.host_stamp = mh.host_stamp;
+    msg.stream = mh.stream;
+    msg.flags = mh.flags;
+    msg.data = pos_ + sizeof(MessageHeader);
+    msg.size = mh.size;
+
+    pos_ += sizeof(MessageHeader) + mh.size;
+    remaining_--;
+
+    if (mh.stream < 32 && ((1u << mh.stream) & streams_) != 0)
+    {
+      return true;
+    }
+  }
+}
+
+void RecordingReader::Cursor::seek(int64_t host_stamp)
+{
+  const std::vector<RecordingBlock>& blocks = reader_->blocks_;
+  auto it = std::lower_bound(blocks.begin(), blocks.end(), host_stamp,
+                             [](const RecordingBlock& b, int64_t t) { return b.last_stamp < t; });
+
+  rewind();
+  block_ = static_cast<std::size_t>(it - blocks.begin());
+  if (!nextBlock())
+  {
+    return;
+  }
+
+  // skip earlier messages within the block
+
+  while (remaining_ > 0 && isValidMessage())
+  {
+    MessageHeader mh = load<MessageHeader>(pos_);
+    if (mh.host_stamp >= host_stamp)
+    {
+      break;
+    }
+    pos_ += sizeof(MessageHeader) + mh.size;
+    remaining_--;
+  }
+}
+}
+}
@@ -0,0 +1,376 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_RECORDING_H
+#define RC_DYNAMICS_API_RECORDING_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace rec
+{
+class FileSink;
+}
+
+/**
+ * Description of a data stream contained in a recording.
+ */
+struct RecordingStream
+{
+  std::string name;         ///< name of the stream, e.g. "imu"
+  std::string pb_msg_type;  ///< protobuf message type, e.g. "Imu"
+};
+
+/**
+ * Index entry of a block of messages in a recording.
+ */
+struct RecordingBlock
+{
+  uint64_t offset;      ///< file offset of the block header
+  int64_t first_stamp;  ///< host time stamp of the first message in the block
+  int64_t last_stamp;   ///< host time stamp of the last message in the block
+  uint32_t count;       ///< number of messages in the block
+  uint32_t streams;     ///< bit mask of the streams with messages in the block, bit i for stream i
+};
+
+/**
+ * A message of a recording. The data pointer refers to the memory mapped
+ * file and stays valid as long as the RecordingReader exists.
+ */
+struct RecordedMessage
+{
+  int64_t host_stamp;  ///< receive time stamp in nanoseconds since epoch (system clock of the recording host)
+  uint16_t stream;     ///< index of the stream, see RecordingReader::getStream()
+  uint16_t flags;      ///< reserved, currently always 0
+  const char* data;    ///< serialized protobuf message
+  std::size_t size;    ///< size of the serialized message in bytes
+};
+
+/**
+ * Records the serialized messages of one or more data streams together with
+ * their host receive time stamps into a binary file.
+ *
+ * The file is append-only. Messages are collected into blocks in memory,
+ * which are written as a whole. Blocks are gathered in a large, page
+ * aligned output buffer, so that the file is written in few large chunks,
+ * optionally bypassing the page cache (direct I/O, only on Linux). Each block starts with a header that
+ * contains the number of messages and the time range, so that the file can
+ * be read even if the recording was interrupted. On close(), an index of
+ * all blocks is appended to the file, which allows opening and seeking
+ * without scanning. For long recordings, rotate() continues the recording
+ * in a new file (see also SegmentedRecordingWriter).
+ *
+ * File layout (all numbers in the native byte order of the recording host,
+ * i.e. little endian on x86 and ARM, recordings of big endian hosts cannot
+ * be read on little endian hosts and vice versa):
+ *
+ *   file header | block | block | ... | block index | trailer
+ *
+ * where a block consists of a block header followed by the messages, each
+ * of them being a message header (time stamp, size, stream index) followed
+ * by the serialized message.
+ *
+ * NOTE: A RecordingWriter is not thread-safe.
+ */
+class RecordingWriter
+{
+public:
+  using Ptr = std::shared_ptr<RecordingWriter>;
+
+  /// Maximum number of streams in one recording
+  static const std::size_t MAX_STREAMS = 15;
+
+  /**
+   * Creates a new recording file, replacing an existing one.
+   *
+   * @param filename name of the file
+   * @param streams streams that are contained in the recording
+   * @param block_size size of the message blocks in bytes
+   * @param direct_io write with O_DIRECT to bypass the page cache, if supported
+   */
+  static Ptr create(const std::string& filename, const std::vector<RecordingStream>& streams,
+                    std::size_t block_size = 65536, bool direct_io = false);
+
+  /**
+   * Creates a new recording file for a single stream, replacing an existing one.
+   *
+   * @param filename name of the file
+   * @param stream_name name of the stream, e.g. "imu"
+   * @param pb_msg_type protobuf message type of the stream, e.g. "Imu"
+   */
+  static Ptr create(const std::string& filename, const std::string& stream_name, const std::string& pb_msg_type);
+
+  /// Closes the recording
+  virtual ~RecordingWriter();
+
+  /**
+   * Appends a serialized message to the recording.
+   *
+   * @param stream index of the stream as given to create()
+   * @param host_stamp receive time stamp in nanoseconds since epoch
+   * @param data serialized message
+   * @param size size of the serialized message
+   */
+  virtual void write(uint16_t stream, int64_t host_stamp, const char* data, std::size_t size);
+
+  /**
+   * Writes the current block and the output buffer to the file. Messages
+   * that have been flushed survive a crash of the recording process.
+   */
+  void flush();
+
+  /**
+   * Writes the current block and the block index and closes the file. This
+   * is done automatically on destruction.
+   */
+  virtual void close();
+
+  /**
+   * Closes the current file like close() and continues the recording with
+   * the same streams in a new file, replacing an existing one.
+   *
+   * @param filename name of the new file
+   */
+  void rotate(const std::string& filename);
+
+  /// Returns the name of the current file
+  const std::string& getFilename() const
+  {
+    return filename_;
+  }
+
+  /// Returns the streams contained in the recording
+  const std::vector<RecordingStream>& getStreams() const
+  {
+    return streams_;
+  }
+
+  /// Returns the number of written messages of all files
+  uint64_t getMessageCount() const
+  {
+    return count_;
+  }
+
+  /// Returns the size of the current file including buffered data
+  uint64_t getFileSize() const
+  {
+    return file_size_;
+  }
+
+  /// Returns the host time stamp of the first message in the current file or 0 if there is none
+  int64_t getFileStartTime() const
+  {
+    return index_.empty() ? (current_.count > 0 ? current_.first_stamp : 0) : index_.front().first_stamp;
+  }
+
+protected:
+  RecordingWriter(const std::string& filename, const std::vector<RecordingStream>& streams,
+                  std::size_t block_size, bool direct_io);
+
+  void open(const std::string& filename);
+  void writeFile(const void* data, std::size_t size);
+  void writeBlock();
+
+  std::string filename_;
+  std::unique_ptr<rec::FileSink> file_;
+  std::vector<RecordingStream> streams_;
+  bool direct_io_;
+  std::size_t num_streams_;
+  std::size_t block_size_;
+  std::vector<char> block_;
+  RecordingBlock current_;
+  std::vector<RecordingBlock> index_;
+  uint64_t count_;
+  uint64_t file_size_;
+};
+
+/**
+ * Reads a recording of a RecordingWriter by mapping the file into memory.
+ * Messages are iterated without copying them.
+ */
+class RecordingReader
+{
+public:
+  using Ptr = std::shared_ptr<RecordingReader>;
+
+  /**
+   * Iterates over the messages of a recording in the order in which they
+   * were recorded.
+   */
+  class Cursor
+  {
+  public:
+    /**
+     * Returns the next message.
+     *
+     * @param msg next message
+     * @return false if there are no more messages
+     */
+    bool next(RecordedMessage& msg);
+
+    /**
+     * Moves the cursor to the first message with a host time stamp equal or
+     * later than the given one. Only the block index is searched, so that
+     * seeking is fast even for large recordings.
+     *
+     * @param host_stamp time stamp in nanoseconds since epoch
+     */
+    void seek(int64_t host_stamp);
+
+    /// Moves the cursor to the first message of the recording
+    void rewind();
+
+    /**
+     * Restricts the cursor to messages of the given streams. Blocks without
+     * messages of these streams are skipped without reading them.
+     *
+     * @param streams bit mask of streams, bit i for stream i
+     */
+    void setStreams(uint32_t streams)
+    {
+      streams_ = streams;
+    }
+
+  protected:
+    friend class RecordingReader;
+
+    explicit Cursor(const RecordingReader* reader);
+
+    bool nextBlock();
+
+    /// Returns true if the message at pos_ including its data lies within the current block
+    bool isValidMessage() const;
+
+    const RecordingReader* reader_;
+    std::size_t block_;     // index of the next block
+    const char* pos_;       // position of the next message in the current block
+    const char* end_;       // end of the current block
+    uint32_t remaining_;    // number of remaining messages in the current block
+    uint32_t streams_;      // bit mask of the returned streams
+  };
+
+  /**
+   * Opens a recording.
+   *
+   * @param filename name of the file
+   */
+  static Ptr open(const std::string& filename);
+
+  /// Unmaps the file
+  virtual ~RecordingReader();
+
+  /// Returns the name of the file
+  const std::string& getFilename() const
+  {
+    return filename_;
+  }
+
+  /// Returns the streams contained in the recording
+  const std::vector<RecordingStream>& getStreams() const
+  {
+    return streams_;
+  }
+
+  /// Returns the stream with the given index
+  const RecordingStream& getStream(uint16_t stream) const
+  {
+    return streams_.at(stream);
+  }
+
+  /// Returns the index of the blocks of the recording
+  const std::vector<RecordingBlock>& getBlocks() const
+  {
+    return blocks_;
+  }
+
+  /// Returns the total number of messages
+  uint64_t getMessageCount() const
+  {
+    return count_;
+  }
+
+  /// Returns the host time stamp of the first message or 0 if the recording is empty
+  int64_t getStartTime() const;
+
+  /// Returns the host time stamp of the last message or 0 if the recording is empty
+  int64_t getEndTime() const;
+
+  /**
+   * Returns true if the recording was properly closed. Otherwise, the
+   * block index has been reconstructed by scanning the file and incomplete
+   * data at the end of the file is ignored.
+   */
+  bool isComplete() const
+  {
+    return complete_;
+  }
+
+  /// Returns a cursor at the first message of the recording
+  Cursor cursor() const
+  {
+    return Cursor(this);
+  }
+
+protected:
+  explicit RecordingReader(const std::string& filename);
+
+  /// Returns true if there is a block at the offset that ends before the given end of the data
+  bool isValidBlock(uint64_t offset, uint64_t end) const;
+
+  void scanBlocks(uint64_t end);
+  void unmap();
+
+  std::string filename_;
+  const char* data_;
+  std::size_t size_;
+#ifdef WIN32
+  void* file_handle_;
+  void* mapping_handle_;
+#endif
+
+  std::vector<RecordingStream> streams_;
+  std::vector<RecordingBlock> blocks_;
+  uint64_t count_;
+  bool complete_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_RECORDING_H
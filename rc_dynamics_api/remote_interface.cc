@@ -35,10 +35,14 @@
 
 #include "remote_interface.h"
 #include "unexpected_receive_timeout.h"
+#include "data_sender.h"
 
 #include "json.hpp"
 #include <cpr/cpr.h>
+#include <atomic>
+#include <future>
 #include <regex>
+#include <thread>
 
 using namespace std;
 using json = nlohmann::json;
@@ -100,81 +104,117 @@ void handleCPRResponse(cpr::Response r)
 
 namespace {
 
-  vector<int> wait_before_retry = { 50, 200, 500, 1000, 2000};
+  // Metrics of the REST-API requests of one http method
+  struct RestMetrics {
+    explicit RestMetrics(const char* _method) : method(_method) {
+      MetricsRegistry::Ptr registry = MetricsRegistry::getDefault();
+      MetricsRegistry::Labels labels = { { "method", method } };
+      requests = &registry->counter("rc_dynamics_rest_requests_total", "REST-API requests, without retries", labels);
+      retries = &registry->counter("rc_dynamics_rest_retries_total", "Retries of rejected REST-API requests", labels);
+      too_many_requests = &registry->counter("rc_dynamics_rest_too_many_requests_total",
+                                             "REST-API responses with http error code 429", labels);
+      failures = &registry->counter("rc_dynamics_rest_failures_total",
+                                    "REST-API requests without response or given up after retries", labels);
+      duration = &registry->histogram("rc_dynamics_rest_request_duration_seconds",
+                                      "Duration of REST-API requests, per attempt",
+                                      Histogram::exponentialBounds(1e-4, 2, 16), labels);
+    }
 
-  // Wrapper around cpr::Get requests which does retries in case of 429 response
-  cpr::Response cprGetWithRetry(cpr::Url url, cpr::Timeout timeout) {
-    for (int retry : wait_before_retry) {
-      auto response = cpr::Get(url, timeout, cpr::Header{ { "accept", "application/json" }});
-      if (response.status_code == 429) {
-        cout << "WARNING: Got http code 429 (too many requests) on "
-             << url << ". Retrying in " << retry << "ms..." << endl;
-#ifdef WIN32
-        Sleep(retry);
-#else
-        usleep(1000 * retry);
-#endif
-        continue;
+    // does the request with the scheduler and records every attempt
+    template <class F>
+    bool execute(RequestScheduler& scheduler, const cpr::Url& url, F attempt) {
+      RC_DYNAMICS_TRACE_SCOPE("rest", "request");
+
+      requests->inc();
+      bool first = true;
+      bool ok = scheduler.execute([&]() {
+        if (!first) {
+          retries->inc();
+        }
+        first = false;
+
+        RC_DYNAMICS_TRACE_SCOPE("rest", method);
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int status_code = attempt();
+        duration->observe(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+
+        if (status_code == 429) {
+          too_many_requests->inc();
+          cout << "WARNING: Got http code 429 (too many requests) on " << url << ". Retrying..." << endl;
+          return false;
+        }
+        if (status_code == 0) {
+          failures->inc();
+        }
+        return true;
+      });
+      if (!ok) {
+        failures->inc();
       }
-      return response;
+      return ok;
     }
-    throw RemoteInterface::TooManyRequests(url);
-  }
 
-  // Wrapper around cpr::Put requests which does retries in case of 429 response
-  cpr::Response cprPutWithRetry(cpr::Url url, cpr::Timeout timeout, cpr::Body body = cpr::Body{}) {
+    const char* method;
+    Counter* requests;
+    Counter* retries;
+    Counter* too_many_requests;
+    Counter* failures;
+    Histogram* duration;
+  };
+
+  // Wrapper around cpr::Get requests which does retries in case of 429 response
+  cpr::Response cprGetWithRetry(RequestScheduler& scheduler, cpr::Url url, cpr::Timeout timeout) {
+    static RestMetrics metrics("GET");
+    cpr::Response response;
+    bool ok = metrics.execute(scheduler, url, [&]() {
+      response = cpr::Get(url, timeout, cpr::Header{ { "accept", "application/json" }});
+      return response.status_code;
+    });
+    if (!ok) {
+      throw RemoteInterface::TooManyRequests(url);
+    }
+    return response;
+  }
 
-    // we need different headers if body is empty or not
-    cpr::Header header;
+  // Returns the headers for PUT and DELETE requests, which differ if body is empty or not
+  cpr::Header getHeader(const cpr::Body& body) {
     if (body == cpr::Body{}) {
-      header = cpr::Header{ { "accept", "application/json" }};
-    } else {
-      header = cpr::Header{ { "accept", "application/json" }, { "Content-Type", "application/json" }};
-    }
-
-    for (int retry : wait_before_retry) {
-      auto response = cpr::Put(url, timeout, body, header);
-      if (response.status_code==429) {
-        cout << "WARNING: Got http code 429 (too many requests) on "
-             << url << ". Retrying in " << retry << "ms..." << endl;
-#ifdef WIN32
-        Sleep(retry);
-#else
-        usleep(1000 * retry);
-#endif
-        continue;
-      }
-      return response;
+      return cpr::Header{ { "accept", "application/json" }};
     }
-    throw RemoteInterface::TooManyRequests(url);
+    return cpr::Header{ { "accept", "application/json" }, { "Content-Type", "application/json" }};
   }
 
-  // Wrapper around cpr::Deletee requests which does retries in case of 429 response
-  cpr::Response cprDeleteWithRetry(cpr::Url url, cpr::Timeout timeout, cpr::Body body = cpr::Body{}) {
+  // Wrapper around cpr::Put requests which does retries in case of 429 response
+  cpr::Response cprPutWithRetry(RequestScheduler& scheduler, cpr::Url url, cpr::Timeout timeout,
+                                cpr::Body body = cpr::Body{}) {
+    static RestMetrics metrics("PUT");
+    cpr::Header header = getHeader(body);
+    cpr::Response response;
+    bool ok = metrics.execute(scheduler, url, [&]() {
+      response = cpr::Put(url, timeout, body, header);
+      return response.status_code;
+    });
+    if (!ok) {
+      throw RemoteInterface::TooManyRequests(url);
+    }
+    return response;
+  }
 
-    // we need different headers if body is empty or not
-    cpr::Header header;
-    if (body == cpr::Body{}) {
-      header = cpr::Header{ { "accept", "application/json" }};
-    } else {
-      header = cpr::Header{ { "accept", "application/json" }, { "Content-Type", "application/json" }};
-    }
-
-    for (int retry : wait_before_retry) {
-      auto response = cpr::Delete(url, timeout, body, header);
-      if (response.status_code==429) {
-        cout << "WARNING: Got http code 429 (too many requests) on "
-             << url << ". Retrying in " << retry << "ms..." << endl;
-#ifdef WIN32
-        Sleep(retry);
-#else
-        usleep(1000 * retry);
-#endif
-        continue;
-      }
-      return response;
+  // Wrapper around cpr::Delete requests which does retries in case of 429 response
+  cpr::Response cprDeleteWithRetry(RequestScheduler& scheduler, cpr::Url url, cpr::Timeout timeout,
+                                   cpr::Body body = cpr::Body{}) {
+    static RestMetrics metrics("DELETE");
+    cpr::Header header = getHeader(body);
+    cpr::Response response;
+    bool ok = metrics.execute(scheduler, url, [&]() {
+      response = cpr::Delete(url, timeout, body, header);
+      return response.status_code;
+    });
+    if (!ok) {
+      throw RemoteInterface::TooManyRequests(url);
     }
-    throw RemoteInterface::TooManyRequests(url);
+    return response;
   }
 
 }
@@ -193,8 +233,30 @@ public:
     return shared_ptr<TrackedDataReceiver>(new TrackedDataReceiver(ip_address, port, stream, creator));
   }
 
+  // Multicast receivers do not remove the destination, since it is shared
+  static shared_ptr<TrackedDataReceiver> createMulticast(const string& group, unsigned int port,
+                                                         const string& interface_ip, const string& stream)
+  {
+    return shared_ptr<TrackedDataReceiver>(new TrackedDataReceiver(group, port, interface_ip, stream));
+  }
+
+  const string& getStream() const
+  {
+    return stream_;
+  }
+
+  const string& getDestination() const
+  {
+    return dest_;
+  }
+
   virtual ~TrackedDataReceiver()
   {
+    if (!creator_)
+    {
+      return;
+    }
+
     try
     {
       creator_->deleteDestinationFromStream(stream_, dest_);
@@ -209,7 +271,15 @@ public:
 protected:
   TrackedDataReceiver(const string& ip_address, unsigned int& port, const string& stream,
                       shared_ptr<RemoteInterface> creator)
-    : DataReceiver(ip_address, port), dest_(ip_address + ":" + to_string(port)), stream_(stream), creator_(creator)
+    : DataReceiver(ip_address, port, stream)
+    , dest_(ip_address + ":" + to_string(port))
+    , stream_(stream)
+    , creator_(creator)
+  {
+  }
+
+  TrackedDataReceiver(const string& group, unsigned int port, const string& interface_ip, const string& stream)
+    : DataReceiver(group, port, interface_ip, stream), dest_(group + ":" + to_string(port)), stream_(stream)
   {
   }
 
@@ -237,14 +307,17 @@ RemoteInterface::Ptr RemoteInterface::create(const string& rc_visard_inet_addrs,
 }
 
 RemoteInterface::RemoteInterface(const string& rc_visard_ip, unsigned int requests_timeout)
-  : visard_addrs_(rc_visard_ip), initialized_(false), visard_version_(0.0),
-    base_url_("http://" + visard_addrs_ + "/api/v1"), timeout_curl_(requests_timeout)
+  : visard_addrs_(rc_visard_ip), visard_ip_(rc_visard_ip.substr(0, rc_visard_ip.find(':'))),
+    initialized_(false), visard_version_(0.0),
+    base_url_("http://" + visard_addrs_ + "/api/v1"), timeout_curl_(requests_timeout),
+    scheduler_(RequestScheduler::getForDevice(visard_addrs_))
 {
   req_streams_.clear();
   protobuf_map_.clear();
 
-  // check if given string is a valid IP address
-  if (!isValidIPAddress(rc_visard_ip))
+  // check if given string is a valid IP address, optionally followed by a port number
+  if (!isValidIPAddress(visard_ip_) ||
+      (visard_ip_.size() < rc_visard_ip.size() && atoi(rc_visard_ip.c_str() + visard_ip_.size() + 1) <= 0))
   {
     throw invalid_argument("Given IP address is not a valid address: " + rc_visard_ip);
   }
@@ -285,7 +358,7 @@ bool RemoteInterface::checkSystemReady()
   avail_streams_.clear();
 
   cpr::Url url = cpr::Url{ base_url_ + "/system"};
-  auto response = cprGetWithRetry(url, cpr::Timeout{ timeout_curl_ });
+  auto response = cprGetWithRetry(*scheduler_, url, cpr::Timeout{ timeout_curl_ });
   if (response.status_code == 502) // bad gateway
   {
     return false;
@@ -293,7 +366,7 @@ bool RemoteInterface::checkSystemReady()
   handleCPRResponse(response);
 
   // initial connection to rc_visard to check if system is ready ...
-  auto get_system = cprGetWithRetry(cpr::Url{ base_url_ + "/system" },
+  auto get_system = cprGetWithRetry(*scheduler_, cpr::Url{ base_url_ + "/system" },
                              cpr::Timeout{ timeout_curl_ });
   handleCPRResponse(get_system);
   auto j = json::parse(get_system.text);
@@ -311,7 +384,7 @@ bool RemoteInterface::checkSystemReady()
   }
 
   // ...and to get streams
-  auto get_streams = cprGetWithRetry(cpr::Url{ base_url_ + "/datastreams" },
+  auto get_streams = cprGetWithRetry(*scheduler_, cpr::Url{ base_url_ + "/datastreams" },
                         cpr::Timeout{ timeout_curl_ });
   handleCPRResponse(get_streams);
 
@@ -330,7 +403,7 @@ bool RemoteInterface::checkSystemReady()
 
 string RemoteInterface::getState(const std::string& node) {
   cpr::Url url = cpr::Url{ base_url_ + "/nodes/" + node + "/status"};
-  auto response = cprGetWithRetry(url, cpr::Timeout{ timeout_curl_ });
+  auto response = cprGetWithRetry(*scheduler_, url, cpr::Timeout{ timeout_curl_ });
   handleCPRResponse(response);
   try
   {
@@ -360,7 +433,7 @@ string RemoteInterface::getStereoInsState()
 std::string RemoteInterface::callDynamicsService(std::string service_name)
 {
   cpr::Url url = cpr::Url{ base_url_ + "/nodes/rc_dynamics/services/" + service_name };
-  auto response = cprPutWithRetry(url, cpr::Timeout{ timeout_curl_ });
+  auto response = cprPutWithRetry(*scheduler_, url, cpr::Timeout{ timeout_curl_ });
   handleCPRResponse(response);
   auto j = json::parse(response.text);
   std::string entered_state;
@@ -445,7 +518,7 @@ std::string RemoteInterface::resetSlam()
 {
   std::string service_name = "reset";
   cpr::Url url = cpr::Url{ base_url_ + "/nodes/rc_slam/services/" + service_name };
-  auto response = cprPutWithRetry(url, cpr::Timeout{ timeout_curl_ });
+  auto response = cprPutWithRetry(*scheduler_, url, cpr::Timeout{ timeout_curl_ });
   handleCPRResponse(response);
   auto j = json::parse(response.text);
   std::string entered_state;
@@ -495,7 +568,7 @@ std::string RemoteInterface::resetSlam()
 RemoteInterface::ReturnCode RemoteInterface::callSlamService(std::string service_name, unsigned int timeout_ms)
 {
   cpr::Url url = cpr::Url{ base_url_ + "/nodes/rc_slam/services/" + service_name };
-  auto response = cprPutWithRetry(url, cpr::Timeout{ (int32_t)timeout_ms });
+  auto response = cprPutWithRetry(*scheduler_, url, cpr::Timeout{ (int32_t)timeout_ms });
   handleCPRResponse(response);
   auto j = json::parse(response.text);
 
@@ -557,7 +630,7 @@ list<string> RemoteInterface::getDestinationsOfStream(const string& stream)
 
   // do get request on respective url (no parameters needed for this simple service call)
   cpr::Url url = cpr::Url{ base_url_ + "/datastreams/" + stream };
-  auto get = cprGetWithRetry(url, cpr::Timeout{ timeout_curl_ });
+  auto get = cprGetWithRetry(*scheduler_, url, cpr::Timeout{ timeout_curl_ });
   handleCPRResponse(get);
 
   // parse result as json
@@ -569,21 +642,39 @@ list<string> RemoteInterface::getDestinationsOfStream(const string& stream)
   return destinations;
 }
 
-void RemoteInterface::addDestinationToStream(const string& stream, const string& destination)
+void RemoteInterface::requestDestinations(bool add, const string& stream, const list<string>& destinations)
 {
-  checkStreamTypeAvailable(stream);
-
-  // do put request on respective url
+  json js_destinations = json::array();
+  for (const auto& dest : destinations)
+  {
+    js_destinations.push_back(dest);
+  }
   json js_args;
-  js_args["destination"] = json::array();
-  js_args["destination"].push_back(destination);
+  js_args["destination"] = js_destinations;
   cpr::Url url = cpr::Url{ base_url_ + "/datastreams/" + stream };
-  auto put = cprPutWithRetry(url, cpr::Timeout{ timeout_curl_ }, cpr::Body{ js_args.dump() });
-  if (put.status_code == 403)
+
+  if (add)
   {
-    throw TooManyStreamDestinations(json::parse(put.text)["message"].get<string>());
+    // do put request on respective url
+    auto put = cprPutWithRetry(*scheduler_, url, cpr::Timeout{ timeout_curl_ }, cpr::Body{ js_args.dump() });
+    if (put.status_code == 403)
+    {
+      throw TooManyStreamDestinations(json::parse(put.text)["message"].get<string>());
+    }
+    handleCPRResponse(put);
   }
-  handleCPRResponse(put);
+  else
+  {
+    // do delete request on respective url; list of destinations are given as body
+    auto del = cprDeleteWithRetry(*scheduler_, url, cpr::Timeout{ timeout_curl_ }, cpr::Body{ js_args.dump() });
+    handleCPRResponse(del);
+  }
+}
+
+void RemoteInterface::addDestinationToStream(const string& stream, const string& destination)
+{
+  checkStreamTypeAvailable(stream);
+  requestDestinations(true, stream, { destination });
 
   // keep track of added destinations
   req_streams_[stream].push_back(destination);
@@ -592,14 +683,7 @@ void RemoteInterface::addDestinationToStream(const string& stream, const string&
 void RemoteInterface::deleteDestinationFromStream(const string& stream, const string& destination)
 {
   checkStreamTypeAvailable(stream);
-
-  // do delete request on respective url
-  json js_args;
-  js_args["destination"] = json::array();
-  js_args["destination"].push_back(destination);
-  cpr::Url url = cpr::Url{ base_url_ + "/datastreams/" + stream };
-  auto del = cprDeleteWithRetry(url, cpr::Timeout{ timeout_curl_ }, cpr::Body{ js_args.dump() });
-  handleCPRResponse(del);
+  requestDestinations(false, stream, { destination });
 
   // delete destination also from list of requested streams
   auto& destinations = req_streams_[stream];
@@ -614,30 +698,13 @@ void RemoteInterface::deleteDestinationsFromStream(const string& stream, const l
 
   // with newer image versions this is the most efficent way, i.e. only one call
   if (visard_version_ >= 1.600001) {
-
-    // do delete request on respective url; list of destinationas are given as body
-    json js_destinations = json::array();
-    for (const auto& dest: destinations)
-    {
-      js_destinations.push_back(dest);
-    }
-    json js_args;
-    js_args["destination"] = js_destinations;
-    cpr::Url url = cpr::Url{ base_url_ + "/datastreams/" + stream };
-    auto del = cprDeleteWithRetry(url, cpr::Timeout{ timeout_curl_ }, cpr::Body{ js_args.dump()});
-    handleCPRResponse(del);
+    requestDestinations(false, stream, destinations);
 
   // with older image versions we have to work around and do several calls
   } else {
     for (const auto& dest : destinations)
     {
-      // do delete request on respective url
-      json js_args;
-      js_args["destination"] = json::array();
-      js_args["destination"].push_back(dest);
-      cpr::Url url = cpr::Url{ base_url_ + "/datastreams/" + stream };
-      auto del = cprDeleteWithRetry(url, cpr::Timeout{ timeout_curl_ }, cpr::Body{ js_args.dump() });
-      handleCPRResponse(del);
+      requestDestinations(false, stream, { dest });
     }
   }
 
@@ -656,6 +723,213 @@ void RemoteInterface::deleteDestinationsFromStream(const string& stream, const l
 namespace
 {
 
+// Request for adding or removing destinations of a stream, see applyStreamDestinations()
+struct DestinationRequest
+{
+  bool add;
+  string stream;
+  list<string> destinations;
+  bool done;
+  exception_ptr error;
+};
+
+// Runs the given requests with at most max_concurrent requests at the same time
+void runConcurrently(vector<DestinationRequest>& requests, const function<void(DestinationRequest&)>& run,
+                     size_t max_concurrent = 8)
+{
+  atomic<size_t> next(0);
+  auto work = [&]() {
+    for (size_t i = next++; i < requests.size(); i = next++)
+    {
+      try
+      {
+        run(requests[i]);
+        requests[i].done = true;
+      }
+      catch (...)
+      {
+        requests[i].error = current_exception();
+      }
+    }
+  };
+
+  // the calling thread does requests as well, so that a single request needs no thread
+
+  vector<thread> threads;
+  for (size_t i = 1; i < min(requests.size(), max_concurrent); i++)
+  {
+    threads.push_back(thread(work));
+  }
+  work();
+  for (auto&& t : threads)
+  {
+    t.join();
+  }
+}
+
+}
+
+void RemoteInterface::applyStreamDestinations(const map<string, DestinationChanges>& changes)
+{
+  for (const auto& change : changes)
+  {
+    checkStreamTypeAvailable(change.first);
+    for (const auto& dest : change.second.add)
+    {
+      if (find(change.second.remove.begin(), change.second.remove.end(), dest) != change.second.remove.end())
+      {
+        throw invalid_argument("Destination " + dest + " is added to and removed from stream " + change.first);
+      }
+    }
+  }
+
+  // the current destinations are read first, so that only real changes are
+  // requested and rolled back, i.e. destinations that exist already or that
+  // are registered by others are not removed by a rollback and vice versa
+
+  vector<DestinationRequest> current;
+  for (const auto& change : changes)
+  {
+    if (!change.second.add.empty() || !change.second.remove.empty())
+    {
+      current.push_back(DestinationRequest{ false, change.first, {}, false, nullptr });
+    }
+  }
+
+  runConcurrently(current, [this](DestinationRequest& r) { r.destinations = getDestinationsOfStream(r.stream); });
+  for (const auto& r : current)
+  {
+    if (r.error)
+    {
+      rethrow_exception(r.error);
+    }
+  }
+
+  // collect the minimal number of requests per phase, i.e. one request per
+  // stream if the firmware accepts several destinations in one request
+
+  bool batch = visard_version_ >= 1.600001;
+  vector<DestinationRequest> phases[2];
+  for (const auto& r : current)
+  {
+    const DestinationChanges& change = changes.at(r.stream);
+    list<string> lists[2];
+    for (const auto& dest : change.remove)
+    {
+      if (find(r.destinations.begin(), r.destinations.end(), dest) != r.destinations.end() &&
+          find(lists[0].begin(), lists[0].end(), dest) == lists[0].end())
+      {
+        lists[0].push_back(dest);
+      }
+    }
+    for (const auto& dest : change.add)
+    {
+      if (find(r.destinations.begin(), r.destinations.end(), dest) == r.destinations.end() &&
+          find(lists[1].begin(), lists[1].end(), dest) == lists[1].end())
+      {
+        lists[1].push_back(dest);
+      }
+    }
+
+    for (int add = 0; add < 2; add++)
+    {
+      if (lists[add].empty())
+      {
+        continue;
+      }
+
+      if (batch)
+      {
+        phases[add].push_back(DestinationRequest{ add == 1, r.stream, lists[add], false, nullptr });
+      }
+      else
+      {
+        for (const auto& dest : lists[add])
+        {
+          phases[add].push_back(DestinationRequest{ add == 1, r.stream, { dest }, false, nullptr });
+        }
+      }
+    }
+  }
+
+  auto run = [this](DestinationRequest& r) { requestDestinations(r.add, r.stream, r.destinations); };
+
+  exception_ptr error;
+  for (auto& phase : phases)
+  {
+    runConcurrently(phase, run);
+    for (const auto& r : phase)
+    {
+      if (r.error)
+      {
+        error = r.error;
+        break;
+      }
+    }
+
+    if (error)
+    {
+      break;
+    }
+  }
+
+  if (error)
+  {
+    // undo all changes, including those of failed additions, which may have
+    // been applied partially; these destinations did not exist before, so
+    // that deleting them is harmless
+
+    vector<DestinationRequest> undo;
+    for (const auto& phase : phases)
+    {
+      for (const auto& r : phase)
+      {
+        if (r.done || (r.add && r.error))
+        {
+          undo.push_back(DestinationRequest{ !r.add, r.stream, r.destinations, false, nullptr });
+        }
+      }
+    }
+
+    runConcurrently(undo, run);
+    for (const auto& r : undo)
+    {
+      if (r.error)
+      {
+        cerr << "[RemoteInterface::applyStreamDestinations] Could not roll back changes of stream " << r.stream
+             << " after a failed request" << endl;
+      }
+    }
+
+    rethrow_exception(error);
+  }
+
+  // keep track of added and deleted destinations
+
+  for (const auto& change : changes)
+  {
+    auto& destinations = req_streams_[change.first];
+    for (const auto& dest : change.second.remove)
+    {
+      auto found = find(destinations.begin(), destinations.end(), dest);
+      if (found != destinations.end())
+      {
+        destinations.erase(found);
+      }
+    }
+    for (const auto& dest : change.second.add)
+    {
+      if (find(destinations.begin(), destinations.end(), dest) == destinations.end())
+      {
+        destinations.push_back(dest);
+      }
+    }
+  }
+}
+
+namespace
+{
+
 // TODO: find an automatic way to parse Messages from Json
 // * is possible with protobuf >= 3.0.x
 // * https://developers.google.com/protocol-buffers/docs/reference/cpp/google.protobuf.util.json_util
@@ -751,7 +1025,7 @@ roboception::msgs::Trajectory RemoteInterface::getSlamTrajectory(const Trajector
 
   // put request on slam module to get the trajectory
   cpr::Url url = cpr::Url{ base_url_ + "/nodes/rc_slam/services/get_trajectory" };
-  auto get = cprPutWithRetry(url, cpr::Timeout{ (int32_t)timeout_ms }, cpr::Body{ js_args.dump() });
+  auto get = cprPutWithRetry(*scheduler_, url, cpr::Timeout{ (int32_t)timeout_ms }, cpr::Body{ js_args.dump() });
   handleCPRResponse(get);
 
   auto js = json::parse(get.text)["response"]["trajectory"];
@@ -762,7 +1036,7 @@ roboception::msgs::Frame RemoteInterface::getCam2ImuTransform(unsigned int timeo
 
   // put request on dynamics module to get the cam2imu transfrom
   cpr::Url url = cpr::Url{ base_url_ + "/nodes/rc_dynamics/services/get_cam2imu_transform" };
-  auto get = cprPutWithRetry(url, cpr::Timeout{ (int32_t)timeout_ms });
+  auto get = cprPutWithRetry(*scheduler_, url, cpr::Timeout{ (int32_t)timeout_ms });
   handleCPRResponse(get);
 
   auto js = json::parse(get.text)["response"];
@@ -776,7 +1050,7 @@ DataReceiver::Ptr RemoteInterface::createReceiverForStream(const string& stream,
 
   // figure out local inet address for streaming
   string dest_address;
-  if (!getThisHostsIP(dest_address, visard_addrs_, dest_interface))
+  if (!getThisHostsIP(dest_address, visard_ip_, dest_interface))
   {
     stringstream msg;
     msg << "Could not infer a valid IP address "
@@ -789,30 +1063,234 @@ DataReceiver::Ptr RemoteInterface::createReceiverForStream(const string& stream,
   // create data receiver with port as specified
   DataReceiver::Ptr receiver = TrackedDataReceiver::create(dest_address, dest_port, stream, shared_from_this());
 
-  // do REST-API call requesting a UDP stream from rc_visard device
-  string destination = dest_address + ":" + to_string(dest_port);
-  addDestinationToStream(stream, destination);
+  establishStream(receiver, stream, dest_address + ":" + to_string(dest_port));
+
+  // stream established, prepare everything for normal pose receiving
+  receiver->setTimeout(100);
+  return receiver;
+}
 
-  // waiting for first message; we set a long timeout for receiving data
-  unsigned int initial_timeOut = 5000;
-  receiver->setTimeout(initial_timeOut);
-  if (!receiver->receive(protobuf_map_[stream]))
+DataReceiver::Ptr RemoteInterface::createMulticastReceiverForStream(const string& stream, const string& group,
+                                                                    unsigned int port, const string& dest_interface)
+{
+  checkStreamTypeAvailable(stream);
+
+  // join the group on the interface that leads to the rc_visard
+  string interface_address;
+  if (!getThisHostsIP(interface_address, visard_ip_, dest_interface))
+  {
+    stringstream msg;
+    msg << "Could not infer a valid IP address "
+           "for this host for joining the multicast group! "
+           "Given network interface specification was '"
+        << dest_interface << "'.";
+    throw invalid_argument(msg.str());
+  }
+
+  DataReceiver::Ptr receiver = TrackedDataReceiver::createMulticast(group, port, interface_address, stream);
+
+  // the group is registered only once for all receivers on all hosts and
+  // belongs to none of them, i.e. it is not tracked for removal
+  establishStream(receiver, stream, group + ":" + to_string(port), false);
+
+  receiver->setTimeout(100);
+  return receiver;
+}
+
+void RemoteInterface::reconnectReceiver(const DataReceiver::Ptr& receiver)
+{
+  auto tracked = dynamic_pointer_cast<TrackedDataReceiver>(receiver);
+  if (!tracked)
+  {
+    throw invalid_argument("Only receivers of createReceiverForStream() can be reconnected");
+  }
+
+  checkStreamTypeAvailable(tracked->getStream());
+
+  // discard messages that have been queued before, so that only a new
+  // message counts as established stream
+
+  size_t size;
+  while (!DataReceiver::select({ receiver }, 0).empty())
   {
-    // we did not receive any message; check why, e.g. dynamics not in correct state?
-    string current_state = getDynamicsState();
+    receiver->receiveRaw(size);
+  }
+
+  establishStream(receiver, tracked->getStream(), tracked->getDestination(), !tracked->isMulticast());
+}
+
+bool RemoteInterface::restoreDestination(const DataReceiver::Ptr& receiver)
+{
+  auto tracked = dynamic_pointer_cast<TrackedDataReceiver>(receiver);
+  if (!tracked)
+  {
+    throw invalid_argument("Only receivers of createReceiverForStream() can be restored");
+  }
+
+  // only immutable members are used here, so that this is thread-safe
+
+  cpr::Url url = cpr::Url{ base_url_ + "/datastreams/" + tracked->getStream() };
+  auto get = cprGetWithRetry(*scheduler_, url, cpr::Timeout{ timeout_curl_ });
+  handleCPRResponse(get);
+
+  auto j = json::parse(get.text);
+  for (auto dest : j["destinations"])
+  {
+    if (dest.get<string>() == tracked->getDestination())
+    {
+      return false;
+    }
+  }
+
+  requestDestinations(true, tracked->getStream(), { tracked->getDestination() });
+  return true;
+}
+
+void RemoteInterface::establishStream(const DataReceiver::Ptr& receiver, const string& stream,
+                                      const string& destination, bool track_destination)
+{
+  // the state is queried concurrently to requesting the stream, so that it
+  // is known without further delay if no message arrives; imu is sent
+  // regardless of the state of rc_dynamics, so that the state does not
+  // matter for it
+
+  const bool needs_dynamics = stream != "imu";
+
+  // the query wakes up the waiting thread with a datagram as soon as the
+  // state is known, so that it can wait on the stream and the state at once;
+  // it runs in a detached thread, which keeps this object and the wake-up
+  // socket alive, so that returning on the first message does not wait for
+  // the query
+
+  unsigned int wakeup_port = 0;
+  DataReceiver::Ptr wakeup;
+  future<string> state;
+  if (needs_dynamics)
+  {
+    wakeup = DataReceiver::create("127.0.0.1", wakeup_port);
+
+    RemoteInterface::Ptr self = shared_from_this();
+    auto query = make_shared<packaged_task<string()>>([self]() { return self->getDynamicsState(); });
+    state = query->get_future();
+
+    thread([query, wakeup, wakeup_port]() {
+      (*query)();
+      try
+      {
+        char c = 0;
+        DataSender::create("127.0.0.1", wakeup_port)->send(&c, 1);
+      }
+      catch (exception&)
+      {
+        // the waiting thread then notices the state after its timeout
+      }
+    }).detach();
+  }
+
+  // do REST-API call requesting a UDP stream from rc_visard device; the
+  // destination may still be known, e.g. on reconnecting
+  auto& destinations = req_streams_[stream];
+  if (!track_destination)
+  {
+    // a multicast group, which is shared with others, so that adding it
+    // again does not harm, but removing it is up to the application
+    requestDestinations(true, stream, { destination });
+  }
+  else if (find(destinations.begin(), destinations.end(), destination) == destinations.end())
+  {
+    addDestinationToStream(stream, destination);
+  }
+  else
+  {
+    requestDestinations(true, stream, { destination });
+  }
+
+  // waiting for first message; we set a long timeout for receiving data,
+  // but give up as soon as rc_dynamics is known to be not running
+  const unsigned int initial_timeOut = 5000;
+  const vector<string> stopped_states = { State::IDLE, State::STOPPING, State::FATAL };
+  auto deadline = chrono::steady_clock::now() + chrono::milliseconds(initial_timeOut);
+  bool state_known = !needs_dynamics;
+  string current_state;
+  while (true)
+  {
+    auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+    if (remaining <= 0)
+    {
+      break;
+    }
+
+    vector<DataReceiver::Ptr> waiting = { receiver };
+    if (!state_known)
+    {
+      waiting.push_back(wakeup);
+    }
+
+    vector<size_t> ready = DataReceiver::select(waiting, static_cast<unsigned int>(remaining));
+    if (!ready.empty() && ready[0] == 0)
+    {
+      // the message is available; the timeout of the receiver is restored
+      // in any case, i.e. the one of the caller on reconnecting
+      unsigned int timeout = receiver->getTimeout();
+      receiver->setTimeout(100);
+      shared_ptr<::google::protobuf::Message> msg;
+      try
+      {
+        msg = receiver->receive(protobuf_map_[stream]);
+      }
+      catch (...)
+      {
+        receiver->setTimeout(timeout);
+        throw;
+      }
+      receiver->setTimeout(timeout);
+
+      if (msg)
+      {
+        return;
+      }
+    }
+
+    if (!state_known && state.wait_for(chrono::seconds(0)) == future_status::ready)
+    {
+      state_known = true;
+      try
+      {
+        current_state = state.get();
+      }
+      catch (exception&)
+      {
+        // the state is queried again if no message arrives at all
+      }
+
+      if (count(stopped_states.begin(), stopped_states.end(), current_state) > 0)
+      {
+        throw DynamicsNotRunning(current_state);
+      }
+    }
+  }
+
+  // we did not receive any message; check why, e.g. dynamics not in correct state?
+  if (needs_dynamics)
+  {
+    if (!state_known)
+    {
+      current_state = state.get();
+    }
+    else if (current_state.empty())
+    {
+      current_state = getDynamicsState();
+    }
+
     std::vector<std::string> valid_states = { "RUNNING",  "RUNNING_WITH_SLAM" };
     if (std::count(valid_states.begin(), valid_states.end(), current_state) == 0)
     {
       throw DynamicsNotRunning(current_state);
     }
-
-    // in other cases we cannot tell, what's the reason
-    throw UnexpectedReceiveTimeout(initial_timeOut);
   }
 
-  // stream established, prepare everything for normal pose receiving
-  receiver->setTimeout(100);
-  return receiver;
+  // in other cases we cannot tell, what's the reason
+  throw UnexpectedReceiveTimeout(initial_timeOut);
 }
 
 void RemoteInterface::cleanUpRequestedStreams()
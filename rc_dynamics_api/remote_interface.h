@@ -38,6 +38,7 @@
 
 #include <string>
 #include <list>
+#include <map>
 #include <memory>
 #include <iostream>
 #include <chrono>
@@ -49,6 +50,7 @@
 
 #include "data_receiver.h"
 #include "net_utils.h"
+#include "request_scheduler.h"
 #include "trajectory_time.h"
 
 namespace rc
@@ -97,6 +99,13 @@ public:
     static const std::string UNKNOWN;            ///< State of component is unknown, e.g. not yet reported
   };
 
+  /// Destinations that are added to and removed from a stream, see applyStreamDestinations()
+  struct DestinationChanges
+  {
+    std::list<std::string> add;     ///< destinations to be added, e.g. "192.168.0.1:30000"
+    std::list<std::string> remove;  ///< destinations to be removed
+  };
+
   struct ReturnCode
   {
     int value; ///< suceess >= 0, failure < 0
@@ -162,7 +171,8 @@ public:
   /**
    * Creates a local instance of rc_visard's remote pose interface
    *
-   * @param rc_visard_ip rc_visard's inet address as string, e.g "192.168.0.12"
+   * @param rc_visard_ip rc_visard's inet address as string, e.g "192.168.0.12", optionally with the port of
+   *                     the REST-API, e.g. "127.0.0.1:8080" for a simulated rc_visard
    * @param requests_timeout timeout in [ms] for doing REST-API calls, which don't have an explicit timeout parameter
    */
   static Ptr create(const std::string& rc_visard_ip, unsigned int requests_timeout = 5000);
@@ -322,6 +332,27 @@ public:
    */
   void deleteDestinationsFromStream(const std::string& stream, const std::list<std::string>& destinations);
 
+  /**
+   * Adds and removes destinations of several streams at once, e.g. for
+   * subscribing a host to many streams.
+   *
+   * With firmware versions >= 1.6, all destinations of a stream are added
+   * with one request and removed with one request. With older versions,
+   * which only accept one destination per request, the requests are sent
+   * concurrently. Removals are done before additions, so that removed
+   * destinations do not count against the maximum number of destinations.
+   *
+   * The current destinations of the streams are read first, so that only
+   * destinations that do not exist yet are added and only existing
+   * destinations are removed. If a request fails, all changes that have
+   * already been done are rolled back as far as possible, i.e. added
+   * destinations are removed and removed destinations are added again, and
+   * the error of the first failed request is thrown.
+   *
+   * @param changes destinations that are added and removed per stream, e.g. "pose"
+   */
+  void applyStreamDestinations(const std::map<std::string, DestinationChanges>& changes);
+
   /**
    * Returns the Slam trajectory from the sensor.
    *
@@ -351,11 +382,15 @@ public:
    *
    *  1) creates a data receiver (including binding socket to a local network interface)
    *  2) adds a destination to the respective stream on rc_visard device
-   *  3) waits/checks for the stream being established
+   *  3) waits/checks for the stream being established, i.e. returns as soon as the
+   *     first message arrives or fails early if rc_dynamics is not running
    *  4) (removes the destination automatically from rc_visard device if data receiver is no longer used)
    *
    * Stream can only be established successfully if rc_dynamics module is running on
-   * rc_visard, see (re)start(_slam) methods.
+   * rc_visard, see (re)start(_slam) methods. The only exception is the imu stream,
+   * which is sent regardless of the state of rc_dynamics.
+   *
+   * The receive timeout of the returned receiver is 100 ms, see DataReceiver::setTimeout().
    *
    *
    * If desired interface for receiving is unspecified (or "") this host's
@@ -370,6 +405,65 @@ public:
   DataReceiver::Ptr createReceiverForStream(const std::string& stream, const std::string& dest_interface = "",
                                             unsigned int dest_port = 0);
 
+  /**
+   * Like createReceiverForStream(), but the receiver joins a multicast
+   * group, so that the rc_visard sends each message only once for any
+   * number of receivers on this and other hosts.
+   *
+   * The group is registered as destination of the stream if it is not
+   * registered already, e.g. by another host. The group is owned by the
+   * application, not by the receivers or this RemoteInterface, since it
+   * may be used by others: neither the receivers nor the RemoteInterface
+   * remove it when they are destroyed. The application that manages the
+   * group removes it explicitly with deleteDestinationFromStream() when no
+   * host needs it anymore. Otherwise, it stays registered until the
+   * rc_visard is restarted.
+   *
+   * @param stream stream type, e.g. "pose", "pose_rt" or "dynamics"
+   * @param group multicast group address, e.g. "239.255.0.1"
+   * @param port port number of the group
+   * @param dest_interface empty or one of this hosts network interfaces for joining the group, e.g. "eth0"
+   */
+  DataReceiver::Ptr createMulticastReceiverForStream(const std::string& stream, const std::string& group,
+                                                     unsigned int port, const std::string& dest_interface = "");
+
+  /**
+   * Re-establishes the stream of a receiver that has been created by
+   * createReceiverForStream(), e.g. after rc_dynamics has been restarted or
+   * the rc_visard has been rebooted.
+   *
+   * The bound socket and the known destination of the receiver are reused,
+   * i.e. no network interfaces are scanned. Messages that have been queued
+   * before are discarded. As in createReceiverForStream(), the method
+   * returns as soon as the first message has been received. The receive
+   * timeout of the receiver is kept.
+   *
+   * @param receiver receiver of createReceiverForStream() or createMulticastReceiverForStream()
+   */
+  void reconnectReceiver(const DataReceiver::Ptr& receiver);
+
+  /**
+   * Checks if the destination of a receiver that has been created by
+   * createReceiverForStream() is still registered on the rc_visard and
+   * registers it again if not, without waiting for messages. In contrast to
+   * the other methods, this method may be called from another thread than
+   * the one using the RemoteInterface, e.g. by a SupervisedReceiver.
+   *
+   * @param receiver receiver of createReceiverForStream() or createMulticastReceiverForStream()
+   * @return true if the destination had to be registered again
+   */
+  bool restoreDestination(const DataReceiver::Ptr& receiver);
+
+  /**
+   * Returns the scheduler of all REST-API requests to the rc_visard, e.g.
+   * for changing the rate limit or for getting the number of rejected
+   * requests and retries.
+   */
+  RequestScheduler::Ptr getRequestScheduler() const
+  {
+    return scheduler_;
+  }
+
 protected:
   static std::map<std::string, RemoteInterface::Ptr> remote_interfaces_;
 
@@ -381,8 +475,15 @@ protected:
   std::string callDynamicsService(std::string service_name);
   ReturnCode callSlamService(std::string service_name, unsigned int timeout_ms = 0); ///< call slam services which have a return code with value and message
   std::string getState(const std::string& node);
+  /// Adds or deletes destinations of a stream with one request, without keeping track of them
+  void requestDestinations(bool add, const std::string& stream, const std::list<std::string>& destinations);
+  /// Requests the stream to the destination of the receiver and waits for the first message, the destination is
+  /// removed on destruction if it is tracked
+  void establishStream(const DataReceiver::Ptr& receiver, const std::string& stream, const std::string& destination,
+                       bool track_destination = true);
 
   std::string visard_addrs_;
+  std::string visard_ip_;  ///< visard_addrs_ without port
   bool initialized_;     ///< indicates if remote_interface was initialized properly at least once, see checkSystemReady()
   float visard_version_; ///< rc_visard's firmware version as double, i.e. major.minor, e.g. 1.6
   std::map<std::string, std::list<std::string>> req_streams_;
@@ -390,6 +491,7 @@ protected:
   std::map<std::string, std::string> protobuf_map_;
   std::string base_url_;
   int timeout_curl_;
+  RequestScheduler::Ptr scheduler_;  ///< shared by all interfaces of the same rc_visard
 };
 }
 }
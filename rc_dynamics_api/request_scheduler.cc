@@ -0,0 +1,202 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "request_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace rc
+{
+namespace dynamics
+{
+std::mutex RequestScheduler::devices_mtx_;
+std::map<std::string, std::weak_ptr<RequestScheduler>> RequestScheduler::devices_;
+
+RequestScheduler::Config::Config() : rate(0), burst(25), base_delay_ms(50), max_delay_ms(2000), max_retries(5)
+{
+}
+
+RequestScheduler::Ptr RequestScheduler::getForDevice(const std::string& device)
+{
+  std::lock_guard<std::mutex> lock(devices_mtx_);
+
+  Ptr scheduler = devices_[device].lock();
+  if (!scheduler)
+  {
+    scheduler = create();
+    devices_[device] = scheduler;
+  }
+
+  return scheduler;
+}
+
+RequestScheduler::Ptr RequestScheduler::create(const Config& config)
+{
+  return Ptr(new RequestScheduler(config));
+}
+
+RequestScheduler::RequestScheduler(const Config& config)
+  : config_(config), stats_(), tokens_(std::max(1.0, config.burst)), last_refill_(Clock::now()),
+    rng_(std::random_device()()), stop_(false), waiting_(0)
+{
+}
+
+RequestScheduler::~RequestScheduler()
+{
+  std::unique_lock<std::mutex> lock(mtx_);
+  stop_ = true;
+  cond_.notify_all();
+  cond_.wait(lock, [this]() { return waiting_ == 0; });
+}
+
+void RequestScheduler::setConfig(const Config& config)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  config_ = config;
+  tokens_ = std::min(tokens_, std::max(1.0, config_.burst));
+}
+
+RequestScheduler::Config RequestScheduler::getConfig() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return config_;
+}
+
+RequestScheduler::Statistics RequestScheduler::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return stats_;
+}
+
+bool RequestScheduler::execute(const std::function<bool()>& attempt)
+{
+  std::chrono::milliseconds last_delay;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    last_delay = std::chrono::milliseconds(config_.base_delay_ms);
+  }
+
+  unsigned int retries = 0;
+  bool reserved = false;  // true if a token has been reserved for the next attempt
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      std::chrono::milliseconds delay(0);
+      if (!reserved)
+      {
+        delay = reserve(Clock::now());
+      }
+
+      if (delay.count() > 0)
+      {
+        stats_.throttled++;
+        reserved = true;
+        wait(lock, delay);
+        continue;
+      }
+
+      reserved = false;
+      stats_.requests++;
+    }
+
+    if (attempt())
+    {
+      return true;
+    }
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    stats_.rejected++;
+    if (retries >= config_.max_retries)
+    {
+      stats_.failed++;
+      return false;
+    }
+
+    retries++;
+    stats_.retries++;
+    wait(lock, nextRetryDelay(last_delay));
+  }
+}
+
+std::chrono::milliseconds RequestScheduler::reserve(Clock::time_point now)
+{
+  if (config_.rate <= 0)
+  {
+    return std::chrono::milliseconds(0);
+  }
+
+  // tokens may become negative, which reserves the next free tokens for
+  // delayed requests, so that they do not compete with each other again
+
+  double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+  last_refill_ = now;
+  tokens_ = std::min(std::max(1.0, config_.burst), tokens_ + elapsed * config_.rate) - 1;
+
+  if (tokens_ >= 0)
+  {
+    return std::chrono::milliseconds(0);
+  }
+
+  return std::chrono::milliseconds(static_cast<int64_t>(std::ceil(-tokens_ * 1000 / config_.rate)));
+}
+
+std::chrono::milliseconds RequestScheduler::nextRetryDelay(std::chrono::milliseconds& last_delay)
+{
+  int64_t base = config_.base_delay_ms;
+  int64_t upper = std::max(base, static_cast<int64_t>(last_delay.count()) * 3);
+  std::uniform_int_distribution<int64_t> dist(base, upper);
+  last_delay = std::chrono::milliseconds(std::min<int64_t>(config_.max_delay_ms, dist(rng_)));
+  return last_delay;
+}
+
+void RequestScheduler::wait(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds delay)
+{
+  // the destructor wakes up all waiting callers and waits until they have
+  // left, so that none of them hangs or accesses a destroyed scheduler
+
+  waiting_++;
+  bool stopped = cond_.wait_for(lock, delay, [this]() { return stop_; });
+  waiting_--;
+
+  if (stopped)
+  {
+    cond_.notify_all();
+    throw std::runtime_error("Request scheduler has been stopped");
+  }
+}
+}
+}
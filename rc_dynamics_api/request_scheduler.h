@@ -0,0 +1,170 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_REQUEST_SCHEDULER_H
+#define RC_DYNAMICS_API_REQUEST_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <stdint.h>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Schedules the REST-API requests to one rc_visard.
+ *
+ * Requests may be limited by a token bucket, so that the rate limit of the
+ * rc_visard is kept ahead of time instead of provoking http error code 429
+ * (too many requests). The limit is off by default and must be enabled with
+ * setConfig(). Requests that exceed the rate are delayed until their
+ * reserved token is available. Requests that are nevertheless rejected are
+ * retried with a decorrelated jitter backoff, i.e. a random delay between
+ * the base delay and three times the previous delay, so that the retries of
+ * concurrent requests spread out instead of hitting the rc_visard at the
+ * same time again.
+ *
+ * All attempts of a request are done in the calling thread, which sleeps
+ * while waiting for the rate limit or the delay of a retry. Thus, a caller
+ * never waits for the attempts of other requests, e.g. of other
+ * RemoteInterface objects of the same rc_visard.
+ *
+ * A request is given as function that does one attempt and returns false
+ * if the attempt has been rejected and should be retried. The function
+ * may throw exceptions, which are passed to the caller.
+ *
+ * All RemoteInterface objects of the same rc_visard share one scheduler,
+ * see getForDevice().
+ */
+class RequestScheduler
+{
+public:
+  using Ptr = std::shared_ptr<RequestScheduler>;
+
+  /// Rate limit and retry behaviour
+  struct Config
+  {
+    Config();
+
+    double rate;                ///< requests per second, 0 for unlimited, which is the default
+    double burst;               ///< number of requests that may be sent at once, at least 1
+    unsigned int base_delay_ms; ///< minimum delay before a retry
+    unsigned int max_delay_ms;  ///< maximum delay before a retry
+    unsigned int max_retries;   ///< number of retries before giving up
+  };
+
+  /// Counters since creation
+  struct Statistics
+  {
+    uint64_t requests;   ///< attempts, including retries
+    uint64_t throttled;  ///< attempts that have been delayed by the rate limit
+    uint64_t rejected;   ///< attempts that have been rejected by the rc_visard
+    uint64_t retries;    ///< retries of rejected attempts
+    uint64_t failed;     ///< requests that have been given up after max_retries
+  };
+
+  /**
+   * Returns the scheduler of the given rc_visard, which is created if it
+   * does not exist yet.
+   *
+   * @param device address of the rc_visard's REST-API, e.g. "192.168.0.12"
+   */
+  static Ptr getForDevice(const std::string& device);
+
+  /**
+   * Creates a scheduler that is not shared.
+   *
+   * @param config rate limit and retry behaviour
+   */
+  static Ptr create(const Config& config = Config());
+
+  /**
+   * Wakes up all callers that are waiting for the rate limit or a retry,
+   * which then fail with an exception, and waits until they have left.
+   */
+  ~RequestScheduler();
+
+  /// Changes the rate limit and retry behaviour
+  void setConfig(const Config& config);
+
+  /// Returns the rate limit and retry behaviour
+  Config getConfig() const;
+
+  /// Returns the counters since creation
+  Statistics getStatistics() const;
+
+  /**
+   * Does a request and waits for its result. All attempts, including
+   * retries, are done in the calling thread, which sleeps while waiting for
+   * the rate limit or the delay of a retry.
+   *
+   * @param attempt function that does one attempt and returns false if it has been rejected
+   * @return false if the request has been given up after max_retries
+   */
+  bool execute(const std::function<bool()>& attempt);
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  explicit RequestScheduler(const Config& config);
+
+  std::chrono::milliseconds reserve(Clock::time_point now);
+  std::chrono::milliseconds nextRetryDelay(std::chrono::milliseconds& last_delay);
+  void wait(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds delay);
+
+  mutable std::mutex mtx_;
+  Config config_;
+  Statistics stats_;
+  double tokens_;
+  Clock::time_point last_refill_;
+  std::mt19937 rng_;
+
+  bool stop_;
+  unsigned int waiting_;  // number of callers that are waiting
+  std::condition_variable cond_;
+
+  static std::mutex devices_mtx_;
+  static std::map<std::string, std::weak_ptr<RequestScheduler>> devices_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_REQUEST_SCHEDULER_H
@@ -0,0 +1,443 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "segmented_recording.h"
+
+#include "json.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+const char* manifest_format = "rc_dynamics_api segmented recording";
+const int manifest_version = 1;
+
+bool endsWith(const std::string& s, const std::string& suffix)
+{
+  return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/// Returns the directory part of a file name including the trailing separator
+std::string getDirectory(const std::string& filename)
+{
+  std::size_t pos = filename.find_last_of("/\\");
+  return pos == std::string::npos ? std::string() : filename.substr(0, pos + 1);
+}
+
+std::string getBasename(const std::string& filename)
+{
+  std::size_t pos = filename.find_last_of("/\\");
+  return pos == std::string::npos ? filename : filename.substr(pos + 1);
+}
+}
+
+SegmentedRecordingWriter::Ptr SegmentedRecordingWriter::create(const std::string& basename,
+                                                               const std::vector<RecordingStream>& streams,
+                                                               uint64_t max_segment_size,
+                                                               unsigned int max_segment_duration_ms,
+                                                               std::size_t block_size, bool direct_io)
+{
+  return Ptr(
+      new SegmentedRecordingWriter(basename, streams, max_segment_size, max_segment_duration_ms, block_size, direct_io));
+}
+
+SegmentedRecordingWriter::SegmentedRecordingWriter(const std::string& basename,
+                                                   const std::vector<RecordingStream>& streams,
+                                                   uint64_t max_segment_size, unsigned int max_segment_duration_ms,
+                                                   std::size_t block_size, bool direct_io)
+  : RecordingWriter(basename + "-00000.bin", streams, block_size, direct_io)
+  , basename_(basename)
+  , manifest_(basename + ".json")
+  , max_segment_size_(max_segment_size)
+  , max_segment_duration_(static_cast<int64_t>(max_segment_duration_ms) * 1000000)
+  , segment_start_count_(0)
+  , closed_(false)
+{
+  RecordingSegment segment = { getFilename(), 0, 0, 0, 0, false };
+  segments_.push_back(segment);
+  writeManifest(false);
+}
+
+SegmentedRecordingWriter::~SegmentedRecordingWriter()
+{
+  try
+  {
+    close();
+  }
+  catch (const std::exception&)
+  {
+    // destructor must not throw
+  }
+}
+
+void SegmentedRecordingWriter::write(uint16_t stream, int64_t host_stamp, const char* data, std::size_t size)
+{
+  if (closed_)
+  {
+    throw std::runtime_error("Recording '" + manifest_ + "' is already closed");
+  }
+
+  RecordingSegment& segment = segments_.back();
+  if (segment.count > 0 && ((max_segment_size_ > 0 && file_size_ + block_.size() + size >= max_segment_size_) ||
+                            (max_segment_duration_ > 0 && host_stamp - segment.start_stamp >= max_segment_duration_)))
+  {
+    finishSegment();
+
+    RecordingSegment next = { segmentFilename(segments_.size()), 0, 0, 0, 0, false };
+    open(next.filename);
+    segments_.push_back(next);
+    writeManifest(false);
+  }
+
+  RecordingWriter::write(stream, host_stamp, data, size);
+
+  RecordingSegment& current = segments_.back();
+  if (current.count == 0)
+  {
+    current.start_stamp = host_stamp;
+  }
+  current.end_stamp = host_stamp;
+  current.count++;
+}
+
+void SegmentedRecordingWriter::close()
+{
+  if (closed_)
+  {
+    return;
+  }
+
+  closed_ = true;
+  finishSegment();
+  writeManifest(true);
+}
+
+std::string SegmentedRecordingWriter::segmentFilename(std::size_t i) const
+{
+  char num[16];
+  std::snprintf(num, sizeof(num), "%05u", static_cast<unsigned int>(i));
+  return basename_ + "-" + num + ".bin";
+}
+
+void SegmentedRecordingWriter::finishSegment()
+{
+  RecordingWriter::close();
+
+  RecordingSegment& segment = segments_.back();
+  segment.size = file_size_;
+  segment.complete = true;
+}
+
+void SegmentedRecordingWriter::writeManifest(bool complete)
+{
+  json streams = json::array();
+  for (auto&& s : streams_)
+  {
+    streams.push_back({ { "name", s.name }, { "pb_msg_type", s.pb_msg_type } });
+  }
+
+  json segments = json::array();
+  for (auto&& s : segments_)
+  {
+    segments.push_back({ { "file", getBasename(s.filename) },
+                         { "start_stamp", s.start_stamp },
+                         { "end_stamp", s.end_stamp },
+                         { "count", s.count },
+                         { "size", s.size },
+                         { "complete", s.complete } });
+  }
+
+  json manifest = { { "format", manifest_format },
+                    { "version", manifest_version },
+                    { "complete", complete },
+                    { "max_segment_size", max_segment_size_ },
+                    { "max_segment_duration_ms", max_segment_duration_ / 1000000 },
+                    { "streams", streams },
+                    { "segments", segments } };
+
+  // replace the manifest atomically, so that it is always complete
+
+  std::string tmp = manifest_ + ".tmp";
+  {
+    std::ofstream out(tmp);
+    out << manifest.dump(2) << std::endl;
+    if (!out)
+    {
+      throw std::runtime_error("Cannot write manifest of recording '" + manifest_ + "'");
+    }
+  }
+
+#ifdef WIN32
+  std::remove(manifest_.c_str());
+#endif
+  if (std::rename(tmp.c_str(), manifest_.c_str()) != 0)
+  {
+    throw std::runtime_error("Cannot write manifest of recording '" + manifest_ + "'");
+  }
+}
+
+SegmentedRecordingReader::Ptr SegmentedRecordingReader::open(const std::string& filename)
+{
+  return Ptr(new SegmentedRecordingReader(filename));
+}
+
+SegmentedRecordingReader::SegmentedRecordingReader(const std::string& filename) : manifest_complete_(true)
+{
+  if (!endsWith(filename, ".json"))
+  {
+    // single recording file
+
+    RecordingReader::Ptr reader = RecordingReader::open(filename);
+    RecordingSegment segment = { filename,
+                                 reader->getStartTime(),
+                                 reader->getEndTime(),
+                                 reader->getMessageCount(),
+                                 0,
+                                 reader->isComplete() };
+    streams_ = reader->getStreams();
+    segments_.push_back(segment);
+    readers_.push_back(reader);
+    return;
+  }
+
+  std::ifstream in(filename);
+  if (!in.is_open())
+  {
+    throw std::runtime_error("Cannot open manifest '" + filename + "'");
+  }
+
+  try
+  {
+    json manifest;
+    in >> manifest;
+
+    if (manifest.at("format").get<std::string>() != manifest_format ||
+        manifest.at("version").get<int>() != manifest_version)
+    {
+      throw std::invalid_argument("Unsupported manifest '" + filename + "'");
+    }
+
+    manifest_complete_ = manifest.at("complete").get<bool>();
+
+    for (auto&& s : manifest.at("streams"))
+    {
+      RecordingStream stream = { s.at("name").get<std::string>(), s.at("pb_msg_type").get<std::string>() };
+      streams_.push_back(stream);
+    }
+
+    directory_ = getDirectory(filename);
+    for (auto&& s : manifest.at("segments"))
+    {
+      RecordingSegment segment = { s.at("file").get<std::string>(),  s.at("start_stamp").get<int64_t>(),
+                                   s.at("end_stamp").get<int64_t>(), s.at("count").get<uint64_t>(),
+                                   s.at("size").get<uint64_t>(),     s.at("complete").get<bool>() };
+      segments_.push_back(segment);
+    }
+  }
+  catch (const json::exception& e)
+  {
+    throw std::invalid_argument("Invalid manifest '" + filename + "': " + e.what());
+  }
+
+  readers_.resize(segments_.size());
+}
+
+SegmentedRecordingReader::~SegmentedRecordingReader()
+{
+}
+
+int SegmentedRecordingReader::getStreamIndex(const std::string& name) const
+{
+  for (std::size_t i = 0; i < streams_.size(); i++)
+  {
+    if (streams_[i].name == name)
+    {
+      return static_cast<int>(i);
+    }
+  }
+
+  return -1;
+}
+
+uint64_t SegmentedRecordingReader::getMessageCount() const
+{
+  uint64_t count = 0;
+  for (std::size_t i = 0; i < segments_.size(); i++)
+  {
+    count += segments_[i].complete ? segments_[i].count : getSegmentReader(i)->getMessageCount();
+  }
+
+  return count;
+}
+
+int64_t SegmentedRecordingReader::getStartTime() const
+{
+  for (std::size_t i = 0; i < segments_.size(); i++)
+  {
+    int64_t t = segments_[i].complete ? segments_[i].start_stamp : getSegmentReader(i)->getStartTime();
+    if (t != 0)
+    {
+      return t;
+    }
+  }
+
+  return 0;
+}
+
+int64_t SegmentedRecordingReader::getEndTime() const
+{
+  for (std::size_t i = segments_.size(); i > 0; i--)
+  {
+    int64_t t = segments_[i - 1].complete ? segments_[i - 1].end_stamp : getSegmentReader(i - 1)->getEndTime();
+    if (t != 0)
+    {
+      return t;
+    }
+  }
+
+  return 0;
+}
+
+bool SegmentedRecordingReader::isComplete() const
+{
+  bool complete = manifest_complete_;
+  for (std::size_t i = 0; i < segments_.size(); i++)
+  {
+    complete = complete && segments_[i].complete && (!readers_[i] || readers_[i]->isComplete());
+  }
+
+  return complete;
+}
+
+RecordingReader::Ptr SegmentedRecordingReader::getSegmentReader(std::size_t i) const
+{
+  if (!readers_.at(i))
+  {
+    RecordingReader::Ptr reader = RecordingReader::open(directory_ + segments_[i].filename);
+
+    const std::vector<RecordingStream>& streams = reader->getStreams();
+    bool same = (streams.size() == streams_.size());
+    for (std::size_t k = 0; same && k < streams.size(); k++)
+    {
+      same = (streams[k].name == streams_[k].name && streams[k].pb_msg_type == streams_[k].pb_msg_type);
+    }
+
+    if (!same)
+    {
+      throw std::invalid_argument("Streams of segment '" + segments_[i].filename + "' do not match the manifest");
+    }
+
+    readers_[i] = reader;
+  }
+
+  return readers_[i];
+}
+
+SegmentedRecordingReader::Query SegmentedRecordingReader::query(const std::string& stream, int64_t start,
+                                                                int64_t end) const
+{
+  int i = getStreamIndex(stream);
+  if (i < 0)
+  {
+    throw std::invalid_argument("Recording does not contain stream '" + stream + "'");
+  }
+
+  return query(1u << i, start, end);
+}
+
+SegmentedRecordingReader::Query::Query(const SegmentedRecordingReader* reader, uint32_t streams, int64_t start,
+                                       int64_t end)
+  : reader_(reader), streams_(streams), start_(start), end_(end), segment_(0)
+{
+}
+
+bool SegmentedRecordingReader::Query::nextSegment()
+{
+  const std::vector<RecordingSegment>& segments = reader_->segments_;
+  while (segment_ < segments.size())
+  {
+    std::size_t i = segment_++;
+
+    // the time range of segments that have not been closed is unknown
+
+    const RecordingSegment& segment = segments[i];
+    if (segment.complete && (segment.count == 0 || segment.end_stamp < start_ || segment.start_stamp > end_))
+    {
+      continue;
+    }
+
+    RecordingReader::Ptr reader = reader_->getSegmentReader(i);
+    cursor_.reset(new RecordingReader::Cursor(reader->cursor()));
+    cursor_->setStreams(streams_);
+    cursor_->seek(start_);
+    return true;
+  }
+
+  return false;
+}
+
+bool SegmentedRecordingReader::Query::next(RecordedMessage& msg)
+{
+  for (;;)
+  {
+    if (!cursor_ && !nextSegment())
+    {
+      return false;
+    }
+
+    if (cursor_->next(msg))
+    {
+      if (msg.host_stamp <= end_)
+      {
+        return true;
+      }
+
+      // all following messages are later
+
+      segment_ = reader_->segments_.size();
+    }
+
+    cursor_.reset();
+  }
+}
+}
+}
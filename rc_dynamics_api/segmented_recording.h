@@ -0,0 +1,277 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_SEGMENTED_RECORDING_H
+#define RC_DYNAMICS_API_SEGMENTED_RECORDING_H
+
+#include "recording.h"
+
+#include <limits>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Description of one file of a segmented recording.
+ */
+struct RecordingSegment
+{
+  std::string filename;  ///< name of the file, relative to the directory of the manifest
+  int64_t start_stamp;   ///< host time stamp of the first message, 0 if unknown
+  int64_t end_stamp;     ///< host time stamp of the last message, 0 if unknown
+  uint64_t count;        ///< number of messages
+  uint64_t size;         ///< size of the file in bytes
+  bool complete;         ///< false if the segment has not been closed
+};
+
+/**
+ * Records like RecordingWriter, but splits long recordings into segments,
+ * i.e. separate recording files that are started when the current one
+ * exceeds a maximum size or duration. Each segment has its own block index
+ * at the end. A manifest file in JSON format lists all segments with their
+ * time ranges, so that a SegmentedRecordingReader can find the segments of
+ * a time range without opening the others.
+ *
+ * For a base name "path/rec", the manifest is "path/rec.json" and the
+ * segments are "path/rec-00000.bin", "path/rec-00001.bin", etc. The
+ * manifest is updated whenever a segment is started or closed, so that it
+ * lists all segments even if the recording process crashed.
+ */
+class SegmentedRecordingWriter : public RecordingWriter
+{
+public:
+  using Ptr = std::shared_ptr<SegmentedRecordingWriter>;
+
+  /**
+   * Creates the manifest and the first segment, replacing existing files.
+   *
+   * @param basename name of the manifest without extension ".json"
+   * @param streams streams that are contained in the recording
+   * @param max_segment_size maximum size of a segment in bytes, 0 for unlimited
+   * @param max_segment_duration_ms maximum duration of a segment in milliseconds, 0 for unlimited
+   * @param block_size size of the message blocks in bytes
+   * @param direct_io write with O_DIRECT to bypass the page cache, if supported
+   */
+  static Ptr create(const std::string& basename, const std::vector<RecordingStream>& streams,
+                    uint64_t max_segment_size, unsigned int max_segment_duration_ms, std::size_t block_size = 65536,
+                    bool direct_io = false);
+
+  /// Closes the recording
+  virtual ~SegmentedRecordingWriter();
+
+  /**
+   * Appends a serialized message to the recording. A new segment is started
+   * before, if the current one has exceeded the maximum size or duration.
+   *
+   * @param stream index of the stream as given to create()
+   * @param host_stamp receive time stamp in nanoseconds since epoch
+   * @param data serialized message
+   * @param size size of the serialized message
+   */
+  virtual void write(uint16_t stream, int64_t host_stamp, const char* data, std::size_t size) override;
+
+  /**
+   * Closes the current segment and writes the final manifest. This is done
+   * automatically on destruction.
+   */
+  virtual void close() override;
+
+  /// Returns the name of the manifest
+  const std::string& getManifestFilename() const
+  {
+    return manifest_;
+  }
+
+  /// Returns all segments that have been started
+  const std::vector<RecordingSegment>& getSegments() const
+  {
+    return segments_;
+  }
+
+protected:
+  SegmentedRecordingWriter(const std::string& basename, const std::vector<RecordingStream>& streams,
+                           uint64_t max_segment_size, unsigned int max_segment_duration_ms, std::size_t block_size,
+                           bool direct_io);
+
+  std::string segmentFilename(std::size_t i) const;
+  void finishSegment();
+  void writeManifest(bool complete);
+
+  std::string basename_;
+  std::string manifest_;
+  uint64_t max_segment_size_;
+  int64_t max_segment_duration_;
+  uint64_t segment_start_count_;  // message count at the start of the current segment
+  std::vector<RecordingSegment> segments_;
+  bool closed_;
+};
+
+/**
+ * Reads a segmented recording of a SegmentedRecordingWriter, or a single
+ * recording file of a RecordingWriter, which is treated as recording with
+ * one segment.
+ *
+ * Queries for a time range only open the segments that overlap with it and
+ * only read the blocks of these segments that overlap with it and contain
+ * messages of the requested streams. Segments are memory mapped on first
+ * use and stay mapped as long as the SegmentedRecordingReader exists.
+ */
+class SegmentedRecordingReader
+{
+public:
+  using Ptr = std::shared_ptr<SegmentedRecordingReader>;
+
+  /**
+   * Iterates over the messages of a time range of selected streams, across
+   * segments, in the order in which they were recorded.
+   */
+  class Query
+  {
+  public:
+    /**
+     * Returns the next message. The data of the message stays valid as long
+     * as the SegmentedRecordingReader exists.
+     *
+     * @param msg next message
+     * @return false if there are no more messages in the time range
+     */
+    bool next(RecordedMessage& msg);
+
+  protected:
+    friend class SegmentedRecordingReader;
+
+    Query(const SegmentedRecordingReader* reader, uint32_t streams, int64_t start, int64_t end);
+
+    bool nextSegment();
+
+    const SegmentedRecordingReader* reader_;
+    uint32_t streams_;
+    int64_t start_;
+    int64_t end_;
+    std::size_t segment_;  // index of the next segment
+    std::unique_ptr<RecordingReader::Cursor> cursor_;
+  };
+
+  /**
+   * Opens a segmented recording by its manifest (file name ending with
+   * ".json") or a single recording file.
+   *
+   * @param filename name of the manifest or recording
+   */
+  static Ptr open(const std::string& filename);
+
+  virtual ~SegmentedRecordingReader();
+
+  /// Returns the streams contained in the recording
+  const std::vector<RecordingStream>& getStreams() const
+  {
+    return streams_;
+  }
+
+  /**
+   * Returns the index of the stream with the given name.
+   *
+   * @param name name of stream
+   * @return index of stream or -1 if the recording does not contain it
+   */
+  int getStreamIndex(const std::string& name) const;
+
+  /// Returns the segments of the recording
+  const std::vector<RecordingSegment>& getSegments() const
+  {
+    return segments_;
+  }
+
+  /// Returns the total number of messages
+  uint64_t getMessageCount() const;
+
+  /// Returns the host time stamp of the first message or 0 if the recording is empty
+  int64_t getStartTime() const;
+
+  /// Returns the host time stamp of the last message or 0 if the recording is empty
+  int64_t getEndTime() const;
+
+  /// Returns true if the recording and all segments were properly closed
+  bool isComplete() const;
+
+  /**
+   * Returns the recording of a segment, which is opened on first access.
+   *
+   * @param i index of segment
+   */
+  RecordingReader::Ptr getSegmentReader(std::size_t i) const;
+
+  /**
+   * Queries all messages of some streams with host time stamps within a
+   * time range.
+   *
+   * @param streams bit mask of the streams, bit i for stream i
+   * @param start first host time stamp of the range in nanoseconds since epoch
+   * @param end last host time stamp of the range in nanoseconds since epoch
+   */
+  Query query(uint32_t streams, int64_t start, int64_t end) const
+  {
+    return Query(this, streams, start, end);
+  }
+
+  /**
+   * Queries all messages of one stream with host time stamps within a time
+   * range.
+   *
+   * @param stream name of the stream, e.g. "dynamics"
+   * @param start first host time stamp of the range in nanoseconds since epoch
+   * @param end last host time stamp of the range in nanoseconds since epoch
+   */
+  Query query(const std::string& stream, int64_t start, int64_t end) const;
+
+  /// Queries all messages of the recording
+  Query queryAll() const
+  {
+    return query(~0u, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+  }
+
+protected:
+  explicit SegmentedRecordingReader(const std::string& filename);
+
+  std::string directory_;
+  bool manifest_complete_;
+  std::vector<RecordingStream> streams_;
+  std::vector<RecordingSegment> segments_;
+  mutable std::vector<RecordingReader::Ptr> readers_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_SEGMENTED_RECORDING_H
@@ -0,0 +1,472 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "shm_ring.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+namespace rc
+{
+namespace dynamics
+{
+namespace shm
+{
+const uint32_t magic = 0x52434452;  // "RCDR"
+const uint32_t version = 1;
+const int max_readers = 32;
+
+struct Reader
+{
+  std::atomic<int32_t> pid;  // 0 if entry is free
+  std::atomic<uint64_t> position;
+  std::atomic<uint64_t> overruns;
+};
+
+/// Header of a slot, followed by slot_size bytes of message data
+struct Slot
+{
+  std::atomic<uint64_t> seq;  // 2 * n + 1 while message n is written, 2 * n + 2 when complete
+  std::atomic<uint32_t> size;
+  std::atomic<int64_t> host_stamp;
+};
+
+/// Layout of the shared memory, followed by the slots
+struct Layout
+{
+  std::atomic<uint32_t> magic;  // set last, after initialization
+  uint32_t version;
+  uint32_t slots;
+  uint32_t slot_size;
+  uint32_t slot_stride;
+  char pb_msg_type[64];
+
+  alignas(64) std::atomic<uint64_t> write_seq;  // number of published messages
+  std::atomic<uint32_t> notify;                 // futex word, incremented on every publish
+  std::atomic<uint32_t> waiters;                // number of readers waiting on notify
+
+  alignas(64) Reader readers[max_readers];
+};
+
+inline Slot* slot(Layout* layout, uint64_t n)
+{
+  return reinterpret_cast<Slot*>(reinterpret_cast<char*>(layout) + sizeof(Layout) +
+                                 (n % layout->slots) * layout->slot_stride);
+}
+
+inline char* slotData(Slot* s)
+{
+  return reinterpret_cast<char*>(s) + sizeof(Slot);
+}
+
+std::size_t mappedSize(unsigned int slots, unsigned int slot_stride)
+{
+  return sizeof(Layout) + static_cast<std::size_t>(slots) * slot_stride;
+}
+}
+
+namespace
+{
+using shm::Layout;
+using shm::Slot;
+
+int64_t steadyNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void wake(Layout* layout)
+{
+  layout->notify.fetch_add(1);
+  if (layout->waiters.load() > 0)
+  {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&layout->notify), FUTEX_WAKE, INT32_MAX, NULL, NULL, 0);
+#endif
+  }
+}
+
+/// Waits until a message after position is published or the deadline (0 for none) is reached
+void wait(Layout* layout, uint64_t position, int64_t deadline)
+{
+  layout->waiters.fetch_add(1);
+  uint32_t notify = layout->notify.load();
+
+  if (layout->write_seq.load() <= position)
+  {
+#ifdef __linux__
+    struct timespec timeout;
+    struct timespec* timeout_ptr = NULL;
+    if (deadline > 0)
+    {
+      int64_t remaining = deadline - steadyNow();
+      if (remaining < 0)
+      {
+        remaining = 0;
+      }
+      timeout.tv_sec = remaining / 1000000000;
+      timeout.tv_nsec = remaining % 1000000000;
+      timeout_ptr = &timeout;
+    }
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&layout->notify), FUTEX_WAIT, notify, timeout_ptr, NULL, 0);
+#else
+    (void)notify;
+    (void)deadline;
+    usleep(100);
+#endif
+  }
+
+  layout->waiters.fetch_sub(1);
+}
+}
+
+ShmRingWriter::Ptr ShmRingWriter::create(const std::string& name, const std::string& pb_msg_type,
+                                         unsigned int slots, unsigned int slot_size, unsigned int mode)
+{
+  return Ptr(new ShmRingWriter(name, pb_msg_type, slots, slot_size, mode));
+}
+
+ShmRingWriter::ShmRingWriter(const std::string& name, const std::string& pb_msg_type, unsigned int slots,
+                             unsigned int slot_size, unsigned int mode)
+  : name_(name), layout_(0), mapped_size_(0)
+{
+  if (slots == 0 || slot_size == 0)
+  {
+    throw std::invalid_argument("Number of slots and slot size of shared memory ring must not be 0");
+  }
+
+  if (pb_msg_type.size() >= sizeof(shm::Layout::pb_msg_type))
+  {
+    throw std::invalid_argument("Protobuf message type name too long: " + pb_msg_type);
+  }
+
+  // slots are aligned to cache lines
+  unsigned int slot_stride = (sizeof(Slot) + slot_size + 63) / 64 * 64;
+  mapped_size_ = shm::mappedSize(slots, slot_stride);
+
+  shm_unlink(name_.c_str());
+
+  // readers trust the sequence locks and the reader table, so that other
+  // users must not be able to write into the ring, which is therefore
+  // created for the owner only and opened up by fchmod() if requested
+
+  mode &= 0777;
+  int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Error while creating shared memory " + name_ + ": " + std::string(strerror(errno)));
+  }
+
+  // the umask is not applied by fchmod, which makes a requested group
+  // permission effective
+
+  if (mode != 0600 && fchmod(fd, static_cast<mode_t>(mode)) < 0)
+  {
+    int e = errno;
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw std::runtime_error("Error while setting permissions of shared memory " + name_ + ": " +
+                             std::string(strerror(e)));
+  }
+
+  if (ftruncate(fd, static_cast<off_t>(mapped_size_)) < 0)
+  {
+    int e = errno;
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw std::runtime_error("Error while resizing shared memory " + name_ + ": " + std::string(strerror(e)));
+  }
+
+  void* p = mmap(NULL, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int e = errno;
+  close(fd);
+  if (p == MAP_FAILED)
+  {
+    shm_unlink(name_.c_str());
+    throw std::runtime_error("Error while mapping shared memory " + name_ + ": " + std::string(strerror(e)));
+  }
+
+  // memory of a new shared memory object is zero-initialized
+
+  layout_ = new (p) Layout();
+  layout_->version = shm::version;
+  layout_->slots = slots;
+  layout_->slot_size = slot_size;
+  layout_->slot_stride = slot_stride;
+  strncpy(layout_->pb_msg_type, pb_msg_type.c_str(), sizeof(layout_->pb_msg_type) - 1);
+  layout_->magic.store(shm::magic, std::memory_order_release);
+}
+
+ShmRingWriter::~ShmRingWriter()
+{
+  munmap(layout_, mapped_size_);
+  shm_unlink(name_.c_str());
+}
+
+void ShmRingWriter::publish(const char* data, std::size_t size, int64_t host_stamp)
+{
+  if (size > layout_->slot_size)
+  {
+    throw std::invalid_argument("Message of size " + std::to_string(size) + " exceeds slot size " +
+                                std::to_string(layout_->slot_size) + " of shared memory ring " + name_);
+  }
+
+  uint64_t n = layout_->write_seq.load(std::memory_order_relaxed);
+  Slot* s = shm::slot(layout_, n);
+
+  s->seq.store(2 * n + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  s->size.store(static_cast<uint32_t>(size), std::memory_order_relaxed);
+  s->host_stamp.store(host_stamp, std::memory_order_relaxed);
+  memcpy(shm::slotData(s), data, size);
+
+  s->seq.store(2 * n + 2, std::memory_order_release);
+  layout_->write_seq.store(n + 1, std::memory_order_release);
+
+  wake(layout_);
+}
+
+uint64_t ShmRingWriter::getPublished() const
+{
+  return layout_->write_seq.load(std::memory_order_relaxed);
+}
+
+std::vector<ShmRingReaderInfo> ShmRingWriter::getReaders() const
+{
+  std::vector<ShmRingReaderInfo> readers;
+  uint64_t published = getPublished();
+
+  for (int i = 0; i < shm::max_readers; i++)
+  {
+    shm::Reader& r = layout_->readers[i];
+    int32_t pid = r.pid.load();
+    if (pid == 0)
+    {
+      continue;
+    }
+
+    if (kill(pid, 0) < 0 && errno == ESRCH)
+    {
+      // reader process terminated without detaching
+      r.pid.compare_exchange_strong(pid, 0);
+      continue;
+    }
+
+    ShmRingReaderInfo info;
+    info.pid = pid;
+    uint64_t position = r.position.load(std::memory_order_relaxed);
+    info.lag = published > position ? published - position : 0;
+    info.overruns = r.overruns.load(std::memory_order_relaxed);
+    readers.push_back(info);
+  }
+
+  return readers;
+}
+
+ShmRingReader::Ptr ShmRingReader::open(const std::string& name)
+{
+  return Ptr(new ShmRingReader(name));
+}
+
+ShmRingReader::ShmRingReader(const std::string& name)
+  : layout_(0), mapped_size_(0), reader_index_(-1), position_(0), slot_seq_(0), timeout_ms_(0), received_(0),
+    overruns_(0)
+{
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Error while opening shared memory " + name + ": " + std::string(strerror(errno)));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) < 0 || static_cast<std::size_t>(st.st_size) < sizeof(Layout))
+  {
+    close(fd);
+    throw std::runtime_error("Shared memory " + name + " is not a valid ring");
+  }
+
+  mapped_size_ = static_cast<std::size_t>(st.st_size);
+  void* p = mmap(NULL, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int e = errno;
+  close(fd);
+  if (p == MAP_FAILED)
+  {
+    throw std::runtime_error("Error while mapping shared memory " + name + ": " + std::string(strerror(e)));
+  }
+
+  layout_ = static_cast<Layout*>(p);
+  if (layout_->magic.load(std::memory_order_acquire) != shm::magic || layout_->version != shm::version ||
+      shm::mappedSize(layout_->slots, layout_->slot_stride) > mapped_size_)
+  {
+    munmap(layout_, mapped_size_);
+    throw std::runtime_error("Shared memory " + name + " is not a valid ring or has an incompatible version");
+  }
+
+  // register in reader table for statistics; reading works without it
+
+  int32_t pid = static_cast<int32_t>(getpid());
+  for (int i = 0; i < shm::max_readers && reader_index_ < 0; i++)
+  {
+    int32_t expected = 0;
+    if (layout_->readers[i].pid.compare_exchange_strong(expected, pid))
+    {
+      reader_index_ = i;
+    }
+  }
+
+  position_ = layout_->write_seq.load(std::memory_order_acquire);
+
+  if (reader_index_ >= 0)
+  {
+    layout_->readers[reader_index_].position.store(position_, std::memory_order_relaxed);
+    layout_->readers[reader_index_].overruns.store(0, std::memory_order_relaxed);
+  }
+}
+
+ShmRingReader::~ShmRingReader()
+{
+  if (reader_index_ >= 0)
+  {
+    layout_->readers[reader_index_].pid.store(0);
+  }
+  munmap(layout_, mapped_size_);
+}
+
+std::string ShmRingReader::getPbMsgType() const
+{
+  return std::string(layout_->pb_msg_type);
+}
+
+void ShmRingReader::setTimeout(unsigned int ms)
+{
+  timeout_ms_ = ms;
+}
+
+const char* ShmRingReader::receiveRaw(std::size_t& size, int64_t& host_stamp)
+{
+  int64_t deadline = timeout_ms_ > 0 ? steadyNow() + static_cast<int64_t>(timeout_ms_) * 1000000 : 0;
+
+  while (true)
+  {
+    uint64_t published = layout_->write_seq.load(std::memory_order_acquire);
+
+    if (position_ < published)
+    {
+      // skip messages that have already been overwritten
+
+      if (published - position_ > layout_->slots)
+      {
+        overruns_ += published - layout_->slots - position_;
+        position_ = published - layout_->slots;
+      }
+
+      Slot* s = shm::slot(layout_, position_);
+      uint64_t expected = 2 * position_ + 2;
+      position_++;
+
+      if (s->seq.load(std::memory_order_acquire) != expected)
+      {
+        overruns_++;
+        continue;
+      }
+
+      size = s->size.load(std::memory_order_relaxed);
+      if (size > layout_->slot_size)
+      {
+        size = layout_->slot_size;
+      }
+      host_stamp = s->host_stamp.load(std::memory_order_relaxed);
+      slot_seq_ = expected;
+
+      if (reader_index_ >= 0)
+      {
+        layout_->readers[reader_index_].position.store(position_, std::memory_order_relaxed);
+        layout_->readers[reader_index_].overruns.store(overruns_, std::memory_order_relaxed);
+      }
+
+      return shm::slotData(s);
+    }
+
+    if (deadline > 0 && steadyNow() >= deadline)
+    {
+      return nullptr;
+    }
+
+    wait(layout_, position_, deadline);
+  }
+}
+
+bool ShmRingReader::validate()
+{
+  Slot* s = shm::slot(layout_, position_ - 1);
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (s->seq.load(std::memory_order_relaxed) == slot_seq_)
+  {
+    received_++;
+    return true;
+  }
+
+  overruns_++;
+  if (reader_index_ >= 0)
+  {
+    layout_->readers[reader_index_].overruns.store(overruns_, std::memory_order_relaxed);
+  }
+  return false;
+}
+
+uint64_t ShmRingReader::getLag() const
+{
+  uint64_t published = layout_->write_seq.load(std::memory_order_relaxed);
+  return published > position_ ? published - position_ : 0;
+}
+}
+}
@@ -0,0 +1,235 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RC_DYNAMICS_API_SHM_RING_H
+#define RC_DYNAMICS_API_SHM_RING_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <google/protobuf/message.h>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace shm
+{
+struct Layout;
+}
+
+/**
+ * Statistics of a reader attached to a shared memory ring.
+ */
+struct ShmRingReaderInfo
+{
+  int pid;            ///< process id of the reader
+  uint64_t lag;       ///< number of published messages not yet read
+  uint64_t overruns;  ///< number of messages lost because the reader was too slow
+};
+
+/**
+ * Publishes serialized messages of one data stream into a ring buffer in
+ * POSIX shared memory, so that any number of processes on the same host can
+ * read the stream, while it is requested only once from the rc_visard (see
+ * the rcdynamics_relay tool).
+ *
+ * Every slot of the ring is protected by its own sequence lock, so that
+ * writing never waits for readers. Readers that fall behind by more than
+ * the number of slots lose messages, which is reported as overrun.
+ *
+ * NOTE: Only one ShmRingWriter may publish into a ring at the same time.
+ */
+class ShmRingWriter
+{
+public:
+  using Ptr = std::shared_ptr<ShmRingWriter>;
+
+  /**
+   * Creates the shared memory ring, replacing an existing one of the same name.
+   *
+   * @param name name of the shared memory object, e.g. "/rcdynamics_dynamics"
+   * @param pb_msg_type protobuf message type of the stream, e.g. "Dynamics"
+   * @param slots number of messages the ring can hold
+   * @param slot_size maximum size of a message in bytes
+   * @param mode access permissions of the shared memory object, regardless of the umask. Readers need read and
+   *             write access, since they register themselves in the ring. The default only permits processes of
+   *             the same user, 0660 additionally permits the group.
+   */
+  static Ptr create(const std::string& name, const std::string& pb_msg_type, unsigned int slots = 1024,
+                    unsigned int slot_size = 512, unsigned int mode = 0600);
+
+  /// Unmaps and removes the shared memory ring
+  virtual ~ShmRingWriter();
+
+  /**
+   * Publishes a serialized message.
+   *
+   * @param data serialized message
+   * @param size size of the message, at most slot_size
+   * @param host_stamp receive time stamp in nanoseconds of the host's steady clock
+   */
+  void publish(const char* data, std::size_t size, int64_t host_stamp);
+
+  /// Returns the number of published messages
+  uint64_t getPublished() const;
+
+  /**
+   * Returns statistics of all readers that are currently attached. Entries
+   * of reader processes that terminated without detaching are released.
+   */
+  std::vector<ShmRingReaderInfo> getReaders() const;
+
+protected:
+  ShmRingWriter(const std::string& name, const std::string& pb_msg_type, unsigned int slots,
+                unsigned int slot_size, unsigned int mode);
+
+  std::string name_;
+  shm::Layout* layout_;
+  std::size_t mapped_size_;
+};
+
+/**
+ * Reads the messages of a shared memory ring published by a ShmRingWriter.
+ *
+ * The interface follows the one of DataReceiver. Messages are de-serialized
+ * directly from shared memory without any intermediate copy.
+ *
+ * NOTE: A ShmRingReader is not thread-safe.
+ */
+class ShmRingReader
+{
+public:
+  using Ptr = std::shared_ptr<ShmRingReader>;
+
+  /**
+   * Attaches to an existing shared memory ring. Reading starts with the next
+   * published message.
+   *
+   * @param name name of the shared memory object, e.g. "/rcdynamics_dynamics"
+   */
+  static Ptr open(const std::string& name);
+
+  /// Detaches from the shared memory ring
+  virtual ~ShmRingReader();
+
+  /// Returns the protobuf message type of the stream, e.g. "Dynamics"
+  std::string getPbMsgType() const;
+
+  /**
+   * Sets a timeout for the receive methods.
+   *
+   * @param ms timeout in milliseconds
+   */
+  void setTimeout(unsigned int ms);
+
+  /**
+   * Returns the next message without de-serializing it.
+   *
+   * The returned pointer refers to the shared memory and may be overwritten
+   * by the writer at any time. After processing the data, the caller must
+   * check with validate() that this did not happen.
+   *
+   * @param size size of the message in bytes
+   * @param host_stamp receive time stamp of the writer in nanoseconds of the host's steady clock
+   * @return pointer to the serialized message, or NULL if timeout
+   */
+  const char* receiveRaw(std::size_t& size, int64_t& host_stamp);
+
+  /**
+   * Checks that the data of the last call to receiveRaw() has not been
+   * overwritten in the meantime. Otherwise, it counts as overrun.
+   */
+  bool validate();
+
+  /**
+   * Receives the next message (template-parameter version), see
+   * DataReceiver::receive().
+   *
+   * @return the next message as PbMsgType, or NULL if timeout
+   */
+  template <class PbMsgType>
+  std::shared_ptr<PbMsgType> receive()
+  {
+    std::size_t size;
+    int64_t host_stamp;
+    const char* data;
+    while ((data = receiveRaw(size, host_stamp)) != 0)
+    {
+      auto pb_msg = std::shared_ptr<PbMsgType>(new PbMsgType());
+      bool parsed = pb_msg->ParseFromArray(data, static_cast<int>(size));
+
+      // message may have been overwritten while parsing; then continue with the next one
+      if (validate() && parsed)
+      {
+        return pb_msg;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Returns the number of successfully received messages
+  uint64_t getReceived() const
+  {
+    return received_;
+  }
+
+  /// Returns the number of published messages that have not been received yet
+  uint64_t getLag() const;
+
+  /// Returns the number of messages lost because this reader was too slow
+  uint64_t getOverruns() const
+  {
+    return overruns_;
+  }
+
+protected:
+  ShmRingReader(const std::string& name);
+
+  shm::Layout* layout_;
+  std::size_t mapped_size_;
+  int reader_index_;  // index in reader table of shared memory, or -1
+
+  uint64_t position_;   // sequence number of the next message to be read
+  uint64_t slot_seq_;   // expected slot sequence number of the message returned by receiveRaw()
+  unsigned int timeout_ms_;
+
+  uint64_t received_, overruns_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_SHM_RING_H
@@ -34,6 +34,7 @@
  */
 
 #include "socket_exception.h"
+#include "metrics.h"
 
 #include <string>
 
@@ -44,6 +45,9 @@ namespace dynamics
 SocketException::SocketException(const std::string& msg, const int errnum)
   : std::runtime_error(msg), errnum_(errnum), msg_(msg + " - " + std::to_string(errnum))
 {
+  static Counter& errors =
+      MetricsRegistry::getDefault()->counter("rc_dynamics_socket_errors_total", "Failed socket operations");
+  errors.inc();
 }
 
 const char* SocketException::what() const noexcept
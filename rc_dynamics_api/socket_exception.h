@@ -33,6 +33,9 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#ifndef RC_DYNAMICS_API_SOCKET_EXCEPTION_H
+#define RC_DYNAMICS_API_SOCKET_EXCEPTION_H
+
 #include <stdexcept>
 
 namespace rc
@@ -71,4 +74,6 @@ private:
   const std::string msg_;
 };
 }
-}
\ No newline at end of file
+}
+
+#endif  // RC_DYNAMICS_API_SOCKET_EXCEPTION_H
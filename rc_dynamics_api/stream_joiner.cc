@@ -0,0 +1,455 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "stream_joiner.h"
+#include "pose_kernels.h"
+#include "pose_timeline.h"
+
+#include "roboception/msgs/dynamics.pb.h"
+#include "roboception/msgs/frame.pb.h"
+#include "roboception/msgs/imu.pb.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+const int64_t NS_PER_SEC = 1000000000;
+
+void setTime(roboception::msgs::Time* time, int64_t stamp)
+{
+  int64_t sec = stamp / NS_PER_SEC;
+  int64_t nsec = stamp % NS_PER_SEC;
+  if (nsec < 0)
+  {
+    sec--;
+    nsec += NS_PER_SEC;
+  }
+
+  time->set_sec(static_cast<int32_t>(sec));
+  time->set_nsec(static_cast<int32_t>(nsec));
+}
+
+void lerp(const roboception::msgs::Vector3d& a, const roboception::msgs::Vector3d& b, double alpha,
+          roboception::msgs::Vector3d* out)
+{
+  out->set_x(a.x() + alpha * (b.x() - a.x()));
+  out->set_y(a.y() + alpha * (b.y() - a.y()));
+  out->set_z(a.z() + alpha * (b.z() - a.z()));
+}
+
+void interpolatePose(const roboception::msgs::Pose& a, const roboception::msgs::Pose& b, double alpha,
+                     roboception::msgs::Pose* out)
+{
+  lerp(a.position(), b.position(), alpha, out->mutable_position());
+
+  const roboception::msgs::Quaternion& qa = a.orientation();
+  const roboception::msgs::Quaternion& qb = b.orientation();
+  double ax = qa.x(), ay = qa.y(), az = qa.z(), aw = qa.w();
+  double bx = qb.x(), by = qb.y(), bz = qb.z(), bw = qb.w();
+  double x, y, z, w;
+
+  kernels::scalar::slerp(kernels::ConstQuaternionArray(&ax, &ay, &az, &aw),
+                         kernels::ConstQuaternionArray(&bx, &by, &bz, &bw), &alpha,
+                         kernels::QuaternionArray{ &x, &y, &z, &w }, 1);
+
+  roboception::msgs::Quaternion* q = out->mutable_orientation();
+  q->set_x(x);
+  q->set_y(y);
+  q->set_z(z);
+  q->set_w(w);
+}
+}
+
+bool StreamJoiner::Tuple::isComplete() const
+{
+  for (const auto& msg : messages)
+  {
+    if (!msg)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+StreamJoiner::Config::Config()
+  : matching(Matching::NEAREST), tolerance_ns(5000000), max_delay_ns(0), max_lag_ns(NS_PER_SEC), capacity(4096),
+    partial(false)
+{
+}
+
+int64_t StreamJoiner::getStamp(const ::google::protobuf::Message& msg)
+{
+  if (auto imu = dynamic_cast<const roboception::msgs::Imu*>(&msg))
+  {
+    return toNanoseconds(imu->timestamp());
+  }
+
+  if (auto dynamics = dynamic_cast<const roboception::msgs::Dynamics*>(&msg))
+  {
+    return toNanoseconds(dynamics->timestamp());
+  }
+
+  if (auto frame = dynamic_cast<const roboception::msgs::Frame*>(&msg))
+  {
+    return toNanoseconds(frame->pose().timestamp());
+  }
+
+  throw std::invalid_argument("Cannot get time stamp of message type " + msg.GetTypeName());
+}
+
+StreamJoiner::MessagePtr StreamJoiner::interpolate(const MessagePtr& a, int64_t stamp_a, const MessagePtr& b,
+                                                   int64_t stamp_b, int64_t stamp)
+{
+  if (stamp_b <= stamp_a)
+  {
+    return a;
+  }
+
+  double alpha = static_cast<double>(stamp - stamp_a) / static_cast<double>(stamp_b - stamp_a);
+  const MessagePtr& nearest = alpha < 0.5 ? a : b;
+
+  if (stamp == stamp_a || stamp == stamp_b)
+  {
+    return nearest;
+  }
+
+  {
+    auto ia = dynamic_cast<const roboception::msgs::Imu*>(a.get());
+    auto ib = dynamic_cast<const roboception::msgs::Imu*>(b.get());
+    if (ia && ib)
+    {
+      std::shared_ptr<roboception::msgs::Imu> msg(new roboception::msgs::Imu(alpha < 0.5 ? *ia : *ib));
+      setTime(msg->mutable_timestamp(), stamp);
+      lerp(ia->linear_acceleration(), ib->linear_acceleration(), alpha, msg->mutable_linear_acceleration());
+      lerp(ia->angular_velocity(), ib->angular_velocity(), alpha, msg->mutable_angular_velocity());
+      return msg;
+    }
+  }
+
+  {
+    auto da = dynamic_cast<const roboception::msgs::Dynamics*>(a.get());
+    auto db = dynamic_cast<const roboception::msgs::Dynamics*>(b.get());
+    if (da && db)
+    {
+      std::shared_ptr<roboception::msgs::Dynamics> msg(new roboception::msgs::Dynamics(alpha < 0.5 ? *da : *db));
+      setTime(msg->mutable_timestamp(), stamp);
+      interpolatePose(da->pose(), db->pose(), alpha, msg->mutable_pose());
+      lerp(da->linear_velocity(), db->linear_velocity(), alpha, msg->mutable_linear_velocity());
+      lerp(da->angular_velocity(), db->angular_velocity(), alpha, msg->mutable_angular_velocity());
+      lerp(da->linear_acceleration(), db->linear_acceleration(), alpha, msg->mutable_linear_acceleration());
+      return msg;
+    }
+  }
+
+  {
+    auto fa = dynamic_cast<const roboception::msgs::Frame*>(a.get());
+    auto fb = dynamic_cast<const roboception::msgs::Frame*>(b.get());
+    if (fa && fb)
+    {
+      std::shared_ptr<roboception::msgs::Frame> msg(new roboception::msgs::Frame(alpha < 0.5 ? *fa : *fb));
+      setTime(msg->mutable_pose()->mutable_timestamp(), stamp);
+      interpolatePose(fa->pose().pose(), fb->pose().pose(), alpha, msg->mutable_pose()->mutable_pose());
+      return msg;
+    }
+  }
+
+  return nearest;
+}
+
+StreamJoiner::Ptr StreamJoiner::create(std::size_t streams, const Config& config)
+{
+  if (streams < 2)
+  {
+    throw std::invalid_argument("A stream joiner needs at least two streams");
+  }
+
+  return Ptr(new StreamJoiner(streams, config));
+}
+
+StreamJoiner::StreamJoiner(std::size_t streams, const Config& config) : config_(config), buffers_(streams)
+{
+  config_.tolerance_ns = config_.matching == Matching::EXACT ? 0 : std::max<int64_t>(0, config_.tolerance_ns);
+  config_.max_delay_ns = std::max<int64_t>(0, config_.max_delay_ns);
+  config_.max_lag_ns = std::max<int64_t>(0, config_.max_lag_ns);
+  config_.capacity = std::max<std::size_t>(1, config_.capacity);
+
+  stats_ = Statistics();
+  reset();
+}
+
+bool StreamJoiner::push(std::size_t stream, const MessagePtr& msg)
+{
+  if (!msg)
+  {
+    throw std::invalid_argument("Cannot join null message");
+  }
+
+  return push(stream, getStamp(*msg), msg);
+}
+
+bool StreamJoiner::push(std::size_t stream, int64_t stamp, const MessagePtr& msg)
+{
+  if (stream >= buffers_.size())
+  {
+    throw std::invalid_argument("Invalid stream index for joining: " + std::to_string(stream));
+  }
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  stats_.pushed++;
+
+  // messages of the reference stream must be newer than the last tuple,
+  // messages of the other streams can still be matched with the next tuple
+  // if they are not older than the last one
+
+  if (emitted_ && (stamp < frontier_ || (stream == 0 && stamp == frontier_)))
+  {
+    stats_.late++;
+    return false;
+  }
+
+  if (!started_)
+  {
+    // streams that have not received any messages yet lag behind from the
+    // first message of any stream
+
+    for (auto& buffer : buffers_)
+    {
+      buffer.latest = stamp;
+    }
+    started_ = true;
+  }
+
+  Buffer& buffer = buffers_[stream];
+  std::deque<Entry>& entries = buffer.entries;
+
+  if (entries.empty() || stamp >= entries.back().stamp)
+  {
+    entries.push_back(Entry{ stamp, msg });
+  }
+  else
+  {
+    auto it = std::upper_bound(entries.begin(), entries.end(), stamp,
+                               [](int64_t s, const Entry& e) { return s < e.stamp; });
+    entries.insert(it, Entry{ stamp, msg });
+  }
+
+  buffer.latest = std::max(buffer.latest, stamp);
+
+  if (entries.size() > config_.capacity)
+  {
+    entries.pop_front();
+    stats_.overflow++;
+  }
+
+  return true;
+}
+
+bool StreamJoiner::pop(Tuple& tuple)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  std::deque<Entry>& reference = buffers_[0].entries;
+  while (!reference.empty() && isReady(reference.front().stamp))
+  {
+    int64_t stamp = reference.front().stamp;
+
+    tuple.stamp = stamp;
+    tuple.messages.resize(buffers_.size());
+    tuple.messages[0] = reference.front().msg;
+    for (std::size_t i = 1; i < buffers_.size(); i++)
+    {
+      tuple.messages[i] = match(buffers_[i], stamp);
+    }
+
+    reference.pop_front();
+    for (std::size_t i = 1; i < buffers_.size(); i++)
+    {
+      prune(buffers_[i], stamp);
+    }
+
+    emitted_ = true;
+    frontier_ = stamp;
+
+    if (!tuple.isComplete())
+    {
+      stats_.incomplete++;
+      if (!config_.partial)
+      {
+        continue;
+      }
+    }
+
+    stats_.emitted++;
+    return true;
+  }
+
+  return false;
+}
+
+void StreamJoiner::flush()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  const std::deque<Entry>& reference = buffers_[0].entries;
+  if (!reference.empty())
+  {
+    flushed_ = std::max(flushed_, reference.back().stamp);
+  }
+}
+
+std::size_t StreamJoiner::getBufferSize(std::size_t stream) const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return buffers_.at(stream).entries.size();
+}
+
+StreamJoiner::Statistics StreamJoiner::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return stats_;
+}
+
+void StreamJoiner::reset()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  for (auto& buffer : buffers_)
+  {
+    buffer.entries.clear();
+    buffer.latest = 0;
+  }
+
+  started_ = false;
+  emitted_ = false;
+  frontier_ = std::numeric_limits<int64_t>::min();
+  flushed_ = std::numeric_limits<int64_t>::min();
+}
+
+bool StreamJoiner::isReady(int64_t stamp) const
+{
+  if (stamp <= flushed_)
+  {
+    return true;
+  }
+
+  int64_t newest = std::numeric_limits<int64_t>::min();
+  for (const auto& buffer : buffers_)
+  {
+    newest = std::max(newest, buffer.latest);
+  }
+
+  // the reference message itself must be final, and all other streams must
+  // have passed the end of the window in which they can match
+
+  for (std::size_t i = 0; i < buffers_.size(); i++)
+  {
+    const Buffer& buffer = buffers_[i];
+    int64_t required = i == 0 ? stamp : stamp + config_.tolerance_ns;
+
+    if (buffer.latest - config_.max_delay_ns < required && buffer.latest >= newest - config_.max_lag_ns)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+StreamJoiner::MessagePtr StreamJoiner::match(const Buffer& buffer, int64_t stamp) const
+{
+  const std::deque<Entry>& entries = buffer.entries;
+
+  // first message that is not older than the reference message
+
+  auto next = std::lower_bound(entries.begin(), entries.end(), stamp,
+                               [](const Entry& e, int64_t s) { return e.stamp < s; });
+
+  if (next != entries.end() && next->stamp == stamp)
+  {
+    return next->msg;
+  }
+
+  if (config_.matching == Matching::EXACT)
+  {
+    return MessagePtr();
+  }
+
+  bool has_next = next != entries.end() && next->stamp - stamp <= config_.tolerance_ns;
+  bool has_prev = next != entries.begin() && stamp - (next - 1)->stamp <= config_.tolerance_ns;
+
+  if (config_.matching == Matching::INTERPOLATE)
+  {
+    if (has_prev && has_next)
+    {
+      auto prev = next - 1;
+      return interpolate(prev->msg, prev->stamp, next->msg, next->stamp, stamp);
+    }
+    return MessagePtr();
+  }
+
+  if (has_prev && (!has_next || stamp - (next - 1)->stamp <= next->stamp - stamp))
+  {
+    return (next - 1)->msg;
+  }
+
+  if (has_next)
+  {
+    return next->msg;
+  }
+
+  return MessagePtr();
+}
+
+void StreamJoiner::prune(Buffer& buffer, int64_t stamp)
+{
+  // the latest message that is not newer than the reference message may
+  // still be the nearest or the left neighbour of the next one
+
+  std::deque<Entry>& entries = buffer.entries;
+  while (entries.size() > 1 && entries[1].stamp <= stamp)
+  {
+    entries.pop_front();
+  }
+}
+}
+}
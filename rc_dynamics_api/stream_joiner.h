@@ -0,0 +1,254 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_STREAM_JOINER_H
+#define RC_DYNAMICS_API_STREAM_JOINER_H
+
+#include <google/protobuf/message.h>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Aligns the messages of several data streams by their time stamps, e.g. for
+ * fusing 'imu' with 'dynamics' or 'pose' with 'pose_rt', which are received
+ * by separate DataReceivers.
+ *
+ * The first stream is the reference stream. For every message of the
+ * reference stream, one tuple is emitted that contains the message and the
+ * matching message of each other stream, which is either the message with
+ * exactly the same time stamp, the nearest message within a tolerance, or
+ * a message that is interpolated between the two neighbouring messages.
+ *
+ * Messages are buffered per stream, sorted by time stamp, so that messages
+ * may arrive out of order and streams may be delayed relative to each other.
+ * A tuple is emitted as soon as its matches cannot change anymore, i.e. when
+ * the watermarks of all streams have passed the time stamp of the reference
+ * message plus the tolerance. The watermark of a stream is its latest time
+ * stamp minus the maximum delay with which messages may arrive out of order.
+ * Messages that are older than the last emitted tuple are late and dropped.
+ * Streams that lag behind the others by more than a configurable time, e.g.
+ * because they are not streamed at all, do not hold back the other streams.
+ *
+ * Memory is bounded by the capacity per stream. If a buffer is full, its
+ * oldest message is dropped. Searching matches and inserting messages takes
+ * O(log n) time for n buffered messages, appending in order takes constant
+ * time.
+ *
+ * All methods are thread-safe, so that every stream can be pushed from the
+ * thread of its DataReceiver.
+ */
+class StreamJoiner
+{
+public:
+  using Ptr = std::shared_ptr<StreamJoiner>;
+  using MessagePtr = std::shared_ptr<const ::google::protobuf::Message>;
+
+  /// How messages of the other streams are matched to the reference stream
+  enum class Matching
+  {
+    EXACT,       ///< same time stamp
+    NEAREST,     ///< nearest time stamp within the tolerance
+    INTERPOLATE  ///< interpolated between the neighbouring messages within the tolerance, see interpolate()
+  };
+
+  /// Parameters of the joiner
+  struct Config
+  {
+    Config();
+
+    Matching matching;     ///< how messages are matched
+    int64_t tolerance_ns;  ///< maximum time difference of matched (or interpolated) messages, ignored for EXACT
+    int64_t max_delay_ns;  ///< maximum delay of messages that arrive out of order within a stream
+    int64_t max_lag_ns;    ///< streams that lag more behind the newest message do not hold back emission
+    std::size_t capacity;  ///< maximum number of buffered messages per stream
+    bool partial;          ///< emit tuples without a match for all streams, with missing messages set to null
+  };
+
+  /// Time-matched messages of all streams
+  struct Tuple
+  {
+    int64_t stamp;                     ///< time stamp of the reference message in nanoseconds since epoch
+    std::vector<MessagePtr> messages;  ///< one message per stream, null if there is no match
+
+    /// Returns true if there is a message for every stream
+    bool isComplete() const;
+
+    /// Returns the message of the given stream as type T, or null if missing or of a different type
+    template <class T>
+    std::shared_ptr<const T> get(std::size_t stream) const
+    {
+      return std::dynamic_pointer_cast<const T>(messages.at(stream));
+    }
+  };
+
+  /// Number of messages and tuples since creation
+  struct Statistics
+  {
+    uint64_t pushed;      ///< messages that have been pushed
+    uint64_t emitted;     ///< tuples that have been emitted
+    uint64_t incomplete;  ///< reference messages without a match for all streams
+    uint64_t late;        ///< messages that have been dropped, because they arrived too late
+    uint64_t overflow;    ///< messages that have been dropped, because the buffer of their stream was full
+  };
+
+  /**
+   * Returns the time stamp of an Imu, Dynamics or Frame message in
+   * nanoseconds since epoch.
+   *
+   * @throw std::invalid_argument if the message is of any other type
+   */
+  static int64_t getStamp(const ::google::protobuf::Message& msg);
+
+  /**
+   * Interpolates between two messages of the same type at the given time
+   * stamp. Vectors of Imu and Dynamics messages are interpolated linearly,
+   * poses of Dynamics and Frame messages linearly in position and by slerp
+   * in orientation. All other fields are taken from the nearest message.
+   * Other message types are not interpolated, but the nearest message is
+   * returned.
+   *
+   * @param a message before stamp
+   * @param stamp_a time stamp of a in nanoseconds since epoch
+   * @param b message after stamp
+   * @param stamp_b time stamp of b in nanoseconds since epoch
+   * @param stamp time stamp of the interpolated message
+   * @return new message with the given time stamp, or a or b
+   */
+  static MessagePtr interpolate(const MessagePtr& a, int64_t stamp_a, const MessagePtr& b, int64_t stamp_b,
+                                int64_t stamp);
+
+  /**
+   * Creates a joiner.
+   *
+   * @param streams number of streams, at least 2, the first is the reference stream
+   * @param config parameters of the joiner
+   */
+  static Ptr create(std::size_t streams, const Config& config = Config());
+
+  /// Returns the number of streams
+  std::size_t getNumStreams() const
+  {
+    return buffers_.size();
+  }
+
+  /**
+   * Adds a message of a stream, with the time stamp given by getStamp().
+   *
+   * @param stream index of the stream
+   * @param msg Imu, Dynamics or Frame message
+   * @return false if the message has been dropped because it is late
+   * @throw std::invalid_argument if the stream index or the message type is invalid
+   */
+  bool push(std::size_t stream, const MessagePtr& msg);
+
+  /**
+   * Adds a message of a stream with an explicit time stamp, e.g. for
+   * message types without time stamp or for time stamps that have been
+   * converted to host time by a ClockEstimator.
+   *
+   * @param stream index of the stream
+   * @param stamp time stamp in nanoseconds since epoch
+   * @param msg message
+   * @return false if the message has been dropped because it is late
+   * @throw std::invalid_argument if the stream index is invalid
+   */
+  bool push(std::size_t stream, int64_t stamp, const MessagePtr& msg);
+
+  /**
+   * Takes the next tuple in order of time stamps, if one is ready. Without
+   * partial tuples (see Config), reference messages without a complete
+   * match are skipped.
+   *
+   * @param tuple next tuple (only valid if returned true)
+   * @return false if no tuple is ready
+   */
+  bool pop(Tuple& tuple);
+
+  /**
+   * Makes all buffered reference messages ready, regardless of the
+   * watermarks, e.g. at the end of a recording. Messages that arrive later
+   * than the last tuple emitted after flushing are dropped as late.
+   */
+  void flush();
+
+  /// Returns the number of buffered messages of a stream
+  std::size_t getBufferSize(std::size_t stream) const;
+
+  /// Returns the number of messages and tuples since creation
+  Statistics getStatistics() const;
+
+  /// Removes all buffered messages and forgets all time stamps
+  void reset();
+
+private:
+  StreamJoiner(std::size_t streams, const Config& config);
+
+  struct Entry
+  {
+    int64_t stamp;
+    MessagePtr msg;
+  };
+
+  struct Buffer
+  {
+    std::deque<Entry> entries;  // sorted by time stamp
+    int64_t latest;             // latest time stamp that has been pushed, or of the first message of any stream
+  };
+
+  bool isReady(int64_t stamp) const;
+  MessagePtr match(const Buffer& buffer, int64_t stamp) const;
+  void prune(Buffer& buffer, int64_t stamp);
+
+  Config config_;
+  mutable std::mutex mtx_;
+  std::vector<Buffer> buffers_;
+  bool started_;      // true if any message has been pushed
+  bool emitted_;      // true if any tuple has been emitted
+  int64_t frontier_;  // time stamp of the last emitted (or skipped) reference message
+  int64_t flushed_;   // reference messages up to this time stamp are ready regardless of watermarks
+  Statistics stats_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_STREAM_JOINER_H
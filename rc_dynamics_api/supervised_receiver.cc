@@ -0,0 +1,170 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "supervised_receiver.h"
+
+#include <algorithm>
+
+namespace rc
+{
+namespace dynamics
+{
+SupervisedReceiver::Ptr SupervisedReceiver::create(const RemoteInterface::Ptr& remote, const std::string& stream,
+                                                   const std::string& dest_interface, unsigned int dest_port,
+                                                   unsigned int silence_ms)
+{
+  return Ptr(new SupervisedReceiver(remote, stream, dest_interface, dest_port, silence_ms));
+}
+
+SupervisedReceiver::SupervisedReceiver(const RemoteInterface::Ptr& remote, const std::string& stream,
+                                       const std::string& dest_interface, unsigned int dest_port,
+                                       unsigned int silence_ms)
+  : remote_(remote), stream_(stream), silence_(std::max(10u, silence_ms)), stop_(false), stats_()
+{
+  metric_outages_ = &MetricsRegistry::getDefault()->counter(
+      "rc_dynamics_stream_outages_total", "Interruptions of supervised streams", { { "stream", stream } });
+  receiver_ = remote_->createReceiverForStream(stream, dest_interface, dest_port);
+  thread_ = std::thread(&SupervisedReceiver::run, this);
+}
+
+SupervisedReceiver::~SupervisedReceiver()
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+
+  cond_.notify_all();
+  thread_.join();
+}
+
+StreamOutageStats SupervisedReceiver::getStats() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  StreamOutageStats stats = stats_;
+  if (stats.in_outage)
+  {
+    stats.current_outage_ms = std::chrono::duration<double, std::milli>(Clock::now() - outage_start_).count();
+  }
+  return stats;
+}
+
+void SupervisedReceiver::run()
+{
+  const Clock::duration interval = silence_ / 5;
+  const Clock::duration max_check_interval = std::max<Clock::duration>(silence_, std::chrono::seconds(5));
+
+  uint64_t count = receiver_->getMessageCount();
+  Clock::time_point last_message = Clock::now();
+  Clock::time_point next_check;
+  Clock::duration check_interval = silence_;
+
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (!stop_)
+  {
+    cond_.wait_for(lock, interval);
+    if (stop_)
+    {
+      break;
+    }
+
+    Clock::time_point now = Clock::now();
+    uint64_t c = receiver_->getMessageCount();
+    if (c != count)
+    {
+      count = c;
+      last_message = now;
+
+      if (stats_.in_outage)
+      {
+        double ms = std::chrono::duration<double, std::milli>(now - outage_start_).count();
+        stats_.in_outage = false;
+        stats_.current_outage_ms = 0;
+        stats_.last_outage_ms = ms;
+        stats_.max_outage_ms = std::max(stats_.max_outage_ms, ms);
+        stats_.total_outage_ms += ms;
+      }
+      continue;
+    }
+
+    if (now - last_message < silence_)
+    {
+      continue;
+    }
+
+    if (!stats_.in_outage)
+    {
+      stats_.in_outage = true;
+      stats_.outages++;
+      metric_outages_->inc();
+      outage_start_ = last_message;
+      next_check = now;
+      check_interval = silence_;
+    }
+
+    if (now < next_check)
+    {
+      continue;
+    }
+
+    // the rc_visard may not be reachable for a while, e.g. while rebooting,
+    // so that checks are done with increasing intervals
+
+    next_check = now + check_interval;
+    check_interval = std::min(max_check_interval, 2 * check_interval);
+
+    lock.unlock();
+    bool restored = false, failed = false;
+    try
+    {
+      restored = remote_->restoreDestination(receiver_);
+    }
+    catch (std::exception&)
+    {
+      failed = true;
+    }
+    lock.lock();
+
+    if (restored)
+    {
+      stats_.restored++;
+    }
+    if (failed)
+    {
+      stats_.failed_checks++;
+    }
+  }
+}
+}
+}
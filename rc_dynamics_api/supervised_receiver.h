@@ -0,0 +1,144 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_SUPERVISED_RECEIVER_H
+#define RC_DYNAMICS_API_SUPERVISED_RECEIVER_H
+
+#include "remote_interface.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Statistics of a SupervisedReceiver about interruptions of the stream.
+ */
+struct StreamOutageStats
+{
+  uint64_t outages;          ///< number of periods without messages longer than the silence threshold
+  uint64_t restored;         ///< number of times the destination had to be registered again
+  uint64_t failed_checks;    ///< number of checks that failed, e.g. because the rc_visard was not reachable
+  bool in_outage;            ///< true if the stream is currently interrupted
+  double current_outage_ms;  ///< duration of the current outage, 0 if there is none
+  double last_outage_ms;     ///< duration of the last finished outage
+  double max_outage_ms;      ///< longest finished outage
+  double total_outage_ms;    ///< sum of all finished outages
+};
+
+/**
+ * Receives a data stream like a receiver of
+ * RemoteInterface::createReceiverForStream(), but supervises the stream in
+ * a background thread and heals it automatically.
+ *
+ * If no message has been received for longer than a silence threshold,
+ * e.g. because the rc_visard rebooted and lost all destinations, the
+ * supervisor checks if the destination is still registered and registers
+ * it again if not. Checks are repeated with increasing intervals until
+ * messages arrive again. The consumer just keeps receiving from
+ * getReceiver(), which returns NULL on timeouts during an outage.
+ *
+ * The duration of outages is measured from the last message before until
+ * the first message after the outage, with the resolution of the
+ * supervision interval, i.e. a fifth of the silence threshold.
+ */
+class SupervisedReceiver
+{
+public:
+  using Ptr = std::shared_ptr<SupervisedReceiver>;
+
+  /**
+   * Creates a receiver for the stream and starts supervising it.
+   *
+   * @param remote remote interface of the rc_visard
+   * @param stream stream type, e.g. "pose", "pose_rt" or "dynamics"
+   * @param dest_interface empty or one of this hosts network interfaces, e.g. "eth0"
+   * @param dest_port 0 or this hosts port number
+   * @param silence_ms time without messages after which the stream is checked
+   */
+  static Ptr create(const RemoteInterface::Ptr& remote, const std::string& stream,
+                    const std::string& dest_interface = "", unsigned int dest_port = 0,
+                    unsigned int silence_ms = 500);
+
+  /**
+   * Stops supervising. The destination is removed when the receiver is no
+   * longer used. If the supervisor is just checking the destination, the
+   * destructor waits until the request has finished, which may take up to
+   * the timeout of requests of the RemoteInterface including retries.
+   */
+  ~SupervisedReceiver();
+
+  /// Returns the receiver of the stream, which is never replaced
+  const DataReceiver::Ptr& getReceiver() const
+  {
+    return receiver_;
+  }
+
+  /// Returns the name of the stream
+  const std::string& getStream() const
+  {
+    return stream_;
+  }
+
+  /// Returns statistics about interruptions of the stream
+  StreamOutageStats getStats() const;
+
+private:
+  SupervisedReceiver(const RemoteInterface::Ptr& remote, const std::string& stream,
+                     const std::string& dest_interface, unsigned int dest_port, unsigned int silence_ms);
+
+  void run();
+
+  typedef std::chrono::steady_clock Clock;
+
+  RemoteInterface::Ptr remote_;
+  std::string stream_;
+  DataReceiver::Ptr receiver_;
+  std::chrono::milliseconds silence_;
+
+  mutable std::mutex mtx_;
+  std::condition_variable cond_;
+  bool stop_;
+  StreamOutageStats stats_;
+  Counter* metric_outages_;
+  Clock::time_point outage_start_;
+  std::thread thread_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_SUPERVISED_RECEIVER_H
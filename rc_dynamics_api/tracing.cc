@@ -0,0 +1,279 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "tracing.h"
+#include "json.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+// appends a string as JSON string, which is usually a literal without special characters
+void appendString(std::string& out, const char* s)
+{
+  out += '"';
+  for (; *s != '\0'; s++)
+  {
+    unsigned char c = static_cast<unsigned char>(*s);
+    if (c == '"' || c == '\\')
+    {
+      out += '\\';
+      out += static_cast<char>(c);
+    }
+    else if (c < 0x20)
+    {
+      char tmp[8];
+      std::snprintf(tmp, sizeof(tmp), "\\u%04x", c);
+      out += tmp;
+    }
+    else
+    {
+      out += static_cast<char>(c);
+    }
+  }
+  out += '"';
+}
+}
+
+Tracer& Tracer::get()
+{
+  // never destroyed, since threads may still record while static objects
+  // are destroyed at exit
+  static Tracer* tracer = new Tracer();
+  return *tracer;
+}
+
+int64_t Tracer::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+Tracer::Tracer() : enabled_(true), buffer_size_(65536), next_tid_(1)
+{
+}
+
+Tracer::ThreadBuffer::ThreadBuffer(std::size_t size, uint64_t _tid)
+  : events(new Event[size]), mask(size - 1), head(0), tid(_tid), finished(false)
+{
+  for (std::size_t i = 0; i < size; i++)
+  {
+    events[i].seq.store(0, std::memory_order_relaxed);
+  }
+}
+
+void Tracer::setBufferSize(std::size_t events)
+{
+  std::size_t size = 1;
+  while (size < events)
+  {
+    size *= 2;
+  }
+
+  buffer_size_.store(size, std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const std::string& name)
+{
+  ThreadBuffer& buffer = getThreadBuffer();
+  std::lock_guard<std::mutex> lock(mtx_);
+  buffer.name = name;
+}
+
+Tracer::ThreadBuffer& Tracer::getThreadBuffer()
+{
+  struct Local
+  {
+    std::shared_ptr<ThreadBuffer> buffer;
+
+    ~Local()
+    {
+      if (buffer)
+      {
+        buffer->finished = true;
+      }
+    }
+  };
+
+  static thread_local Local local;
+  if (!local.buffer)
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    local.buffer = std::make_shared<ThreadBuffer>(buffer_size_.load(std::memory_order_relaxed), next_tid_++);
+    buffers_.push_back(local.buffer);
+  }
+
+  return *local.buffer;
+}
+
+void Tracer::record(const char* category, const char* name, int64_t start_ns, int64_t duration_ns)
+{
+  if (!enabled_.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  ThreadBuffer& buffer = getThreadBuffer();
+  uint64_t head = buffer.head.load(std::memory_order_relaxed);
+  Event& event = buffer.events[head & buffer.mask];
+
+  event.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  event.category.store(category, std::memory_order_relaxed);
+  event.name.store(name, std::memory_order_relaxed);
+  event.start_ns.store(start_ns, std::memory_order_relaxed);
+  event.duration_ns.store(duration_ns, std::memory_order_relaxed);
+  event.seq.store(head + 1, std::memory_order_release);
+
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::clear()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  for (auto&& b : buffers_)
+  {
+    if (!b->finished)
+    {
+      // events are skipped by the sequence numbers, which must then be
+      // below the head
+
+      for (std::size_t i = 0; i <= b->mask; i++)
+      {
+        b->events[i].seq.store(0, std::memory_order_relaxed);
+      }
+      buffers.push_back(b);
+    }
+  }
+
+  buffers_.swap(buffers);
+}
+
+std::string Tracer::toChromeTrace() const
+{
+#ifdef WIN32
+  int pid = _getpid();
+#else
+  int pid = static_cast<int>(getpid());
+#endif
+
+  // written directly instead of building a JSON document, which would be
+  // slow for millions of events
+
+  std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  const char* sep = "";
+  char tmp[160];
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  for (auto&& b : buffers_)
+  {
+    if (!b->name.empty())
+    {
+      std::snprintf(tmp, sizeof(tmp),
+                    "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%llu,\"args\":{\"name\":", sep,
+                    pid, static_cast<unsigned long long>(b->tid));
+      out += tmp;
+      out += nlohmann::json(b->name).dump();
+      out += "}}";
+      sep = ",";
+    }
+
+    uint64_t head = b->head.load(std::memory_order_acquire);
+    uint64_t size = b->mask + 1;
+    for (uint64_t i = head > size ? head - size : 0; i < head; i++)
+    {
+      const Event& event = b->events[i & b->mask];
+
+      // skip events that are overwritten while reading them
+
+      if (event.seq.load(std::memory_order_acquire) != i + 1)
+      {
+        continue;
+      }
+
+      const char* category = event.category.load(std::memory_order_relaxed);
+      const char* name = event.name.load(std::memory_order_relaxed);
+      int64_t start_ns = event.start_ns.load(std::memory_order_relaxed);
+      int64_t duration_ns = event.duration_ns.load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (event.seq.load(std::memory_order_relaxed) != i + 1)
+      {
+        continue;
+      }
+
+      out += sep;
+      out += "{\"name\":";
+      appendString(out, name);
+      out += ",\"cat\":";
+      appendString(out, category);
+      std::snprintf(tmp, sizeof(tmp), ",\"ph\":\"X\",\"ts\":%lld.%03d,\"dur\":%lld.%03d,\"pid\":%d,\"tid\":%llu}",
+                    static_cast<long long>(start_ns / 1000), static_cast<int>(start_ns % 1000),
+                    static_cast<long long>(duration_ns / 1000), static_cast<int>(duration_ns % 1000), pid,
+                    static_cast<unsigned long long>(b->tid));
+      out += tmp;
+      sep = ",";
+    }
+  }
+
+  out += "]}";
+  return out;
+}
+
+void Tracer::writeChromeTrace(const std::string& filename) const
+{
+  std::ofstream out(filename);
+  out << toChromeTrace() << std::endl;
+  if (!out)
+  {
+    throw std::runtime_error("Cannot write trace to '" + filename + "'");
+  }
+}
+}
+}
@@ -0,0 +1,214 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_TRACING_H
+#define RC_DYNAMICS_API_TRACING_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "tracing_config.h"
+
+/**
+ * Trace points of the hot paths, e.g. receiving and de-serializing
+ * messages and REST-API requests. They are only compiled if
+ * RC_DYNAMICS_TRACING is defined by the generated tracing_config.h, i.e. if
+ * the library is built with the cmake option ENABLE_TRACING, and expand to
+ * nothing otherwise.
+ *
+ *   RC_DYNAMICS_TRACE_SCOPE("receive", "parse");
+ *
+ * records the time from the trace point to the end of the enclosing scope.
+ * Category and name must be string literals or otherwise live as long as
+ * the program.
+ */
+#ifdef RC_DYNAMICS_TRACING
+#define RC_DYNAMICS_TRACE_CONCAT2(a, b) a##b
+#define RC_DYNAMICS_TRACE_CONCAT(a, b) RC_DYNAMICS_TRACE_CONCAT2(a, b)
+#define RC_DYNAMICS_TRACE_SCOPE(category, name)                                                                      \
+  rc::dynamics::TraceScope RC_DYNAMICS_TRACE_CONCAT(rc_dynamics_trace_scope_, __LINE__)(category, name)
+#else
+#define RC_DYNAMICS_TRACE_SCOPE(category, name) \
+  do                                            \
+  {                                             \
+  } while (0)
+#endif
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Records timestamped events into one ring buffer per thread, which can be
+ * written in the trace event format of Chrome, which is also read by
+ * Perfetto (https://ui.perfetto.dev).
+ *
+ * Recording is lock-free: every thread only writes into its own buffer and
+ * the oldest events are overwritten if the buffer is full. Events of
+ * threads that have finished are kept until clear() is called.
+ */
+class Tracer
+{
+public:
+  /// Returns the tracer of the trace points of the library
+  static Tracer& get();
+
+  /// Returns the current time in nanoseconds of a monotonic clock
+  static int64_t now();
+
+  /**
+   * Enables or disables recording at runtime, which is enabled by default.
+   */
+  void setEnabled(bool enabled)
+  {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  bool isEnabled() const
+  {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Sets the number of events per thread, which is rounded up to a power
+   * of two. It is only applied to the buffers of threads that record their
+   * first event afterwards.
+   *
+   * @param events number of events, default is 65536
+   */
+  void setBufferSize(std::size_t events);
+
+  /// Names the calling thread in the trace, e.g. "imu receiver"
+  void setThreadName(const std::string& name);
+
+  /**
+   * Records an event of the calling thread.
+   *
+   * @param category category, e.g. "receive" or "rest"
+   * @param name name, e.g. "parse"
+   * @param start_ns start time, see now()
+   * @param duration_ns duration
+   */
+  void record(const char* category, const char* name, int64_t start_ns, int64_t duration_ns);
+
+  /// Removes all events and the buffers of finished threads
+  void clear();
+
+  /**
+   * Returns all recorded events in the trace event format of Chrome, i.e.
+   * as JSON object with an array traceEvents of complete events ("ph": "X").
+   */
+  std::string toChromeTrace() const;
+
+  /**
+   * Writes all recorded events into a file, see toChromeTrace().
+   *
+   * @param filename file name, e.g. "trace.json"
+   * @throw runtime_error if the file cannot be written
+   */
+  void writeChromeTrace(const std::string& filename) const;
+
+private:
+  Tracer();
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+
+  // event slots are atomic, since they may be read while being overwritten,
+  // which is detected by the sequence number like in a seqlock
+  struct Event
+  {
+    std::atomic<uint64_t> seq;  // number of the event + 1, 0 while being written
+    std::atomic<const char*> category;
+    std::atomic<const char*> name;
+    std::atomic<int64_t> start_ns;
+    std::atomic<int64_t> duration_ns;
+  };
+
+  struct ThreadBuffer
+  {
+    ThreadBuffer(std::size_t size, uint64_t tid);
+
+    std::unique_ptr<Event[]> events;
+    std::size_t mask;
+    std::atomic<uint64_t> head;  // number of events ever recorded, only written by the owning thread
+    uint64_t tid;
+    std::string name;            // guarded by mtx_
+    std::atomic<bool> finished;  // set when the owning thread exits
+  };
+
+  ThreadBuffer& getThreadBuffer();
+
+  std::atomic<bool> enabled_;
+  std::atomic<std::size_t> buffer_size_;
+  mutable std::mutex mtx_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+  uint64_t next_tid_;
+};
+
+/**
+ * Records the time from construction to destruction, see
+ * RC_DYNAMICS_TRACE_SCOPE.
+ */
+class TraceScope
+{
+public:
+  TraceScope(const char* category, const char* name)
+    : category_(category), name_(name), start_(Tracer::get().isEnabled() ? Tracer::now() : -1)
+  {
+  }
+
+  ~TraceScope()
+  {
+    if (start_ >= 0)
+    {
+      Tracer::get().record(category_, name_, start_, Tracer::now() - start_);
+    }
+  }
+
+private:
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  const char* category_;
+  const char* name_;
+  int64_t start_;
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_TRACING_H
@@ -34,6 +34,7 @@
  */
 
 #include "unexpected_receive_timeout.h"
+#include "metrics.h"
 
 #include <string>
 
@@ -49,6 +50,9 @@ UnexpectedReceiveTimeout::UnexpectedReceiveTimeout(unsigned int timeout_millis)
                   "or a firewall on the host may be active.")
   , timeout_(timeout_millis)
 {
+  static Counter& timeouts = MetricsRegistry::getDefault()->counter(
+      "rc_dynamics_unexpected_receive_timeouts_total", "Streams that did not deliver messages in time");
+  timeouts.inc();
 }
 }
 }
\ No newline at end of file
@@ -0,0 +1,234 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <rc_dynamics_api/clock_estimator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace std;
+using rc::dynamics::ClockEstimator;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+const int64_t ms = 1000000;
+const int64_t s = 1000 * ms;
+
+int64_t distance(int64_t a, int64_t b)
+{
+  return a > b ? a - b : b - a;
+}
+
+/**
+ * Stream of 100 Hz messages of a device with a clock that drifts against
+ * the host clock, received with a minimum delay of 1 ms and exponentially
+ * distributed additional delays.
+ */
+class Stream
+{
+public:
+  Stream(ClockEstimator& estimator, double skew)
+    : estimator_(estimator), skew_(skew), rng_(1), jitter_(1.0 / (0.3 * ms)), t_(0), jump_(0), congestion_(0),
+      late_(0)
+  {
+  }
+
+  /// Sets the offset of the device clock relative to its correct time
+  void jump(int64_t offset)
+  {
+    jump_ = offset;
+  }
+
+  /// Sets an additional delay of all messages
+  void congest(int64_t delay)
+  {
+    congestion_ = delay;
+  }
+
+  /**
+   * Adds the messages of the given duration to the estimator.
+   *
+   * @return largest error of converting device time stamps into the host time of sending plus the minimum delay
+   */
+  int64_t run(int64_t duration)
+  {
+    int64_t error = 0;
+    for (int64_t end = t_ + duration; t_ < end; t_ += 10 * ms)
+    {
+      int64_t device = deviceTime(t_);
+      int64_t sent = hostTime(t_);
+      int64_t received = sent + ms + congestion_ + static_cast<int64_t>(jitter_(rng_));
+      estimator_.add(device, received);
+
+      if (estimator_.toHost(device) > received)
+      {
+        late_++;
+      }
+      error = max(error, distance(estimator_.toHost(device), sent + ms));
+    }
+    return error;
+  }
+
+  /// Returns the number of messages that were converted to a host time later than their reception
+  int getLate() const
+  {
+    return late_;
+  }
+
+  int64_t deviceTime(int64_t t) const
+  {
+    return 1700000000 * s + t + jump_;
+  }
+
+  int64_t hostTime(int64_t t) const
+  {
+    return 1700000003 * s + t + static_cast<int64_t>(skew_ * t);
+  }
+
+private:
+  ClockEstimator& estimator_;
+  double skew_;
+  mt19937 rng_;
+  exponential_distribution<double> jitter_;
+  int64_t t_, jump_, congestion_;
+  int late_;
+};
+
+/**
+ * Checks the estimated drift and offset and that conversions are never
+ * later than the reception of messages.
+ */
+void testDrift()
+{
+  ClockEstimator::Ptr estimator = ClockEstimator::create();
+
+  check("invalid without samples", !estimator->isValid() && estimator->toHost(123) == 123 &&
+                                       estimator->toDevice(123) == 123);
+
+  Stream stream(*estimator, 20e-6);
+  stream.run(10 * s);
+  int64_t error = stream.run(50 * s);
+
+  ClockEstimator::Model model = estimator->getModel();
+  check("valid with samples", model.valid && model.samples == 6000);
+  check("drift is estimated", fabs(model.skew - 20e-6) < 1e-6);
+  check("offset is estimated", error < ms / 10);
+  check("no restarts", model.restarts == 0);
+  check("conversions are never later than reception", stream.getLate() == 0);
+
+  int64_t device = stream.deviceTime(60 * s);
+  check("conversion to device time is inverse", distance(estimator->toDevice(estimator->toHost(device)), device) <= 1);
+
+  estimator->reset();
+  check("reset forgets all samples", !estimator->isValid() && estimator->getModel().samples == 0);
+}
+
+/**
+ * Checks that a forward jump of the device clock restarts the estimation
+ * immediately.
+ */
+void testForwardJump()
+{
+  ClockEstimator::Ptr estimator = ClockEstimator::create();
+  Stream stream(*estimator, 20e-6);
+  stream.run(30 * s);
+
+  stream.jump(s);
+  stream.run(10 * ms);
+  check("forward jump restarts immediately", estimator->getModel().restarts == 1);
+
+  stream.run(5 * s);
+  check("offset is estimated after forward jump", stream.run(5 * s) < ms / 10);
+  check("no further restarts after forward jump", estimator->getModel().restarts == 1);
+  check("conversions are never later than reception after forward jump", stream.getLate() == 0);
+}
+
+/**
+ * Checks that congestion of the network is not mistaken for a backward
+ * jump of the device clock, but that a persistent backward jump restarts
+ * the estimation.
+ */
+void testBackwardJump()
+{
+  ClockEstimator::Ptr estimator = ClockEstimator::create();
+  Stream stream(*estimator, 20e-6);
+  stream.run(30 * s);
+
+  // congestion of more than one interval of the minimum filter
+
+  stream.congest(200 * ms);
+  stream.run(800 * ms);
+  stream.congest(0);
+  check("congestion is not mistaken for a jump", estimator->getModel().restarts == 0);
+  check("offset is kept during congestion", stream.run(5 * s) < ms / 10);
+
+  stream.jump(-s);
+  stream.run(500 * ms);
+  check("backward jump is not accepted immediately", estimator->getModel().restarts == 0);
+
+  stream.run(5 * s);
+  check("persistent backward jump restarts", estimator->getModel().restarts == 1);
+  check("offset is estimated after backward jump", stream.run(5 * s) < ms / 10);
+}
+}
+
+int main()
+{
+  testDrift();
+  testForwardJump();
+  testBackwardJump();
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
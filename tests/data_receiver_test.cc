@@ -0,0 +1,131 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "../benchmarks/synthetic_data.h"
+
+#include <rc_dynamics_api/data_receiver.h>
+#include <rc_dynamics_api/data_sender.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using rc::dynamics::DataReceiver;
+using rc::dynamics::DataSender;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+/**
+ * Checks that messages sent via the loopback interface are received
+ * unchanged by all variants of receiving.
+ */
+void testReceive()
+{
+  unsigned int port = 0;
+  DataReceiver::Ptr receiver = DataReceiver::create("127.0.0.1", port);
+  DataSender::Ptr sender = DataSender::create("127.0.0.1", port);
+  receiver->setTimeout(1000);
+
+  roboception::msgs::Dynamics msg = bench::createDynamics(1);
+  string data = msg.SerializeAsString();
+
+  sender->send(data.data(), data.size());
+  size_t size = 0;
+  const char* raw = receiver->receiveRaw(size);
+  check("receiveRaw() returns the datagram", raw != 0 && string(raw, size) == data);
+
+  sender->send(msg);
+  shared_ptr<roboception::msgs::Dynamics> typed = receiver->receive<roboception::msgs::Dynamics>();
+  check("receive<Dynamics>() returns the message", typed && typed->SerializeAsString() == data);
+
+  sender->send(msg);
+  shared_ptr<::google::protobuf::Message> dispatched = receiver->receive("Dynamics");
+  check("receive(\"Dynamics\") returns the message",
+        dispatched && dispatched->GetTypeName() == "roboception.msgs.Dynamics" &&
+            dispatched->SerializeAsString() == data);
+
+  check("messages are counted", receiver->getMessageCount() == 3);
+}
+
+/// Checks that receive() returns NULL after the timeout and select() finds the receiver with data
+void testTimeoutAndSelect()
+{
+  unsigned int port_a = 0, port_b = 0;
+  DataReceiver::Ptr a = DataReceiver::create("127.0.0.1", port_a);
+  DataReceiver::Ptr b = DataReceiver::create("127.0.0.1", port_b);
+
+  check("new receiver has no timeout", a->getTimeout() == 0);
+  a->setTimeout(50);
+  check("timeout is returned", a->getTimeout() == 50);
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  check("receive() returns NULL on timeout", !a->receive<roboception::msgs::Imu>());
+  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+  check("receive() returns after the timeout", ms >= 40 && ms < 1000);
+
+  check("select() times out without data", DataReceiver::select({ a, b }, 10).empty());
+
+  DataSender::create("127.0.0.1", port_b)->send(bench::createImu(1));
+  vector<size_t> ready = DataReceiver::select({ a, b }, 1000);
+  check("select() returns the receiver with data", ready.size() == 1 && ready[0] == 1);
+}
+}
+
+int main()
+{
+  testReceive();
+  testTimeoutAndSelect();
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
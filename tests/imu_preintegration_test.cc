@@ -0,0 +1,175 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <rc_dynamics_api/imu_preintegration.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::ImuDelta;
+using rc::dynamics::ImuPreintegrator;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+const int64_t t_start = 1700000000000000000LL;
+const int64_t period = 1000000;  // 1 kHz
+
+/// Returns the largest difference between the components of the deltas
+double maxDifference(const ImuDelta& a, const ImuDelta& b)
+{
+  double d[] = { a.qx - b.qx, a.qy - b.qy, a.qz - b.qz, a.qw - b.qw, a.vx - b.vx,
+                 a.vy - b.vy, a.vz - b.vz, a.px - b.px, a.py - b.py, a.pz - b.pz };
+
+  double ret = 0;
+  for (double v : d)
+  {
+    ret = max(ret, fabs(v));
+  }
+  return ret;
+}
+
+/**
+ * Checks that deltas do not change when old samples are dropped and the
+ * cumulative state is rebased, by comparing with a buffer that holds all
+ * samples.
+ */
+void testRebaseKeepsDeltas()
+{
+  ImuPreintegrator small(100), all(1000);
+
+  mt19937 rng(1);
+  normal_distribution<double> noise(0, 1);
+
+  bool ok = true;
+  double error = 0;
+  for (int i = 0; i < 450; i++)
+  {
+    int64_t stamp = t_start + i * period;
+    double acc[3] = { noise(rng), noise(rng), 9.81 + noise(rng) };
+    double gyro[3] = { 0.5 * noise(rng), 0.5 * noise(rng), 0.5 * noise(rng) };
+    ok = small.add(stamp, acc, gyro) && all.add(stamp, acc, gyro) && ok;
+
+    if (i >= 99)
+    {
+      // delta over the whole small buffer and between two samples
+
+      int64_t t0 = small.startTime() + period / 3;
+      int64_t t1 = small.endTime() - period / 2;
+
+      ImuDelta a, b;
+      ok = small.delta(t0, t1, a) && all.delta(t0, t1, b) && ok;
+      error = max(error, maxDifference(a, b));
+    }
+  }
+
+  check("samples added and deltas computed", ok);
+  check("size is limited to the capacity", small.size() == 100);
+  check("deltas are unchanged by rebasing", error < 1e-12);
+}
+
+/**
+ * Checks the precision of deltas after an hour of a 1 kHz stream of a
+ * sensor that rotates about the direction of gravity with constant angular
+ * velocity, for which deltas are known exactly.
+ */
+void testLongRun()
+{
+  const double g = 9.81, w = 0.5;
+  const double acc[3] = { 0, 0, g };
+  const double gyro[3] = { 0, 0, w };
+
+  ImuPreintegrator imu(2000);
+
+  bool ok = true;
+  const int64_t n = 3600 * 1000;
+  for (int64_t i = 0; i < n; i++)
+  {
+    ok = imu.add(t_start + i * period, acc, gyro) && ok;
+  }
+  check("samples of an hour added", ok);
+
+  ImuDelta delta;
+  int64_t t1 = imu.endTime(), t0 = t1 - 1000 * period;
+  check("delta of the last second computed", imu.delta(t0, t1, delta));
+
+  ImuDelta expected;
+  expected.qx = 0;
+  expected.qy = 0;
+  expected.qz = sin(0.5 * w * delta.dt);
+  expected.qw = cos(0.5 * w * delta.dt);
+  expected.vx = 0;
+  expected.vy = 0;
+  expected.vz = g * delta.dt;
+  expected.px = 0;
+  expected.py = 0;
+  expected.pz = 0.5 * g * delta.dt * delta.dt;
+
+  double error = maxDifference(delta, expected);
+  if (error >= 1e-9)
+  {
+    cerr << "Largest error of delta after an hour: " << error << endl;
+  }
+  check("delta after an hour is precise", error < 1e-9);
+}
+}
+
+int main()
+{
+  testRebaseKeepsDeltas();
+  testLongRun();
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
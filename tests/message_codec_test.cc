@@ -0,0 +1,362 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "../benchmarks/synthetic_data.h"
+
+#include <rc_dynamics_api/message_codec.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+using rc::dynamics::BitReader;
+using rc::dynamics::BitWriter;
+using rc::dynamics::MessageCodec;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+/// Appends the values of all floating point fields of the message, recursively
+void collectDoubles(const Message& m, vector<double>& values)
+{
+  const Reflection* r = m.GetReflection();
+  vector<const FieldDescriptor*> fields;
+  r->ListFields(m, &fields);
+
+  for (const FieldDescriptor* field : fields)
+  {
+    int n = field->is_repeated() ? r->FieldSize(m, field) : 1;
+    for (int k = 0; k < n; k++)
+    {
+      if (field->cpp_type() == FieldDescriptor::CPPTYPE_DOUBLE)
+      {
+        values.push_back(field->is_repeated() ? r->GetRepeatedDouble(m, field, k) : r->GetDouble(m, field));
+      }
+      else if (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE)
+      {
+        collectDoubles(field->is_repeated() ? r->GetRepeatedMessage(m, field, k) : r->GetMessage(m, field), values);
+      }
+    }
+  }
+}
+
+/// Clears all floating point fields of the message, recursively
+void clearDoubles(Message& m)
+{
+  const Reflection* r = m.GetReflection();
+  vector<const FieldDescriptor*> fields;
+  r->ListFields(m, &fields);
+
+  for (const FieldDescriptor* field : fields)
+  {
+    if (field->cpp_type() == FieldDescriptor::CPPTYPE_DOUBLE)
+    {
+      r->ClearField(&m, field);
+    }
+    else if (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE)
+    {
+      int n = field->is_repeated() ? r->FieldSize(m, field) : 1;
+      for (int k = 0; k < n; k++)
+      {
+        clearDoubles(field->is_repeated() ? *r->MutableRepeatedMessage(&m, field, k) : *r->MutableMessage(&m, field));
+      }
+    }
+  }
+}
+
+/**
+ * Returns the largest difference between the floating point values of two
+ * messages, or infinity if the messages have different fields. NaN equals
+ * NaN.
+ */
+double maxDifference(const Message& a, const Message& b)
+{
+  vector<double> va, vb;
+  collectDoubles(a, va);
+  collectDoubles(b, vb);
+
+  if (va.size() != vb.size())
+  {
+    return numeric_limits<double>::infinity();
+  }
+
+  double ret = 0;
+  for (size_t i = 0; i < va.size(); i++)
+  {
+    if (std::isnan(va[i]) != std::isnan(vb[i]))
+    {
+      return numeric_limits<double>::infinity();
+    }
+    if (va[i] != vb[i] && !std::isnan(va[i]))
+    {
+      ret = max(ret, fabs(va[i] - vb[i]));
+    }
+  }
+  return ret;
+}
+
+/**
+ * Checks that values of all bit widths and unsigned integers of all
+ * encodings are read back as written, including a tail of less than eight
+ * bytes.
+ */
+void testBits()
+{
+  mt19937_64 rng(1);
+  uniform_int_distribution<int> width(1, 64);
+
+  vector<pair<uint64_t, int> > values;
+  for (int i = 0; i < 1001; i++)
+  {
+    int n = width(rng);
+    uint64_t v = rng();
+    values.push_back(make_pair(n < 64 ? v & ((1ull << n) - 1) : v, n));
+  }
+
+  const uint64_t integers[] = { 0, 1, 255, 256, 65535, 65536, 4294967295ull, 4294967296ull, ~0ull };
+
+  BitWriter out;
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    out.write(values[i].first, values[i].second);
+  }
+  for (uint64_t v : integers)
+  {
+    out.writeUInt(v);
+  }
+  out.writeBytes("abc", 3);
+  out.writeBit(true);
+  out.finish();
+
+  BitReader in(out.getData(), out.getSize());
+
+  bool ok = true;
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    ok = in.read(values[i].second) == values[i].first && ok;
+  }
+  check("values of all bit widths", ok);
+
+  ok = true;
+  for (uint64_t v : integers)
+  {
+    ok = in.readUInt() == v && ok;
+  }
+  check("unsigned integers of all encodings", ok);
+
+  char bytes[3];
+  in.readBytes(bytes, 3);
+  check("bytes", string(bytes, 3) == "abc");
+  check("last bit", in.readBit());
+}
+
+/**
+ * Encodes and decodes the messages with the given tolerance and returns the
+ * largest error of the floating point values, or infinity if other fields
+ * changed.
+ */
+template <class T>
+double roundTrip(const vector<T>& messages, double tolerance, size_t* size = 0)
+{
+  MessageCodec encoder(T::descriptor(), tolerance), decoder(T::descriptor(), tolerance);
+
+  BitWriter out;
+  for (size_t i = 0; i < messages.size(); i++)
+  {
+    // independently decodable blocks
+
+    if (i == messages.size() / 2)
+    {
+      encoder.reset();
+    }
+    encoder.encode(out, messages[i]);
+  }
+  out.finish();
+
+  if (size)
+  {
+    *size = out.getSize();
+  }
+
+  BitReader in(out.getData(), out.getSize());
+
+  double ret = 0;
+  for (size_t i = 0; i < messages.size(); i++)
+  {
+    if (i == messages.size() / 2)
+    {
+      decoder.reset();
+    }
+
+    T m;
+    decoder.decode(in, m);
+
+    if (tolerance == 0)
+    {
+      if (messages[i].SerializeAsString() != m.SerializeAsString())
+      {
+        return numeric_limits<double>::infinity();
+      }
+    }
+    else
+    {
+      // all fields except floating point values must be equal
+
+      ret = max(ret, maxDifference(messages[i], m));
+
+      T a = messages[i];
+      clearDoubles(a);
+      clearDoubles(m);
+      if (a.SerializeAsString() != m.SerializeAsString())
+      {
+        return numeric_limits<double>::infinity();
+      }
+    }
+  }
+  return ret;
+}
+
+/// Returns messages of the synthetic dynamics stream, with special values
+vector<roboception::msgs::Dynamics> createDynamics()
+{
+  vector<roboception::msgs::Dynamics> ret;
+  for (int i = 0; i < 1000; i++)
+  {
+    ret.push_back(bench::createDynamics(i));
+  }
+
+  // values that cannot be quantized must be stored exactly
+
+  ret[500].mutable_pose()->mutable_position()->set_x(numeric_limits<double>::quiet_NaN());
+  ret[500].mutable_pose()->mutable_position()->set_y(numeric_limits<double>::infinity());
+  ret[500].mutable_pose()->mutable_position()->set_z(1e300);
+  ret[501].mutable_pose()->mutable_position()->set_x(-0.0);
+  ret[501].mutable_pose()->mutable_position()->set_y(numeric_limits<double>::denorm_min());
+
+  // changes of the present fields and of strings
+
+  ret[600].clear_linear_acceleration();
+  ret[601].set_pose_frame("odom");
+  ret[602].clear_covariance();
+
+  return ret;
+}
+
+/**
+ * Checks that lossless compression restores the serialized messages
+ * exactly and that quantized compression keeps the tolerance and
+ * compresses stronger.
+ */
+void testRoundTrip()
+{
+  vector<roboception::msgs::Dynamics> dynamics = createDynamics();
+  vector<roboception::msgs::Imu> imu;
+  vector<roboception::msgs::Frame> frames;
+  for (int i = 0; i < 1000; i++)
+  {
+    imu.push_back(bench::createImu(i));
+    frames.push_back(bench::createFrame(i));
+  }
+
+  size_t lossless = 0, quantized = 0;
+  check("lossless dynamics", roundTrip(dynamics, 0, &lossless) == 0);
+  check("lossless imu", roundTrip(imu, 0) == 0);
+  check("lossless frames", roundTrip(frames, 0) == 0);
+
+  for (int e : { 3, 6, 9 })
+  {
+    double tolerance = pow(10.0, -e);
+    string t = " with tolerance 1e-" + to_string(e);
+    double error = roundTrip(dynamics, tolerance, &quantized);
+    check("quantized dynamics" + t, error <= tolerance * (1 + 1e-9));
+    check("quantized imu" + t, roundTrip(imu, tolerance) <= tolerance * (1 + 1e-9));
+    check("quantized frames" + t, roundTrip(frames, tolerance) <= tolerance * (1 + 1e-9));
+
+    if (e == 6)
+    {
+      check("quantized dynamics are smaller" + t, quantized < lossless);
+    }
+  }
+}
+
+/**
+ * Checks that messages that are not serialized in the canonical way are
+ * refused without writing anything.
+ */
+void testNonCanonical()
+{
+  MessageCodec codec(roboception::msgs::Imu::descriptor());
+
+  string data = bench::createImu(1).SerializeAsString();
+  data += string("\xf8\x07\x01", 3);  // unknown varint field 127
+
+  BitWriter out;
+  check("unknown fields are refused", !codec.encode(out, data.data(), data.size()));
+  out.finish();
+  check("nothing is written for refused messages", out.getSize() == 0);
+}
+}
+
+int main()
+{
+  testBits();
+  testRoundTrip();
+  testNonCanonical();
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,294 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <rc_dynamics_api/pose_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace rc::dynamics;
+namespace k = rc::dynamics::kernels;
+
+namespace
+{
+/**
+ * Poses in structure-of-arrays layout with random positions and random unit
+ * quaternions.
+ */
+struct Poses
+{
+  explicit Poses(size_t n, unsigned int seed = 1) : x(n), y(n), z(n), qx(n), qy(n), qz(n), qw(n)
+  {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> pos(-10, 10);
+    normal_distribution<double> rot(0, 1);
+
+    for (size_t i = 0; i < n; i++)
+    {
+      x[i] = pos(rng);
+      y[i] = pos(rng);
+      z[i] = pos(rng);
+
+      double a = rot(rng), b = rot(rng), c = rot(rng), d = rot(rng);
+      double norm = sqrt(a * a + b * b + c * c + d * d);
+      qx[i] = a / norm;
+      qy[i] = b / norm;
+      qz[i] = c / norm;
+      qw[i] = d / norm;
+    }
+  }
+
+  k::PoseArray array()
+  {
+    k::PoseArray p = { { x.data(), y.data(), z.data() }, { qx.data(), qy.data(), qz.data(), qw.data() } };
+    return p;
+  }
+
+  double maxDifference(const Poses& other) const
+  {
+    double d = 0;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+      d = max(d, fabs(x[i] - other.x[i]));
+      d = max(d, fabs(y[i] - other.y[i]));
+      d = max(d, fabs(z[i] - other.z[i]));
+      d = max(d, fabs(qx[i] - other.qx[i]));
+      d = max(d, fabs(qy[i] - other.qy[i]));
+      d = max(d, fabs(qz[i] - other.qz[i]));
+      d = max(d, fabs(qw[i] - other.qw[i]));
+    }
+    return d;
+  }
+
+  vector<double> x, y, z, qx, qy, qz, qw;
+};
+
+int failures = 0;
+
+void check(const string& name, size_t n, double error, double tolerance = 1e-12)
+{
+  if (!(error <= tolerance))
+  {
+    cerr << "ERROR: " << name << " (n = " << n << ") has an error of " << error << endl;
+    failures++;
+  }
+}
+
+/**
+ * Compares the vectorized kernels with the scalar reference, for sizes that
+ * exercise full SIMD registers as well as the remaining tail.
+ */
+void testVectorizedAgainstScalar(size_t n)
+{
+  Poses a(n, 1), b(n, 2), out(n, 3), ref(n, 3);
+  vector<double> t(n);
+  mt19937 rng(4);
+  uniform_real_distribution<double> dist(0, 1);
+  for (auto& v : t)
+  {
+    v = dist(rng);
+  }
+
+  StampedPose cam2imu = { 0, 0.05, -0.01, 0.02, 0.5, -0.5, 0.5, 0.5 };
+
+  k::multiply(a.array().orientation, b.array().orientation, out.array().orientation, n);
+  k::scalar::multiply(a.array().orientation, b.array().orientation, ref.array().orientation, n);
+  check("multiply", n, out.maxDifference(ref));
+
+  out = a;
+  ref = a;
+  for (size_t i = 0; i < n; i++)
+  {
+    out.qw[i] = ref.qw[i] = 2 * a.qw[i];
+  }
+  k::normalize(out.array().orientation, n);
+  k::scalar::normalize(ref.array().orientation, n);
+  check("normalize", n, out.maxDifference(ref));
+
+  k::rotate(a.array().orientation, b.array().position, out.array().position, n);
+  k::scalar::rotate(a.array().orientation, b.array().position, ref.array().position, n);
+  check("rotate", n, out.maxDifference(ref));
+
+  k::compose(a.array(), b.array(), out.array(), n);
+  k::scalar::compose(a.array(), b.array(), ref.array(), n);
+  check("compose", n, out.maxDifference(ref));
+
+  k::compose(a.array(), cam2imu, out.array(), n);
+  k::scalar::compose(a.array(), cam2imu, ref.array(), n);
+  check("compose with constant", n, out.maxDifference(ref));
+
+  k::compose(cam2imu, a.array(), out.array(), n);
+  k::scalar::compose(cam2imu, a.array(), ref.array(), n);
+  check("compose constant with", n, out.maxDifference(ref));
+
+  k::inverse(a.array(), out.array(), n);
+  k::scalar::inverse(a.array(), ref.array(), n);
+  check("inverse", n, out.maxDifference(ref));
+
+  k::slerp(a.array().orientation, b.array().orientation, t.data(), out.array().orientation, n);
+  k::scalar::slerp(a.array().orientation, b.array().orientation, t.data(), ref.array().orientation, n);
+  check("slerp", n, out.maxDifference(ref));
+
+  // in-place operation
+
+  out = a;
+  k::compose(out.array(), b.array(), out.array(), n);
+  k::scalar::compose(a.array(), b.array(), ref.array(), n);
+  check("compose in-place", n, out.maxDifference(ref));
+
+  out = a;
+  k::inverse(out.array(), out.array(), n);
+  k::scalar::inverse(a.array(), ref.array(), n);
+  check("inverse in-place", n, out.maxDifference(ref));
+}
+
+/**
+ * Checks the scalar reference against known results and identities, so
+ * that errors in the quaternion math are not hidden by comparing two
+ * implementations that share the same mistake.
+ */
+void testScalarReference()
+{
+  const size_t n = 1000;
+  Poses a(n, 5), b(n, 6), out(n), tmp(n);
+
+  // rotation by 90 degrees about z maps x to y
+
+  {
+    double s = sqrt(0.5);
+    double qx = 0, qy = 0, qz = s, qw = s, vx = 1, vy = 0, vz = 0, rx, ry, rz;
+    k::scalar::rotate(k::ConstQuaternionArray(&qx, &qy, &qz, &qw), k::ConstVectorArray(&vx, &vy, &vz),
+                      k::VectorArray{ &rx, &ry, &rz }, 1);
+    check("scalar rotate about z", 1, fabs(rx) + fabs(ry - 1) + fabs(rz));
+  }
+
+  // i * j = k
+
+  {
+    double ax = 1, ay = 0, az = 0, aw = 0, bx = 0, by = 1, bz = 0, bw = 0, rx, ry, rz, rw;
+    k::scalar::multiply(k::ConstQuaternionArray(&ax, &ay, &az, &aw), k::ConstQuaternionArray(&bx, &by, &bz, &bw),
+                        k::QuaternionArray{ &rx, &ry, &rz, &rw }, 1);
+    check("scalar multiply i * j", 1, fabs(rx) + fabs(ry) + fabs(rz - 1) + fabs(rw));
+  }
+
+  // rotation preserves length, and composition is consistent with rotating twice
+
+  k::scalar::rotate(a.array().orientation, b.array().position, out.array().position, n);
+  double length_error = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    length_error = max(length_error, fabs(hypot(hypot(out.x[i], out.y[i]), out.z[i]) -
+                                          hypot(hypot(b.x[i], b.y[i]), b.z[i])));
+  }
+  check("scalar rotate preserves length", n, length_error, 1e-12);
+
+  k::scalar::multiply(a.array().orientation, b.array().orientation, tmp.array().orientation, n);
+  k::scalar::rotate(tmp.array().orientation, a.array().position, out.array().position, n);
+  k::scalar::rotate(b.array().orientation, a.array().position, tmp.array().position, n);
+  k::scalar::rotate(a.array().orientation, tmp.array().position, tmp.array().position, n);
+  double rotation_error = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    rotation_error = max(rotation_error, fabs(out.x[i] - tmp.x[i]) + fabs(out.y[i] - tmp.y[i]) +
+                                             fabs(out.z[i] - tmp.z[i]));
+  }
+  check("scalar (a * b) v = a (b v)", n, rotation_error, 1e-12);
+
+  // a * a^-1 is the identity
+
+  k::scalar::inverse(a.array(), tmp.array(), n);
+  k::scalar::compose(a.array(), tmp.array(), out.array(), n);
+  double identity_error = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    identity_error = max(identity_error, fabs(out.x[i]) + fabs(out.y[i]) + fabs(out.z[i]) + fabs(out.qx[i]) +
+                                             fabs(out.qy[i]) + fabs(out.qz[i]) + fabs(fabs(out.qw[i]) - 1));
+  }
+  check("scalar compose with inverse", n, identity_error, 1e-12);
+
+  // slerp reaches the end points, and the half way point has equal angles to both
+
+  vector<double> t0(n, 0), t1(n, 1), th(n, 0.5);
+  out = a;
+  k::scalar::slerp(a.array().orientation, b.array().orientation, t0.data(), out.array().orientation, n);
+  check("scalar slerp t = 0", n, out.maxDifference(a));
+
+  k::scalar::slerp(a.array().orientation, b.array().orientation, t1.data(), out.array().orientation, n);
+  double slerp1_error = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    double d = out.qx[i] * b.qx[i] + out.qy[i] * b.qy[i] + out.qz[i] * b.qz[i] + out.qw[i] * b.qw[i];
+    slerp1_error = max(slerp1_error, 1 - fabs(d));
+  }
+  check("scalar slerp t = 1", n, slerp1_error);
+
+  k::scalar::slerp(a.array().orientation, b.array().orientation, th.data(), out.array().orientation, n);
+  double half_error = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    double da = out.qx[i] * a.qx[i] + out.qy[i] * a.qy[i] + out.qz[i] * a.qz[i] + out.qw[i] * a.qw[i];
+    double db = out.qx[i] * b.qx[i] + out.qy[i] * b.qy[i] + out.qz[i] * b.qz[i] + out.qw[i] * b.qw[i];
+    half_error = max(half_error, fabs(fabs(da) - fabs(db)));
+  }
+  check("scalar slerp t = 0.5", n, half_error);
+}
+}
+
+int main()
+{
+  cout << "Instruction set: " << k::instructionSet() << endl;
+
+  testScalarReference();
+
+  // odd sizes exercise the scalar tail of the vectorized kernels
+  for (size_t n : { 0, 1, 2, 3, 4, 5, 7, 8, 9, 4099 })
+  {
+    testVectorizedAgainstScalar(n);
+  }
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,257 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <rc_dynamics_api/pose_predictor.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::PosePredictor;
+using rc::dynamics::StampedPose;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+const int64_t t_start = 1700000000000000000LL;
+const double pi = 3.14159265358979323846;
+
+struct Quaternion
+{
+  double x, y, z, w;
+};
+
+/// Rotation by angle about the axis (x, y, z) of unit length
+Quaternion rotation(double x, double y, double z, double angle)
+{
+  double s = sin(0.5 * angle);
+  Quaternion q = { x * s, y * s, z * s, cos(0.5 * angle) };
+  return q;
+}
+
+Quaternion multiply(const Quaternion& a, const Quaternion& b)
+{
+  Quaternion r = { a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y, a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                   a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w, a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z };
+  return r;
+}
+
+roboception::msgs::Dynamics createDynamics(int64_t stamp, const Quaternion& q)
+{
+  roboception::msgs::Dynamics msg;
+  msg.mutable_timestamp()->set_sec(stamp / 1000000000);
+  msg.mutable_timestamp()->set_nsec(stamp % 1000000000);
+  msg.mutable_pose()->mutable_position()->set_x(1);
+  msg.mutable_pose()->mutable_position()->set_y(2);
+  msg.mutable_pose()->mutable_position()->set_z(3);
+  msg.mutable_pose()->mutable_orientation()->set_x(q.x);
+  msg.mutable_pose()->mutable_orientation()->set_y(q.y);
+  msg.mutable_pose()->mutable_orientation()->set_z(q.z);
+  msg.mutable_pose()->mutable_orientation()->set_w(q.w);
+  msg.set_pose_frame("world");
+  return msg;
+}
+
+bool equal(const StampedPose& pose, int64_t stamp, double x, double y, double z, const Quaternion& q,
+           double eps = 1e-12)
+{
+  return pose.stamp == stamp && fabs(pose.x - x) < eps && fabs(pose.y - y) < eps && fabs(pose.z - z) < eps &&
+         fabs(pose.qx - q.x) < eps && fabs(pose.qy - q.y) < eps && fabs(pose.qz - q.z) < eps &&
+         fabs(pose.qw - q.w) < eps;
+}
+
+/**
+ * Checks that nothing is predicted without a sample and that predictions
+ * are limited to the horizon in both directions.
+ */
+void testHorizon()
+{
+  PosePredictor predictor(0.5);
+  StampedPose pose;
+
+  check("no sample initially", !predictor.hasSample() && predictor.sampleTime() == 0);
+  check("no prediction without sample", !predictor.predict(t_start, pose));
+
+  Quaternion q = rotation(0, 0, 1, 0.3);
+  predictor.update(createDynamics(t_start, q));
+
+  check("sample is set", predictor.hasSample() && predictor.sampleTime() == t_start);
+  check("prediction at the time of the sample", predictor.predict(t_start, pose) && equal(pose, t_start, 1, 2, 3, q));
+  check("prediction at the horizon", predictor.predict(t_start + 500000000, pose));
+  check("prediction back to the horizon", predictor.predict(t_start - 500000000, pose));
+  check("no prediction beyond the horizon", !predictor.predict(t_start + 500000001, pose));
+  check("no prediction back beyond the horizon", !predictor.predict(t_start - 500000001, pose));
+}
+
+/**
+ * Checks extrapolation with constant acceleration and angular velocity,
+ * with vectors given in the pose frame and in the body frame.
+ */
+void testExtrapolation()
+{
+  PosePredictor predictor(1.0);
+  StampedPose pose;
+
+  // rotation by 90 degrees about x, i.e. the body y axis is the world z axis
+
+  Quaternion q = rotation(1, 0, 0, pi / 2);
+  double dt = 0.2;
+  int64_t t = t_start + 200000000;
+
+  // vectors in the pose frame
+
+  roboception::msgs::Dynamics msg = createDynamics(t_start, q);
+  msg.mutable_linear_velocity()->set_x(1);
+  msg.set_linear_velocity_frame("world");
+  msg.mutable_linear_acceleration()->set_z(2);
+  msg.set_linear_acceleration_frame("world");
+  msg.mutable_angular_velocity()->set_z(0.5);
+  msg.set_angular_velocity_frame("world");
+  predictor.update(msg);
+
+  Quaternion expected = multiply(rotation(0, 0, 1, 0.5 * dt), q);
+  check("extrapolation in pose frame",
+        predictor.predict(t, pose) && equal(pose, t, 1 + dt, 2, 3 + dt * dt, expected));
+
+  // the same motion with vectors in the body frame
+
+  msg = createDynamics(t_start, q);
+  msg.mutable_linear_velocity()->set_x(1);
+  msg.set_linear_velocity_frame("imu");
+  msg.mutable_linear_acceleration()->set_y(2);
+  msg.set_linear_acceleration_frame("imu");
+  msg.mutable_angular_velocity()->set_y(0.5);
+  msg.set_angular_velocity_frame("imu");
+  predictor.update(msg);
+
+  check("extrapolation in body frame",
+        predictor.predict(t, pose) && equal(pose, t, 1 + dt, 2, 3 + dt * dt, expected));
+
+  // backwards in time and without angular velocity
+
+  msg = createDynamics(t_start, q);
+  msg.mutable_linear_velocity()->set_y(-1);
+  predictor.update(msg);
+
+  t = t_start - 200000000;
+  check("extrapolation backwards without rotation", predictor.predict(t, pose) && equal(pose, t, 1, 2 + dt, 3, q));
+}
+
+/**
+ * Checks that readers never see a partially updated sample, while a writer
+ * continuously publishes samples of which all values depend on a counter.
+ */
+void testSeqlock()
+{
+  PosePredictor predictor(1e9);
+  predictor.update(createDynamics(t_start, rotation(0, 0, 1, 0)));
+
+  atomic<bool> running(true);
+  thread writer([&]() {
+    for (int i = 1; running; i++)
+    {
+      roboception::msgs::Dynamics msg = createDynamics(t_start + i, rotation(0, 0, 1, 0.001 * i));
+      msg.mutable_pose()->mutable_position()->set_x(i);
+      msg.mutable_pose()->mutable_position()->set_y(2 * i);
+      msg.mutable_pose()->mutable_position()->set_z(3 * i);
+      predictor.update(msg);
+    }
+  });
+
+  atomic<int> torn(0), reads(0);
+  vector<thread> readers;
+  for (int r = 0; r < 3; r++)
+  {
+    readers.push_back(thread([&]() {
+      double last = 0;
+      while (running)
+      {
+        StampedPose pose;
+        predictor.predict(t_start, pose);
+
+        Quaternion q = rotation(0, 0, 1, 0.001 * pose.x);
+        if (pose.x < last || pose.y != 2 * pose.x || pose.z != 3 * pose.x || pose.qz != q.z || pose.qw != q.w)
+        {
+          torn++;
+        }
+        last = pose.x;
+        reads++;
+      }
+    }));
+  }
+
+  this_thread::sleep_for(chrono::milliseconds(300));
+  running = false;
+
+  writer.join();
+  for (thread& t : readers)
+  {
+    t.join();
+  }
+
+  check("readers have read samples", reads > 0);
+  check("readers never see partial updates", torn == 0);
+}
+}
+
+int main()
+{
+  testHorizon();
+  testExtrapolation();
+  testSeqlock();
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,304 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <rc_dynamics_api/pose_timeline.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::PoseTimeline;
+using rc::dynamics::StampedPose;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+StampedPose createPose(int64_t stamp, double x, double angle)
+{
+  // rotation about the z axis
+
+  StampedPose p;
+  p.stamp = stamp;
+  p.x = x;
+  p.y = 2 * x;
+  p.z = -x;
+  p.qx = 0;
+  p.qy = 0;
+  p.qz = sin(0.5 * angle);
+  p.qw = cos(0.5 * angle);
+  return p;
+}
+
+bool equal(const StampedPose& a, const StampedPose& b, double eps = 1e-9)
+{
+  return a.stamp == b.stamp && fabs(a.x - b.x) < eps && fabs(a.y - b.y) < eps && fabs(a.z - b.z) < eps &&
+         fabs(a.qx - b.qx) < eps && fabs(a.qy - b.qy) < eps && fabs(a.qz - b.qz) < eps && fabs(a.qw - b.qw) < eps;
+}
+
+/**
+ * Checks lookups on the boundaries of the time range and interpolation
+ * between two poses.
+ */
+void testInterpolation()
+{
+  StampedPose pose;
+
+  PoseTimeline timeline;
+  check("lookup fails on empty timeline", !timeline.lookup(0, pose));
+
+  timeline.add(createPose(1000, 1, 0));
+  check("lookup at the only pose", timeline.lookup(1000, pose) && equal(pose, createPose(1000, 1, 0)));
+  check("lookup before the only pose fails", !timeline.lookup(999, pose));
+  check("lookup after the only pose fails", !timeline.lookup(1001, pose));
+
+  timeline.add(createPose(2000, 3, 1));
+  check("older pose is ignored", !timeline.add(createPose(1500, 0, 0)) && timeline.size() == 2);
+  check("pose with the same time stamp is ignored", !timeline.add(createPose(2000, 0, 0)) && timeline.size() == 2);
+
+  check("lookup at start time", timeline.lookup(1000, pose) && equal(pose, createPose(1000, 1, 0)));
+  check("lookup at end time", timeline.lookup(2000, pose) && equal(pose, createPose(2000, 3, 1)));
+  check("lookup before start time fails", !timeline.lookup(999, pose));
+  check("lookup after end time fails", !timeline.lookup(2001, pose));
+
+  check("lerp and slerp at a quarter", timeline.lookup(1250, pose) && equal(pose, createPose(1250, 1.5, 0.25)));
+
+  // q and -q are the same orientation, so that slerp must take the shorter arc
+
+  StampedPose p = createPose(3000, 3, 1.5);
+  p.qz = -p.qz;
+  p.qw = -p.qw;
+  timeline.add(p);
+  check("slerp takes the shorter arc", timeline.lookup(2500, pose) && equal(pose, createPose(2500, 3, 1.25)));
+
+  PoseTimeline nearest(0, PoseTimeline::Interpolation::NEAREST);
+  nearest.add(createPose(1000, 1, 0));
+  nearest.add(createPose(2000, 3, 1));
+  check("nearest before the middle", nearest.lookup(1499, pose) && equal(pose, createPose(1499, 1, 0)));
+  check("nearest after the middle", nearest.lookup(1500, pose) && equal(pose, createPose(1500, 3, 1)));
+}
+
+/**
+ * Checks that a bounded timeline drops the oldest poses and interpolates
+ * across the wrap around of its storage.
+ */
+void testRingBuffer()
+{
+  PoseTimeline timeline(5);
+  for (int i = 0; i < 12; i++)
+  {
+    timeline.add(createPose(1000 * i, i, 0.1 * i));
+  }
+
+  check("bounded timeline keeps capacity", timeline.size() == 5 && timeline.capacity() == 5);
+  check("oldest poses are dropped", timeline.startTime() == 7000 && timeline.endTime() == 11000);
+  check("at(0) is the oldest pose", equal(timeline.at(0), createPose(7000, 7, 0.7)));
+
+  StampedPose pose;
+  check("lookup of dropped pose fails", !timeline.lookup(6999, pose));
+
+  bool ok = true;
+  for (int64_t stamp = 7000; stamp <= 11000; stamp += 125)
+  {
+    ok = timeline.lookup(stamp, pose) && equal(pose, createPose(stamp, stamp / 1000.0, stamp / 10000.0)) && ok;
+  }
+  check("lookups across the wrap around", ok);
+
+  timeline.clear();
+  check("clear removes all poses", timeline.empty() && !timeline.lookup(11000, pose));
+}
+
+/// Gives access to the search of the timeline
+class SearchableTimeline : public PoseTimeline
+{
+public:
+  using PoseTimeline::find;
+};
+
+/// Returns the unevenly spaced time stamps of a timeline for checking the search
+vector<int64_t> createStamps(mt19937& rng)
+{
+  uniform_int_distribution<int64_t> gap(1, 1000);
+
+  // bursts of close poses and long gaps defeat interpolation search
+
+  vector<int64_t> stamps;
+  int64_t t = 1000000;
+  for (int i = 0; i < 2000; i++)
+  {
+    t += (i / 100) % 2 == 0 ? gap(rng) : 100000 * gap(rng);
+    stamps.push_back(t);
+  }
+  return stamps;
+}
+
+/**
+ * Checks the search for all hints before, at and after the result, which
+ * exercises galloping forwards and backwards up to the boundaries of the
+ * timeline.
+ */
+void testGalloping()
+{
+  mt19937 rng(2);
+  vector<int64_t> stamps = createStamps(rng);
+
+  SearchableTimeline timeline;
+  for (size_t i = 0; i < stamps.size(); i++)
+  {
+    timeline.add(createPose(stamps[i], i, 0));
+  }
+
+  bool ok = true;
+  for (size_t j : { size_t(0), size_t(1), size_t(2), size_t(999), size_t(1000), stamps.size() - 2 })
+  {
+    for (int64_t stamp : { stamps[j], stamps[j] + 1, stamps[j + 1] - 1 })
+    {
+      for (size_t hint = 0; hint <= stamps.size(); hint++)
+      {
+        ok = timeline.find(stamp, hint) == j && ok;
+      }
+    }
+  }
+  check("search finds the interval from any hint", ok);
+}
+
+/**
+ * Checks single and batch lookups on unevenly spaced time stamps against a
+ * linear search, for sorted, reversed, repeated and random queries, of
+ * which the batch lookup only gallops from the previous result if sorted.
+ */
+void testSearch()
+{
+  mt19937 rng(1);
+  vector<int64_t> stamps = createStamps(rng);
+
+  PoseTimeline timeline;
+  for (size_t i = 0; i < stamps.size(); i++)
+  {
+    timeline.add(createPose(stamps[i], i, 0));
+  }
+
+  int64_t t_start = stamps.front(), t_end = stamps.back();
+  uniform_int_distribution<int64_t> query(t_start - 1000, t_end + 1000);
+
+  vector<int64_t> queries;
+  for (int i = 0; i < 2000; i++)
+  {
+    queries.push_back(query(rng));
+  }
+  queries.push_back(t_start);
+  queries.push_back(t_end);
+  queries.push_back(stamps[1000]);
+  queries.push_back(stamps[1000] - 1);
+
+  vector<vector<int64_t> > orders;
+  orders.push_back(queries);
+  sort(queries.begin(), queries.end());
+  orders.push_back(queries);
+  reverse(queries.begin(), queries.end());
+  orders.push_back(queries);
+  orders.push_back(vector<int64_t>(10, stamps[500] + 1));
+
+  for (size_t k = 0; k < orders.size(); k++)
+  {
+    const vector<int64_t>& q = orders[k];
+
+    vector<StampedPose> poses;
+    vector<bool> valid;
+    size_t found = timeline.lookup(q, poses, &valid);
+
+    bool ok = true;
+    size_t expected_found = 0;
+    for (size_t i = 0; i < q.size(); i++)
+    {
+      // reference by linear search
+
+      bool in_range = q[i] >= t_start && q[i] <= t_end;
+      StampedPose expected;
+      if (in_range)
+      {
+        size_t j = upper_bound(stamps.begin(), stamps.end(), q[i]) - stamps.begin() - 1;
+        double x = j;
+        if (j + 1 < stamps.size())
+        {
+          x += static_cast<double>(q[i] - stamps[j]) / (stamps[j + 1] - stamps[j]);
+        }
+        expected = createPose(q[i], x, 0);
+        expected_found++;
+      }
+
+      StampedPose single;
+      ok = timeline.lookup(q[i], single) == in_range && ok;
+      ok = valid[i] == in_range && ok;
+      if (in_range)
+      {
+        ok = equal(single, expected) && equal(poses[i], expected) && ok;
+      }
+    }
+
+    check("lookups of query order " + to_string(k) + " match linear search", ok);
+    check("number of found poses of query order " + to_string(k), found == expected_found);
+  }
+}
+}
+
+int main()
+{
+  testInterpolation();
+  testRingBuffer();
+  testGalloping();
+  testSearch();
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
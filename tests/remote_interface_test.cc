@@ -0,0 +1,266 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "../tools/visard_simulator.h"
+
+#include <rc_dynamics_api/remote_interface.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::DataReceiver;
+using rc::dynamics::RemoteInterface;
+using rc::dynamics::VisardSimulator;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+/**
+ * Runs a test against a simulator of its own, so that the tests do not
+ * depend on each other, and counts exceptions as failures.
+ */
+void run(const string& name, const function<void(VisardSimulator&, RemoteInterface&)>& test,
+         const VisardSimulator::Config& config = VisardSimulator::Config())
+{
+  try
+  {
+    VisardSimulator::Ptr sim = VisardSimulator::create("127.0.0.1", 0, config);
+    RemoteInterface::Ptr rc = RemoteInterface::create(sim->getAddress());
+    if (!rc->checkSystemReady())
+    {
+      throw runtime_error("Simulator is not ready");
+    }
+
+    test(*sim, *rc);
+  }
+  catch (const exception& e)
+  {
+    cerr << "ERROR: " << name << ": " << e.what() << endl;
+    failures++;
+  }
+}
+
+/// Discards all messages that are queued in the socket of the receiver
+void drain(const DataReceiver::Ptr& receiver)
+{
+  size_t size;
+  while (!DataReceiver::select({ receiver }, 0).empty())
+  {
+    receiver->receiveRaw(size);
+  }
+}
+
+/**
+ * Checks that a new receiver returns from receive() after its timeout of
+ * 100 ms if no messages arrive anymore.
+ */
+void testReceiverTimeout(VisardSimulator& sim, RemoteInterface& rc)
+{
+  DataReceiver::Ptr receiver = rc.createReceiverForStream("imu", "lo");
+  check("timeout of new receiver is 100 ms", receiver->getTimeout() == 100);
+  if (receiver->getTimeout() == 0)
+  {
+    return;  // receive() would block forever
+  }
+
+  sim.clearDestinations();
+  drain(receiver);
+  check("receive() returns NULL on timeout", !receiver->receive<roboception::msgs::Imu>());
+}
+
+/// Checks that reconnectReceiver() keeps the timeout that has been set by the caller
+void testReconnectKeepsTimeout(VisardSimulator& sim, RemoteInterface& rc)
+{
+  DataReceiver::Ptr receiver = rc.createReceiverForStream("imu", "lo");
+  receiver->setTimeout(250);
+
+  sim.clearDestinations();
+  rc.reconnectReceiver(receiver);
+
+  check("reconnectReceiver() keeps the timeout", receiver->getTimeout() == 250);
+  check("reconnectReceiver() restores the destination", sim.getDestinations("imu").size() == 1);
+}
+
+/**
+ * Checks that streams fail early if rc_dynamics is not running, except imu,
+ * which is sent regardless of rc_dynamics.
+ */
+void testNotRunning(VisardSimulator& sim, RemoteInterface& rc)
+{
+  sim.setDynamicsState("IDLE");
+
+  bool not_running = false;
+  try
+  {
+    rc.createReceiverForStream("dynamics", "lo");
+  }
+  catch (const RemoteInterface::DynamicsNotRunning&)
+  {
+    not_running = true;
+  }
+  check("dynamics fails with DynamicsNotRunning", not_running);
+
+  DataReceiver::Ptr receiver = rc.createReceiverForStream("imu", "lo");
+  check("imu is established although rc_dynamics is not running", receiver != nullptr);
+}
+
+/// Returns the destinations of a stream in sorted order
+vector<string> sorted(vector<string> destinations)
+{
+  sort(destinations.begin(), destinations.end());
+  return destinations;
+}
+
+/**
+ * Checks that applyStreamDestinations() rolls back a failed change without
+ * removing destinations that existed before and without adding destinations
+ * that did not exist.
+ */
+void testRollback(VisardSimulator& sim, RemoteInterface& rc)
+{
+  map<string, RemoteInterface::DestinationChanges> subscribe;
+  subscribe["imu"].add = { "127.0.0.1:40000", "127.0.0.1:40001", "127.0.0.1:40002", "127.0.0.1:40003" };
+  subscribe["pose"].add = { "127.0.0.1:40000" };
+  rc.applyStreamDestinations(subscribe);
+
+  vector<string> expected = sorted(vector<string>(subscribe["imu"].add.begin(), subscribe["imu"].add.end()));
+  check("destinations are added", sorted(sim.getDestinations("imu")) == expected);
+
+  // older firmware versions add the destinations one by one, so that the
+  // first new destination is added before the request of the second fails
+
+  VisardSimulator::Config config = sim.getConfig();
+  config.max_destinations = 5;
+  sim.setConfig(config);
+
+  map<string, RemoteInterface::DestinationChanges> exceeding;
+  exceeding["imu"].add = { "127.0.0.1:40000", "127.0.0.1:40004", "127.0.0.1:40005" };
+  exceeding["imu"].remove = { "127.0.0.1:40010" };
+  exceeding["pose"].remove = { "127.0.0.1:40000" };
+
+  bool failed = false;
+  try
+  {
+    rc.applyStreamDestinations(exceeding);
+  }
+  catch (const exception&)
+  {
+    failed = true;
+  }
+
+  check("change beyond the maximum number of destinations fails", failed);
+  check("rollback keeps existing and does not add removed destinations",
+        sorted(sim.getDestinations("imu")) == expected);
+  check("rollback adds removed destinations again", sim.getDestinations("pose").size() == 1);
+
+  map<string, RemoteInterface::DestinationChanges> unsubscribe;
+  unsubscribe["imu"].remove = subscribe["imu"].add;
+  unsubscribe["pose"].remove = subscribe["pose"].add;
+  rc.applyStreamDestinations(unsubscribe);
+}
+
+/**
+ * Checks that two receivers of a multicast group on the loopback interface
+ * both get the messages of one destination, and that the group is left to
+ * the application when the receivers are destroyed.
+ */
+void testMulticast(VisardSimulator& sim, RemoteInterface& rc)
+{
+  const string group = "239.255.0.1:30202";
+
+  DataReceiver::Ptr a = rc.createMulticastReceiverForStream("imu", "239.255.0.1", 30202, "lo");
+  DataReceiver::Ptr b = rc.createMulticastReceiverForStream("imu", "239.255.0.1", 30202, "lo");
+
+  check("group is registered once", sim.getDestinations("imu") == vector<string>{ group });
+  check("timeout of multicast receiver is 100 ms", a->getTimeout() == 100 && b->getTimeout() == 100);
+
+  int received_a = 0, received_b = 0;
+  for (int i = 0; i < 10; i++)
+  {
+    received_a += a->receive<roboception::msgs::Imu>() ? 1 : 0;
+    received_b += b->receive<roboception::msgs::Imu>() ? 1 : 0;
+  }
+  check("first receiver gets the messages", received_a == 10);
+  check("second receiver gets the messages", received_b == 10);
+
+  a.reset();
+  b.reset();
+  check("group stays registered without receivers", sim.getDestinations("imu") == vector<string>{ group });
+
+  rc.deleteDestinationFromStream("imu", group);
+  check("group is removed by the application", sim.getDestinations("imu").empty());
+}
+}
+
+int main()
+{
+  run("receiver timeout", testReceiverTimeout);
+  run("reconnect keeps timeout", testReconnectKeepsTimeout);
+  run("not running", testNotRunning);
+
+  for (const char* version : { "v1.5.0", "v1.7.0" })
+  {
+    VisardSimulator::Config config;
+    config.firmware_version = version;
+    run(string("rollback of destinations, ") + version, testRollback, config);
+  }
+
+  run("multicast", testMulticast);
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
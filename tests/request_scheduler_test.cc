@@ -0,0 +1,189 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <rc_dynamics_api/request_scheduler.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using rc::dynamics::RequestScheduler;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+RequestScheduler::Config fastRetries()
+{
+  RequestScheduler::Config config;
+  config.base_delay_ms = 1;
+  config.max_delay_ms = 5;
+  config.max_retries = 3;
+  return config;
+}
+
+/// Checks that rejected attempts are retried in the calling thread until max_retries
+void testRetries()
+{
+  RequestScheduler::Ptr scheduler = RequestScheduler::create(fastRetries());
+  thread::id caller = this_thread::get_id();
+
+  int attempts = 0;
+  bool same_thread = true;
+  bool ok = scheduler->execute([&]() {
+    same_thread = same_thread && this_thread::get_id() == caller;
+    return ++attempts == 3;
+  });
+  check("request succeeds after two rejections", ok && attempts == 3);
+  check("attempts are done in the calling thread", same_thread);
+
+  attempts = 0;
+  ok = scheduler->execute([&]() {
+    attempts++;
+    return false;
+  });
+  check("request is given up after max_retries", !ok && attempts == 4);
+
+  RequestScheduler::Statistics stats = scheduler->getStatistics();
+  check("statistics count attempts", stats.requests == 7 && stats.rejected == 6 && stats.retries == 5);
+  check("statistics count failed requests", stats.failed == 1);
+
+  bool thrown = false;
+  try
+  {
+    scheduler->execute([]() -> bool { throw runtime_error("attempt failed"); });
+  }
+  catch (const runtime_error&)
+  {
+    thrown = true;
+  }
+  check("exceptions of attempts are passed to the caller", thrown);
+}
+
+/// Checks that the rate limit is off by default and delays requests if enabled
+void testRateLimit()
+{
+  check("rate limit is off by default", RequestScheduler::Config().rate == 0);
+
+  RequestScheduler::Config config = fastRetries();
+  config.rate = 100;
+  config.burst = 5;
+  RequestScheduler::Ptr scheduler = RequestScheduler::create(config);
+
+  // 5 requests of the burst are sent at once, the other 20 with 100/s
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int i = 0; i < 25; i++)
+  {
+    scheduler->execute([]() { return true; });
+  }
+  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+  check("requests beyond the burst are delayed", ms >= 180);
+  check("delayed requests are counted as throttled", scheduler->getStatistics().throttled == 20);
+}
+
+/**
+ * Checks that a caller that is waiting for a retry is woken up with an
+ * exception when the scheduler is destroyed.
+ */
+void testShutdown()
+{
+  RequestScheduler::Config config;
+  config.base_delay_ms = 60000;
+  config.max_delay_ms = 60000;
+  RequestScheduler::Ptr scheduler = RequestScheduler::create(config);
+
+  RequestScheduler* raw = scheduler.get();
+  atomic<bool> attempted(false), woken(false);
+  thread caller([&]() {
+    try
+    {
+      raw->execute([&]() {
+        attempted = true;
+        return false;
+      });
+    }
+    catch (const runtime_error&)
+    {
+      woken = true;
+    }
+  });
+
+  while (!attempted)
+  {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  this_thread::sleep_for(chrono::milliseconds(20));
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  scheduler.reset();
+  caller.join();
+  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+  check("waiting caller fails on destruction", woken);
+  check("waiting caller is woken up immediately", ms < 1000);
+}
+}
+
+int main()
+{
+  testRetries();
+  testRateLimit();
+  testShutdown();
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
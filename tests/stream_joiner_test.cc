@@ -0,0 +1,250 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <rc_dynamics_api/stream_joiner.h>
+
+#include "roboception/msgs/imu.pb.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using rc::dynamics::StreamJoiner;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+const int64_t ms = 1000000;
+const int64_t t0 = 1700000000000LL * ms;
+
+/// Imu message at t0 plus the given milliseconds, with the time as value for checking matches and interpolation
+StreamJoiner::MessagePtr createImu(int64_t t)
+{
+  shared_ptr<roboception::msgs::Imu> msg(new roboception::msgs::Imu());
+  msg->mutable_timestamp()->set_sec((t0 + t * ms) / 1000000000);
+  msg->mutable_timestamp()->set_nsec((t0 + t * ms) % 1000000000);
+  msg->mutable_linear_acceleration()->set_x(t);
+  return msg;
+}
+
+/// Returns the value of an Imu message of createImu(), or -1 if there is no message
+double value(const StreamJoiner::Tuple& tuple, size_t stream)
+{
+  auto imu = tuple.get<roboception::msgs::Imu>(stream);
+  return imu ? imu->linear_acceleration().x() : -1;
+}
+
+StreamJoiner::Config createConfig(StreamJoiner::Matching matching)
+{
+  StreamJoiner::Config config;
+  config.matching = matching;
+  config.tolerance_ns = 5 * ms;
+  return config;
+}
+
+/**
+ * Checks that a tuple is only emitted when the watermarks of all streams
+ * have passed its time stamp plus the tolerance, and that late messages
+ * are dropped afterwards.
+ */
+void testWatermark()
+{
+  StreamJoiner::Ptr joiner = StreamJoiner::create(2, createConfig(StreamJoiner::Matching::NEAREST));
+  StreamJoiner::Tuple tuple;
+
+  joiner->push(0, createImu(100));
+  joiner->push(1, createImu(98));
+  check("not ready before other stream passed the tolerance", !joiner->pop(tuple));
+
+  joiner->push(1, createImu(104));
+  check("not ready before other stream passed the tolerance", !joiner->pop(tuple));
+
+  joiner->push(1, createImu(106));
+  check("ready after other stream passed the tolerance", joiner->pop(tuple));
+  check("tuple of reference message", tuple.stamp == t0 + 100 * ms && value(tuple, 0) == 100);
+  check("nearest message matched", value(tuple, 1) == 98);
+  check("only one tuple ready", !joiner->pop(tuple));
+
+  // late messages
+
+  check("reference message of the last tuple is late", !joiner->push(0, createImu(100)));
+  check("older reference message is late", !joiner->push(0, createImu(99)));
+  check("older message of other stream is late", !joiner->push(1, createImu(99)));
+  check("message of other stream at the last tuple is not late", joiner->push(1, createImu(100)));
+  check("newer reference message is not late", joiner->push(0, createImu(101)));
+
+  StreamJoiner::Statistics stats = joiner->getStatistics();
+  check("statistics of watermarks", stats.pushed == 9 && stats.emitted == 1 && stats.late == 3);
+}
+
+/**
+ * Checks that messages may arrive out of order within the maximum delay.
+ */
+void testOutOfOrder()
+{
+  StreamJoiner::Config config = createConfig(StreamJoiner::Matching::NEAREST);
+  config.max_delay_ns = 10 * ms;
+  StreamJoiner::Ptr joiner = StreamJoiner::create(2, config);
+  StreamJoiner::Tuple tuple;
+
+  joiner->push(0, createImu(100));
+  joiner->push(1, createImu(120));
+  check("not ready before reference stream passed the maximum delay", !joiner->pop(tuple));
+
+  joiner->push(1, createImu(97));
+  joiner->push(1, createImu(102));
+  joiner->push(0, createImu(110));
+  joiner->push(0, createImu(105));
+
+  check("first tuple after maximum delay", joiner->pop(tuple) && value(tuple, 0) == 100 && value(tuple, 1) == 102);
+  check("not ready before reference stream passed the maximum delay", !joiner->pop(tuple));
+
+  joiner->push(0, createImu(115));
+  check("out of order reference message", joiner->pop(tuple) && value(tuple, 0) == 105 && value(tuple, 1) == 102);
+  check("not ready before other stream passed the maximum delay", !joiner->pop(tuple));
+}
+
+/**
+ * Checks exact matching and interpolation, which skip reference messages
+ * without match unless partial tuples are enabled.
+ */
+void testMatching()
+{
+  StreamJoiner::Ptr exact = StreamJoiner::create(2, createConfig(StreamJoiner::Matching::EXACT));
+  StreamJoiner::Tuple tuple;
+
+  exact->push(0, createImu(100));
+  exact->push(0, createImu(110));
+  exact->push(1, createImu(101));
+  exact->push(1, createImu(110));
+  exact->push(1, createImu(120));
+  check("exact match", exact->pop(tuple) && value(tuple, 0) == 110 && value(tuple, 1) == 110);
+  check("reference message without exact match is skipped", exact->getStatistics().incomplete == 1);
+
+  StreamJoiner::Config config = createConfig(StreamJoiner::Matching::INTERPOLATE);
+  config.partial = true;
+  StreamJoiner::Ptr interpolate = StreamJoiner::create(2, config);
+
+  interpolate->push(0, createImu(100));
+  interpolate->push(0, createImu(110));
+  interpolate->push(1, createImu(98));
+  interpolate->push(1, createImu(103));
+  interpolate->push(1, createImu(120));
+  check("interpolated between neighbours", interpolate->pop(tuple) && value(tuple, 1) == 100 &&
+                                               tuple.get<roboception::msgs::Imu>(1)->timestamp().nsec() ==
+                                                   (t0 + 100 * ms) % 1000000000);
+  check("partial tuple without neighbours within tolerance",
+        interpolate->pop(tuple) && value(tuple, 0) == 110 && value(tuple, 1) == -1 && !tuple.isComplete());
+}
+
+/**
+ * Checks that a stream that lags behind does not hold back the others.
+ */
+void testLag()
+{
+  StreamJoiner::Config config = createConfig(StreamJoiner::Matching::NEAREST);
+  config.max_lag_ns = 1000 * ms;
+  config.partial = true;
+  StreamJoiner::Ptr joiner = StreamJoiner::create(2, config);
+  StreamJoiner::Tuple tuple;
+
+  for (int64_t t = 0; t <= 1000; t += 100)
+  {
+    joiner->push(0, createImu(t));
+  }
+  check("not ready while other stream lags less than max_lag", !joiner->pop(tuple));
+
+  joiner->push(0, createImu(1100));
+  check("ready when other stream lags more than max_lag", joiner->pop(tuple) && value(tuple, 1) == -1);
+}
+
+/**
+ * Checks flushing, the buffer capacity and resetting.
+ */
+void testFlushAndOverflow()
+{
+  StreamJoiner::Config config = createConfig(StreamJoiner::Matching::NEAREST);
+  config.capacity = 3;
+  StreamJoiner::Ptr joiner = StreamJoiner::create(2, config);
+  StreamJoiner::Tuple tuple;
+
+  for (int64_t t = 100; t < 105; t++)
+  {
+    joiner->push(1, createImu(t));
+  }
+  check("buffer is limited to capacity", joiner->getBufferSize(1) == 3 && joiner->getStatistics().overflow == 2);
+
+  joiner->push(0, createImu(100));
+  joiner->push(0, createImu(101));
+  check("not ready before flushing", !joiner->pop(tuple));
+
+  joiner->flush();
+  check("first tuple after flushing", joiner->pop(tuple) && value(tuple, 0) == 100 && value(tuple, 1) == 102);
+  check("second tuple after flushing", joiner->pop(tuple) && value(tuple, 0) == 101 && value(tuple, 1) == 102);
+  check("late after flushing", !joiner->push(1, createImu(100)));
+
+  joiner->reset();
+  check("reset removes all messages", joiner->getBufferSize(0) == 0 && joiner->getBufferSize(1) == 0);
+  check("not late after reset", joiner->push(0, createImu(100)));
+}
+}
+
+int main()
+{
+  testWatermark();
+  testOutOfOrder();
+  testMatching();
+  testLag();
+  testFlushAndOverflow();
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
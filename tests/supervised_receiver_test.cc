@@ -0,0 +1,209 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "../tools/visard_simulator.h"
+
+#include <rc_dynamics_api/supervised_receiver.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace std;
+using rc::dynamics::DataReceiver;
+using rc::dynamics::RemoteInterface;
+using rc::dynamics::StreamOutageStats;
+using rc::dynamics::SupervisedReceiver;
+using rc::dynamics::VisardSimulator;
+
+namespace
+{
+int failures = 0;
+
+void check(const string& name, bool ok)
+{
+  if (!ok)
+  {
+    cerr << "ERROR: " << name << endl;
+    failures++;
+  }
+}
+
+/**
+ * Runs a test against a simulator of its own, so that the tests do not
+ * depend on each other, and counts exceptions as failures.
+ */
+void run(const string& name, const function<void(VisardSimulator&, const RemoteInterface::Ptr&)>& test)
+{
+  try
+  {
+    VisardSimulator::Ptr sim = VisardSimulator::create();
+    RemoteInterface::Ptr rc = RemoteInterface::create(sim->getAddress());
+    if (!rc->checkSystemReady())
+    {
+      throw runtime_error("Simulator is not ready");
+    }
+
+    test(*sim, rc);
+  }
+  catch (const exception& e)
+  {
+    cerr << "ERROR: " << name << ": " << e.what() << endl;
+    failures++;
+  }
+}
+
+/**
+ * Keeps receiving from the supervised receiver in a thread, as a consumer
+ * would, and counts the calls of receive() that returned NULL.
+ */
+class Consumer
+{
+public:
+  explicit Consumer(const SupervisedReceiver::Ptr& supervised)
+    : running_(true), timeouts_(0), thread_(&Consumer::run, this, supervised->getReceiver(), supervised->getStream())
+  {
+  }
+
+  ~Consumer()
+  {
+    running_ = false;
+    thread_.join();
+  }
+
+  int getTimeouts() const
+  {
+    return timeouts_;
+  }
+
+private:
+  void run(DataReceiver::Ptr receiver, string stream)
+  {
+    string pb_msg_type = stream == "imu" ? "Imu" : "Dynamics";
+    while (running_)
+    {
+      if (!receiver->receive(pb_msg_type))
+      {
+        timeouts_++;
+      }
+    }
+  }
+
+  atomic<bool> running_;
+  atomic<int> timeouts_;
+  thread thread_;
+};
+
+/// Waits until an outage has been detected and is over, at most 10 s
+StreamOutageStats waitForRestoredStream(const SupervisedReceiver::Ptr& supervised)
+{
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  StreamOutageStats stats = supervised->getStats();
+  while ((stats.outages == 0 || stats.in_outage) && chrono::steady_clock::now() - start < chrono::seconds(10))
+  {
+    this_thread::sleep_for(chrono::milliseconds(10));
+    stats = supervised->getStats();
+  }
+  return stats;
+}
+
+/**
+ * Checks that a lost destination is registered again and that the consumer
+ * gets NULL from receive() during the outage instead of blocking.
+ */
+void testLostDestination(VisardSimulator& sim, const RemoteInterface::Ptr& rc)
+{
+  SupervisedReceiver::Ptr supervised = SupervisedReceiver::create(rc, "imu", "lo", 0, 200);
+  uint64_t count;
+  {
+    Consumer consumer(supervised);
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    sim.clearDestinations();
+    StreamOutageStats stats = waitForRestoredStream(supervised);
+
+    check("outage is detected", stats.outages == 1);
+    check("stream is restored", !stats.in_outage);
+    check("destination is registered again", stats.restored == 1 && sim.getDestinations("imu").size() == 1);
+    check("outage lasts about the silence threshold", stats.last_outage_ms >= 200 && stats.last_outage_ms < 2000);
+    check("receive() returns NULL during the outage", consumer.getTimeouts() > 0);
+
+    count = supervised->getReceiver()->getMessageCount();
+  }
+
+  check("messages arrive after the outage", supervised->getReceiver()->receive<roboception::msgs::Imu>() != nullptr &&
+                                                supervised->getReceiver()->getMessageCount() > count);
+}
+
+/**
+ * Checks that an interruption by rc_dynamics is measured as outage, without
+ * registering the destination again.
+ */
+void testDynamicsStopped(VisardSimulator& sim, const RemoteInterface::Ptr& rc)
+{
+  SupervisedReceiver::Ptr supervised = SupervisedReceiver::create(rc, "dynamics", "lo", 0, 100);
+  Consumer consumer(supervised);
+  this_thread::sleep_for(chrono::milliseconds(100));
+
+  sim.setDynamicsState("IDLE");
+  this_thread::sleep_for(chrono::milliseconds(300));
+  sim.setDynamicsState("RUNNING");
+
+  StreamOutageStats stats = waitForRestoredStream(supervised);
+  check("outage is detected", stats.outages == 1);
+  check("stream resumes", !stats.in_outage);
+  check("destination is kept", stats.restored == 0);
+  check("outage lasts about the stop of rc_dynamics", stats.last_outage_ms >= 300 && stats.last_outage_ms < 2000);
+}
+}
+
+int main()
+{
+  run("lost destination", testLostDestination);
+  run("rc_dynamics stopped", testDynamicsStopped);
+
+  if (failures > 0)
+  {
+    cerr << failures << " checks failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -41,6 +41,9 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <map>
+#include <cmath>
+#include <stdint.h>
 
 #include "rc_dynamics_api/msg_utils.h"
 
@@ -262,6 +265,336 @@ struct Line
 };
 }
 
+namespace csv
+{
+/**
+ * Writes the decimal digits of v backwards, ending before p, and returns a
+ * pointer to the first digit. Two digits are converted at once.
+ */
+inline char* formatUInt(char* p, uint64_t v)
+{
+  static const char digits[] =
+      "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+
+  while (v >= 100)
+  {
+    const char* d = digits + 2 * (v % 100);
+    v /= 100;
+    *--p = d[1];
+    *--p = d[0];
+  }
+
+  if (v >= 10)
+  {
+    const char* d = digits + 2 * v;
+    *--p = d[1];
+    *--p = d[0];
+  }
+  else
+  {
+    *--p = static_cast<char>('0' + v);
+  }
+
+  return p;
+}
+
+/**
+ * Appends an unsigned integer in decimal representation.
+ */
+inline void appendUInt(std::string& out, uint64_t v)
+{
+  char buf[24];
+  char* p = formatUInt(buf + sizeof(buf), v);
+  out.append(p, buf + sizeof(buf) - p);
+}
+
+/**
+ * Appends a signed integer in decimal representation.
+ */
+inline void appendInt(std::string& out, int64_t v)
+{
+  char buf[24];
+  char* p;
+  if (v < 0)
+  {
+    p = formatUInt(buf + sizeof(buf), 0 - static_cast<uint64_t>(v));
+    *--p = '-';
+  }
+  else
+  {
+    p = formatUInt(buf + sizeof(buf), static_cast<uint64_t>(v));
+  }
+  out.append(p, buf + sizeof(buf) - p);
+}
+
+/**
+ * Appends a floating point value with six decimals, with exactly the same
+ * result as std::to_string(), but without going through printf.
+ *
+ * The value is scaled and rounded with integer arithmetic. If the rounding
+ * error of scaling might change the result, i.e. close to a tie or for large
+ * values, it falls back to std::to_string().
+ */
+inline void appendFixed(std::string& out, double v)
+{
+  double a = std::fabs(v);
+  if (!(a < 1e9))  // also true for nan
+  {
+    out += std::to_string(v);
+    return;
+  }
+
+  double scaled = a * 1e6;
+  double integral = std::floor(scaled);
+  double frac = scaled - integral;
+  if (std::fabs(frac - 0.5) <= scaled * 2.3e-16)
+  {
+    out += std::to_string(v);
+    return;
+  }
+
+  uint64_t n = static_cast<uint64_t>(integral) + (frac > 0.5 ? 1 : 0);
+  uint32_t f = static_cast<uint32_t>(n % 1000000);
+
+  char buf[32];
+  char* end = buf + sizeof(buf);
+  char* p = formatUInt(end, f);
+  while (p > end - 6)
+  {
+    *--p = '0';
+  }
+  *--p = '.';
+  p = formatUInt(p, n / 1000000);
+  if (std::signbit(v))
+  {
+    *--p = '-';
+  }
+  out.append(p, end - p);
+}
+
+/**
+ * Writes messages as csv-lines in the same format as Line, but much faster.
+ *
+ * Instead of walking the message descriptor for every message, the field
+ * layout of each message type is compiled once into a flat list of
+ * operations. Lines are formatted into an internal buffer, which is written
+ * to the stream when it is full and on flush() or destruction.
+ */
+class Writer
+{
+public:
+  explicit Writer(std::ostream& out, std::size_t buffer_size = 65536)
+    : out_(out), buffer_size_(buffer_size), last_descr_(0), last_plan_(0)
+  {
+    buffer_.reserve(buffer_size_ + 1024);
+  }
+
+  ~Writer()
+  {
+    flush();
+  }
+
+  /**
+   * Writes the message as csv-line.
+   */
+  Writer& operator<<(const ::google::protobuf::Message& m)
+  {
+    append(buffer_, m);
+    buffer_ += '\n';
+    if (buffer_.size() >= buffer_size_)
+    {
+      flush();
+    }
+    return *this;
+  }
+
+  /**
+   * Appends the message as csv-line, without line break, to the given string.
+   */
+  void append(std::string& out, const ::google::protobuf::Message& m)
+  {
+    const std::vector<Op>& ops = plan(m.GetDescriptor());
+    std::size_t start = out.size();
+    appendFields(out, m, ops.data(), ops.data() + ops.size());
+
+    // remove separator after the last entry
+    if (out.size() > start)
+    {
+      out.resize(out.size() - 1);
+    }
+  }
+
+  /**
+   * Writes all buffered lines to the stream.
+   */
+  void flush()
+  {
+    if (!buffer_.empty())
+    {
+      out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+      buffer_.clear();
+    }
+  }
+
+private:
+  /**
+   * Operation for one field. The operations of the fields of a sub-message
+   * follow directly and are skipped via children.
+   */
+  struct Op
+  {
+    const ::google::protobuf::FieldDescriptor* field;
+    ::google::protobuf::FieldDescriptor::CppType type;
+    bool repeated;
+    bool check_presence;
+    std::size_t children;
+  };
+
+  const std::vector<Op>& plan(const ::google::protobuf::Descriptor* descr)
+  {
+    if (descr != last_descr_)
+    {
+      auto it = plans_.find(descr);
+      if (it == plans_.end())
+      {
+        it = plans_.insert(std::make_pair(descr, std::vector<Op>())).first;
+        compile(it->second, descr);
+      }
+
+      last_descr_ = descr;
+      last_plan_ = &it->second;
+    }
+
+    return *last_plan_;
+  }
+
+  static void compile(std::vector<Op>& ops, const ::google::protobuf::Descriptor* descr)
+  {
+    using namespace ::google::protobuf;
+
+    for (int i = 0; i < descr->field_count(); ++i)
+    {
+      auto field = descr->field(i);
+
+      Op op;
+      op.field = field;
+      op.type = field->cpp_type();
+      op.repeated = field->is_repeated();
+      op.check_presence = field->is_optional();
+      op.children = 0;
+
+      std::size_t k = ops.size();
+      ops.push_back(op);
+      if (op.type == FieldDescriptor::CPPTYPE_MESSAGE)
+      {
+        compile(ops, field->message_type());
+        ops[k].children = ops.size() - k - 1;
+      }
+    }
+  }
+
+  static void appendFields(std::string& out, const ::google::protobuf::Message& m, const Op* begin, const Op* end)
+  {
+    using namespace ::google::protobuf;
+
+    auto refl = m.GetReflection();
+    for (const Op* op = begin; op < end; op += 1 + op->children)
+    {
+      auto field = op->field;
+
+      if (op->repeated)
+      {
+        int size = refl->FieldSize(m, field);
+        for (int k = 0; k < size; ++k)
+        {
+          switch (op->type)
+          {
+            case FieldDescriptor::CPPTYPE_MESSAGE:
+              appendFields(out, refl->GetRepeatedMessage(m, field, k), op + 1, op + 1 + op->children);
+              continue;
+            case FieldDescriptor::CPPTYPE_BOOL:
+              out += refl->GetRepeatedBool(m, field, k) ? '1' : '0';
+              break;
+            case FieldDescriptor::CPPTYPE_ENUM:
+              out += refl->GetRepeatedEnum(m, field, k)->name();
+              break;
+            case FieldDescriptor::CPPTYPE_FLOAT:
+              appendFixed(out, refl->GetRepeatedFloat(m, field, k));
+              break;
+            case FieldDescriptor::CPPTYPE_DOUBLE:
+              appendFixed(out, refl->GetRepeatedDouble(m, field, k));
+              break;
+            case FieldDescriptor::CPPTYPE_UINT32:
+              appendUInt(out, refl->GetRepeatedUInt32(m, field, k));
+              break;
+            case FieldDescriptor::CPPTYPE_UINT64:
+              appendUInt(out, refl->GetRepeatedUInt64(m, field, k));
+              break;
+            case FieldDescriptor::CPPTYPE_INT32:
+              appendInt(out, refl->GetRepeatedInt32(m, field, k));
+              break;
+            case FieldDescriptor::CPPTYPE_INT64:
+              appendInt(out, refl->GetRepeatedInt64(m, field, k));
+              break;
+            case FieldDescriptor::CPPTYPE_STRING:
+              out += refl->GetRepeatedString(m, field, k);
+              break;
+          }
+          out += ',';
+        }
+      }
+      else if (!op->check_presence || refl->HasField(m, field))
+      {
+        switch (op->type)
+        {
+          case FieldDescriptor::CPPTYPE_MESSAGE:
+            appendFields(out, refl->GetMessage(m, field), op + 1, op + 1 + op->children);
+            continue;
+          case FieldDescriptor::CPPTYPE_BOOL:
+            out += refl->GetBool(m, field) ? '1' : '0';
+            break;
+          case FieldDescriptor::CPPTYPE_ENUM:
+            out += refl->GetEnum(m, field)->name();
+            break;
+          case FieldDescriptor::CPPTYPE_FLOAT:
+            appendFixed(out, refl->GetFloat(m, field));
+            break;
+          case FieldDescriptor::CPPTYPE_DOUBLE:
+            appendFixed(out, refl->GetDouble(m, field));
+            break;
+          case FieldDescriptor::CPPTYPE_UINT32:
+            appendUInt(out, refl->GetUInt32(m, field));
+            break;
+          case FieldDescriptor::CPPTYPE_UINT64:
+            appendUInt(out, refl->GetUInt64(m, field));
+            break;
+          case FieldDescriptor::CPPTYPE_INT32:
+            appendInt(out, refl->GetInt32(m, field));
+            break;
+          case FieldDescriptor::CPPTYPE_INT64:
+            appendInt(out, refl->GetInt64(m, field));
+            break;
+          case FieldDescriptor::CPPTYPE_STRING:
+            out += refl->GetString(m, field);
+            break;
+        }
+        out += ',';
+      }
+    }
+  }
+
+  std::ostream& out_;
+  std::size_t buffer_size_;
+  std::string buffer_;
+
+  const ::google::protobuf::Descriptor* last_descr_;
+  const std::vector<Op>* last_plan_;
+  std::map<const ::google::protobuf::Descriptor*, std::vector<Op>> plans_;
+};
+}
+
 std::ostream& operator<<(std::ostream& s, const csv::Header& header)
 {
   bool first = true;
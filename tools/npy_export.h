@@ -0,0 +1,637 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_NPY_EXPORT_H
+#define RC_DYNAMICS_API_NPY_EXPORT_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <errno.h>
+#include <sys/stat.h>
+#ifdef WIN32
+#include <direct.h>
+#endif
+
+#include "rc_dynamics_api/json.hpp"
+
+#include <google/protobuf/message.h>
+
+namespace npy
+{
+/**
+ * Writes the header of a one dimensional .npy file (format version 1.0).
+ * The header is padded to a size that does not depend on the number of rows,
+ * so that it can be rewritten with the final number of rows.
+ */
+inline void writeHeader(std::ostream& out, const std::string& descr, uint64_t rows)
+{
+  std::string dict = "{'descr': " + descr + ", 'fortran_order': False, 'shape': (";
+  std::size_t size = (10 + dict.size() + 20 + 5 + 1 + 63) / 64 * 64;  // room for 20 digits, ",), }" and '\n'
+
+  dict += std::to_string(rows) + ",), }";
+  dict.resize(size - 11, ' ');
+  dict += '\n';
+
+  uint16_t len = static_cast<uint16_t>(dict.size());
+  out.write("\x93NUMPY\x01\x00", 8);
+  out.put(static_cast<char>(len & 0xff));
+  out.put(static_cast<char>(len >> 8));
+  out.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+}
+
+/**
+ * Exports messages of one stream column-oriented into a directory, so that
+ * they can be memory mapped and loaded with numpy without any parsing, e.g.
+ * with numpy.load("pose_position_x.npy", mmap_mode="r").
+ *
+ * The directory contains:
+ *
+ * - one .npy file per field, named like the columns of csv::Header,
+ *   with one element per message, plus host_stamp.npy with the receive
+ *   time stamps in nanoseconds. Missing values are NaN for floating point
+ *   fields and 0 otherwise. Strings are stored as codes into a dictionary
+ *   given in the manifest.
+ * - _blocks.npy with the range of rows and time stamps of every block of
+ *   block_rows messages, for skipping blocks that are out of the time range
+ *   of interest.
+ * - manifest.json describing the stream, the columns and their data types.
+ *
+ * All singular fields of the message type get a column, also if they are
+ * not set in the first message. The number of columns of repeated fields
+ * is determined by the first message. Messages with more elements cause an
+ * exception, since their values could not be exported.
+ */
+class Writer
+{
+public:
+  Writer(const std::string& directory, const std::string& stream_name, const std::string& pb_msg_type,
+         std::size_t block_rows = 65536)
+    : directory_(directory)
+    , stream_name_(stream_name)
+    , pb_msg_type_(pb_msg_type)
+    , block_rows_(block_rows)
+    , rows_(0)
+    , block_fill_(0)
+    , closed_(false)
+  {
+#ifdef WIN32
+    int ret = _mkdir(directory.c_str());
+#else
+    int ret = mkdir(directory.c_str(), 0755);
+#endif
+    if (ret < 0 && errno != EEXIST)
+    {
+      throw std::runtime_error("Cannot create directory '" + directory + "': " + std::strerror(errno));
+    }
+
+    Column host_stamp;
+    host_stamp.name = "host_stamp";
+    host_stamp.descr = "'<i8'";
+    host_stamp.type = ::google::protobuf::FieldDescriptor::CPPTYPE_INT64;
+    columns_.push_back(std::move(host_stamp));
+  }
+
+  ~Writer()
+  {
+    try
+    {
+      close();
+    }
+    catch (const std::exception&)
+    {
+      // destructor must not throw
+    }
+  }
+
+  /**
+   * Appends a message as one row.
+   *
+   * @param host_stamp receive time stamp in nanoseconds since epoch
+   * @param m message
+   */
+  void write(int64_t host_stamp, const ::google::protobuf::Message& m)
+  {
+    if (rows_ == 0 && block_fill_ == 0)
+    {
+      compile(m);
+    }
+    check(m);
+
+    append(columns_[0], host_stamp);
+    for (std::size_t i = 1; i < columns_.size(); i++)
+    {
+      appendField(columns_[i], m);
+    }
+
+    int64_t stamp = messageStamp(m);
+    if (block_fill_ == 0)
+    {
+      block_.min_host_stamp = block_.max_host_stamp = host_stamp;
+      block_.min_stamp = block_.max_stamp = stamp;
+    }
+    block_.min_host_stamp = std::min(block_.min_host_stamp, host_stamp);
+    block_.max_host_stamp = std::max(block_.max_host_stamp, host_stamp);
+    block_.min_stamp = std::min(block_.min_stamp, stamp);
+    block_.max_stamp = std::max(block_.max_stamp, stamp);
+
+    if (++block_fill_ >= block_rows_)
+    {
+      writeBlock();
+    }
+  }
+
+  /**
+   * Writes the remaining rows, the final headers, the block statistics and
+   * the manifest. This is done automatically on destruction.
+   */
+  void close()
+  {
+    if (closed_)
+    {
+      return;
+    }
+    closed_ = true;
+
+    writeBlock();
+
+    nlohmann::json columns = nlohmann::json::array();
+    for (auto&& c : columns_)
+    {
+      if (!c.file.is_open())
+      {
+        openColumn(c);
+      }
+      c.file.seekp(0);
+      writeHeader(c.file, c.descr, rows_);
+      c.file.close();
+
+      nlohmann::json column = { { "name", c.name }, { "file", c.name + ".npy" }, { "dtype", unquote(c.descr) } };
+      if (c.type == ::google::protobuf::FieldDescriptor::CPPTYPE_STRING)
+      {
+        column["dictionary"] = c.dictionary_values;
+      }
+      columns.push_back(column);
+    }
+
+    std::string descr = "[('first_row', '<u8'), ('num_rows', '<u8'), ('min_host_stamp', '<i8'), "
+                        "('max_host_stamp', '<i8'), ('min_stamp', '<i8'), ('max_stamp', '<i8')]";
+    std::ofstream blocks(path("_blocks.npy"), std::ios::binary);
+    writeHeader(blocks, descr, blocks_.size());
+    if (!blocks_.empty())
+    {
+      blocks.write(reinterpret_cast<const char*>(blocks_.data()),
+                   static_cast<std::streamsize>(blocks_.size() * sizeof(BlockStats)));
+    }
+
+    nlohmann::json manifest = { { "stream", stream_name_ },
+                                { "pb_msg_type", pb_msg_type_ },
+                                { "rows", rows_ },
+                                { "block_rows", block_rows_ },
+                                { "blocks", "_blocks.npy" },
+                                { "columns", columns } };
+    std::ofstream manifest_file(path("manifest.json"));
+    manifest_file << manifest.dump(2) << std::endl;
+
+    if (!blocks || !manifest_file)
+    {
+      throw std::runtime_error("Cannot write to directory '" + directory_ + "'");
+    }
+  }
+
+  /// Returns the number of written rows
+  uint64_t getRowCount() const
+  {
+    return rows_ + block_fill_;
+  }
+
+  /// Returns the number of columns including host_stamp
+  std::size_t getColumnCount() const
+  {
+    return columns_.size();
+  }
+
+private:
+  /// One step on the path from the message to a field value
+  struct Step
+  {
+    const ::google::protobuf::FieldDescriptor* field;
+    int index;  // index for repeated fields, -1 otherwise
+  };
+
+  /// Maximum number of elements of a repeated field (or 1 for a singular field) that are covered by columns
+  struct Guard
+  {
+    std::vector<Step> path;  // path to the message containing the field
+    const ::google::protobuf::FieldDescriptor* field;
+    int max_size;
+  };
+
+  struct Column
+  {
+    std::string name;
+    std::string descr;
+    ::google::protobuf::FieldDescriptor::CppType type;
+    std::vector<Step> path;
+    std::vector<char> buffer;
+    std::ofstream file;
+    std::map<std::string, uint16_t> dictionary;
+    std::vector<std::string> dictionary_values;
+  };
+
+  /// Statistics of a block, with the memory layout of the _blocks.npy records
+  struct BlockStats
+  {
+    uint64_t first_row;
+    uint64_t num_rows;
+    int64_t min_host_stamp;
+    int64_t max_host_stamp;
+    int64_t min_stamp;
+    int64_t max_stamp;
+  };
+
+  static std::string unquote(const std::string& s)
+  {
+    return s.substr(1, s.size() - 2);
+  }
+
+  std::string path(const std::string& file) const
+  {
+    return directory_ + "/" + file;
+  }
+
+  /**
+   * Determines the columns from the descriptor of the message, in the same
+   * order and with the naming of csv::Header. Every singular field gets
+   * a column, also if it is not set in the given message. The number of
+   * elements of repeated fields is taken from the given message and guarded,
+   * see check().
+   */
+  void compile(const ::google::protobuf::Message& m)
+  {
+    std::vector<Step> prefix;
+    std::vector<const ::google::protobuf::Descriptor*> types;
+    compile(m, prefix, "", types);
+  }
+
+  void compile(const ::google::protobuf::Message& m, std::vector<Step>& prefix, const std::string& name,
+               std::vector<const ::google::protobuf::Descriptor*>& types)
+  {
+    using namespace ::google::protobuf;
+
+    auto descr = m.GetDescriptor();
+    auto refl = m.GetReflection();
+    types.push_back(descr);
+    for (int i = 0; i < descr->field_count(); ++i)
+    {
+      auto field = descr->field(i);
+      bool is_message = field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE;
+
+      if (field->is_repeated())
+      {
+        int size = refl->FieldSize(m, field);
+        guards_.push_back({ prefix, field, size });
+        for (int k = 0; k < size; k++)
+        {
+          std::string element = name + field->name() + "_" + std::to_string(k);
+          prefix.push_back({ field, k });
+          if (is_message)
+          {
+            compile(refl->GetRepeatedMessage(m, field, k), prefix, element + "_", types);
+          }
+          else
+          {
+            addColumn(prefix, element);
+          }
+          prefix.pop_back();
+        }
+      }
+      else if (is_message && std::find(types.begin(), types.end(), field->message_type()) != types.end())
+      {
+        // recursive message types cannot be expanded from the descriptor
+        guards_.push_back({ prefix, field, refl->HasField(m, field) ? 1 : 0 });
+        if (refl->HasField(m, field))
+        {
+          throw std::runtime_error("Recursive message type of field " + name + field->name() +
+                                   " cannot be exported as columns");
+        }
+      }
+      else
+      {
+        // GetMessage() returns the default instance of fields that are not set
+
+        prefix.push_back({ field, -1 });
+        if (is_message)
+        {
+          compile(refl->GetMessage(m, field), prefix, name + field->name() + "_", types);
+        }
+        else
+        {
+          addColumn(prefix, name + field->name());
+        }
+        prefix.pop_back();
+      }
+    }
+    types.pop_back();
+  }
+
+  /**
+   * Throws an exception if the message has more elements of a repeated field
+   * than the first message, since they would be silently dropped otherwise.
+   */
+  void check(const ::google::protobuf::Message& m) const
+  {
+    for (const Guard& g : guards_)
+    {
+      const ::google::protobuf::Message* msg = getMessage(m, g.path, g.path.size());
+      if (!msg)
+      {
+        continue;
+      }
+
+      auto refl = msg->GetReflection();
+      int size = g.field->is_repeated() ? refl->FieldSize(*msg, g.field) : (refl->HasField(*msg, g.field) ? 1 : 0);
+      if (size > g.max_size)
+      {
+        throw std::runtime_error("Row " + std::to_string(getRowCount()) + " has " + std::to_string(size) +
+                                 " elements of field " + g.field->full_name() + ", but columns only for " +
+                                 std::to_string(g.max_size) + " elements, which are determined by the first message");
+      }
+    }
+  }
+
+  /**
+   * Follows the first n steps of the path and returns the message that
+   * contains the field of the next step, or null if any message on the
+   * path is not present.
+   */
+  static const ::google::protobuf::Message* getMessage(const ::google::protobuf::Message& m,
+                                                       const std::vector<Step>& path, std::size_t n)
+  {
+    const ::google::protobuf::Message* msg = &m;
+    for (std::size_t i = 0; i < n && msg; i++)
+    {
+      const Step& step = path[i];
+      auto refl = msg->GetReflection();
+      bool present = step.index >= 0 ? step.index < refl->FieldSize(*msg, step.field) :
+                                       (!step.field->is_optional() || refl->HasField(*msg, step.field));
+
+      if (!present)
+      {
+        msg = 0;
+      }
+      else
+      {
+        msg = step.index >= 0 ? &refl->GetRepeatedMessage(*msg, step.field, step.index) :
+                                &refl->GetMessage(*msg, step.field);
+      }
+    }
+    return msg;
+  }
+
+  void addColumn(const std::vector<Step>& path, const std::string& name)
+  {
+    using namespace ::google::protobuf;
+
+    Column c;
+    c.name = name;
+    c.path = path;
+    c.type = path.back().field->cpp_type();
+    switch (c.type)
+    {
+      case FieldDescriptor::CPPTYPE_BOOL:
+        c.descr = "'|u1'";
+        break;
+      case FieldDescriptor::CPPTYPE_ENUM:
+      case FieldDescriptor::CPPTYPE_INT32:
+        c.descr = "'<i4'";
+        break;
+      case FieldDescriptor::CPPTYPE_UINT32:
+        c.descr = "'<u4'";
+        break;
+      case FieldDescriptor::CPPTYPE_INT64:
+        c.descr = "'<i8'";
+        break;
+      case FieldDescriptor::CPPTYPE_UINT64:
+        c.descr = "'<u8'";
+        break;
+      case FieldDescriptor::CPPTYPE_FLOAT:
+        c.descr = "'<f4'";
+        break;
+      case FieldDescriptor::CPPTYPE_DOUBLE:
+        c.descr = "'<f8'";
+        break;
+      case FieldDescriptor::CPPTYPE_STRING:
+        c.descr = "'<u2'";
+        break;
+      default:
+        throw std::logic_error("Unexpected field type");
+    }
+    columns_.push_back(std::move(c));
+  }
+
+  template <class T>
+  static void append(Column& c, T v)
+  {
+    const char* p = reinterpret_cast<const char*>(&v);
+    c.buffer.insert(c.buffer.end(), p, p + sizeof(T));
+  }
+
+  /// Appends the value of the column's field of the message or the missing value
+  static void appendField(Column& c, const ::google::protobuf::Message& m)
+  {
+    using namespace ::google::protobuf;
+
+    const Message* msg = getMessage(m, c.path, c.path.size() - 1);
+    if (msg)
+    {
+      const Step& step = c.path.back();
+      auto refl = msg->GetReflection();
+      bool present = step.index >= 0 ? step.index < refl->FieldSize(*msg, step.field) :
+                                       (!step.field->is_optional() || refl->HasField(*msg, step.field));
+      if (!present)
+      {
+        msg = 0;
+      }
+    }
+
+    const Step& step = c.path.back();
+    auto refl = msg ? msg->GetReflection() : 0;
+    int k = step.index;
+    switch (c.type)
+    {
+      case FieldDescriptor::CPPTYPE_BOOL:
+        append<uint8_t>(c, msg && (k >= 0 ? refl->GetRepeatedBool(*msg, step.field, k) : refl->GetBool(*msg, step.field)));
+        break;
+      case FieldDescriptor::CPPTYPE_ENUM:
+        append<int32_t>(c, !msg ? 0 : k >= 0 ? refl->GetRepeatedEnumValue(*msg, step.field, k) :
+                                               refl->GetEnumValue(*msg, step.field));
+        break;
+      case FieldDescriptor::CPPTYPE_INT32:
+        append<int32_t>(c, !msg ? 0 : k >= 0 ? refl->GetRepeatedInt32(*msg, step.field, k) :
+                                               refl->GetInt32(*msg, step.field));
+        break;
+      case FieldDescriptor::CPPTYPE_UINT32:
+        append<uint32_t>(c, !msg ? 0 : k >= 0 ? refl->GetRepeatedUInt32(*msg, step.field, k) :
+                                                refl->GetUInt32(*msg, step.field));
+        break;
+      case FieldDescriptor::CPPTYPE_INT64:
+        append<int64_t>(c, !msg ? 0 : k >= 0 ? refl->GetRepeatedInt64(*msg, step.field, k) :
+                                               refl->GetInt64(*msg, step.field));
+        break;
+      case FieldDescriptor::CPPTYPE_UINT64:
+        append<uint64_t>(c, !msg ? 0 : k >= 0 ? refl->GetRepeatedUInt64(*msg, step.field, k) :
+                                                refl->GetUInt64(*msg, step.field));
+        break;
+      case FieldDescriptor::CPPTYPE_FLOAT:
+        append<float>(c, !msg ? std::numeric_limits<float>::quiet_NaN() :
+                                k >= 0 ? refl->GetRepeatedFloat(*msg, step.field, k) :
+                                         refl->GetFloat(*msg, step.field));
+        break;
+      case FieldDescriptor::CPPTYPE_DOUBLE:
+        append<double>(c, !msg ? std::numeric_limits<double>::quiet_NaN() :
+                                 k >= 0 ? refl->GetRepeatedDouble(*msg, step.field, k) :
+                                          refl->GetDouble(*msg, step.field));
+        break;
+      case FieldDescriptor::CPPTYPE_STRING:
+      {
+        std::string s;
+        if (msg)
+        {
+          s = k >= 0 ? refl->GetRepeatedString(*msg, step.field, k) : refl->GetString(*msg, step.field);
+        }
+
+        auto it = c.dictionary.find(s);
+        if (it == c.dictionary.end())
+        {
+          if (c.dictionary.size() > std::numeric_limits<uint16_t>::max())
+          {
+            throw std::runtime_error("Too many different values of field " + c.name);
+          }
+          it = c.dictionary.insert(std::make_pair(s, static_cast<uint16_t>(c.dictionary.size()))).first;
+          c.dictionary_values.push_back(s);
+        }
+        append<uint16_t>(c, it->second);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  /// Returns the time stamp of the message in nanoseconds, or 0 if it has none
+  static int64_t messageStamp(const ::google::protobuf::Message& m)
+  {
+    auto field = m.GetDescriptor()->FindFieldByName("timestamp");
+    if (!field || field->cpp_type() != ::google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE || field->is_repeated())
+    {
+      return 0;
+    }
+
+    const ::google::protobuf::Message& t = m.GetReflection()->GetMessage(m, field);
+    auto sec = t.GetDescriptor()->FindFieldByName("sec");
+    auto nsec = t.GetDescriptor()->FindFieldByName("nsec");
+    if (!sec || !nsec || sec->cpp_type() != ::google::protobuf::FieldDescriptor::CPPTYPE_INT32 ||
+        nsec->cpp_type() != ::google::protobuf::FieldDescriptor::CPPTYPE_INT32)
+    {
+      return 0;
+    }
+
+    return t.GetReflection()->GetInt32(t, sec) * 1000000000ll + t.GetReflection()->GetInt32(t, nsec);
+  }
+
+  void openColumn(Column& c)
+  {
+    c.file.open(path(c.name + ".npy"), std::ios::binary | std::ios::trunc);
+    if (!c.file.is_open())
+    {
+      throw std::runtime_error("Cannot create file '" + path(c.name + ".npy") + "'");
+    }
+    writeHeader(c.file, c.descr, 0);
+  }
+
+  void writeBlock()
+  {
+    if (block_fill_ == 0)
+    {
+      return;
+    }
+
+    for (auto&& c : columns_)
+    {
+      if (!c.file.is_open())
+      {
+        openColumn(c);
+      }
+      c.file.write(c.buffer.data(), static_cast<std::streamsize>(c.buffer.size()));
+      if (!c.file)
+      {
+        throw std::runtime_error("Cannot write to file '" + path(c.name + ".npy") + "'");
+      }
+      c.buffer.clear();
+    }
+
+    block_.first_row = rows_;
+    block_.num_rows = block_fill_;
+    blocks_.push_back(block_);
+
+    rows_ += block_fill_;
+    block_fill_ = 0;
+  }
+
+  std::string directory_;
+  std::string stream_name_;
+  std::string pb_msg_type_;
+  std::size_t block_rows_;
+
+  std::vector<Column> columns_;
+  std::vector<Guard> guards_;
+  std::vector<BlockStats> blocks_;
+  BlockStats block_;
+  uint64_t rows_;           // number of rows written to the files
+  std::size_t block_fill_;  // number of rows in the current block
+  bool closed_;
+};
+}
+
+#endif  // RC_DYNAMICS_API_NPY_EXPORT_H
@@ -0,0 +1,168 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <cstdlib>
+#include <iostream>
+
+#include "rc_dynamics_api/segmented_recording.h"
+#include "rc_dynamics_api/compressed_recording.h"
+
+using namespace std;
+using namespace rc::dynamics;
+
+/**
+ * Print usage of example including command line args
+ */
+void printUsage(char* arg)
+{
+  cout << "\nCompresses a binary recording of rcdynamics_stream (see -f bin), or decompresses "
+          "\nit again into a binary recording. The recording to compress is either a single "
+          "\nfile or the manifest (.json) of a segmented recording."
+       << "\n\nUsage: \n"
+       << arg << " [-q <tolerance>] <recording> <output>\n"
+       << arg << " -x <compressed recording> <output>"
+       << "\n\n -q <tolerance> Maximum error of floating point values, e.g. 1e-6. Default is 0, i.e."
+          "\n                lossless compression"
+          "\n -x             Decompress the given compressed recording" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+  /**
+   * Parse program options
+   */
+  string file_name, out_file_name;
+  double tolerance = 0;
+  bool decompress = false;
+
+  int i = 1;
+  while (i < argc)
+  {
+    std::string p = argv[i++];
+
+    if (p == "-q" && i < argc)
+    {
+      tolerance = atof(argv[i++]);
+    }
+    else if (p == "-x")
+    {
+      decompress = true;
+    }
+    else if (p == "-h")
+    {
+      printUsage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+    else if (p.size() > 0 && p[0] != '-' && file_name.empty())
+    {
+      file_name = p;
+    }
+    else if (p.size() > 0 && p[0] != '-' && out_file_name.empty())
+    {
+      out_file_name = p;
+    }
+    else
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (file_name.empty() || out_file_name.empty())
+  {
+    cerr << "Please specify a recording and an output file." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (!(tolerance >= 0))
+  {
+    cerr << "The tolerance must not be negative." << endl;
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    uint64_t cnt_msgs = 0;
+    RecordedMessage msg;
+
+    if (decompress)
+    {
+      CompressedRecordingReader::Ptr reader = CompressedRecordingReader::open(file_name);
+      RecordingWriter::Ptr writer = RecordingWriter::create(out_file_name, reader->getStreams());
+      while (reader->next(msg))
+      {
+        writer->write(msg.stream, msg.host_stamp, msg.data, msg.size);
+        ++cnt_msgs;
+      }
+      writer->close();
+
+      if (!reader->isComplete())
+      {
+        cerr << "WARN: Compressed recording '" << file_name << "' has not been closed properly" << endl;
+      }
+
+      cout << "Decompressed " << cnt_msgs << " messages to '" << out_file_name << "'." << endl;
+      return EXIT_SUCCESS;
+    }
+
+    SegmentedRecordingReader::Ptr reader = SegmentedRecordingReader::open(file_name);
+    if (!reader->isComplete())
+    {
+      cerr << "WARN: Recording '" << file_name << "' has not been closed properly" << endl;
+    }
+
+    CompressedRecordingWriter::Ptr writer =
+        CompressedRecordingWriter::create(out_file_name, reader->getStreams(), tolerance);
+    uint64_t raw_size = 0;
+    SegmentedRecordingReader::Query query = reader->queryAll();
+    while (query.next(msg))
+    {
+      writer->write(msg.stream, msg.host_stamp, msg.data, msg.size);
+      raw_size += msg.size;
+      ++cnt_msgs;
+    }
+    writer->close();
+
+    cout << "Compressed " << cnt_msgs << " messages with " << raw_size << " bytes to " << writer->getFileSize()
+         << " bytes in '" << out_file_name << "'." << endl;
+  }
+  catch (exception& e)
+  {
+    cerr << "ERROR! " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
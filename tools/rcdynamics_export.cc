@@ -0,0 +1,270 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#include "rc_dynamics_api/segmented_recording.h"
+#include "roboception/msgs/frame.pb.h"
+#include "roboception/msgs/dynamics.pb.h"
+#include "roboception/msgs/imu.pb.h"
+#include "csv_printing.h"
+#include "npy_export.h"
+
+using namespace std;
+using namespace rc::dynamics;
+
+/**
+ * Print usage of example including command line args
+ */
+void printUsage(char* arg)
+{
+  cout << "\nLists the streams of a binary recording of rcdynamics_stream (see -f bin), "
+          "\nor exports the messages of one stream as csv-file or as directory of numpy arrays."
+          "\nThe recording is either a single file or the manifest (.json) of a segmented "
+          "\nrecording."
+       << "\n\nUsage: \n"
+       << arg << " -l | [-s <stream>] [-b <start>] [-e <end>] [-f <format>] [-o <output>] <recording>"
+       << "\n\n -b <start>    Only export messages received at or after this time, in seconds since epoch"
+          "\n -e <end>      Only export messages received at or before this time, in seconds since epoch"
+          "\n -f <format>   Output format: csv (default) or npy. The latter writes one .npy file per field"
+          "\n               together with block statistics and a manifest.json into the output directory"
+          "\n               given by -o" << endl;
+}
+
+/**
+ * Creates an empty message of the given protobuf message type
+ */
+shared_ptr<::google::protobuf::Message> createMessage(const string& pb_msg_type)
+{
+  if (pb_msg_type == roboception::msgs::Frame::descriptor()->name())
+    return make_shared<roboception::msgs::Frame>();
+  if (pb_msg_type == roboception::msgs::Imu::descriptor()->name())
+    return make_shared<roboception::msgs::Imu>();
+  if (pb_msg_type == roboception::msgs::Dynamics::descriptor()->name())
+    return make_shared<roboception::msgs::Dynamics>();
+
+  throw invalid_argument("Unsupported protobuf message type '" + pb_msg_type + "'");
+}
+
+int main(int argc, char* argv[])
+{
+  /**
+   * Parse program options
+   */
+  string file_name, out_file_name, stream_name, format = "csv";
+  bool only_list_streams = false;
+  int64_t start_stamp = numeric_limits<int64_t>::min(), end_stamp = numeric_limits<int64_t>::max();
+
+  int i = 1;
+  while (i < argc)
+  {
+    std::string p = argv[i++];
+
+    if (p == "-l")
+    {
+      only_list_streams = true;
+    }
+    else if (p == "-s" && i < argc)
+    {
+      stream_name = string(argv[i++]);
+    }
+    else if (p == "-b" && i < argc)
+    {
+      start_stamp = static_cast<int64_t>(std::floor(atof(argv[i++]) * 1e9));
+    }
+    else if (p == "-e" && i < argc)
+    {
+      end_stamp = static_cast<int64_t>(std::ceil(atof(argv[i++]) * 1e9));
+    }
+    else if (p == "-f" && i < argc)
+    {
+      format = string(argv[i++]);
+    }
+    else if (p == "-o" && i < argc)
+    {
+      out_file_name = string(argv[i++]);
+    }
+    else if (p == "-h")
+    {
+      printUsage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+    else if (p.size() > 0 && p[0] != '-' && file_name.empty())
+    {
+      file_name = p;
+    }
+    else
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (file_name.empty())
+  {
+    cerr << "Please specify a recording." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (format != "csv" && format != "npy")
+  {
+    cerr << "Unknown output format '" << format << "'." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (format == "npy" && out_file_name.empty() && !only_list_streams)
+  {
+    cerr << "Please specify an output directory with -o for the npy format." << endl;
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    SegmentedRecordingReader::Ptr reader = SegmentedRecordingReader::open(file_name);
+    const vector<RecordingStream>& streams = reader->getStreams();
+
+    if (!reader->isComplete())
+    {
+      cerr << "WARN: Recording '" << file_name << "' has not been closed properly" << endl;
+    }
+
+    /* Only list the streams of the recording and exit */
+    if (only_list_streams)
+    {
+      vector<uint64_t> counts(streams.size(), 0);
+      SegmentedRecordingReader::Query query = reader->queryAll();
+      RecordedMessage msg;
+      while (query.next(msg))
+      {
+        if (msg.stream < counts.size())
+          counts[msg.stream]++;
+      }
+
+      double secs = (reader->getEndTime() - reader->getStartTime()) * 1e-9;
+      cout << left << setw(24) << "Streams:" << setw(24) << "Protobuf message types:"
+           << "Messages:" << endl;
+      for (size_t k = 0; k < streams.size(); k++)
+        cout << left << setw(24) << streams[k].name << setw(24) << streams[k].pb_msg_type << counts[k] << endl;
+      cout << endl << "Start:    " << fixed << setprecision(3) << reader->getStartTime() * 1e-9 << " s" << endl;
+      cout << "Duration: " << fixed << setprecision(3) << secs << " s" << endl;
+      if (reader->getSegments().size() > 1)
+        cout << "Segments: " << reader->getSegments().size() << endl;
+      return EXIT_SUCCESS;
+    }
+
+    /* Find the stream that is exported */
+    int stream = stream_name.empty() && streams.size() == 1 ? 0 : reader->getStreamIndex(stream_name);
+    if (stream < 0)
+    {
+      cerr << "Please specify one of the streams of the recording, see -l." << endl;
+      return EXIT_FAILURE;
+    }
+
+    auto pb_msg = createMessage(streams[stream].pb_msg_type);
+    uint64_t cnt_msgs = 0;
+
+    /* Export all messages of the stream as columns */
+    if (format == "npy")
+    {
+      npy::Writer npy_writer(out_file_name, streams[stream].name, streams[stream].pb_msg_type);
+      SegmentedRecordingReader::Query query = reader->query(1u << stream, start_stamp, end_stamp);
+      RecordedMessage msg;
+      while (query.next(msg))
+      {
+        if (!pb_msg->ParseFromArray(msg.data, static_cast<int>(msg.size)))
+          continue;
+
+        npy_writer.write(msg.host_stamp, *pb_msg);
+        ++cnt_msgs;
+      }
+      npy_writer.close();
+
+      cout << "Exported " << cnt_msgs << " " << streams[stream].name << " messages as "
+           << npy_writer.getColumnCount() << " columns to '" << out_file_name << "'." << endl;
+      return EXIT_SUCCESS;
+    }
+
+    ofstream output_file;
+    if (!out_file_name.empty())
+    {
+      output_file.open(out_file_name);
+      if (!output_file.is_open())
+      {
+        cerr << "Could not open file '" << out_file_name << "' for writing!" << endl;
+        return EXIT_FAILURE;
+      }
+    }
+    ostream& out = output_file.is_open() ? static_cast<ostream&>(output_file) : cout;
+
+    /* Export all messages of the stream as csv-lines */
+    {
+      csv::Writer csv_writer(out);
+      SegmentedRecordingReader::Query query = reader->query(1u << stream, start_stamp, end_stamp);
+      RecordedMessage msg;
+      while (query.next(msg))
+      {
+        if (!pb_msg->ParseFromArray(msg.data, static_cast<int>(msg.size)))
+          continue;
+
+        if (cnt_msgs == 0)
+        {
+          csv::Header h;
+          out << (h << *pb_msg) << endl;
+        }
+        csv_writer << *pb_msg;
+        ++cnt_msgs;
+      }
+    }
+
+    if (output_file.is_open())
+    {
+      output_file.close();
+      cout << "Exported " << cnt_msgs << " " << streams[stream].name << " messages to '" << out_file_name << "'."
+           << endl;
+    }
+  }
+  catch (exception& e)
+  {
+    cerr << "ERROR! " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
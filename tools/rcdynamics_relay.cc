@@ -0,0 +1,231 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <signal.h>
+#include <chrono>
+#include <iomanip>
+
+#include "rc_dynamics_api/remote_interface.h"
+#include "rc_dynamics_api/shm_ring.h"
+
+using namespace std;
+using namespace rc::dynamics;
+
+/**
+ * catching signals for proper program escape
+ */
+static bool caught_signal = false;
+void signal_callback_handler(int signum)
+{
+  printf("Caught signal %d, stopping program!\n", signum);
+  caught_signal = true;
+}
+
+/**
+ * Print usage of example including command line args
+ */
+void printUsage(char* arg)
+{
+  cout << "\nRequests a data stream of the specified rc_visard IP once and publishes "
+          "\nthe received messages into a shared memory ring, from which any number "
+          "\nof local processes can read them (see rc::dynamics::ShmRingReader)."
+       << "\n\nUsage: \n"
+       << arg << " -v <rcVisardIP> -s <stream> [-i <networkInterface>]"
+                 " [-m <shmName>][-n <numSlots>][-u <octalMode>][-p <statsPeriodSecs>]"
+       << "\n\n  -u <octalMode>  access permissions of the shared memory, default 0600 (only"
+          "\n                 this user), e.g. 0660 for permitting readers of the same group"
+       << endl;
+}
+
+int main(int argc, char* argv[])
+{
+  // Register signals and signal handler
+  signal(SIGINT, signal_callback_handler);
+  signal(SIGTERM, signal_callback_handler);
+
+  /**
+   * Parse program options (e.g. IP )
+   */
+  string visard_ip, network_iface = "", stream_name, shm_name;
+  unsigned int num_slots = 1024, stats_period_secs = 5, mode = 0600;
+  bool user_set_ip = false;
+  bool user_set_stream_type = false;
+
+  int i = 1;
+  while (i < argc)
+  {
+    std::string p = argv[i++];
+
+    if (p == "-s" && i < argc)
+    {
+      stream_name = string(argv[i++]);
+      user_set_stream_type = true;
+    }
+    else if (p == "-i" && i < argc)
+    {
+      network_iface = string(argv[i++]);
+    }
+    else if (p == "-v" && i < argc)
+    {
+      visard_ip = string(argv[i++]);
+      user_set_ip = true;
+    }
+    else if (p == "-m" && i < argc)
+    {
+      shm_name = string(argv[i++]);
+    }
+    else if (p == "-n" && i < argc)
+    {
+      num_slots = (unsigned int)std::max(1, atoi(argv[i++]));
+    }
+    else if (p == "-u" && i < argc)
+    {
+      mode = (unsigned int)strtoul(argv[i++], NULL, 8) & 0777;
+    }
+    else if (p == "-p" && i < argc)
+    {
+      stats_period_secs = (unsigned int)std::max(1, atoi(argv[i++]));
+    }
+    else if (p == "-h")
+    {
+      printUsage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+    else
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!user_set_ip)
+  {
+    cerr << "Please specify rc_visard IP." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (!user_set_stream_type)
+  {
+    cerr << "Please specify stream type." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (shm_name.empty())
+  {
+    shm_name = "/rcdynamics_" + stream_name;
+  }
+
+  /**
+   * Instantiate and connect RemoteInterface
+   */
+  cout << "connecting to rc_visard " << visard_ip << "..." << endl;
+  auto rc_dynamics = RemoteInterface::create(visard_ip);
+  try
+  {
+    while (!caught_signal && !rc_dynamics->checkSystemReady())
+    {
+      cout << "... system not yet ready. Trying again." << endl;
+      usleep(1000 * 500);
+    }
+    cout << "... connected!" << endl;
+  }
+  catch (exception& e)
+  {
+    cout << "ERROR! Could not connect to rc_dynamics module on rc_visard: " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  /**
+   * Request the data stream once and relay all messages into shared memory
+   */
+  uint64_t cnt_msgs = 0;
+  try
+  {
+    string pb_msg_type = rc_dynamics->getPbMsgTypeOfStream(stream_name);
+    auto writer = ShmRingWriter::create(shm_name, pb_msg_type, num_slots, 512, mode);
+
+    cout << "Initializing " << stream_name << " data stream..." << endl;
+    auto receiver = rc_dynamics->createReceiverForStream(stream_name, network_iface);
+
+    unsigned int timeout_millis = 100;
+    receiver->setTimeout(timeout_millis);
+    cout << "Relaying " << stream_name << " messages of type " << pb_msg_type << " to shared memory " << shm_name
+         << "..." << endl;
+
+    chrono::steady_clock::time_point last_stats = chrono::steady_clock::now();
+    uint64_t last_cnt_msgs = 0;
+    while (!caught_signal)
+    {
+      size_t size;
+      const char* data = receiver->receiveRaw(size);
+      chrono::steady_clock::time_point now = chrono::steady_clock::now();
+
+      if (data)
+      {
+        writer->publish(data, size, chrono::duration_cast<chrono::nanoseconds>(now.time_since_epoch()).count());
+        ++cnt_msgs;
+      }
+      else
+      {
+        cerr << "did not receive any data during last " << timeout_millis << " ms." << endl;
+      }
+
+      // print statistics of relay and all attached readers
+
+      chrono::duration<double> elapsed = now - last_stats;
+      if (elapsed.count() >= stats_period_secs)
+      {
+        cout << fixed << setprecision(1) << (cnt_msgs - last_cnt_msgs) / elapsed.count() << " msgs/s, "
+             << cnt_msgs << " msgs total";
+        for (auto&& r : writer->getReaders())
+        {
+          cout << " | reader " << r.pid << ": lag " << r.lag << ", overruns " << r.overruns;
+        }
+        cout << endl;
+
+        last_stats = now;
+        last_cnt_msgs = cnt_msgs;
+      }
+    }
+  }
+  catch (exception& e)
+  {
+    cout << "Caught exception during relaying, stopping: " << e.what() << endl;
+  }
+
+  cout << "Relayed " << cnt_msgs << " " << stream_name << " messages." << endl;
+
+  return EXIT_SUCCESS;
+}
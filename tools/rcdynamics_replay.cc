@@ -0,0 +1,402 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <signal.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "rc_dynamics_api/data_sender.h"
+#include "rc_dynamics_api/recording.h"
+
+#ifdef WIN32
+#include <winsock2.h>
+#undef max
+#undef min
+#endif
+
+using namespace std;
+using namespace rc::dynamics;
+
+/**
+ * catching signals for proper program escape
+ */
+static bool caught_signal = false;
+void signal_callback_handler(int signum)
+{
+  printf("Caught signal %d, stopping program!\n", signum);
+  caught_signal = true;
+}
+
+/**
+ * Print usage of example including command line args
+ */
+void printUsage(char* arg)
+{
+  cout << "\nReplays binary recordings of rcdynamics_stream (see -f bin) by sending "
+          "\nthe recorded messages via UDP. Messages of all given recordings are sent "
+          "\nin the order of their receive time stamps, either with the original timing, "
+          "\nscaled by a speed factor, or as fast as possible (speed 0)."
+       << "\n\nUsage: \n"
+       << arg << " -d [<stream>=]<destIP>:<destPort> [-d ...] [-x <speed>] [-l]"
+                 " [-p <statsPeriodSecs>] <recording> [<recording> ...]"
+       << endl;
+}
+
+/**
+ * Destination of one stream, given as [<stream>=]<ip>:<port>
+ */
+struct Destination
+{
+  string stream;  // empty for all streams without explicit destination
+  string ip;
+  unsigned int port;
+};
+
+bool parseDestination(const string& s, Destination& dest)
+{
+  size_t eq = s.find('=');
+  size_t colon = s.rfind(':');
+  if (colon == string::npos || (eq != string::npos && eq > colon))
+  {
+    return false;
+  }
+
+  size_t ip_start = (eq == string::npos) ? 0 : eq + 1;
+  dest.stream = (eq == string::npos) ? "" : s.substr(0, eq);
+  dest.ip = s.substr(ip_start, colon - ip_start);
+  dest.port = static_cast<unsigned int>(atoi(s.c_str() + colon + 1));
+  return dest.port > 0 && dest.port < 65536;
+}
+
+/**
+ * A stream of a recording that is replayed
+ */
+struct ReplayedStream
+{
+  string name;
+  DataSender::Ptr sender;  // NULL if stream is not replayed
+  uint64_t cnt_msgs;
+};
+
+/**
+ * A recording that is replayed with a cursor at its next message
+ */
+struct Replay
+{
+  RecordingReader::Ptr reader;
+  RecordingReader::Cursor cursor;
+  RecordedMessage next;
+  bool has_next;
+  vector<size_t> streams;  // index into list of all replayed streams
+};
+
+/**
+ * Waits until the given time. Sleeping is only done for longer durations,
+ * as its resolution is too coarse for high message rates.
+ */
+void waitUntil(chrono::steady_clock::time_point t)
+{
+  chrono::steady_clock::time_point now = chrono::steady_clock::now();
+  if (t - now > chrono::microseconds(1000))
+  {
+    this_thread::sleep_for(t - now - chrono::microseconds(500));
+  }
+
+  while (chrono::steady_clock::now() < t)
+  {
+    this_thread::yield();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef WIN32
+  WSADATA wsaData;
+  WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+
+  // Register signals and signal handler
+  signal(SIGINT, signal_callback_handler);
+  signal(SIGTERM, signal_callback_handler);
+
+  /**
+   * Parse program options
+   */
+  vector<Destination> destinations;
+  vector<string> file_names;
+  double speed = 1;
+  unsigned int stats_period_secs = 5;
+  bool loop = false;
+
+  int i = 1;
+  while (i < argc)
+  {
+    std::string p = argv[i++];
+
+    if (p == "-d" && i < argc)
+    {
+      Destination dest;
+      if (!parseDestination(argv[i++], dest))
+      {
+        cerr << "Invalid destination: " << argv[i - 1] << endl;
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+      destinations.push_back(dest);
+    }
+    else if (p == "-x" && i < argc)
+    {
+      speed = std::max(0.0, atof(argv[i++]));
+    }
+    else if (p == "-l")
+    {
+      loop = true;
+    }
+    else if (p == "-p" && i < argc)
+    {
+      stats_period_secs = (unsigned int)std::max(1, atoi(argv[i++]));
+    }
+    else if (p == "-h")
+    {
+      printUsage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+    else if (p.size() > 0 && p[0] != '-')
+    {
+      file_names.push_back(p);
+    }
+    else
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (destinations.empty())
+  {
+    cerr << "Please specify a destination." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (file_names.empty())
+  {
+    cerr << "Please specify a recording." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  /**
+   * Open all recordings and assign destinations to their streams
+   */
+  vector<ReplayedStream> streams;
+  vector<Replay> replays;
+  int64_t start_stamp = 0, end_stamp = 0;
+  uint64_t total_msgs = 0;
+  try
+  {
+    for (auto&& file_name : file_names)
+    {
+      RecordingReader::Ptr reader = RecordingReader::open(file_name);
+      Replay replay = { reader, reader->cursor(), RecordedMessage(), false, vector<size_t>() };
+
+      for (auto&& s : reader->getStreams())
+      {
+        ReplayedStream stream = { s.name, DataSender::Ptr(), 0 };
+        for (auto&& dest : destinations)
+        {
+          if (dest.stream == s.name || (dest.stream.empty() && !stream.sender))
+          {
+            stream.sender = DataSender::create(dest.ip, dest.port);
+          }
+        }
+
+        if (stream.sender)
+        {
+          cout << "Replaying " << s.name << " stream of '" << file_name << "' (" << s.pb_msg_type << ") to "
+               << stream.sender->getIpAddress() << ":" << stream.sender->getPort() << endl;
+        }
+        else
+        {
+          cout << "Skipping " << s.name << " stream of '" << file_name << "' without destination" << endl;
+        }
+
+        replay.streams.push_back(streams.size());
+        streams.push_back(stream);
+      }
+
+      if (!reader->isComplete())
+      {
+        cout << "WARN: Recording '" << file_name << "' has not been closed properly" << endl;
+      }
+
+      if (reader->getMessageCount() > 0)
+      {
+        if (total_msgs == 0 || reader->getStartTime() < start_stamp)
+          start_stamp = reader->getStartTime();
+        if (total_msgs == 0 || reader->getEndTime() > end_stamp)
+          end_stamp = reader->getEndTime();
+        total_msgs += reader->getMessageCount();
+      }
+
+      replay.has_next = replay.cursor.next(replay.next);
+      replays.push_back(replay);
+    }
+  }
+  catch (exception& e)
+  {
+    cout << "ERROR! Could not open recordings: " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (total_msgs == 0)
+  {
+    cout << "Recordings are empty." << endl;
+    return EXIT_SUCCESS;
+  }
+
+  // when looping, the next pass starts one average message period after the end
+  int64_t pass_duration = end_stamp - start_stamp;
+  pass_duration += pass_duration / static_cast<int64_t>(total_msgs);
+
+  /**
+   * Send all messages in the order of their time stamps
+   */
+  uint64_t cnt_msgs = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  try
+  {
+    chrono::steady_clock::time_point last_stats = start;
+    uint64_t last_cnt_msgs = 0;
+    int64_t max_late_ns = 0;
+    int64_t offset = 0;  // offset of the current pass to the recorded time stamps
+    while (!caught_signal)
+    {
+      // find the recording with the earliest next message
+
+      Replay* replay = 0;
+      for (auto&& r : replays)
+      {
+        if (r.has_next && (!replay || r.next.host_stamp < replay->next.host_stamp))
+        {
+          replay = &r;
+        }
+      }
+
+      if (!replay)
+      {
+        if (!loop)
+        {
+          break;
+        }
+
+        for (auto&& r : replays)
+        {
+          r.cursor.rewind();
+          r.has_next = r.cursor.next(r.next);
+        }
+        offset += pass_duration;
+        continue;
+      }
+
+      // wait until the scheduled time of the message
+
+      const RecordedMessage& msg = replay->next;
+      if (speed > 0)
+      {
+        chrono::steady_clock::time_point t =
+            start + chrono::nanoseconds(static_cast<int64_t>((msg.host_stamp + offset - start_stamp) / speed));
+        waitUntil(t);
+        max_late_ns = std::max(
+            max_late_ns,
+            static_cast<int64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t).count()));
+      }
+
+      if (msg.stream < replay->streams.size())
+      {
+        ReplayedStream& stream = streams[replay->streams[msg.stream]];
+        if (stream.sender)
+        {
+          stream.sender->send(msg.data, msg.size);
+          ++stream.cnt_msgs;
+          ++cnt_msgs;
+        }
+      }
+
+      replay->has_next = replay->cursor.next(replay->next);
+
+      // print achieved send rate
+
+      chrono::steady_clock::time_point now = chrono::steady_clock::now();
+      if (now - last_stats >= chrono::seconds(stats_period_secs))
+      {
+        double secs = chrono::duration<double>(now - last_stats).count();
+        cout << "sent " << fixed << setprecision(1) << (cnt_msgs - last_cnt_msgs) / secs << " msgs/s";
+        if (speed > 0)
+        {
+          cout << ", max delay " << setprecision(3) << max_late_ns * 1e-6 << " ms";
+        }
+        cout << endl;
+
+        last_stats = now;
+        last_cnt_msgs = cnt_msgs;
+        max_late_ns = 0;
+      }
+    }
+  }
+  catch (exception& e)
+  {
+    cout << "Caught exception during replay, stopping: " << e.what() << endl;
+  }
+
+  double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  cout << "Sent " << cnt_msgs << " messages in " << fixed << setprecision(3) << secs << " s ("
+       << setprecision(1) << (secs > 0 ? cnt_msgs / secs : 0.0) << " msgs/s)" << endl;
+  for (auto&& s : streams)
+  {
+    if (s.sender)
+    {
+      cout << "  " << s.name << ": " << s.cnt_msgs << " messages" << endl;
+    }
+  }
+
+#ifdef WIN32
+  ::WSACleanup();
+#endif
+
+  return EXIT_SUCCESS;
+}
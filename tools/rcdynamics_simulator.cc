@@ -0,0 +1,197 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <signal.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "visard_simulator.h"
+
+using namespace std;
+using namespace rc::dynamics;
+
+/**
+ * catching signals for proper program escape
+ */
+static bool caught_signal = false;
+void signal_callback_handler(int signum)
+{
+  printf("Caught signal %d, stopping program!\n", signum);
+  caught_signal = true;
+}
+
+/**
+ * Print usage of example including command line args
+ */
+void printUsage(char* arg)
+{
+  cout << "\nSimulates an rc_visard for testing and benchmarking without hardware. The REST-API "
+          "\nendpoints used by RemoteInterface are served and synthetic messages are streamed "
+          "\nvia UDP to all registered destinations, as long as rc_dynamics is running. The "
+          "\nsimulator can be used e.g. with: rcdynamics_stream -v <ip>:<port> -s imu"
+       << "\n\nUsage: \n"
+       << arg << " [-a <ip>] [-p <port>] [-r <stream>=<rate> ...] [-l <ms>] [-j <ms>] [-q <rate>] [-m <rate>]"
+                 " [-f <version>] [-s <state>] [-t <secs>]"
+       << "\n\n -a <ip>              IP address of the REST-API, default 127.0.0.1"
+          "\n -p <port>            Port of the REST-API, default 8080"
+          "\n -r <stream>=<rate>   Messages per second of a stream, 0 for disabling it"
+          "\n -l <ms>              Latency of REST-API responses"
+          "\n -j <ms>              Maximum additional random latency of REST-API responses"
+          "\n -q <rate>            Probability of rejecting REST-API requests with 429 (too many requests)"
+          "\n -m <rate>            Maximum number of REST-API requests per second, beyond requests are"
+          "\n                      rejected with 429"
+          "\n -f <version>         Firmware version, default v1.6.0"
+          "\n -s <state>           Initial state of rc_dynamics, default RUNNING"
+          "\n -t <secs>            Stop after the given time, default runs until interrupted"
+       << endl;
+}
+
+int main(int argc, char* argv[])
+{
+  // Register signals and signal handler
+  signal(SIGINT, signal_callback_handler);
+  signal(SIGTERM, signal_callback_handler);
+
+  /**
+   * Parse program options
+   */
+  VisardSimulator::Config config;
+  vector<pair<string, double>> rates;
+  string ip = "127.0.0.1", state = "RUNNING";
+  unsigned int port = 8080;
+  double max_secs = 0;
+
+  int i = 1;
+  while (i < argc)
+  {
+    std::string p = argv[i++];
+
+    if (p == "-a" && i < argc)
+    {
+      ip = argv[i++];
+    }
+    else if (p == "-p" && i < argc)
+    {
+      port = static_cast<unsigned int>(atoi(argv[i++]));
+    }
+    else if (p == "-r" && i < argc)
+    {
+      string s = argv[i++];
+      size_t eq = s.find('=');
+      if (eq == string::npos)
+      {
+        cerr << "Invalid rate: " << s << endl;
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+      rates.push_back(make_pair(s.substr(0, eq), atof(s.c_str() + eq + 1)));
+    }
+    else if (p == "-l" && i < argc)
+    {
+      config.latency_ms = static_cast<unsigned int>(max(0, atoi(argv[i++])));
+    }
+    else if (p == "-j" && i < argc)
+    {
+      config.latency_jitter_ms = static_cast<unsigned int>(max(0, atoi(argv[i++])));
+    }
+    else if (p == "-q" && i < argc)
+    {
+      config.too_many_requests_rate = atof(argv[i++]);
+    }
+    else if (p == "-m" && i < argc)
+    {
+      config.max_requests_per_sec = static_cast<unsigned int>(max(0, atoi(argv[i++])));
+    }
+    else if (p == "-f" && i < argc)
+    {
+      config.firmware_version = argv[i++];
+    }
+    else if (p == "-s" && i < argc)
+    {
+      state = argv[i++];
+    }
+    else if (p == "-t" && i < argc)
+    {
+      max_secs = atof(argv[i++]);
+    }
+    else if (p == "-h")
+    {
+      printUsage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+    else
+    {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  try
+  {
+    VisardSimulator::Ptr simulator = VisardSimulator::create(ip, port, config);
+    for (auto&& r : rates)
+    {
+      simulator->setRate(r.first, r.second);
+    }
+    simulator->setDynamicsState(state);
+
+    cout << "Simulated rc_visard is listening on " << simulator->getAddress() << endl;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    VisardSimulator::Statistics last = simulator->getStatistics();
+    while (!caught_signal && (max_secs <= 0 || chrono::steady_clock::now() - start < chrono::duration<double>(max_secs)))
+    {
+      this_thread::sleep_for(chrono::seconds(1));
+
+      VisardSimulator::Statistics stats = simulator->getStatistics();
+      if (stats.requests != last.requests || stats.messages != last.messages)
+      {
+        cout << "requests: " << stats.requests - last.requests << " (" << stats.rejected - last.rejected
+             << " rejected), messages: " << stats.messages - last.messages << " (" << stats.send_errors - last.send_errors
+             << " errors)" << endl;
+      }
+      last = stats;
+    }
+
+    simulator->stop();
+  }
+  catch (exception& e)
+  {
+    cerr << "ERROR! " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -39,12 +39,17 @@
 #include <iomanip>
 
 #include "rc_dynamics_api/remote_interface.h"
+#include "rc_dynamics_api/async_recording_writer.h"
+#include "rc_dynamics_api/segmented_recording.h"
+#include "rc_dynamics_api/tracing.h"
 #include "csv_printing.h"
 
 #ifdef WIN32
 #include <winsock2.h>
 #undef max
 #undef min
+#else
+#include "rc_dynamics_api/metrics_server.h"
 #endif
 
 using namespace std;
@@ -67,10 +72,18 @@ void printUsage(char* arg)
 {
   cout << "\nLists available rcdynamics data streams of the specified rc_visard IP, "
           "\nor requests a data stream and either prints received messages or records "
-          "\nthem as csv-file, see -o option."
+          "\nthem as csv-file or binary recording, see -o and -f options. Several "
+          "\nstreams can be requested at once with multiple -s options, which are "
+          "\nthen recorded into one binary recording. Long binary recordings can be "
+          "\nsplit into segments of limited size (-S) or duration (-T), which are listed "
+          "\nin a manifest <output_file>.json. With -m, the metrics of receiving are "
+          "\nserved for Prometheus on http://127.0.0.1:<metricsPort>/metrics (not on Windows)."
+          "\nWith -x, the trace points of receiving are written as Chrome trace, if "
+          "\ncompiled with ENABLE_TRACING."
        << "\n\nUsage: \n"
-       << arg << " -v <rcVisardIP> -l | -s <stream> [-a] [-i <networkInterface>]"
-                 " [-n <maxNumData>][-t <maxRecTimeSecs>][-o <output_file>]"
+       << arg << " -v <rcVisardIP> -l | -s <stream> [-s <stream> ...] [-a] [-i <networkInterface>]"
+                 " [-n <maxNumData>][-t <maxRecTimeSecs>][-o <output_file> [-f csv|bin] [-d]"
+                 " [-S <maxSegmentMB>] [-T <maxSegmentSecs>]] [-m <metricsPort>] [-x <traceFile>]"
        << endl;
 }
 
@@ -88,7 +101,8 @@ int main(int argc, char* argv[])
   /**
    * Parse program options (e.g. IP )
    */
-  string out_file_name, visard_ip, network_iface = "", stream_name;
+  string out_file_name, out_format = "csv", visard_ip, network_iface = "", trace_file_name;
+  vector<string> stream_names;
   unsigned int max_num_recording = 50, max_secs_recording = 5;
   bool user_autostart = false;
   bool user_set_out_file = false;
@@ -97,6 +111,9 @@ int main(int argc, char* argv[])
   bool user_set_ip = false;
   bool user_set_stream_type = false;
   bool only_list_streams = false;
+  bool direct_io = false;
+  unsigned int max_segment_mb = 0, max_segment_secs = 0;
+  unsigned int metrics_port = 0;
 
   int i = 1;
   while (i < argc)
@@ -109,7 +126,7 @@ int main(int argc, char* argv[])
     }
     else if (p == "-s" && i < argc)
     {
-      stream_name = string(argv[i++]);
+      stream_names.push_back(string(argv[i++]));
       user_set_stream_type = true;
     }
     else if (p == "-a")
@@ -140,6 +157,30 @@ int main(int argc, char* argv[])
       out_file_name = string(argv[i++]);
       user_set_out_file = true;
     }
+    else if (p == "-f" && i < argc)
+    {
+      out_format = string(argv[i++]);
+    }
+    else if (p == "-d")
+    {
+      direct_io = true;
+    }
+    else if (p == "-S" && i < argc)
+    {
+      max_segment_mb = (unsigned int)std::max(0, atoi(argv[i++]));
+    }
+    else if (p == "-T" && i < argc)
+    {
+      max_segment_secs = (unsigned int)std::max(0, atoi(argv[i++]));
+    }
+    else if (p == "-m" && i < argc)
+    {
+      metrics_port = (unsigned int)std::max(0, atoi(argv[i++]));
+    }
+    else if (p == "-x" && i < argc)
+    {
+      trace_file_name = string(argv[i++]);
+    }
     else if (p == "-h")
     {
       printUsage(argv[0]);
@@ -166,6 +207,64 @@ int main(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  if (out_format != "csv" && out_format != "bin")
+  {
+    cerr << "Unknown output format '" << out_format << "'." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (out_format == "bin" && !user_set_out_file)
+  {
+    cerr << "Binary format requires an output file." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool segmented = (max_segment_mb > 0 || max_segment_secs > 0);
+  if (segmented && out_format != "bin")
+  {
+    cerr << "Only binary recordings can be split into segments." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (segmented)
+  {
+    // the output file name is the base name of the manifest and segments
+    if (out_file_name.size() > 4 && out_file_name.compare(out_file_name.size() - 4, 4, ".bin") == 0)
+    {
+      out_file_name.resize(out_file_name.size() - 4);
+    }
+  }
+
+  if (out_format == "csv" && user_set_out_file && stream_names.size() > 1)
+  {
+    cerr << "Several streams can only be recorded in binary format." << endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (stream_names.size() > RecordingWriter::MAX_STREAMS)
+  {
+    cerr << "At most " << RecordingWriter::MAX_STREAMS << " streams can be requested at once." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // 'imu' stream works regardless if the rc_dynamics module is running
+  bool needs_dynamics = false;
+  for (auto&& s : stream_names)
+  {
+    needs_dynamics = needs_dynamics || s != "imu";
+  }
+
+#ifndef RC_DYNAMICS_TRACING
+  if (!trace_file_name.empty())
+  {
+    cerr << "WARN: Trace points are not compiled in, the trace will be empty" << endl;
+  }
+#endif
+
   if (!user_set_max_num_msgs && !user_set_max_recording_time)
   {
     user_set_max_num_msgs = true;
@@ -175,7 +274,7 @@ int main(int argc, char* argv[])
    * open file for recording if required
    */
   ofstream output_file;
-  if (user_set_out_file)
+  if (user_set_out_file && out_format == "csv")
   {
     output_file.open(out_file_name);
     if (!output_file.is_open())
@@ -185,6 +284,23 @@ int main(int argc, char* argv[])
     }
   }
 
+#ifndef WIN32
+  MetricsServer::Ptr metrics_server;
+  if (metrics_port > 0)
+  {
+    try
+    {
+      metrics_server = MetricsServer::create(MetricsRegistry::getDefault(), metrics_port);
+      cout << "serving metrics on http://127.0.0.1:" << metrics_server->getPort() << "/metrics" << endl;
+    }
+    catch (exception& e)
+    {
+      cerr << "Could not serve metrics: " << e.what() << endl;
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+
   /**
    * Instantiate and connect RemoteInterface
    */
@@ -237,7 +353,7 @@ int main(int argc, char* argv[])
   }
 
   /* For all streams except 'imu' the rc_dynamcis node has to be started */
-  if (user_autostart && stream_name != "imu")
+  if (user_autostart && needs_dynamics)
   {
     try
     {
@@ -262,48 +378,140 @@ int main(int argc, char* argv[])
   }
 
   /**
-   * Request a data stream and start receiving as well as processing the data
+   * Request the data streams and start receiving as well as processing the data
    */
   unsigned int cnt_msgs = 0;
-  try
+  string stream_list;
+  for (auto&& s : stream_names)
   {
-    cout << "Initializing " << stream_name << " data stream..." << endl;
-    auto receiver = rc_dynamics->createReceiverForStream(stream_name, network_iface);
+    stream_list += (stream_list.empty() ? "" : ", ") + s;
+  }
 
+  try
+  {
     unsigned int timeout_millis = 100;
-    receiver->setTimeout(timeout_millis);
-    cout << "Listening for " << stream_name << " messages..." << endl;
+    vector<DataReceiver::Ptr> receivers;
+    vector<RecordingStream> streams;
+    for (auto&& s : stream_names)
+    {
+      cout << "Initializing " << s << " data stream..." << endl;
+      receivers.push_back(rc_dynamics->createReceiverForStream(s, network_iface));
+      receivers.back()->setTimeout(timeout_millis);
+      streams.push_back({ s, rc_dynamics->getPbMsgTypeOfStream(s) });
+    }
+
+    // binary recording stores the received datagrams as they are, without
+    // de-serializing them, and writes them in a separate thread, so that
+    // slow storage does not delay receiving
+    AsyncRecordingWriter::Ptr recording;
+    unique_ptr<csv::Writer> csv_writer;
+    if (out_format == "bin" && segmented)
+    {
+      auto writer = SegmentedRecordingWriter::create(out_file_name, streams, max_segment_mb * 1024ull * 1024,
+                                                     max_segment_secs * 1000, 65536, direct_io);
+      recording = AsyncRecordingWriter::create(writer);
+      out_file_name = writer->getManifestFilename();
+    }
+    else if (out_format == "bin")
+    {
+      recording = AsyncRecordingWriter::create(out_file_name, streams, 8192, direct_io);
+    }
+    else if (output_file.is_open())
+    {
+      csv_writer.reset(new csv::Writer(output_file));
+    }
+
+    cout << "Listening for " << stream_list << " messages..." << endl;
 
     chrono::time_point<chrono::system_clock> start = chrono::system_clock::now();
     chrono::duration<double> elapsed_secs(0);
+    uint64_t last_dropped = 0;
+    double last_warning_secs = 0;
+    int64_t last_host_stamp = 0;
     while (!caught_signal && (!user_set_max_num_msgs || cnt_msgs < max_num_recording) &&
            (!user_set_max_recording_time || elapsed_secs.count() < max_secs_recording))
     {
-      auto msg = receiver->receive(rc_dynamics->getPbMsgTypeOfStream(stream_name));
-      if (msg)
+      // wait for messages of any of the streams
+      vector<size_t> ready = DataReceiver::select(receivers, timeout_millis);
+
+      for (size_t k : ready)
       {
-        if (output_file.is_open())
+        if (recording)
         {
-          if (cnt_msgs == 0)
+          size_t size;
+          const char* data = receivers[k]->receiveRaw(size);
+          if (data)
           {
-            csv::Header h;
-            output_file << (h << *msg) << endl;
+            // keep the recording ordered in time, even if the system clock is set back
+            int64_t host_stamp =
+                chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+            host_stamp = std::max(host_stamp, last_host_stamp);
+            last_host_stamp = host_stamp;
+
+            recording->write(static_cast<uint16_t>(k), host_stamp, data, size);
+            ++cnt_msgs;
           }
-          csv::Line l;
-          output_file << (l << *msg) << endl;
         }
         else
         {
-          cout << "received " << stream_name << " msg:" << endl << msg->DebugString() << endl;
+          auto msg = receivers[k]->receive(streams[k].pb_msg_type);
+          if (msg)
+          {
+            if (csv_writer)
+            {
+              if (cnt_msgs == 0)
+              {
+                csv::Header h;
+                output_file << (h << *msg) << endl;
+              }
+              *csv_writer << *msg;
+            }
+            else
+            {
+              cout << "received " << streams[k].name << " msg:" << endl << msg->DebugString() << endl;
+            }
+            ++cnt_msgs;
+          }
+        }
+      }
+
+      if (recording)
+      {
+        // warn if storage cannot keep up
+        AsyncRecordingStats stats = recording->getStats();
+        if (elapsed_secs.count() - last_warning_secs >= 1 &&
+            (stats.dropped > last_dropped || stats.queued > stats.capacity / 2))
+        {
+          cerr << "WARN: storage too slow, " << stats.queued << " messages queued, " << stats.dropped
+               << " dropped, longest write took " << stats.max_stall_ms << " ms" << endl;
+          last_dropped = stats.dropped;
+          last_warning_secs = elapsed_secs.count();
         }
-        ++cnt_msgs;
       }
-      else
+
+      if (ready.empty())
       {
         cerr << "did not receive any data during last " << timeout_millis << " ms." << endl;
       }
       elapsed_secs = chrono::system_clock::now() - start;
     }
+
+    if (recording)
+    {
+      recording->close();
+
+      AsyncRecordingStats stats = recording->getStats();
+      if (stats.dropped > 0)
+      {
+        cerr << "WARN: " << stats.dropped << " messages have been dropped, as storage was too slow" << endl;
+      }
+      cnt_msgs = static_cast<unsigned int>(stats.written);
+    }
+
+    if (csv_writer)
+    {
+      csv_writer->flush();
+    }
   }
   catch (exception& e)
   {
@@ -314,7 +522,7 @@ int main(int argc, char* argv[])
    * Stopping streaming and clean-up
    * 'imu' stream works regardless if the rc_dynamics module is running, so no need to stop it
    */
-  if (user_autostart && stream_name != "imu")
+  if (user_autostart && needs_dynamics)
   {
     try
     {
@@ -327,14 +535,31 @@ int main(int argc, char* argv[])
     }
   }
 
-  if (output_file.is_open())
+  if (out_format == "bin")
+  {
+    cout << "Recorded " << cnt_msgs << " " << stream_list << " messages to '" << out_file_name << "'." << endl;
+  }
+  else if (output_file.is_open())
   {
     output_file.close();
-    cout << "Recorded " << cnt_msgs << " " << stream_name << " messages to '" << out_file_name << "'." << endl;
+    cout << "Recorded " << cnt_msgs << " " << stream_list << " messages to '" << out_file_name << "'." << endl;
   }
   else
   {
-    cout << "Received  " << cnt_msgs << " " << stream_name << " messages." << endl;
+    cout << "Received  " << cnt_msgs << " " << stream_list << " messages." << endl;
+  }
+
+  if (!trace_file_name.empty())
+  {
+    try
+    {
+      Tracer::get().writeChromeTrace(trace_file_name);
+      cout << "Wrote trace to '" << trace_file_name << "'." << endl;
+    }
+    catch (exception& e)
+    {
+      cerr << e.what() << endl;
+    }
   }
 
 #ifdef WIN32
@@ -0,0 +1,1105 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "visard_simulator.h"
+
+#include "rc_dynamics_api/json.hpp"
+#include "rc_dynamics_api/socket_exception.h"
+#include "roboception/msgs/frame.pb.h"
+#include "roboception/msgs/dynamics.pb.h"
+#include "roboception/msgs/imu.pb.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+namespace rc
+{
+namespace dynamics
+{
+namespace
+{
+/// Angular speed of the simulated motion on a circle of 1 m radius, in rad/s
+const double omega = 0.5;
+
+/// Maximum number of poses returned by get_trajectory
+const int max_trajectory_poses = 10000;
+
+void setTime(roboception::msgs::Time* time, int64_t stamp)
+{
+  time->set_sec(static_cast<int32_t>(stamp / 1000000000));
+  time->set_nsec(static_cast<int32_t>(stamp % 1000000000));
+}
+
+void setPose(roboception::msgs::Pose* pose, double t)
+{
+  double a = omega * t;
+  pose->mutable_position()->set_x(std::cos(a));
+  pose->mutable_position()->set_y(std::sin(a));
+  pose->mutable_position()->set_z(0.1 * std::sin(0.1 * a));
+  pose->mutable_orientation()->set_x(0);
+  pose->mutable_orientation()->set_y(0);
+  pose->mutable_orientation()->set_z(std::sin(a / 2));
+  pose->mutable_orientation()->set_w(std::cos(a / 2));
+}
+
+json toJson(int64_t stamp)
+{
+  json js;
+  js["sec"] = stamp / 1000000000;
+  js["nsec"] = stamp % 1000000000;
+  return js;
+}
+
+json toJson(const roboception::msgs::Pose& pose)
+{
+  json js;
+  js["position"]["x"] = pose.position().x();
+  js["position"]["y"] = pose.position().y();
+  js["position"]["z"] = pose.position().z();
+  js["orientation"]["x"] = pose.orientation().x();
+  js["orientation"]["y"] = pose.orientation().y();
+  js["orientation"]["z"] = pose.orientation().z();
+  js["orientation"]["w"] = pose.orientation().w();
+  return js;
+}
+
+/**
+ * Returns the time stamp of a time given as argument of get_trajectory in
+ * nanoseconds since epoch, resolving relative times with respect to the
+ * start or end of the trajectory.
+ */
+int64_t getTrajectoryTime(const json& args, const std::string& name, int64_t start, int64_t end, bool is_end)
+{
+  json::const_iterator it = args.find(name);
+  if (it == args.end())
+  {
+    return is_end ? end : start;
+  }
+
+  int64_t t = it->value("sec", 0ll) * 1000000000ll + it->value("nsec", 0ll);
+  if (!args.value(name + "_relative", false))
+  {
+    return t;
+  }
+
+  // positive values are relative to the start, negative values to the end
+  return (t < 0 || (t == 0 && is_end)) ? end + t : start + t;
+}
+
+bool parseDestination(const std::string& destination, sockaddr_in& addr)
+{
+  std::size_t colon = destination.rfind(':');
+  if (colon == std::string::npos)
+  {
+    return false;
+  }
+
+  int port = atoi(destination.c_str() + colon + 1);
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  return port > 0 && port < 65536 && inet_pton(AF_INET, destination.substr(0, colon).c_str(), &addr.sin_addr) == 1;
+}
+
+const char* getReason(int status)
+{
+  switch (status)
+  {
+    case 200:
+      return "OK";
+    case 400:
+      return "Bad Request";
+    case 403:
+      return "Forbidden";
+    case 404:
+      return "Not Found";
+    case 405:
+      return "Method Not Allowed";
+    case 429:
+      return "Too Many Requests";
+    default:
+      return "Internal Server Error";
+  }
+}
+
+/// Returns true if the firmware version, e.g. "v1.6.0", is before the given major and minor version
+bool isVersionBefore(const std::string& version, int major, int minor)
+{
+  int a = 0, b = 0;
+  if (sscanf(version.c_str(), "v%d.%d", &a, &b) != 2)
+  {
+    return false;
+  }
+  return a < major || (a == major && b < minor);
+}
+
+std::string toLower(std::string s)
+{
+  std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+  return s;
+}
+
+std::string errorMessage(const std::string& message)
+{
+  json js;
+  js["message"] = message;
+  return js.dump();
+}
+}
+
+VisardSimulator::Config::Config()
+  : firmware_version("v1.6.0")
+  , latency_ms(0)
+  , latency_jitter_ms(0)
+  , too_many_requests_rate(0)
+  , max_requests_per_sec(0)
+  , max_destinations(10)
+  , seed(42)
+{
+}
+
+std::vector<VisardSimulator::Stream> VisardSimulator::getDefaultStreams()
+{
+  return { { "dynamics", "Dynamics", 200 }, { "dynamics_ins", "Dynamics", 200 }, { "imu", "Imu", 200 },
+           { "pose", "Frame", 25 },         { "pose_ins", "Frame", 25 },         { "pose_rt", "Frame", 200 },
+           { "pose_rt_ins", "Frame", 200 } };
+}
+
+VisardSimulator::Ptr VisardSimulator::create(const std::string& ip_address, unsigned int port, const Config& config,
+                                             const std::vector<Stream>& streams)
+{
+  return Ptr(new VisardSimulator(ip_address, port, config, streams));
+}
+
+VisardSimulator::VisardSimulator(const std::string& ip_address, unsigned int port, const Config& config,
+                                 const std::vector<Stream>& streams)
+  : ip_(ip_address)
+  , port_(port)
+  , listen_fd_(-1)
+  , send_fd_(-1)
+  , config_(config)
+  , dynamics_state_("RUNNING")
+  , rng_(config.seed)
+  , start_(std::chrono::steady_clock::now())
+  , start_stamp_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::system_clock::now().time_since_epoch()).count())
+  , running_(true)
+  , num_requests_(0)
+  , num_rejected_(0)
+  , num_messages_(0)
+  , num_send_errors_(0)
+  , next_connection_(0)
+{
+  for (auto&& s : streams)
+  {
+    StreamState state;
+    state.stream = s;
+    streams_.push_back(state);
+  }
+
+  // socket for the REST-API
+
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  if (inet_pton(AF_INET, ip_address.c_str(), &addr.sin_addr) != 1)
+  {
+    throw std::invalid_argument("Given IP address is not a valid address: " + ip_address);
+  }
+
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  send_fd_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (listen_fd_ < 0 || send_fd_ < 0)
+  {
+    int e = errno;
+    stop();
+    throw SocketException("Error while creating socket!", e);
+  }
+
+  // multicast destinations are served via the interface of the REST-API,
+  // including receivers on this host
+
+  if (addr.sin_addr.s_addr != htonl(INADDR_ANY))
+  {
+    setsockopt(send_fd_, IPPROTO_IP, IP_MULTICAST_IF, &addr.sin_addr, sizeof(addr.sin_addr));
+  }
+  unsigned char loop = 1;
+  setsockopt(send_fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+
+  int on = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(listen_fd_, 64) < 0)
+  {
+    int e = errno;
+    stop();
+    throw SocketException("Error while binding socket!", e);
+  }
+
+  socklen_t len = sizeof(addr);
+  getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+  port_ = ntohs(addr.sin_port);
+
+  serve_thread_ = std::thread(&VisardSimulator::serve, this);
+  stream_thread_ = std::thread(&VisardSimulator::stream, this);
+}
+
+VisardSimulator::~VisardSimulator()
+{
+  stop();
+}
+
+std::string VisardSimulator::getAddress() const
+{
+  return ip_ + ":" + std::to_string(port_);
+}
+
+void VisardSimulator::setConfig(const Config& config)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  config_ = config;
+}
+
+VisardSimulator::Config VisardSimulator::getConfig() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return config_;
+}
+
+void VisardSimulator::setRate(const std::string& stream, double rate)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  for (auto&& s : streams_)
+  {
+    if (s.stream.name == stream)
+    {
+      s.stream.rate = std::max(0.0, rate);
+      cond_.notify_all();
+      return;
+    }
+  }
+  throw std::invalid_argument("Unknown stream: " + stream);
+}
+
+void VisardSimulator::setDynamicsState(const std::string& state)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  dynamics_state_ = state;
+}
+
+std::string VisardSimulator::getDynamicsState() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return dynamics_state_;
+}
+
+std::vector<std::string> VisardSimulator::getDestinations(const std::string& stream) const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  for (auto&& s : streams_)
+  {
+    if (s.stream.name == stream)
+    {
+      return s.destinations;
+    }
+  }
+  return std::vector<std::string>();
+}
+
+void VisardSimulator::clearDestinations()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  for (auto&& s : streams_)
+  {
+    s.destinations.clear();
+    s.addresses.clear();
+  }
+}
+
+VisardSimulator::Statistics VisardSimulator::getStatistics() const
+{
+  Statistics ret;
+  ret.requests = num_requests_;
+  ret.rejected = num_rejected_;
+  ret.messages = num_messages_;
+  ret.send_errors = num_send_errors_;
+  return ret;
+}
+
+void VisardSimulator::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    running_ = false;
+    cond_.notify_all();
+
+    // wake up all threads that wait for data
+    for (auto&& c : connections_)
+    {
+      shutdown(c.second.fd, SHUT_RDWR);
+    }
+  }
+
+  if (serve_thread_.joinable())
+  {
+    serve_thread_.join();
+  }
+
+  if (stream_thread_.joinable())
+  {
+    stream_thread_.join();
+  }
+
+  for (auto&& c : connections_)
+  {
+    c.second.thread.join();
+    close(c.second.fd);
+  }
+  connections_.clear();
+  finished_.clear();
+
+  if (listen_fd_ >= 0)
+  {
+    close(listen_fd_);
+    listen_fd_ = -1;
+  }
+
+  if (send_fd_ >= 0)
+  {
+    close(send_fd_);
+    send_fd_ = -1;
+  }
+}
+
+void VisardSimulator::serve()
+{
+  while (running_)
+  {
+    // join threads of closed connections
+
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      for (uint64_t id : finished_)
+      {
+        auto it = connections_.find(id);
+        if (it != connections_.end())
+        {
+          it->second.thread.join();
+          close(it->second.fd);
+          connections_.erase(it);
+        }
+      }
+      finished_.clear();
+    }
+
+    // wait for new connections, with timeout for checking if stopped
+
+    pollfd p;
+    p.fd = listen_fd_;
+    p.events = POLLIN;
+    if (poll(&p, 1, 100) <= 0)
+    {
+      continue;
+    }
+
+    int fd = accept(listen_fd_, 0, 0);
+    if (fd < 0)
+    {
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!running_)
+    {
+      close(fd);
+      break;
+    }
+    uint64_t id = next_connection_++;
+    connections_[id].fd = fd;
+    connections_[id].thread = std::thread(&VisardSimulator::handleConnection, this, id, fd);
+  }
+}
+
+void VisardSimulator::handleConnection(uint64_t id, int fd)
+{
+  std::string buffer;
+  char tmp[4096];
+  bool keep_alive = true;
+
+  while (running_ && keep_alive)
+  {
+    // read header of next request
+
+    std::size_t header_end;
+    while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos)
+    {
+      ssize_t n = TEMP_FAILURE_RETRY(recv(fd, tmp, sizeof(tmp), 0));
+      if (n <= 0)
+      {
+        keep_alive = false;
+        break;
+      }
+      buffer.append(tmp, static_cast<std::size_t>(n));
+    }
+
+    if (!keep_alive)
+    {
+      break;
+    }
+
+    std::istringstream header(buffer.substr(0, header_end));
+    std::string method, path, version, line;
+    header >> method >> path >> version;
+    std::getline(header, line);
+
+    std::size_t content_length = 0;
+    bool expect_continue = false;
+    keep_alive = (version == "HTTP/1.1");
+    while (std::getline(header, line))
+    {
+      std::size_t colon = line.find(':');
+      if (colon == std::string::npos)
+      {
+        continue;
+      }
+
+      std::string name = toLower(line.substr(0, colon));
+      std::string value = toLower(line.substr(colon + 1));
+      value.erase(0, value.find_first_not_of(" \t"));
+      value.erase(value.find_last_not_of(" \t\r") + 1);
+
+      if (name == "content-length")
+      {
+        content_length = static_cast<std::size_t>(std::strtoul(value.c_str(), 0, 10));
+      }
+      else if (name == "connection")
+      {
+        keep_alive = (value == "keep-alive" || (keep_alive && value != "close"));
+      }
+      else if (name == "expect" && value == "100-continue")
+      {
+        expect_continue = true;
+      }
+    }
+
+    // read body
+
+    std::size_t request_size = header_end + 4 + content_length;
+    if (expect_continue && buffer.size() < request_size)
+    {
+      const char cont[] = "HTTP/1.1 100 Continue\r\n\r\n";
+      send(fd, cont, sizeof(cont) - 1, MSG_NOSIGNAL);
+    }
+
+    while (buffer.size() < request_size)
+    {
+      ssize_t n = TEMP_FAILURE_RETRY(recv(fd, tmp, sizeof(tmp), 0));
+      if (n <= 0)
+      {
+        keep_alive = false;
+        break;
+      }
+      buffer.append(tmp, static_cast<std::size_t>(n));
+    }
+
+    if (buffer.size() < request_size)
+    {
+      break;
+    }
+
+    std::string body = buffer.substr(header_end + 4, content_length);
+    buffer.erase(0, request_size);
+
+    // answer like a busy rc_visard
+
+    num_requests_++;
+    unsigned int latency = getLatency();
+    if (latency > 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(latency));
+    }
+
+    Response r;
+    if (isRejected())
+    {
+      num_rejected_++;
+      r.status = 429;
+      r.body = errorMessage("Too many requests");
+    }
+    else
+    {
+      std::size_t query = path.find('?');
+      r = handleRequest(method, path.substr(0, query), body);
+    }
+
+    std::ostringstream out;
+    out << "HTTP/1.1 " << r.status << " " << getReason(r.status) << "\r\n"
+        << "Content-Type: application/json\r\n"
+        << "Content-Length: " << r.body.size() << "\r\n"
+        << "Connection: " << (keep_alive ? "keep-alive" : "close") << "\r\n\r\n"
+        << r.body;
+
+    std::string response = out.str();
+    if (send(fd, response.data(), response.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(response.size()))
+    {
+      break;
+    }
+  }
+
+  // the socket is closed after joining this thread
+  std::lock_guard<std::mutex> lock(mtx_);
+  finished_.push_back(id);
+}
+
+bool VisardSimulator::isRejected()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  if (config_.max_requests_per_sec > 0)
+  {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    while (!requests_.empty() && now - requests_.front() >= std::chrono::seconds(1))
+    {
+      requests_.pop_front();
+    }
+
+    if (requests_.size() >= config_.max_requests_per_sec)
+    {
+      return true;
+    }
+    requests_.push_back(now);
+  }
+
+  return config_.too_many_requests_rate > 0 &&
+         std::uniform_real_distribution<double>(0, 1)(rng_) < config_.too_many_requests_rate;
+}
+
+unsigned int VisardSimulator::getLatency()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  unsigned int ret = config_.latency_ms;
+  if (config_.latency_jitter_ms > 0)
+  {
+    ret += std::uniform_int_distribution<unsigned int>(0, config_.latency_jitter_ms)(rng_);
+  }
+  return ret;
+}
+
+VisardSimulator::Response VisardSimulator::handleRequest(const std::string& method, const std::string& path,
+                                                         const std::string& body)
+{
+  const std::string prefix = "/api/v1";
+  std::vector<std::string> p;
+  if (path.compare(0, prefix.size(), prefix) == 0)
+  {
+    std::istringstream in(path.substr(prefix.size()));
+    std::string s;
+    while (std::getline(in, s, '/'))
+    {
+      if (!s.empty())
+      {
+        p.push_back(s);
+      }
+    }
+  }
+
+  Response r;
+  r.status = 200;
+
+  if (p.size() == 1 && p[0] == "system" && method == "GET")
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    json js;
+    js["ready"] = true;
+    js["hostname"] = "rc-visard-simulator";
+    js["firmware"]["active_image"]["image_version"] = config_.firmware_version;
+    js["time"] = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    js["uptime"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    r.body = js.dump();
+  }
+  else if (p.size() == 1 && p[0] == "datastreams" && method == "GET")
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    json js = json::array();
+    for (auto&& s : streams_)
+    {
+      json stream;
+      stream["name"] = s.stream.name;
+      stream["protobuf"] = s.stream.pb_msg_type;
+      stream["protocol"] = "UDP";
+      stream["description"] = "Simulated " + s.stream.name + " stream";
+      js.push_back(stream);
+    }
+    r.body = js.dump();
+  }
+  else if (p.size() == 2 && p[0] == "datastreams")
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto&& s : streams_)
+    {
+      if (s.stream.name == p[1])
+      {
+        return handleStream(method, s, body);
+      }
+    }
+    r.status = 404;
+    r.body = errorMessage("Unknown data stream: " + p[1]);
+  }
+  else if (p.size() == 3 && p[0] == "nodes" && p[2] == "status" && method == "GET")
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool running = (dynamics_state_ == "RUNNING" || dynamics_state_ == "RUNNING_WITH_SLAM");
+    json js;
+    js["name"] = p[1];
+    if (p[1] == "rc_dynamics")
+    {
+      js["values"]["state"] = dynamics_state_;
+    }
+    else if (p[1] == "rc_stereo_ins")
+    {
+      js["values"]["state"] = running ? "RUNNING" : "IDLE";
+    }
+    else if (p[1] == "rc_slam")
+    {
+      js["values"]["state"] = dynamics_state_ == "RUNNING_WITH_SLAM" ? "RUNNING" : "IDLE";
+    }
+    else
+    {
+      r.status = 404;
+      r.body = errorMessage("Unknown node: " + p[1]);
+      return r;
+    }
+    js["status"] = running ? "running" : "stale";
+    r.body = js.dump();
+  }
+  else if (p.size() == 4 && p[0] == "nodes" && p[2] == "services" && method == "PUT")
+  {
+    return handleService(p[1], p[3], body);
+  }
+  else
+  {
+    r.status = 404;
+    r.body = errorMessage("Unknown resource: " + path);
+  }
+
+  return r;
+}
+
+VisardSimulator::Response VisardSimulator::handleStream(const std::string& method, StreamState& s,
+                                                        const std::string& body)
+{
+  Response r;
+  r.status = 200;
+
+  std::vector<std::string> destinations;
+  if (method == "PUT" || method == "DELETE")
+  {
+    try
+    {
+      json js = body.empty() ? json::object() : json::parse(body);
+      json::const_iterator it = js.find("destination");
+      if (it != js.end())
+      {
+        for (auto&& d : *it)
+        {
+          destinations.push_back(d.get<std::string>());
+        }
+      }
+    }
+    catch (const std::exception&)
+    {
+      r.status = 400;
+      r.body = errorMessage("Invalid request body");
+      return r;
+    }
+  }
+
+  if (method == "PUT")
+  {
+    for (auto&& d : destinations)
+    {
+      sockaddr_in addr;
+      if (!parseDestination(d, addr))
+      {
+        r.status = 400;
+        r.body = errorMessage("Invalid destination: " + d);
+        return r;
+      }
+
+      if (std::find(s.destinations.begin(), s.destinations.end(), d) == s.destinations.end())
+      {
+        if (s.destinations.size() >= config_.max_destinations)
+        {
+          r.status = 403;
+          r.body = errorMessage("Too many destinations for stream " + s.stream.name + ", maximum is " +
+                                std::to_string(config_.max_destinations));
+          return r;
+        }
+        s.destinations.push_back(d);
+        s.addresses.push_back(addr);
+      }
+    }
+  }
+  else if (method == "DELETE")
+  {
+    // older firmware cannot delete several destinations with one request
+    if (destinations.size() > 1 && isVersionBefore(config_.firmware_version, 1, 6))
+    {
+      r.status = 400;
+      r.body = errorMessage("Only one destination can be deleted per request");
+      return r;
+    }
+
+    if (destinations.empty())
+    {
+      s.destinations.clear();
+      s.addresses.clear();
+    }
+
+    for (auto&& d : destinations)
+    {
+      auto it = std::find(s.destinations.begin(), s.destinations.end(), d);
+      if (it != s.destinations.end())
+      {
+        s.addresses.erase(s.addresses.begin() + (it - s.destinations.begin()));
+        s.destinations.erase(it);
+      }
+    }
+  }
+  else if (method != "GET")
+  {
+    r.status = 405;
+    r.body = errorMessage("Method not allowed: " + method);
+    return r;
+  }
+
+  json js;
+  js["name"] = s.stream.name;
+  js["protobuf"] = s.stream.pb_msg_type;
+  js["protocol"] = "UDP";
+  js["destinations"] = s.destinations;
+  r.body = js.dump();
+  return r;
+}
+
+VisardSimulator::Response VisardSimulator::handleService(const std::string& node, const std::string& service,
+                                                         const std::string& body)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  Response r;
+  r.status = 200;
+
+  json js;
+  js["name"] = service;
+
+  if (node == "rc_dynamics")
+  {
+    bool slam = (dynamics_state_ == "RUNNING_WITH_SLAM");
+    if (service == "start")
+    {
+      dynamics_state_ = slam ? "RUNNING_WITH_SLAM" : "RUNNING";
+    }
+    else if (service == "start_slam" || service == "restart_slam")
+    {
+      dynamics_state_ = "RUNNING_WITH_SLAM";
+    }
+    else if (service == "restart")
+    {
+      dynamics_state_ = "RUNNING";
+    }
+    else if (service == "stop")
+    {
+      dynamics_state_ = "IDLE";
+    }
+    else if (service == "stop_slam")
+    {
+      dynamics_state_ = slam ? "RUNNING" : dynamics_state_;
+    }
+    else if (service == "get_cam2imu_transform")
+    {
+      int64_t stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch()).count();
+      roboception::msgs::Pose pose;
+      pose.mutable_position()->set_x(0.0);
+      pose.mutable_position()->set_y(-0.03);
+      pose.mutable_position()->set_z(-0.01);
+      pose.mutable_orientation()->set_x(0);
+      pose.mutable_orientation()->set_y(0);
+      pose.mutable_orientation()->set_z(0);
+      pose.mutable_orientation()->set_w(1);
+
+      js["response"]["parent"] = "imu";
+      js["response"]["name"] = "camera";
+      js["response"]["producer"] = "rc_dynamics";
+      js["response"]["pose"]["timestamp"] = toJson(stamp);
+      js["response"]["pose"]["pose"] = toJson(pose);
+      r.body = js.dump();
+      return r;
+    }
+    else
+    {
+      r.status = 404;
+      r.body = errorMessage("Unknown service: " + service);
+      return r;
+    }
+
+    js["response"]["accepted"] = true;
+    js["response"]["current_state"] = dynamics_state_;
+  }
+  else if (node == "rc_slam")
+  {
+    if (service == "reset")
+    {
+      js["response"]["accepted"] = true;
+      js["response"]["current_state"] = dynamics_state_ == "RUNNING_WITH_SLAM" ? "RUNNING" : "IDLE";
+    }
+    else if (service == "save_map" || service == "load_map" || service == "remove_map")
+    {
+      js["response"]["return_code"]["value"] = 0;
+      js["response"]["return_code"]["message"] = "";
+    }
+    else if (service == "get_trajectory")
+    {
+      // poses of the simulated motion at 10 Hz since start of the simulator
+
+      json args;
+      try
+      {
+        args = body.empty() ? json::object() : json::parse(body).value("args", json::object());
+      }
+      catch (const std::exception&)
+      {
+        r.status = 400;
+        r.body = errorMessage("Invalid request body");
+        return r;
+      }
+
+      int64_t end_stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now().time_since_epoch()).count();
+      int64_t first = getTrajectoryTime(args, "start_time", start_stamp_, end_stamp, false);
+      int64_t last = getTrajectoryTime(args, "end_time", start_stamp_, end_stamp, true);
+
+      json poses = json::array();
+      const int64_t period = 100000000;
+      int64_t t = std::max(first, start_stamp_);
+      t = start_stamp_ + ((t - start_stamp_ + period - 1) / period) * period;
+      for (int i = 0; t <= std::min(last, end_stamp) && i < max_trajectory_poses; t += period, i++)
+      {
+        roboception::msgs::Pose pose;
+        setPose(&pose, (t - start_stamp_) * 1e-9);
+
+        json js_pose;
+        js_pose["timestamp"] = toJson(t);
+        js_pose["pose"] = toJson(pose);
+        poses.push_back(js_pose);
+      }
+
+      js["response"]["trajectory"]["parent"] = "world";
+      js["response"]["trajectory"]["name"] = "rcvisard";
+      js["response"]["trajectory"]["producer"] = "slam";
+      js["response"]["trajectory"]["timestamp"] = toJson(end_stamp);
+      js["response"]["trajectory"]["poses"] = poses;
+    }
+    else
+    {
+      r.status = 404;
+      r.body = errorMessage("Unknown service: " + service);
+      return r;
+    }
+  }
+  else
+  {
+    r.status = 404;
+    r.body = errorMessage("Unknown node: " + node);
+    return r;
+  }
+
+  r.body = js.dump();
+  return r;
+}
+
+std::string VisardSimulator::createMessage(const Stream& stream, double t, int64_t stamp, bool slam) const
+{
+  double a = omega * t;
+
+  if (stream.pb_msg_type == "Imu")
+  {
+    // rotation about z and centripetal acceleration of the motion on the circle
+    roboception::msgs::Imu msg;
+    setTime(msg.mutable_timestamp(), stamp);
+    msg.mutable_linear_acceleration()->set_x(-omega * omega * std::cos(a / 2));
+    msg.mutable_linear_acceleration()->set_y(omega * omega * std::sin(a / 2));
+    msg.mutable_linear_acceleration()->set_z(9.81);
+    msg.mutable_angular_velocity()->set_x(0);
+    msg.mutable_angular_velocity()->set_y(0);
+    msg.mutable_angular_velocity()->set_z(omega);
+    return msg.SerializeAsString();
+  }
+
+  if (stream.pb_msg_type == "Dynamics")
+  {
+    roboception::msgs::Dynamics msg;
+    setTime(msg.mutable_timestamp(), stamp);
+    setPose(msg.mutable_pose(), t);
+    msg.set_pose_frame("world");
+    msg.mutable_linear_velocity()->set_x(-omega * std::sin(a));
+    msg.mutable_linear_velocity()->set_y(omega * std::cos(a));
+    msg.mutable_linear_velocity()->set_z(0.01 * omega * std::cos(0.1 * a));
+    msg.set_linear_velocity_frame("world");
+    msg.mutable_angular_velocity()->set_x(0);
+    msg.mutable_angular_velocity()->set_y(0);
+    msg.mutable_angular_velocity()->set_z(omega);
+    msg.set_angular_velocity_frame("imu");
+    msg.mutable_linear_acceleration()->set_x(-omega * omega * std::cos(a / 2));
+    msg.mutable_linear_acceleration()->set_y(omega * omega * std::sin(a / 2));
+    msg.mutable_linear_acceleration()->set_z(9.81);
+    msg.set_linear_acceleration_frame("imu");
+
+    // upper triangle of the 6x6 covariance, so that messages fit into the buffer of DataReceiver
+    for (int r = 0; r < 6; r++)
+    {
+      for (int c = r; c < 6; c++)
+      {
+        msg.add_covariance(r == c ? 1e-4 : 0);
+      }
+    }
+    msg.set_possible_slam_failure(false);
+    return msg.SerializeAsString();
+  }
+
+  roboception::msgs::Frame msg;
+  setTime(msg.mutable_pose()->mutable_timestamp(), stamp);
+  setPose(msg.mutable_pose()->mutable_pose(), t);
+  msg.set_parent("world");
+  msg.set_name("rcvisard");
+  msg.set_producer(slam && stream.name.find("_ins") == std::string::npos ? "slam" : "ins");
+  return msg.SerializeAsString();
+}
+
+void VisardSimulator::stream()
+{
+  typedef std::chrono::steady_clock clock;
+
+  std::vector<clock::time_point> next(streams_.size(), clock::now());
+  std::vector<sockaddr_in> addresses;
+
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (running_)
+  {
+    // wait for the next message that is due
+
+    clock::time_point now = clock::now();
+    clock::time_point due = now + std::chrono::milliseconds(100);
+    for (std::size_t i = 0; i < streams_.size(); i++)
+    {
+      if (streams_[i].stream.rate > 0)
+      {
+        due = std::min(due, next[i]);
+      }
+      else
+      {
+        next[i] = now;
+      }
+    }
+
+    if (due > now)
+    {
+      cond_.wait_until(lock, due);
+      continue;
+    }
+
+    bool running = (dynamics_state_ == "RUNNING" || dynamics_state_ == "RUNNING_WITH_SLAM");
+    bool slam = (dynamics_state_ == "RUNNING_WITH_SLAM");
+    for (std::size_t i = 0; i < streams_.size(); i++)
+    {
+      const Stream stream = streams_[i].stream;
+      if (stream.rate <= 0 || next[i] > now)
+      {
+        continue;
+      }
+
+      // keep the rate, but do not send bursts of messages after a stall
+
+      next[i] += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / stream.rate));
+      if (next[i] < now - std::chrono::milliseconds(100))
+      {
+        next[i] = now;
+      }
+
+      // like on the rc_visard, imu is sent regardless of the state of rc_dynamics
+
+      addresses = streams_[i].addresses;
+      if ((!running && stream.name != "imu") || addresses.empty())
+      {
+        continue;
+      }
+
+      lock.unlock();
+
+      int64_t stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch()).count();
+      std::string data = createMessage(stream, std::chrono::duration<double>(now - start_).count(), stamp, slam);
+      for (auto&& addr : addresses)
+      {
+        ssize_t ret = TEMP_FAILURE_RETRY(sendto(send_fd_, data.data(), data.size(), 0,
+                                                reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)));
+        if (ret < 0)
+        {
+          num_send_errors_++;
+        }
+        else
+        {
+          num_messages_++;
+        }
+      }
+
+      lock.lock();
+    }
+  }
+}
+}
+}
@@ -0,0 +1,243 @@
+/*
+ * This file is part of the rc_dynamics_api package.
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RC_DYNAMICS_API_VISARD_SIMULATOR_H
+#define RC_DYNAMICS_API_VISARD_SIMULATOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+
+namespace rc
+{
+namespace dynamics
+{
+/**
+ * Stand-in for an rc_visard for testing and benchmarking without hardware.
+ *
+ * It serves the parts of the REST-API that are used by RemoteInterface,
+ * i.e. /system, /datastreams, /datastreams/<stream>, /nodes/<node>/status
+ * and the services of rc_dynamics and rc_slam, and streams synthetic Imu,
+ * Dynamics and Frame messages via UDP to all registered destinations. As on
+ * the rc_visard, the imu stream is always sent, all other streams only as
+ * long as rc_dynamics is running. The messages describe a smooth motion on
+ * a circle, time stamped with the system clock of this host. Destinations
+ * may be multicast groups, which are served via the network interface of
+ * the REST-API address.
+ *
+ * For reproducing the behaviour of a busy device, every REST-API response
+ * can be delayed and requests can be rejected with http error code 429
+ * (too many requests), either randomly or beyond a request rate limit.
+ *
+ * The simulator listens on a configurable address and port, so that it can
+ * be reached by RemoteInterface::create("127.0.0.1:8080") without
+ * privileges.
+ *
+ * NOTE: Only available on POSIX systems.
+ */
+class VisardSimulator
+{
+public:
+  using Ptr = std::shared_ptr<VisardSimulator>;
+
+  /// Description of a simulated data stream
+  struct Stream
+  {
+    std::string name;         ///< name of the stream, e.g. "dynamics"
+    std::string pb_msg_type;  ///< protobuf message type, i.e. "Imu", "Dynamics" or "Frame"
+    double rate;              ///< messages per second
+  };
+
+  /// Behaviour of the REST-API
+  struct Config
+  {
+    Config();
+
+    std::string firmware_version;       ///< e.g. "v1.6.0", before 1.6 only one destination can be deleted per request
+    unsigned int latency_ms;            ///< delay of every REST-API response
+    unsigned int latency_jitter_ms;     ///< maximum of an additional, uniformly distributed delay
+    double too_many_requests_rate;      ///< probability of rejecting a request with 429
+    unsigned int max_requests_per_sec;  ///< requests beyond this rate are rejected with 429, 0 for unlimited
+    unsigned int max_destinations;      ///< maximum number of destinations per stream
+    unsigned int seed;                  ///< seed of the random numbers, for reproducible runs
+  };
+
+  /// Number of requests and messages since creation
+  struct Statistics
+  {
+    uint64_t requests;     ///< REST-API requests
+    uint64_t rejected;     ///< REST-API requests that have been rejected with 429
+    uint64_t messages;     ///< datagrams sent to destinations
+    uint64_t send_errors;  ///< datagrams that could not be sent
+  };
+
+  /**
+   * Returns the data streams of an rc_visard with their usual rates.
+   */
+  static std::vector<Stream> getDefaultStreams();
+
+  /**
+   * Creates a simulator that immediately starts listening for REST-API
+   * requests. rc_dynamics is initially in state RUNNING.
+   *
+   * @param ip_address IP address of the REST-API
+   * @param port port number of the REST-API, 0 for an arbitrary port
+   * @param config behaviour of the REST-API
+   * @param streams data streams
+   */
+  static Ptr create(const std::string& ip_address = "127.0.0.1", unsigned int port = 0,
+                    const Config& config = Config(), const std::vector<Stream>& streams = getDefaultStreams());
+
+  /// Stops the simulator
+  ~VisardSimulator();
+
+  /// Returns the address of the REST-API as <ip>:<port>, e.g. for RemoteInterface::create()
+  std::string getAddress() const;
+
+  /// Returns the port number of the REST-API
+  unsigned int getPort() const
+  {
+    return port_;
+  }
+
+  /// Changes the behaviour of the REST-API
+  void setConfig(const Config& config);
+
+  /// Returns the behaviour of the REST-API
+  Config getConfig() const;
+
+  /**
+   * Changes the rate of a data stream.
+   *
+   * @param stream name of the stream
+   * @param rate messages per second, 0 for not sending any messages
+   */
+  void setRate(const std::string& stream, double rate);
+
+  /**
+   * Sets the state of rc_dynamics. Messages of other streams than imu are
+   * only streamed in the states RUNNING and RUNNING_WITH_SLAM.
+   */
+  void setDynamicsState(const std::string& state);
+
+  /// Returns the state of rc_dynamics
+  std::string getDynamicsState() const;
+
+  /// Returns the registered destinations of a stream
+  std::vector<std::string> getDestinations(const std::string& stream) const;
+
+  /// Removes all destinations of all streams, like a reboot of the rc_visard
+  void clearDestinations();
+
+  /// Returns the number of requests and messages since creation
+  Statistics getStatistics() const;
+
+  /// Stops serving requests and streaming. This is done automatically on destruction.
+  void stop();
+
+private:
+  VisardSimulator(const std::string& ip_address, unsigned int port, const Config& config,
+                  const std::vector<Stream>& streams);
+
+  struct StreamState
+  {
+    Stream stream;
+    std::vector<std::string> destinations;
+    std::vector<sockaddr_in> addresses;
+  };
+
+  struct Connection
+  {
+    int fd;
+    std::thread thread;
+  };
+
+  struct Response
+  {
+    int status;
+    std::string body;
+  };
+
+  void serve();
+  void handleConnection(uint64_t id, int fd);
+  Response handleRequest(const std::string& method, const std::string& path, const std::string& body);
+  Response handleStream(const std::string& method, StreamState& s, const std::string& body);
+  Response handleService(const std::string& node, const std::string& service, const std::string& body);
+  bool isRejected();
+  unsigned int getLatency();
+
+  void stream();
+  std::string createMessage(const Stream& stream, double t, int64_t stamp, bool slam) const;
+
+  std::string ip_;
+  unsigned int port_;
+  int listen_fd_;
+  int send_fd_;
+
+  mutable std::mutex mtx_;
+  std::condition_variable cond_;
+  Config config_;
+  std::vector<StreamState> streams_;
+  std::string dynamics_state_;
+  std::mt19937 rng_;
+  std::deque<std::chrono::steady_clock::time_point> requests_;  // time of requests within the last second
+  std::chrono::steady_clock::time_point start_;
+  int64_t start_stamp_;
+
+  std::atomic<bool> running_;
+  std::atomic<uint64_t> num_requests_;
+  std::atomic<uint64_t> num_rejected_;
+  std::atomic<uint64_t> num_messages_;
+  std::atomic<uint64_t> num_send_errors_;
+
+  std::thread serve_thread_;
+  std::thread stream_thread_;
+  uint64_t next_connection_;
+  std::map<uint64_t, Connection> connections_;
+  std::vector<uint64_t> finished_;  // connections that can be joined and closed
+};
+}
+}
+
+#endif  // RC_DYNAMICS_API_VISARD_SIMULATOR_H